@@ -1,5 +1,6 @@
-#version 330 core
+#version 460 core
 
+#include "camera"
 #include "light"
 
 in vec3 v_FragPos;
@@ -7,14 +8,6 @@ in mat3 v_TBN;
 in vec2 v_TexCoord;
 in vec4 v_FragPosLightSpace;
 
-uniform vec3 u_CameraPos;
-uniform vec3 u_Ambient;
-
-uniform material u_Material;
-uniform sampler2D u_Material_diffuse[MAX_TEXTURES];
-uniform sampler2D u_Material_normal[MAX_TEXTURES];
-uniform sampler2D u_Material_specular[MAX_TEXTURES];
-
 uniform sampler2D u_ShadowMap;
 uniform float u_ShadowBias;
 uniform bool u_ShadowsEnabled;
@@ -37,9 +30,11 @@ float shadow_factor(vec4 frag_pos_light_space) {
 }
 
 void main() {
+  material mat = u_Materials[u_MaterialIndex];
+
   // Normal
   vec3 norm;
-  if (u_UseNormalMap && u_Material.normal_count > 0) {
+  if (u_UseNormalMap && mat.normal_count > 0) {
     vec3 n = texture(u_Material_normal[0], v_TexCoord).rgb * 2.0 - 1.0;
     norm   = normalize(v_TBN * n);
   } else {
@@ -50,25 +45,22 @@ void main() {
 
   // Diffuse color
   vec3 diff_tex =
-      u_Material.diffuse_count > 0 ? texture(u_Material_diffuse[0], v_TexCoord).rgb : u_Material.surface_color;
+      mat.diffuse_count > 0 ? texture(u_Material_diffuse[0], v_TexCoord).rgb : mat.surface_color;
 
   // Specular factor from specular map
   float spec_factor =
-      (u_UseSpecularMap && u_Material.specular_count > 0) ? texture(u_Material_specular[0], v_TexCoord).r : 1.0;
+      (u_UseSpecularMap && mat.specular_count > 0) ? texture(u_Material_specular[0], v_TexCoord).r : 1.0;
 
   // Scale material ks by specular map
-  material mat = u_Material;
   mat.ks *= spec_factor;
 
   vec3 lighting = vec3(0.0);
 
   float shadow = shadow_factor(v_FragPosLightSpace);
-  for (int i = 0; i < u_DirectionalCount; ++i)
+  for (uint i = 0; i < u_DirectionalCount; ++i)
     lighting += shadow * calc_dir_light(u_DirectionalLights[i], mat, norm, view_dir);
 
-  for (int i = 0; i < u_PointCount; ++i) lighting += calc_point_light(u_PointLights[i], mat, norm, v_FragPos, view_dir);
-
-  for (int i = 0; i < u_SpotCount; ++i) lighting += calc_spot_light(u_SpotLights[i], mat, norm, v_FragPos, view_dir);
+  lighting += calc_clustered_lights(mat, norm, v_FragPos, view_dir);
 
   vec3 ambient = u_Ambient * mat.ka * diff_tex;
 
@@ -1,8 +1,8 @@
-#version 330 core
+#version 460 core
 
-layout(location = 0) in vec3 a_Position;
+#include "camera"
+#include "object"
 
-uniform mat4 u_M;
-uniform mat4 u_VP;
+layout(location = 0) in vec3 a_Position;
 
-void main() { gl_Position = u_VP * u_M * vec4(a_Position, 1.0); }
+void main() { gl_Position = u_VP * current_object().world * vec4(a_Position, 1.0); }
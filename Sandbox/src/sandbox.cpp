@@ -1,21 +1,35 @@
 #include <imgui/imgui.h>
 
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <mEn/features/type_ptr.hpp>
+#include <mEn/functions/geometric.hpp>
+#include <mEn/functions/matrix_common.hpp>
 #include <mEn/functions/matrix_projection.hpp>
 #include <mEn/functions/matrix_transform.hpp>
 #include <mEn/functions/trigonometric.hpp>
 #include <mEn/fwd.hpp>
 #include <mEn/vec3.hpp>
+#include <mEn/vec4.hpp>
 
 #include <kEn.hpp>  //NOLINT
 #include <kEn/core/application.hpp>
 #include <kEn/core/input/key_codes.hpp>
 #include <kEn/core/layer.hpp>
 #include <kEn/core/log.hpp>
+#include <kEn/core/task.hpp>
 #include <kEn/core/timestep.hpp>
 #include <kEn/core/window.hpp>
 #include <kEn/event/application_events.hpp>
@@ -31,11 +45,15 @@
 #include <kEn/renderer/shader.hpp>
 #include <kEn/renderer/texture_format.hpp>
 #include <kEn/scene/assets/model.hpp>
+#include <kEn/scene/bounds.hpp>
 #include <kEn/scene/components/camera.hpp>
 #include <kEn/scene/components/camera_controllers.hpp>
 #include <kEn/scene/components/light.hpp>
 #include <kEn/scene/components/model_component.hpp>
 #include <kEn/scene/game_object.hpp>
+#include <kEn/scene/render_snapshot.hpp>
+#include <kEn/scene/spatial_index.hpp>
+#include <kEn/scene/update_scheduler.hpp>
 
 namespace {
 
@@ -66,10 +84,9 @@ class DemoLayer : public kEn::Layer {
     spot_light_->set_cutoff_angles(10.F, 20.F);
     camera_obj_.add_child(spot_light_obj_);
 
-    // --- Model ---
+    // --- Model (imported and decoded on workers, shown once uploaded) ---
     model_obj_.transform().set_local_pos({0.F, 0.F, 0.F});
-    auto backpack = kEn::Model::load("backpack/backpack.obj", {}, true);
-    model_obj_.emplace_component<kEn::ModelComponent>(backpack);
+    load_model(model_obj_, kEn::Model::load_async("backpack/backpack.obj", {}, true, true));
 
     // --- Directional light that always aims at the model (LookAt) ---
     dir_light_        = &dir_light_obj_.emplace_component<kEn::DirectionalLight>();
@@ -85,15 +102,17 @@ class DemoLayer : public kEn::Layer {
     // --- Floor (scaled cube with programmatic white texture) ---
     floor_obj_.transform().set_local_pos({0.F, -1.8F, 0.F});
     floor_obj_.transform().set_local_scale({10.F, 0.2F, 10.F});
-    auto floor_model = kEn::Model::load("cube/cube.obj");
-    floor_obj_.emplace_component<kEn::ModelComponent>(floor_model);
+    load_model(floor_obj_, kEn::Model::load_async("cube/cube.obj", {}, false, true));
 
-    // --- Register lights (once -- SceneData never clears them) ---
-    kEn::Renderer::add_light(*point_light_);
-    kEn::Renderer::add_light(*dir_light_);
-    kEn::Renderer::add_light(*spot_light_);
     kEn::Renderer::set_ambient(ambient_color_);
 
+    // --- Update scheduling (spot_light_obj_ is registered through camera_obj_) ---
+    update_scheduler_.add(camera_obj_);
+    update_scheduler_.add(model_obj_);
+    update_scheduler_.add(floor_obj_);
+    update_scheduler_.add(point_light_obj_);
+    update_scheduler_.add(dir_light_obj_);
+
     // --- Shader ---
     phong_shader_ = device_.create_shader("phong");
 
@@ -102,6 +121,7 @@ class DemoLayer : public kEn::Layer {
     shadow_spec.width                        = kShadowMapSize;
     shadow_spec.height                       = kShadowMapSize;
     shadow_spec.attachments.depth_attachment = kEn::TextureFormat::Depth32F;
+    shadow_spec.debug_name                   = "Shadow map";
 
     shadow_map_fb_ = device_.create_framebuffer(shadow_spec);
     shadow_shader_ = device_.create_shader("shadow");
@@ -112,6 +132,7 @@ class DemoLayer : public kEn::Layer {
     fb_spec.height      = vp_h_;
     fb_spec.attachments = {.color_attachments = {kEn::TextureFormat::RGBA8},
                            .depth_attachment  = kEn::TextureFormat::Depth24Stencil8};
+    fb_spec.debug_name  = "Viewport";
 
     framebuffer_ = device_.create_framebuffer(fb_spec);
 
@@ -131,56 +152,88 @@ class DemoLayer : public kEn::Layer {
   void on_detach() override { KEN_INFO("DemoLayer detached"); }
 
   void on_update(kEn::Timestep delta, kEn::Timestep time) override {
-    camera_obj_.update(delta, time);
-    model_obj_.update(delta, time);
-    floor_obj_.update(delta, time);
-    point_light_obj_.update(delta, time);
-    dir_light_obj_.update(delta, time);
+    adopt_loaded_models();
+
+    const std::array views{kEn::Frustum::from_matrix(camera_->view_projection_matrix())};
+    update_scheduler_.set_focus(camera_obj_.transform().world_pos());
+    update_scheduler_.set_views(views);
+    update_scheduler_.update(delta, time);
+    scene_index_.update();
+  }
+
+  void on_snapshot(kEn::RenderSnapshot& snapshot) override {
+    snapshot.camera = kEn::RenderSnapshot::View::from(*camera_);
+    camera_obj_.snapshot(snapshot);
+    model_obj_.snapshot(snapshot);
+    floor_obj_.snapshot(snapshot);
+    point_light_obj_.snapshot(snapshot);
+    dir_light_obj_.snapshot(snapshot);
+    snapshot.point_lights.insert(snapshot.point_lights.end(), light_swarm_.begin(), light_swarm_.end());
   }
 
-  void on_render(double alpha) override {
+  void on_render(double /*alpha*/) override {
+    const kEn::RenderSnapshot& snapshot = kEn::Application::instance().render_snapshot();
+    if (snapshot.directional_lights.empty()) {
+      return;  // nothing simulated yet
+    }
+
     // --- Compute light-space matrix from directional light transform ---
     constexpr mEn::Mat4 kLightProj = mEn::ortho(-12.F, 12.F, -12.F, 12.F, 0.1F, 30.F);
 
-    const mEn::Vec3 light_pos  = dir_light_obj_.transform().world_pos();
+    const mEn::Vec3 light_pos  = snapshot.directional_lights.front().pos;
     const mEn::Mat4 light_view = mEn::lookAt(light_pos, mEn::Vec3{0.F}, mEn::Vec3{0.F, 1.F, 0.F});
 
     // --- Shadow pass ---
     if (shadows_enabled_) {
+      const kEn::GpuScope gpu_scope(device_.context(), "Shadow pass");
       device_.context().set_render_target(*shadow_map_fb_);
       device_.context().set_viewport(0, 0, kShadowMapSize, kShadowMapSize);
       shadow_map_fb_->clear_depth();
       device_.context().set_depth_state(*depth_state_);
       device_.context().set_raster_state(*raster_front_cull_);
       kEn::Renderer::begin_scene(light_pos, light_view, kLightProj, device_.context());
-      floor_obj_.render(*shadow_shader_, alpha);
-      model_obj_.render(*shadow_shader_, alpha);
+      kEn::Renderer::set_lod_view(1, static_cast<float>(kShadowMapSize));
+      for (const auto& object : snapshot.objects) {
+        object.render(*shadow_shader_);
+      }
       kEn::Renderer::end_scene();
+      shadow_cull_stats_ = kEn::Renderer::cull_stats();
     }
 
     // --- Main pass ---
-    device_.context().set_render_target(*framebuffer_);
-    device_.context().set_viewport(0, 0, vp_w_, vp_h_);
-    device_.context().set_clear_color({0.08F, 0.08F, 0.12F, 1.F});
-    device_.context().clear();
-    device_.context().set_depth_state(*depth_state_);
-    device_.context().set_raster_state(wireframe_ ? *raster_wireframe_ : *raster_back_cull_);
-
-    kEn::Renderer::begin_scene(*camera_, device_.context());
-    kEn::Renderer::prepare(*phong_shader_);
-
-    device_.context().bind_attachment(kShadowMapSlot, kEn::ShaderStage::Fragment, *shadow_map_fb_->depth_attachment());
-    phong_shader_->set_uniform("u_ShadowMap", static_cast<int>(kShadowMapSlot));
-    phong_shader_->set_uniform("u_LightVP", kLightProj * light_view);
-    phong_shader_->set_uniform("u_ShadowBias", shadow_bias_);
-    phong_shader_->set_uniform("u_ShadowsEnabled", shadows_enabled_);
-    phong_shader_->set_uniform("u_UseNormalMap", use_normal_map_);
-    phong_shader_->set_uniform("u_UseSpecularMap", use_specular_map_);
-
-    floor_obj_.render(*phong_shader_, alpha);
-    model_obj_.render(*phong_shader_, alpha);
+    {
+      using namespace kEn::literals;  // NOLINT(google-build-using-namespace)
+      const kEn::GpuScope gpu_scope(device_.context(), "Main pass");
+      device_.context().set_render_target(*framebuffer_);
+      device_.context().set_viewport(0, 0, vp_w_, vp_h_);
+      device_.context().set_clear_color({0.08F, 0.08F, 0.12F, 1.F});
+      device_.context().clear();
+      device_.context().set_depth_state(*depth_state_);
+      device_.context().set_raster_state(wireframe_ ? *raster_wireframe_ : *raster_back_cull_);
+
+      kEn::Renderer::begin_scene(snapshot.camera.position, snapshot.camera.view, snapshot.camera.projection,
+                                 device_.context());
+      kEn::Renderer::set_lod_view(0, static_cast<float>(vp_h_));
+      snapshot.prepare();
+
+      device_.context().bind_attachment(kShadowMapSlot, kEn::ShaderStage::Fragment,
+                                        *shadow_map_fb_->depth_attachment());
+      phong_shader_->set_uniform("u_ShadowMap"_uniform, static_cast<int>(kShadowMapSlot));
+      phong_shader_->set_uniform("u_LightVP"_uniform, kLightProj * light_view);
+      phong_shader_->set_uniform("u_ShadowBias"_uniform, shadow_bias_);
+      phong_shader_->set_uniform("u_ShadowsEnabled"_uniform, shadows_enabled_);
+      phong_shader_->set_uniform("u_UseNormalMap"_uniform, use_normal_map_);
+      phong_shader_->set_uniform("u_UseSpecularMap"_uniform, use_specular_map_);
+
+      for (const auto& object : snapshot.objects) {
+        object.render(*phong_shader_);
+      }
 
-    kEn::Renderer::end_scene();
+      kEn::Renderer::end_scene();
+      main_cull_stats_  = kEn::Renderer::cull_stats();
+      main_lod_stats_   = kEn::Renderer::lod_stats();
+      main_queue_stats_ = kEn::Renderer::queue_stats();
+    }
 
     device_.context().bind_default_framebuffer();
     const kEn::Window& win = kEn::Application::instance().main_window();
@@ -216,6 +269,11 @@ class DemoLayer : public kEn::Layer {
       }
       const auto tex_id = framebuffer_->color_attachment(0).imgui_id();
       ImGui::Image(tex_id, size, {0, 1}, {1, 0});
+      if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
+        const ImVec2 min   = ImGui::GetItemRectMin();
+        const ImVec2 mouse = ImGui::GetMousePos();
+        pick((mouse.x - min.x) / size.x, (mouse.y - min.y) / size.y);
+      }
     }
     ImGui::End();
     ImGui::PopStyleVar();
@@ -232,6 +290,16 @@ class DemoLayer : public kEn::Layer {
                                 200.F);
       }
 
+      ImGui::SeparatorText("Picking");
+      if (picked_) {
+        ImGui::Text("Object: %.*s", static_cast<int>(picked_->object->name().size()), picked_->object->name().data());
+        ImGui::Text("Mesh: %s  Triangle: %u", picked_->mesh != nullptr ? picked_->mesh->name.c_str() : "-",
+                    picked_->triangle);
+        ImGui::Text("Distance: %.3f", static_cast<double>(picked_->distance));
+      } else {
+        ImGui::TextDisabled("Click the viewport to pick an object");
+      }
+
       ImGui::SeparatorText("Rendering");
       ImGui::Checkbox("Wireframe (F1)", &wireframe_);
       ImGui::Checkbox("Normal Map", &use_normal_map_);
@@ -243,6 +311,38 @@ class DemoLayer : public kEn::Layer {
       if (shadows_enabled_) {
         ImGui::SliderFloat("Shadow Bias", &shadow_bias_, 0.0001F, 0.05F, "%.4f");
       }
+
+      ImGui::SeparatorText("Culling");
+      bool frustum_culling = kEn::Renderer::frustum_culling();
+      if (ImGui::Checkbox("Frustum Culling", &frustum_culling)) {
+        kEn::Renderer::set_frustum_culling(frustum_culling);
+      }
+      ImGui::Text("Main pass:   %zu visible, %zu culled", main_cull_stats_.visible, main_cull_stats_.culled);
+      ImGui::Text("Shadow pass: %zu visible, %zu culled", shadow_cull_stats_.visible, shadow_cull_stats_.culled);
+
+      ImGui::SeparatorText("Level of Detail");
+      auto lod         = kEn::Renderer::lod_settings();
+      bool lod_changed = ImGui::Checkbox("Enable LOD", &lod.enabled);
+      lod_changed |= ImGui::SliderFloat("Max Pixel Error", &lod.max_pixel_error, 0.1F, 16.F, "%.1f px");
+      lod_changed |= ImGui::SliderFloat("Hysteresis", &lod.hysteresis, 0.F, 0.9F);
+      if (lod_changed) {
+        kEn::Renderer::set_lod_settings(lod);
+      }
+      ImGui::Text("Main pass: %zu / %zu triangles", main_lod_stats_.submitted_triangles,
+                  main_lod_stats_.full_triangles);
+
+      ImGui::SeparatorText("Render Queue");
+      const auto& unsorted = main_queue_stats_.unsorted;
+      const auto& sorted   = main_queue_stats_.sorted;
+      ImGui::Text("Main pass: %zu draws", main_queue_stats_.draws);
+      ImGui::Text("Shader binds:   %zu -> %zu", unsorted.shaders, sorted.shaders);
+      ImGui::Text("Material binds: %zu -> %zu", unsorted.materials, sorted.materials);
+      ImGui::Text("VAO binds:      %zu -> %zu", unsorted.vertex_inputs, sorted.vertex_inputs);
+
+      ImGui::SeparatorText("Update Scheduling");
+      const auto& sched = update_scheduler_.stats();
+      ImGui::Text("%zu registered, %zu sleeping", sched.registered, sched.sleeping);
+      ImGui::Text("Last tick: %zu updated, %zu throttled", sched.updated, sched.throttled);
     }
     ImGui::End();
 
@@ -262,6 +362,14 @@ class DemoLayer : public kEn::Layer {
       if (ImGui::CollapsingHeader("Spot Light (torch)")) {
         spot_light_->imgui();
       }
+
+      ImGui::SeparatorText("Clustered Lighting");
+      if (ImGui::SliderInt("Light Swarm", &light_swarm_size_, 0, kMaxLightSwarm)) {
+        scatter_light_swarm();
+      }
+      const auto& clusters = kEn::Renderer::light_cluster_stats();
+      ImGui::Text("%zu point, %zu spot lights", clusters.point_lights, clusters.spot_lights);
+      ImGui::Text("%zu cluster references, at most %zu per cluster", clusters.references, clusters.max_lights);
     }
     ImGui::End();
 
@@ -281,6 +389,63 @@ class DemoLayer : public kEn::Layer {
   }
 
  private:
+  /** A model still loading and the object that shows it once it is loaded. */
+  struct PendingModel {
+    kEn::Task<std::shared_ptr<kEn::Model>> task;
+    kEn::GameObject* object;
+  };
+
+  void load_model(kEn::GameObject& object, kEn::Task<std::shared_ptr<kEn::Model>> task) {
+    task.start();
+    pending_models_.push_back({.task = std::move(task), .object = &object});
+  }
+
+  /** Gives every object whose model finished loading its ModelComponent and registers it with the scene. */
+  void adopt_loaded_models() {
+    std::erase_if(pending_models_, [this](PendingModel& pending) {
+      if (!pending.task.done()) {
+        return false;
+      }
+      try {
+        auto model = pending.task.result();
+        pending.object->emplace_component<kEn::ModelComponent>(model);
+        scene_index_.insert(*pending.object, std::move(model));
+        update_scheduler_.add(*pending.object);
+      } catch (const std::exception& e) {
+        KEN_ERROR("Failed to load model: {}", e.what());
+      }
+      return true;
+    });
+  }
+
+  /** Casts a ray from the camera through the viewport point (u, v) in [0, 1], v pointing down. */
+  void pick(float u, float v) {
+    const mEn::Mat4 inv_vp = mEn::inverse(camera_->view_projection_matrix());
+    const float x          = (2.F * u) - 1.F;
+    const float y          = 1.F - (2.F * v);
+
+    const mEn::Vec4 near_h = inv_vp * mEn::Vec4(x, y, -1.F, 1.F);
+    const mEn::Vec4 far_h  = inv_vp * mEn::Vec4(x, y, 1.F, 1.F);
+    const mEn::Vec3 near   = mEn::Vec3(near_h) / near_h.w;
+    const mEn::Vec3 far    = mEn::Vec3(far_h) / far_h.w;
+
+    picked_ = scene_index_.raycast(kEn::Ray(near, mEn::normalize(far - near)));
+  }
+
+  /** Scatters light_swarm_size_ small point lights of random colors over the floor. */
+  void scatter_light_swarm() {
+    std::mt19937 rng(kLightSwarmSeed);
+    std::uniform_real_distribution<float> unit(0.F, 1.F);
+    std::uniform_real_distribution<float> span(-9.F, 9.F);
+
+    light_swarm_.clear();
+    for (int i = 0; i < light_swarm_size_; ++i) {
+      light_swarm_.push_back({.color = {unit(rng), unit(rng), unit(rng)},
+                              .pos   = {span(rng), -1.5F + (2.F * unit(rng)), span(rng)},
+                              .atten = kEn::Attenuation::from_radius(1.F + (2.F * unit(rng)))});
+    }
+  }
+
   bool on_key_pressed(kEn::KeyPressedEvent& event) {
     if (event.key() == kEn::key::f1) {
       wireframe_ = !wireframe_;
@@ -312,6 +477,12 @@ class DemoLayer : public kEn::Layer {
   kEn::GameObject point_light_obj_;
   kEn::GameObject dir_light_obj_;
 
+  // Declared after the objects it indexes so it unsubscribes from their transforms first
+  kEn::SpatialIndex scene_index_;
+  std::optional<kEn::RaycastHit> picked_;
+  kEn::UpdateScheduler update_scheduler_;
+  std::vector<PendingModel> pending_models_;
+
   kEn::PerspectiveCamera* camera_   = nullptr;
   kEn::PointLight* point_light_     = nullptr;
   kEn::DirectionalLight* dir_light_ = nullptr;
@@ -329,8 +500,18 @@ class DemoLayer : public kEn::Layer {
   float shadow_bias_    = 0.005F;
   bool shadows_enabled_ = true;
 
-  static constexpr uint32_t kShadowMapSize = 2048;
-  static constexpr uint32_t kShadowMapSlot = 15;
+  kEn::Renderer::CullStats main_cull_stats_;
+  kEn::Renderer::CullStats shadow_cull_stats_;
+  kEn::Renderer::LodStats main_lod_stats_;
+  kEn::Renderer::QueueStats main_queue_stats_;
+
+  std::vector<kEn::PointLight::Data> light_swarm_;
+  int light_swarm_size_ = 0;
+
+  static constexpr uint32_t kShadowMapSize  = 2048;
+  static constexpr uint32_t kShadowMapSlot  = 15;
+  static constexpr int kMaxLightSwarm       = 4096;
+  static constexpr uint32_t kLightSwarmSeed = 42;
 
   bool viewport_focused_   = false;
   bool viewport_hovered_   = false;
@@ -345,11 +526,41 @@ class DemoLayer : public kEn::Layer {
 
 class Sandbox : public kEn::Application {
  public:
-  Sandbox() : kEn::Application({.title = "Sandbox", .enable_debug = true}) {
+  explicit Sandbox(kEn::ApplicationSpec spec) : kEn::Application(std::move(spec)) {
     push_layer(std::make_unique<DemoLayer>());
   }
 };
 
+/** @brief Reads <tt>--record FILE</tt>, <tt>--replay FILE</tt>, <tt>--report FILE</tt>, <tt>--trace FILE</tt>,
+ *         <tt>--workers N</tt>, <tt>--headless</tt> and <tt>--pipelined</tt>.
+ */
+kEn::ApplicationSpec parse_args(std::span<const std::string_view> args) {
+  kEn::ApplicationSpec spec{.title = "Sandbox", .enable_debug = true, .queue_events = true};
+
+  for (size_t i = 1; i < args.size(); ++i) {
+    const bool has_value = i + 1 < args.size();
+    if (args[i] == "--headless") {
+      spec.headless = true;
+    } else if (args[i] == "--pipelined") {
+      spec.pipelined = true;
+    } else if (args[i] == "--record" && has_value) {
+      spec.record_events = args[++i];
+    } else if (args[i] == "--replay" && has_value) {
+      spec.replay_events = args[++i];
+    } else if (args[i] == "--report" && has_value) {
+      spec.replay_report = args[++i];
+    } else if (args[i] == "--trace" && has_value) {
+      spec.profile_trace = args[++i];
+    } else if (args[i] == "--workers" && has_value) {
+      const std::string_view value = args[++i];
+      std::from_chars(value.data(), value.data() + value.size(), spec.worker_threads);
+    }
+  }
+  return spec;
+}
+
 }  // namespace
 
-kEn::Application* kEn::create_application(std::vector<std::string_view> /*args*/) { return new Sandbox(); }  // NOLINT
+kEn::Application* kEn::create_application(std::vector<std::string_view> args) {
+  return new Sandbox(parse_args(args));  // NOLINT
+}
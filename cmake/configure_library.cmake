@@ -130,5 +130,25 @@ function(configure_library)
     endif()
   endif()
 
+  # Benchmarks configuration
+  if(BUILD_BENCHMARKS)
+    message(STATUS "Configuring ${PROJECT_NAME}_benchmarks executable")
+    file(GLOB_RECURSE BENCHMARKS_SOURCES 
+        "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/*.cpp"
+    )
+    if(NOT BENCHMARKS_SOURCES)
+      message(STATUS "No benchmark sources found, benchmarks executable configuration stopped")
+    else()
+      add_executable(
+          "${PROJECT_NAME}_benchmarks"
+          ${BENCHMARKS_SOURCES} 
+      )
+      target_link_libraries(
+          "${PROJECT_NAME}_benchmarks"
+          ${PROJECT_NAME}
+      )
+    endif()
+  endif()
+
   list(POP_BACK CMAKE_MESSAGE_INDENT)
 endfunction()
\ No newline at end of file
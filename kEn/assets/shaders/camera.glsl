@@ -0,0 +1,11 @@
+#pragma once
+
+// Per-view camera data, uploaded once per view by Renderer::begin_scene.
+// Layout must match Renderer::CameraBlock; the binding is Renderer::kCameraBinding.
+layout(std140, binding = 0) uniform Camera {
+  mat4 u_V;
+  mat4 u_P;
+  mat4 u_VP;
+  vec3 u_CameraPos;
+  vec3 u_Ambient;
+};
@@ -1,12 +1,9 @@
 #pragma once
 
+#include "camera"
 #include "material"
 
-struct attenuation {
-  float linear;
-  float quadratic;
-};
-
+// Layouts must match the Packed structs of kEn::DirectionalLight, PointLight and SpotLight.
 struct directional_light {
   vec3 color;
 
@@ -15,38 +12,81 @@ struct directional_light {
 
 struct point_light {
   vec3 color;
-
-  attenuation atten;
+  float linear;
 
   vec3 pos;
+  float quadratic;
+
+  float radius;
 };
 
 struct spot_light {
   vec3 color;
-
-  attenuation atten;
+  float linear;
 
   vec3 pos;
+  float quadratic;
+
   vec3 dir;
   float cutoff;
-  float outerCutoff;
-};
+  float outer_cutoff;
 
-const int MAX_LIGHTS = 15;
+  float radius;
+};
 
 uniform bool u_UseBlinn = true;
 
-uniform int u_DirectionalCount;
-uniform directional_light u_DirectionalLights[MAX_LIGHTS];
+// Uploaded once per frame by Renderer::prepare; the bindings are Renderer::k*LightBinding.
+layout(std430, binding = 2) readonly buffer DirectionalLights {
+  uint u_DirectionalCount;
+  directional_light u_DirectionalLights[];
+};
+
+layout(std430, binding = 3) readonly buffer PointLights {
+  uint u_PointCount;
+  point_light u_PointLights[];
+};
+
+layout(std430, binding = 4) readonly buffer SpotLights {
+  uint u_SpotCount;
+  spot_light u_SpotLights[];
+};
+
+// Point and spot lights binned into the clusters of the view frustum by Renderer::prepare.
+// Layouts must match kEn::LightClusters; the bindings are Renderer::kLightClusterBinding and kLightIndexBinding.
+struct light_cluster {
+  uint first;
+  uint point_count;
+  uint spot_count;
+  uint pad0;
+};
+
+layout(std430, binding = 5) readonly buffer LightClusters {
+  uvec4 u_ClusterGrid;  // tiles along x and y, depth slices along z
+  vec4 u_ClusterDepth;  // slice = log(view depth) * x + y
+  light_cluster u_Clusters[];
+};
+
+layout(std430, binding = 6) readonly buffer LightIndices {
+  uint u_LightIndices[];
+};
+
+light_cluster find_cluster(vec3 frag_pos) {
+  vec4 clip  = u_VP * vec4(frag_pos, 1.0);
+  uvec2 tile = uvec2(clamp((clip.xy / clip.w * 0.5 + 0.5) * vec2(u_ClusterGrid.xy), vec2(0.0),
+                           vec2(u_ClusterGrid.xy - 1u)));
 
-uniform int u_PointCount;
-uniform point_light u_PointLights[MAX_LIGHTS];
+  float depth = max(-(u_V * vec4(frag_pos, 1.0)).z, 1e-4);
+  uint slice  = uint(clamp(floor(log(depth) * u_ClusterDepth.x + u_ClusterDepth.y), 0.0, float(u_ClusterGrid.z - 1u)));
 
-uniform int u_SpotCount;
-uniform spot_light u_SpotLights[MAX_LIGHTS];
+  return u_Clusters[(slice * u_ClusterGrid.y + tile.y) * u_ClusterGrid.x + tile.x];
+}
 
-float calc_attenuation(attenuation atten, float dist) {
-  return 1.0 / (1.0 + dist * (atten.linear + dist * atten.quadratic));
+// Windowed so that it reaches 0 at the radius the lights are clustered with, instead of cutting off there.
+float calc_attenuation(float linear, float quadratic, float radius, float dist) {
+  float ratio  = dist / radius;
+  float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+  return window * window / (1.0 + dist * (linear + dist * quadratic));
 }
 
 vec2 calc_light(vec3 light_dir, vec3 normal, vec3 view_dir) {
@@ -74,7 +114,8 @@ vec3 calc_point_light(point_light light, material mat, vec3 normal, vec3 frag_po
   vec3 diffuse  = mat.kd * factors.x * light.color;
   vec3 specular = mat.ks * pow(factors.y, u_UseBlinn ? 4 * mat.m : mat.m) * light.color;
 
-  return (diffuse + specular) * calc_attenuation(light.atten, length(light.pos - frag_pos));
+  float dist = length(light.pos - frag_pos);
+  return (diffuse + specular) * calc_attenuation(light.linear, light.quadratic, light.radius, dist);
 }
 
 vec3 calc_dir_light(directional_light light, material mat, vec3 normal, vec3 view_dir) {
@@ -91,12 +132,12 @@ vec3 calc_spot_light(spot_light light, material mat, vec3 normal, vec3 frag_pos,
   vec3 light_dir = normalize(light.pos - frag_pos);
 
   float theta   = dot(light_dir, normalize(-light.dir));
-  float epsilon = light.cutoff - light.outerCutoff;
+  float epsilon = light.cutoff - light.outer_cutoff;
   float intensity;
   if (epsilon == 0)
     intensity = theta > light.cutoff ? 1 : 0;
   else
-    intensity = clamp((theta - light.outerCutoff) / epsilon, 0.0, 1.0);
+    intensity = clamp((theta - light.outer_cutoff) / epsilon, 0.0, 1.0);
 
   vec2 factors = u_UseBlinn ? calc_light_blinn(normalize(light.pos - frag_pos), normal, view_dir)
                             : calc_light(normalize(light.pos - frag_pos), normal, view_dir);
@@ -104,5 +145,21 @@ vec3 calc_spot_light(spot_light light, material mat, vec3 normal, vec3 frag_pos,
   vec3 diffuse  = mat.kd * factors.x * light.color;
   vec3 specular = mat.ks * pow(factors.y, u_UseBlinn ? 4 * mat.m : mat.m) * light.color;
 
-  return (diffuse + specular) * calc_attenuation(light.atten, length(light.pos - frag_pos)) * intensity;
+  float dist = length(light.pos - frag_pos);
+  return (diffuse + specular) * calc_attenuation(light.linear, light.quadratic, light.radius, dist) * intensity;
+}
+
+// Sum of the point and spot lights of the fragment's cluster.
+vec3 calc_clustered_lights(material mat, vec3 normal, vec3 frag_pos, vec3 view_dir) {
+  light_cluster cluster = find_cluster(frag_pos);
+
+  vec3 result = vec3(0.0);
+  uint spots  = cluster.first + cluster.point_count;
+  for (uint i = cluster.first; i < spots; ++i)
+    result += calc_point_light(u_PointLights[u_LightIndices[i]], mat, normal, frag_pos, view_dir);
+
+  for (uint i = spots; i < spots + cluster.spot_count; ++i)
+    result += calc_spot_light(u_SpotLights[u_LightIndices[i]], mat, normal, frag_pos, view_dir);
+
+  return result;
 }
\ No newline at end of file
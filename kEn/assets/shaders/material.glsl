@@ -1,6 +1,7 @@
 #pragma once
 
-const int MAX_TEXTURES = 5;
+// Must match Material::kMaxTexturesPerType; the sampler arrays below take consecutive units.
+const int MAX_TEXTURES = 3;
 
 struct material {
   float ka;
@@ -17,3 +18,15 @@ struct material {
   int normal_count;
   int specular_count;
 };
+
+// Baked materials, shared by all materials with equal parameters; see Renderer::kMaterialBinding.
+layout(std430, binding = 7) readonly buffer Materials {
+  material u_Materials[];
+};
+
+uniform uint u_MaterialIndex;
+
+layout(binding = 0) uniform sampler2D u_Material_diffuse[MAX_TEXTURES];
+layout(binding = 3) uniform sampler2D u_Material_height[MAX_TEXTURES];
+layout(binding = 6) uniform sampler2D u_Material_normal[MAX_TEXTURES];
+layout(binding = 9) uniform sampler2D u_Material_specular[MAX_TEXTURES];
@@ -0,0 +1,17 @@
+#pragma once
+
+// Constants of every object drawn in the current view, uploaded once per view by Renderer::end_scene.
+// Layout must match kEn::ObjectData; the binding is Renderer::kObjectBinding.
+struct object_data {
+  mat4 world;
+  mat4 normal;  // Transposed inverse of world
+  mat4 previous_world;
+};
+
+layout(std430, binding = 1) readonly buffer Objects {
+  object_data u_Objects[];
+};
+
+// The renderer passes the index of a draw's object as its base instance, so this is only
+// available in vertex shaders.
+object_data current_object() { return u_Objects[gl_BaseInstance]; }
@@ -0,0 +1,123 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kEn::bench {
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+/** @brief Shortest sample; calibration doubles the batch size until it is reached. */
+constexpr std::chrono::milliseconds kMinSampleTime{20};
+
+struct Entry {
+  std::string name;
+  void (*benchmark)(State&);
+};
+
+std::vector<Entry>& registry() {
+  static std::vector<Entry> entries;
+  return entries;
+}
+
+double time_batch(const std::function<void(std::size_t)>& batch, std::size_t count) {
+  const auto start = clock::now();
+  batch(count);
+  return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+}
+
+}  // namespace
+
+void State::run(const std::function<void(std::size_t)>& batch) {
+  std::size_t count = 1;
+  while (time_batch(batch, count) < std::chrono::duration<double, std::nano>(kMinSampleTime).count()) {
+    count *= 2;
+  }
+
+  std::array<double, kSamples> samples{};
+  for (auto& sample : samples) {
+    sample = time_batch(batch, count) / static_cast<double>(count);
+  }
+  std::ranges::sort(samples);
+
+  result_.iterations = count;
+  result_.median_ns  = samples[kSamples / 2];
+  result_.min_ns     = samples.front();
+}
+
+Registration::Registration(std::string_view name, void (*benchmark)(State&)) {
+  registry().push_back({.name = std::string(name), .benchmark = benchmark});
+}
+
+}  // namespace kEn::bench
+
+/**
+ * Usage: kEn_benchmarks [FILTER] [--json FILE]
+ *
+ * Runs every benchmark whose name contains FILTER and prints one line per
+ * benchmark; with --json the results are also written to FILE.
+ */
+int main(int argc, char** argv) {
+  using namespace kEn::bench;  // NOLINT(google-build-using-namespace)
+
+  const std::span<char*> args(argv, static_cast<std::size_t>(argc));
+  std::string_view filter;
+  std::string json_path;
+  for (std::size_t i = 1; i < args.size(); ++i) {
+    if (std::string_view(args[i]) == "--json" && i + 1 < args.size()) {
+      json_path = args[++i];
+    } else {
+      filter = args[i];
+    }
+  }
+
+  auto& entries = registry();
+  std::ranges::sort(entries, {}, &Entry::name);
+
+  std::fputs(std::format("{:<40} {:>12} {:>14} {:>14} {:>12}\n", "benchmark", "iterations", "median ns/op", "min ns/op",
+                         "ns/item")
+                 .c_str(),
+             stdout);
+  std::string json = "[";
+  for (const auto& entry : entries) {
+    if (!entry.name.contains(filter)) {
+      continue;
+    }
+
+    State state;
+    entry.benchmark(state);
+    const Result& r        = state.result();
+    const double item_time = r.median_ns / static_cast<double>(std::max<std::size_t>(r.items, 1));
+    std::fputs(std::format("{:<40} {:>12} {:>14.1f} {:>14.1f} {:>12.2f}\n", entry.name, r.iterations, r.median_ns,
+                           r.min_ns, item_time)
+                   .c_str(),
+               stdout);
+
+    json += std::format("{}\n  {{\"name\": \"{}\", \"items\": {}, \"median_ns\": {:.2f}, \"min_ns\": {:.2f}}}",
+                        json.size() > 1 ? "," : "", entry.name, r.items, r.median_ns, r.min_ns);
+    std::fflush(stdout);
+  }
+  json += "\n]\n";
+
+  if (!json_path.empty()) {
+    std::ofstream out(json_path, std::ios::trunc);
+    out << json;
+    if (!out) {
+      std::fputs(std::format("Failed to write {}\n", json_path).c_str(), stderr);
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/** @file
+ *  @ingroup ken
+ *
+ *  Minimal micro-benchmark harness behind the @c kEn_benchmarks executable.
+ *
+ *  A benchmark is a function taking a @ref kEn::bench::State, registered with
+ *  @ref KEN_BENCHMARK.  It prepares its inputs and then times one operation
+ *  with @ref kEn::bench::State::measure:
+ *  @code
+ *  void sort_keys(kEn::bench::State& state) {
+ *    auto keys = make_keys(10'000);
+ *    state.set_items(keys.size());
+ *    state.measure([&] { kEn::bench::keep(sort(keys)); });
+ *  }
+ *  KEN_BENCHMARK(sort_keys);
+ *  @endcode
+ *
+ *  Every benchmark uses fixed seeds, so runs on one machine compare directly.
+ */
+
+namespace kEn::bench {
+
+/** @brief Timing of one benchmark, filled in by @ref State::measure. */
+struct Result {
+  std::size_t iterations = 0;    ///< Operations per sample.
+  std::size_t items      = 1;    ///< Items processed by one operation, see @ref State::set_items.
+  double median_ns       = 0.0;  ///< Median time of one operation over all samples.
+  double min_ns          = 0.0;  ///< Fastest sample, per operation.
+};
+
+/** @brief Handed to every benchmark; times the operation it is given. */
+class State {
+ public:
+  /** @brief Number of timed samples; the median of them is reported. */
+  static constexpr std::size_t kSamples = 11;
+
+  /** @brief Sets how many items (lights, keys, rays...) one operation processes, for the per-item time. */
+  void set_items(std::size_t items) noexcept { result_.items = items; }
+
+  /**
+   * @brief Times @p op.
+   *
+   * The number of calls per sample is calibrated so that a sample takes at
+   * least a few milliseconds; then @ref kSamples samples are taken.  Setup
+   * done before the call is not timed.
+   */
+  template <typename F>
+  void measure(F&& op) {
+    run([&op](std::size_t count) {
+      for (std::size_t i = 0; i < count; ++i) {
+        op();
+      }
+    });
+  }
+
+  /** @brief Returns the timing of the last @ref measure call. */
+  [[nodiscard]] const Result& result() const noexcept { return result_; }
+
+ private:
+  void run(const std::function<void(std::size_t)>& batch);
+
+  Result result_;
+};
+
+/** @brief Registers a benchmark at static initialization; use @ref KEN_BENCHMARK. */
+struct Registration {
+  Registration(std::string_view name, void (*benchmark)(State&));
+};
+
+namespace detail {
+
+inline const void* volatile sink = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace detail
+
+/** @brief Makes @p value observable, so the computation producing it is not optimized away. */
+template <typename T>
+void keep(const T& value) noexcept {
+  detail::sink = &value;
+}
+
+}  // namespace kEn::bench
+
+/**
+ * @def KEN_BENCHMARK(fn)
+ * @brief Registers @p fn, a @c void(kEn::bench::State&) function, under its own name.
+ */
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define KEN_BENCHMARK(fn) static const ::kEn::bench::Registration ken_benchmark_##fn(#fn, fn)
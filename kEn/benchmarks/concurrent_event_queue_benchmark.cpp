@@ -0,0 +1,61 @@
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <kEn/event/concurrent_event_queue.hpp>
+#include <kEn/event/event.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+
+using kEn::bench::State;
+
+struct CounterEvent : kEn::Event<CounterEvent> {
+  explicit CounterEvent(std::size_t value) : value(value) {}
+
+  std::size_t value;
+};
+
+/** @brief One thread posts a batch and drains it; the uncontended cost of an event. */
+void mpsc_post_drain(State& state) {
+  constexpr std::size_t kBatch = 1024;
+  kEn::ConcurrentEventQueue queue;
+  std::size_t sum = 0;
+
+  state.set_items(kBatch);
+  state.measure([&] {
+    for (std::size_t i = 0; i < kBatch; ++i) {
+      queue.post<CounterEvent>(i);
+    }
+    queue.drain([&sum](kEn::BaseEvent& e) { sum += static_cast<CounterEvent&>(e).value; });
+  });
+  kEn::bench::keep(sum);
+}
+KEN_BENCHMARK(mpsc_post_drain);
+
+/** @brief Four threads post while the calling thread drains, as workers posting to the main thread do. */
+void mpsc_four_producers(State& state) {
+  constexpr std::size_t kProducers = 4;
+  constexpr std::size_t kEvents    = 16'384;
+  kEn::ConcurrentEventQueue queue;
+
+  state.set_items(kProducers * kEvents);
+  state.measure([&] {
+    std::size_t delivered = 0;
+    std::vector<std::jthread> producers;
+    for (std::size_t p = 0; p < kProducers; ++p) {
+      producers.emplace_back([&queue] {
+        for (std::size_t i = 0; i < kEvents; ++i) {
+          queue.post<CounterEvent>(i);
+        }
+      });
+    }
+    while (delivered < kProducers * kEvents) {
+      delivered += queue.drain([](kEn::BaseEvent&) {});
+    }
+  });
+}
+KEN_BENCHMARK(mpsc_four_producers);
+
+}  // namespace
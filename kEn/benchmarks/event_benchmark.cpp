@@ -0,0 +1,42 @@
+#include <array>
+#include <cstddef>
+
+#include <kEn/core/input/key_codes.hpp>
+#include <kEn/core/input/mod_keys.hpp>
+#include <kEn/event/application_events.hpp>
+#include <kEn/event/event.hpp>
+#include <kEn/event/key_events.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+
+using kEn::bench::State;
+
+/** @brief Four event types, three of them with typed subscribers and all of them seen by a catch-all. */
+void event_dispatch_mixed(State& state) {
+  kEn::EventDispatcher dispatcher;
+  std::size_t sink = 0;
+  dispatcher.subscribe([&sink](kEn::KeyPressedEvent& e) { return (sink += kEn::key::code(e.key())) == 0; });
+  dispatcher.subscribe([&sink](kEn::KeyReleasedEvent& e) { return (sink += kEn::key::code(e.key())) == 0; });
+  dispatcher.subscribe([&sink](kEn::WindowResizeEvent& e) { return (sink += e.width()) == 0; });
+  dispatcher.subscribe<kEn::BaseEvent>([&sink](kEn::BaseEvent&) { return ++sink == 0; });
+
+  kEn::KeyPressedEvent press(kEn::key::a, kEn::ModKeys{}, false);
+  kEn::KeyReleasedEvent release(kEn::key::b, kEn::ModKeys{});
+  kEn::WindowResizeEvent resize(3, 4);
+  kEn::WindowCloseEvent close;
+  const std::array<kEn::BaseEvent*, 4> events{&press, &release, &resize, &close};
+
+  state.set_items(events.size());
+  state.measure([&] {
+    for (auto* event : events) {
+      event->handled = false;
+      kEn::bench::keep(dispatcher.dispatch(*event));
+    }
+  });
+  kEn::bench::keep(sink);
+}
+KEN_BENCHMARK(event_dispatch_mixed);
+
+}  // namespace
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <kEn/core/job_system.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+
+using kEn::bench::State;
+
+/** @brief Runs the default worker pool for the duration of one benchmark, as the Application does. */
+struct WorkerPool {
+  WorkerPool() { kEn::JobSystem::init(); }
+  ~WorkerPool() { kEn::JobSystem::shutdown(); }
+
+  WorkerPool(const WorkerPool&)            = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+};
+
+/** @brief Submission and scheduling overhead: jobs that do nothing, all submitted by the calling thread. */
+void job_system_empty_jobs(State& state) {
+  constexpr std::size_t kJobs = 10'000;
+  const WorkerPool pool;
+
+  state.set_items(kJobs);
+  state.measure([] {
+    kEn::JobCounter counter;
+    for (std::size_t i = 0; i < kJobs; ++i) {
+      kEn::JobSystem::run(counter, [] {});
+    }
+    kEn::JobSystem::wait(counter);
+  });
+}
+KEN_BENCHMARK(job_system_empty_jobs);
+
+/** @brief Stealing: every parent spawns its children on its worker's deque, which idle workers steal from. */
+void job_system_nested_jobs(State& state) {
+  constexpr std::size_t kParents  = 64;
+  constexpr std::size_t kChildren = 256;
+  const WorkerPool pool;
+  std::atomic<std::size_t> sum = 0;
+
+  state.set_items(kParents * (kChildren + 1));
+  state.measure([&sum] {
+    kEn::JobCounter parents;
+    for (std::size_t p = 0; p < kParents; ++p) {
+      kEn::JobSystem::run(parents, [&sum] {
+        kEn::JobCounter children;
+        for (std::size_t c = 0; c < kChildren; ++c) {
+          kEn::JobSystem::run(children, [&sum, c] { sum.fetch_add(c, std::memory_order_relaxed); });
+        }
+        kEn::JobSystem::wait(children);
+      });
+    }
+    kEn::JobSystem::wait(parents);
+  });
+  kEn::bench::keep(sum.load());
+}
+KEN_BENCHMARK(job_system_nested_jobs);
+
+constexpr std::size_t kSumElements = std::size_t{1} << 20;
+constexpr std::size_t kSumGrain    = 4096;
+
+/** @brief Compute-heavy, memory-light body shared by the serial and parallel sums. */
+double sum_roots(const std::vector<float>& values, std::size_t begin, std::size_t end) {
+  double sum = 0.0;
+  for (std::size_t i = begin; i < end; ++i) {
+    sum += std::sqrt(static_cast<double>(values[i]));
+  }
+  return sum;
+}
+
+std::vector<float> sum_input() {
+  std::vector<float> values(kSumElements);
+  std::ranges::generate(values, [i = 0U]() mutable { return static_cast<float>(i++ % 1024); });
+  return values;
+}
+
+/** @brief parallel_for over the sum; compare with @c job_system_serial_sum for the speedup. */
+void job_system_parallel_sum(State& state) {
+  const auto values = sum_input();
+  const WorkerPool pool;
+  double total = 0.0;
+  std::mutex mutex;
+
+  state.set_items(kSumElements);
+  state.measure([&] {
+    kEn::JobSystem::parallel_for(
+        values.size(),
+        [&](std::size_t begin, std::size_t end) {
+          const double partial = sum_roots(values, begin, end);
+          const std::scoped_lock lock(mutex);
+          total += partial;
+        },
+        kSumGrain);
+  });
+  kEn::bench::keep(total);
+}
+KEN_BENCHMARK(job_system_parallel_sum);
+
+/** @brief The same sum in a plain loop on the calling thread. */
+void job_system_serial_sum(State& state) {
+  const auto values = sum_input();
+  double total      = 0.0;
+
+  state.set_items(kSumElements);
+  state.measure([&] { total += sum_roots(values, 0, values.size()); });
+  kEn::bench::keep(total);
+}
+KEN_BENCHMARK(job_system_serial_sum);
+
+}  // namespace
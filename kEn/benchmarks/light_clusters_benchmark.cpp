@@ -0,0 +1,68 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <mEn/constants.hpp>
+#include <mEn/functions/geometric.hpp>
+#include <mEn/functions/matrix_projection.hpp>
+#include <mEn/functions/matrix_transform.hpp>
+#include <mEn/mat4.hpp>
+#include <mEn/vec3.hpp>
+
+#include <kEn/renderer/light_clusters.hpp>
+#include <kEn/scene/components/light.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+
+using kEn::bench::State;
+
+/**
+ * @brief Builds the clusters of a 1920x1080-like view over @p count lights, a quarter of them spot lights,
+ *        scattered over a 200 x 20 x 200 level in front of the camera.
+ *
+ * Runs without a job pool, so all slices are assigned on the calling thread; items are lights.
+ */
+void build_clusters(State& state, std::size_t count) {
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> across(-100.F, 100.F);
+  std::uniform_real_distribution<float> height(0.F, 20.F);
+  std::uniform_real_distribution<float> ahead(-200.F, 0.F);
+  std::uniform_real_distribution<float> radius(2.F, 8.F);
+  std::uniform_real_distribution<float> unit(-1.F, 1.F);
+
+  std::vector<kEn::PointLight::Data> points;
+  std::vector<kEn::SpotLight::Data> spots;
+  for (std::size_t i = 0; i < count; ++i) {
+    const mEn::Vec3 pos(across(rng), height(rng), ahead(rng));
+    const auto atten = kEn::Attenuation::from_radius(radius(rng));
+    if (i % 4 == 3) {
+      spots.push_back({.color        = mEn::Vec3(1.F),
+                       .pos          = pos,
+                       .dir          = mEn::normalize(mEn::Vec3(unit(rng), -1.F, unit(rng))),
+                       .atten        = atten,
+                       .cutoff       = 0.9F,
+                       .outer_cutoff = 0.8F});
+    } else {
+      points.push_back({.color = mEn::Vec3(1.F), .pos = pos, .atten = atten});
+    }
+  }
+
+  const auto view       = mEn::lookAt(mEn::Vec3(0.F, 2.F, 0.F), mEn::Vec3(0.F, 2.F, -1.F), mEn::Vec3(0.F, 1.F, 0.F));
+  const auto projection = mEn::perspective(mEn::kPi<float> / 3.F, 16.F / 9.F, 0.1F, 250.F);
+  kEn::LightClusters clusters;
+
+  state.set_items(count);
+  state.measure([&] { clusters.build(view, projection, points, spots); });
+  kEn::bench::keep(clusters.stats());
+}
+
+void light_clusters_256(State& state) { build_clusters(state, 256); }
+void light_clusters_1024(State& state) { build_clusters(state, 1024); }
+void light_clusters_4096(State& state) { build_clusters(state, 4096); }
+KEN_BENCHMARK(light_clusters_256);
+KEN_BENCHMARK(light_clusters_1024);
+KEN_BENCHMARK(light_clusters_4096);
+
+}  // namespace
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <kEn/renderer/render_queue.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+
+using kEn::bench::State;
+
+constexpr std::size_t kDraws = 10'000;
+
+/**
+ * @brief Opaque keys laid out like @ref kEn::RenderQueue::make_key: 32 shaders, 256 materials,
+ *        64 vertex inputs and random depths, drawn from a fixed seed.
+ */
+std::vector<std::uint64_t> make_scene_keys() {
+  std::mt19937_64 rng(7);
+  std::array<std::uint64_t, 256> states{};
+  for (auto& state : states) {
+    const std::uint64_t shader   = rng() % 32;
+    const std::uint64_t material = rng() & 0xFFFFU;
+    const std::uint64_t input    = (rng() % 64) * 977;
+    state                        = ((shader * 0x1F3U) << 32U) | (material << 16U) | (input & 0xFFFFU);
+  }
+
+  std::vector<std::uint64_t> keys(kDraws);
+  for (auto& key : keys) {
+    key = (states[rng() % states.size()] << 16U) | (rng() & 0xFFFFU);
+  }
+  return keys;
+}
+
+/** @brief Fills a queue and radix-sorts it, as every view does each frame. */
+void render_queue_sort(State& state) {
+  const auto keys = make_scene_keys();
+  kEn::RenderQueue queue;
+
+  state.set_items(keys.size());
+  state.measure([&] {
+    queue.clear();
+    for (const auto key : keys) {
+      queue.push(key, {});
+    }
+    queue.sort();
+    kEn::bench::keep(queue.order().front());
+  });
+}
+KEN_BENCHMARK(render_queue_sort);
+
+/** @brief The same keys through @c std::stable_sort, the comparison sort the radix sort replaces. */
+void render_queue_stable_sort_baseline(State& state) {
+  struct Entry {
+    std::uint64_t key;
+    std::uint32_t packet;
+  };
+  const auto keys = make_scene_keys();
+  std::vector<Entry> entries;
+  std::vector<kEn::DrawPacket> packets;
+
+  state.set_items(keys.size());
+  state.measure([&] {
+    entries.clear();
+    packets.clear();
+    for (const auto key : keys) {
+      entries.push_back({.key = key, .packet = static_cast<std::uint32_t>(packets.size())});
+      packets.emplace_back();
+    }
+    std::ranges::stable_sort(entries, {}, &Entry::key);
+    kEn::bench::keep(entries.front().packet);
+  });
+}
+KEN_BENCHMARK(render_queue_stable_sort_baseline);
+
+}  // namespace
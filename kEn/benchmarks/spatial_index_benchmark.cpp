@@ -0,0 +1,102 @@
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <mEn/vec3.hpp>
+
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/game_object.hpp>
+#include <kEn/scene/spatial_index.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+
+using kEn::bench::State;
+
+constexpr std::size_t kObjects = 4096;
+constexpr std::size_t kQueries = 64;
+
+/** @brief Unit boxes scattered over a 200^3 volume, with a fixed seed. */
+struct Scene {
+  Scene() : index({.background_rebuild = false}), rng(99) {
+    const auto unit = kEn::Aabb::from_center_extents(mEn::Vec3(0.F), mEn::Vec3(0.5F));
+    for (std::size_t i = 0; i < kObjects; ++i) {
+      objects.push_back(std::make_unique<kEn::GameObject>(random_point()));
+      index.insert(*objects.back(), unit);
+    }
+    index.update();
+    for (std::size_t i = 0; i < kQueries; ++i) {
+      queries.push_back(kEn::Aabb::from_center_extents(random_point(), mEn::Vec3(10.F)));
+    }
+  }
+
+  mEn::Vec3 random_point() {
+    std::uniform_real_distribution<float> coordinate(-100.F, 100.F);
+    return {coordinate(rng), coordinate(rng), coordinate(rng)};
+  }
+
+  kEn::SpatialIndex index;
+  std::mt19937 rng;
+  std::vector<std::unique_ptr<kEn::GameObject>> objects;
+  std::vector<kEn::Aabb> queries;
+};
+
+/** @brief Box queries through the tree. */
+void spatial_index_box_query(State& state) {
+  Scene scene;
+  std::size_t found = 0;
+
+  state.set_items(kQueries);
+  state.measure([&] {
+    for (const auto& box : scene.queries) {
+      scene.index.query(box, [&found](kEn::GameObject&) { ++found; });
+    }
+  });
+  kEn::bench::keep(found);
+}
+KEN_BENCHMARK(spatial_index_box_query);
+
+/** @brief The same queries answered by testing every object, the baseline the tree replaces. */
+void spatial_index_box_query_brute_force(State& state) {
+  Scene scene;
+  std::vector<kEn::Aabb> bounds;
+  for (const auto& object : scene.objects) {
+    bounds.push_back(scene.index.world_bounds(*object));
+  }
+  std::size_t found = 0;
+
+  state.set_items(kQueries);
+  state.measure([&] {
+    for (const auto& box : scene.queries) {
+      for (const auto& object_bounds : bounds) {
+        found += object_bounds.overlaps(box) ? 1 : 0;
+      }
+    }
+  });
+  kEn::bench::keep(found);
+}
+KEN_BENCHMARK(spatial_index_box_query_brute_force);
+
+/** @brief One tick in which a tenth of the objects move a little; items are the moved objects. */
+void spatial_index_update_moving(State& state) {
+  Scene scene;
+  std::uniform_real_distribution<float> step(-0.5F, 0.5F);
+  constexpr std::size_t kMoved = kObjects / 10;
+  std::size_t first            = 0;
+
+  state.set_items(kMoved);
+  state.measure([&] {
+    for (std::size_t i = 0; i < kMoved; ++i) {
+      auto& transform = scene.objects[(first + i) % kObjects]->transform();
+      transform.translate_local(mEn::Vec3(step(scene.rng), step(scene.rng), step(scene.rng)));
+    }
+    first = (first + kMoved) % kObjects;
+    scene.index.update();
+  });
+  kEn::bench::keep(scene.index.stats());
+}
+KEN_BENCHMARK(spatial_index_update_moving);
+
+}  // namespace
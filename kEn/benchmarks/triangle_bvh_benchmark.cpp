@@ -0,0 +1,79 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <mEn/vec3.hpp>
+
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/triangle_bvh.hpp>
+
+#include "benchmark.hpp"
+
+namespace {
+
+using kEn::bench::State;
+
+constexpr std::size_t kTriangles = 50'000;
+constexpr std::size_t kRays      = 256;
+
+/** @brief A 50k-triangle sphere-like shell of small random triangles and rays through it, with a fixed seed. */
+struct Mesh {
+  Mesh() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> unit(-1.F, 1.F);
+    const auto on_shell = [&] {
+      mEn::Vec3 p(unit(rng), unit(rng), unit(rng));
+      const float length = std::sqrt((p.x * p.x) + (p.y * p.y) + (p.z * p.z)) + 1e-6F;
+      return p * (10.F / length);
+    };
+
+    for (std::size_t i = 0; i < kTriangles; ++i) {
+      const mEn::Vec3 center = on_shell();
+      for (int corner = 0; corner < 3; ++corner) {
+        indices.push_back(static_cast<uint32_t>(positions.size()));
+        positions.push_back(center + mEn::Vec3(unit(rng), unit(rng), unit(rng)) * 0.3F);
+      }
+    }
+    for (std::size_t i = 0; i < kRays; ++i) {
+      const mEn::Vec3 origin = on_shell() * 2.F;
+      rays.emplace_back(origin, (on_shell() * 0.5F) - origin);
+    }
+  }
+
+  std::vector<mEn::Vec3> positions;
+  std::vector<uint32_t> indices;
+  std::vector<kEn::Ray> rays;
+};
+
+/** @brief Closest-hit rays against the tree, which is built before timing starts. */
+void triangle_bvh_raycast(State& state) {
+  const Mesh mesh;
+  const kEn::TriangleBvh bvh(mesh.positions, mesh.indices);
+  bvh.build();
+  std::size_t hits = 0;
+
+  state.set_items(kRays);
+  state.measure([&] {
+    for (const auto& ray : mesh.rays) {
+      hits += bvh.raycast(ray, ray.max_distance).has_value() ? 1 : 0;
+    }
+  });
+  kEn::bench::keep(hits);
+}
+KEN_BENCHMARK(triangle_bvh_raycast);
+
+/** @brief Builds the tree over the whole mesh; items are triangles. */
+void triangle_bvh_build(State& state) {
+  const Mesh mesh;
+
+  state.set_items(kTriangles);
+  state.measure([&] {
+    const kEn::TriangleBvh bvh(mesh.positions, mesh.indices);
+    bvh.build();
+  });
+}
+KEN_BENCHMARK(triangle_bvh_build);
+
+}  // namespace
@@ -6,14 +6,19 @@
 #include <kEn/core/input/input.hpp>
 #include <kEn/core/input/key_codes.hpp>
 #include <kEn/core/input/mouse_codes.hpp>
+#include <kEn/core/job_system.hpp>
 #include <kEn/core/layer.hpp>
 #include <kEn/core/log.hpp>
+#include <kEn/core/memory_tracker.hpp>
+#include <kEn/core/profiler.hpp>
+#include <kEn/core/task.hpp>
 #include <kEn/imgui/imgui_layer.hpp>
 
 // Renderer
 #include <kEn/renderer/buffer.hpp>
 #include <kEn/renderer/device.hpp>
 #include <kEn/renderer/framebuffer.hpp>
+#include <kEn/renderer/image.hpp>
 #include <kEn/renderer/renderer.hpp>
 #include <kEn/renderer/shader.hpp>
 #include <kEn/renderer/vertex_input.hpp>
@@ -24,6 +29,9 @@
 #include <kEn/scene/components/light.hpp>
 #include <kEn/scene/components/model_component.hpp>
 #include <kEn/scene/game_object.hpp>
+#include <kEn/scene/render_snapshot.hpp>
+#include <kEn/scene/spatial_index.hpp>
+#include <kEn/scene/update_scheduler.hpp>
 
 // Entry Point
 #include <kEn/core/entry_point.hpp>
\ No newline at end of file
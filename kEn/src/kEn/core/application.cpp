@@ -1,108 +1,393 @@
 #include "application.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <format>
+#include <fstream>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <ranges>
+#include <span>
+#include <stop_token>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <kEn/core/assert.hpp>
+#include <kEn/core/job_system.hpp>
 #include <kEn/core/layer.hpp>
+#include <kEn/core/log.hpp>
+#include <kEn/core/profiler.hpp>
 #include <kEn/core/timestep.hpp>
 #include <kEn/core/window.hpp>
 #include <kEn/event/application_events.hpp>
 #include <kEn/event/event.hpp>
+#include <kEn/event/event_recording.hpp>
 #include <kEn/imgui/debug_layer.hpp>
 #include <kEn/imgui/imgui_frame.hpp>
 #include <kEn/imgui/imgui_layer.hpp>
 #include <kEn/renderer/device.hpp>
+#include <kEn/renderer/render_context.hpp>
+#include <kEn/renderer/renderer.hpp>
+#include <kEn/scene/render_snapshot.hpp>
 
 namespace kEn {
 Application* Application::instance_ = nullptr;
 
+namespace {
+
+/** @brief Summary of a series of frame times or tick intervals, in milliseconds. */
+struct FrameTimeStats {
+  std::size_t count = 0;
+  double mean       = 0.0;
+  double p50        = 0.0;
+  double p95        = 0.0;
+  double p99        = 0.0;
+  double max        = 0.0;
+
+  static FrameTimeStats of(std::span<const duration_t> times) {
+    std::vector<double> ms(times.size());
+    std::ranges::transform(times, ms.begin(), [](duration_t time) {
+      return std::chrono::duration<double, std::milli>(time).count();
+    });
+    std::ranges::sort(ms);
+
+    const auto percentile = [&ms](double p) {
+      return ms[static_cast<size_t>(p * static_cast<double>(ms.size() - 1) + 0.5)];
+    };
+    return {.count = ms.size(),
+            .mean  = std::accumulate(ms.begin(), ms.end(), 0.0) / static_cast<double>(ms.size()),
+            .p50   = percentile(0.5),
+            .p95   = percentile(0.95),
+            .p99   = percentile(0.99),
+            .max   = ms.back()};
+  }
+};
+
+}  // namespace
+
 Application::Application(ApplicationSpec spec) : spec_(std::move(spec)) {
   KEN_CORE_ASSERT(!instance_, "App already exists!");
-  instance_ = this;
+  instance_    = this;
+  main_thread_ = std::this_thread::get_id();
+  KEN_PROFILE_THREAD("Main");
+  JobSystem::init(spec_.worker_threads > 0 ? spec_.worker_threads : JobSystem::default_worker_count());
+
+  if (spec_.headless && spec_.api != Device::Api::Null) {
+    KEN_CORE_WARN("Headless mode has no graphics context; using the null device");
+    spec_.api = Device::Api::Null;
+  }
 
   WindowProperties win_props{spec_.title, spec_.window_width, spec_.window_height};
   win_props.opengl_debug_context = (spec_.api == Device::Api::OpenGL && spec_.enable_debug);
+  win_props.headless             = spec_.headless;
 
   window_ = std::make_unique<Window>(win_props);
   window_->set_event_handler([this](auto& event) { window_event_handler(event); });
+  window_->set_event_queueing(spec_.queue_events);
 
   dispatcher_.subscribe(this, &Application::on_window_close);
   dispatcher_.subscribe(this, &Application::on_window_resize);
 
+  if (!spec_.replay_events.empty()) {
+    replay_ = EventReplay::load(spec_.replay_events);
+  }
+  if (replay_ != nullptr) {
+    KEN_CORE_INFO("Replaying {} ticks from {}", replay_->tick_count(), spec_.replay_events.string());
+    if (replay_->tick_time() != kTickTime) {
+      KEN_CORE_WARN("Recording was made with a different tick time; replay will not match it");
+    }
+    window_->set_input_enabled(false);
+  } else if (!spec_.record_events.empty()) {
+    recorder_ = std::make_unique<EventRecorder>(spec_.record_events, kTickTime);
+  }
+
   device_ = Device::create(spec_.api, window_->native_window(), spec_.enable_debug);
-  window_->set_vsync(true);
+  Renderer::init(*device_);
+  window_->set_vsync(replay_ == nullptr);
 
-  push_overlay(std::make_unique<ImguiLayer>());
-  if (spec_.enable_debug) {
-    push_overlay(std::make_unique<DebugLayer>());
+  if (!spec_.headless) {
+    push_overlay(std::make_unique<ImguiLayer>());
+    if (spec_.enable_debug) {
+      push_overlay(std::make_unique<DebugLayer>());
+    }
   }
 }
 
+Application::~Application() {
+  JobSystem::shutdown();
+  Renderer::shutdown();
+  instance_ = nullptr;
+}
+
 void Application::push_layer(std::unique_ptr<Layer> layer) { layer_stack_.push_layer(std::move(layer)); }
 
 void Application::push_overlay(std::unique_ptr<Layer> overlay) { layer_stack_.push_overlay(std::move(overlay)); }
 
+void Application::run_on_main_thread(std::function<void()> task) {
+  if (on_main_thread()) {
+    task();
+    return;
+  }
+  const std::scoped_lock lock(main_thread_mutex_);
+  main_thread_tasks_.push_back(std::move(task));
+}
+
+void Application::run_main_thread_tasks() {
+  {
+    const std::scoped_lock lock(main_thread_mutex_);
+    std::swap(main_thread_tasks_, running_tasks_);
+  }
+  for (const auto& task : running_tasks_) {
+    task();
+  }
+  running_tasks_.clear();
+}
+
 void Application::run() {
+  if (spec_.pipelined) {
+    run_pipelined();
+  } else {
+    run_sequential();
+  }
+
+  if (recorder_ != nullptr) {
+    recorder_->finish(tick_count_);
+  }
+  if (replay_ != nullptr) {
+    report_replay();
+  }
+  if (!spec_.profile_trace.empty()) {
+    Profiler::write_chrome_trace(spec_.profile_trace);
+  }
+}
+
+void Application::run_sequential() {
   using clock = std::chrono::high_resolution_clock;
   duration_t lag{};
-  duration_t second{};
   auto previous_time = clock::now();
 
-  size_t frames = 0;
-  size_t ticks  = 0;
-
   while (running_) {
-    window_->poll_events();
+    KEN_PROFILE_FRAME();
+    {
+      KEN_PROFILE_SCOPE("Application::poll_events");
+      window_->poll_events();
+      posted_events_.drain([this](BaseEvent& event) { window_event_handler(event); });
+      run_main_thread_tasks();
+    }
 
-    auto current_time = clock::now();
-    auto delta        = current_time - previous_time;
-    previous_time     = current_time;
+    const auto current_time = clock::now();
+    const auto delta        = std::chrono::duration_cast<duration_t>(current_time - previous_time);
+    previous_time           = current_time;
+    lag += delta;
 
-    lag += std::chrono::duration_cast<duration_t>(delta);
-    second += std::chrono::duration_cast<duration_t>(delta);
+    if (replay_ != nullptr) {
+      // One tick per frame, independent of wall-clock time, so every replay simulates the same ticks.
+      if (tick_count_ > 0) {
+        replay_frame_times_.push_back(delta);
+      }
+      if (replay_->finished(tick_count_)) {
+        break;
+      }
+      replay_->deliver(tick_count_, [this](BaseEvent& event) { window_->inject_event(event); });
+      lag = kTickTime;
+    }
 
-    while (lag >= kTickTime) {
-      update();
+    if (lag >= kTickTime) {
+      while (lag >= kTickTime) {
+        update();
+        lag -= kTickTime;
+      }
+      take_snapshot();
+    }
+
+    count_frame(delta);
+    render(std::chrono::duration<double>(lag).count() / std::chrono::duration<double>(kTickTime).count());
+  }
+}
 
-      lag -= kTickTime;
-      time_ += kTickTime;
-      ++ticks;
+void Application::run_pipelined() {
+  using clock        = std::chrono::high_resolution_clock;
+  auto previous_time = clock::now();
+
+  std::jthread simulation([this](const std::stop_token& stop) { simulate(stop); });
+
+  while (running_) {
+    KEN_PROFILE_FRAME();
+    if (replay_ != nullptr) {
+      // Every frame waits for a tick of its own, so that replays time one tick per frame in both modes.
+      KEN_PROFILE_SCOPE("Application::wait_for_tick");
+      for (auto ticks = tick_count_.load(); ticks <= frame_count_ && running_; ticks = tick_count_.load()) {
+        tick_count_.wait(ticks);
+      }
+    }
+    {
+      KEN_PROFILE_SCOPE("Application::poll_events");
+      const std::scoped_lock lock(simulation_mutex_);
+      window_->poll_events();
+      posted_events_.drain([this](BaseEvent& event) { window_event_handler(event); });
+      run_main_thread_tasks();
     }
 
-    ++frames;
-    if (second > std::chrono::seconds(1)) {
-      const uint16_t seconds = static_cast<uint16_t>(std::chrono::duration_cast<std::chrono::seconds>(second).count());
+    const auto current_time = clock::now();
+    const auto delta        = std::chrono::duration_cast<duration_t>(current_time - previous_time);
+    previous_time           = current_time;
 
-      fps_   = static_cast<uint16_t>(frames / seconds);
-      tps_   = static_cast<uint16_t>(ticks / seconds);
-      frames = 0;
-      ticks  = 0;
-      second = duration_t{};
+    if (replay_ != nullptr && frame_count_ > 0) {
+      replay_frame_times_.push_back(delta);
     }
 
-    render(std::chrono::duration<double>(lag).count() / std::chrono::duration<double>(kTickTime).count());
+    count_frame(delta);
+    // The latest tick is drawn as it is; interpolating would need the one before it as well.
+    render(0.0);
+
+    ++frame_count_;
+    frame_count_.notify_one();
+  }
+
+  simulation.request_stop();
+  ++frame_count_;
+  frame_count_.notify_one();
+}
+
+void Application::simulate(const std::stop_token& stop) {
+  KEN_PROFILE_THREAD("Simulation");
+  using clock    = std::chrono::steady_clock;
+  auto next_tick = clock::now();
+
+  while (!stop.stop_requested()) {
+    if (replay_ != nullptr) {
+      // Run at most one tick ahead of the frame being drawn, so that every replayed tick gets its own frame.
+      for (auto frames = frame_count_.load(); frames + 1 < tick_count_ && !stop.stop_requested();
+           frames      = frame_count_.load()) {
+        frame_count_.wait(frames);
+      }
+    } else {
+      std::this_thread::sleep_until(next_tick);
+      next_tick += kTickTime;
+    }
+    if (stop.stop_requested()) {
+      break;
+    }
+
+    const std::scoped_lock lock(simulation_mutex_);
+    if (replay_ != nullptr) {
+      if (replay_->finished(tick_count_)) {
+        running_ = false;
+        tick_count_.notify_one();
+        break;
+      }
+      replay_->deliver(tick_count_, [this](BaseEvent& event) { window_->inject_event(event); });
+    }
+    update();
+    take_snapshot();
+    tick_count_.notify_one();
+  }
+}
+
+void Application::count_frame(duration_t delta) {
+  ++second_frames_;
+  second_ += delta;
+  if (second_ <= std::chrono::seconds(1)) {
+    return;
+  }
+
+  const std::uint64_t ticks = tick_count_;
+  const auto whole_seconds  = std::chrono::duration_cast<std::chrono::seconds>(second_);
+  const auto seconds        = static_cast<std::uint64_t>(whole_seconds.count());
+
+  fps_               = static_cast<uint16_t>(second_frames_ / seconds);
+  tps_               = static_cast<uint16_t>((ticks - second_first_tick_) / seconds);
+  second_frames_     = 0;
+  second_first_tick_ = ticks;
+  second_            = duration_t{};
+}
+
+void Application::report_replay() const {
+  if (replay_frame_times_.empty()) {
+    KEN_CORE_WARN("Replay ended before any frame was timed");
+    return;
+  }
+
+  const FrameTimeStats replayed = FrameTimeStats::of(replay_frame_times_);
+  KEN_CORE_INFO("Replay finished: {} frames of one tick each, mean {:.3f} ms, p50 {:.3f} ms, p95 {:.3f} ms, "
+                "p99 {:.3f} ms, max {:.3f} ms",
+                replayed.count, replayed.mean, replayed.p50, replayed.p95, replayed.p99, replayed.max);
+
+  // The first interval is always zero, as there is no tick before it.
+  const auto& intervals         = replay_->tick_intervals();
+  const FrameTimeStats recorded =
+      intervals.size() > 1 ? FrameTimeStats::of({intervals.begin() + 1, intervals.end()}) : FrameTimeStats{};
+  if (recorded.count > 0) {
+    KEN_CORE_INFO("Recorded tick intervals: mean {:.3f} ms, p50 {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+                  recorded.mean, recorded.p50, recorded.p95, recorded.p99, recorded.max);
+  }
+
+  if (spec_.replay_report.empty()) {
+    return;
+  }
+  std::ofstream out(spec_.replay_report, std::ios::trunc);
+  out << std::format(
+      "{{\"frames\": {}, \"ticks\": {}, \"pipelined\": {}, \"mean_ms\": {:.4f}, \"p50_ms\": {:.4f}, "
+      "\"p95_ms\": {:.4f}, \"p99_ms\": {:.4f}, \"max_ms\": {:.4f}, \"recorded_mean_ms\": {:.4f}, "
+      "\"recorded_p95_ms\": {:.4f}, \"recorded_max_ms\": {:.4f}}}\n",
+      replayed.count, tick_count_.load(), spec_.pipelined, replayed.mean, replayed.p50, replayed.p95, replayed.p99,
+      replayed.max, recorded.mean, recorded.p95, recorded.max);
+  if (!out) {
+    KEN_CORE_ERROR("Failed to write replay report {}", spec_.replay_report.string());
   }
 }
 
 void Application::update() {
+  KEN_PROFILE_FUNCTION();
+  if (recorder_ != nullptr) {
+    const auto now      = std::chrono::steady_clock::now();
+    const auto interval = std::chrono::duration_cast<duration_t>(now - last_tick_start_);
+    recorder_->record_tick(tick_count_, tick_count_ > 0 ? interval : duration_t{});
+    last_tick_start_ = now;
+  }
+  window_->input().latch();
+
   for (const auto& layer : layer_stack_) {
     layer->on_update(Timestep{kTickTime}, Timestep{time_});
   }
+
+  time_ += kTickTime;
+  ++tick_count_;
+}
+
+void Application::take_snapshot() {
+  KEN_PROFILE_FUNCTION();
+  RenderSnapshot& snapshot = snapshots_.write();
+  snapshot.clear();
+  snapshot.tick = tick_count_;
+
+  for (const auto& layer : layer_stack_) {
+    layer->on_snapshot(snapshot);
+  }
+  snapshots_.publish();
 }
 
 void Application::render(double alpha) {
+  KEN_PROFILE_FUNCTION();
+  if (!snapshots_.acquire()) {
+    snapshots_.read().redraw();
+  }
+
   if (!minimized_) {
     for (const auto& layer : layer_stack_) {
       layer->on_render(alpha);
     }
 
-    {
+    if (!spec_.headless) {
+      KEN_PROFILE_SCOPE("Application::imgui");
+      const GpuScope gpu_scope(device_->context(), "ImGui");
       const ImguiFrame frame;
+      const std::scoped_lock lock(simulation_mutex_);
 
       for (const auto& layer : layer_stack_) {
         layer->on_imgui();
@@ -110,10 +395,15 @@ void Application::render(double alpha) {
     }
   }
 
+  KEN_PROFILE_SCOPE("Application::swap_buffers");
   device_->swap_buffers();
 }
 
 void Application::window_event_handler(BaseEvent& e) {
+  if (recorder_ != nullptr) {
+    recorder_->record(tick_count_, e);
+  }
+
   if (dispatcher_.dispatch(e)) {
     return;
   }
@@ -1,18 +1,31 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <kEn/core/core.hpp>
+#include <kEn/core/job_system.hpp>
 #include <kEn/core/layer_stack.hpp>
+#include <kEn/core/snapshot_buffer.hpp>
 #include <kEn/core/timestep.hpp>
 #include <kEn/core/window.hpp>
 #include <kEn/event/application_events.hpp>
+#include <kEn/event/concurrent_event_queue.hpp>
 #include <kEn/event/event.hpp>
+#include <kEn/event/event_recording.hpp>
 #include <kEn/renderer/device.hpp>
+#include <kEn/scene/render_snapshot.hpp>
 
 /** @file
  *  @ingroup ken
@@ -26,24 +39,38 @@ namespace kEn {
  *  All fields have sensible defaults; only override what differs.
  */
 struct ApplicationSpec {
-  std::string title           = "kEngine";           /**< Window title bar text. */
-  std::uint32_t window_width  = 1280;                /**< Initial window width in pixels. */
-  std::uint32_t window_height = 720;                 /**< Initial window height in pixels. */
-  Device::Api api             = Device::Api::OpenGL; /**< Graphics API to use. */
-  bool enable_debug           = false; /**< Enable GPU debug output and push the internal DebugLayer overlay. */
+  std::string title            = "kEngine";           /**< Window title bar text. */
+  std::uint32_t window_width   = 1280;                /**< Initial window width in pixels. */
+  std::uint32_t window_height  = 720;                 /**< Initial window height in pixels. */
+  Device::Api api              = Device::Api::OpenGL; /**< Graphics API to use. */
+  bool enable_debug            = false; /**< Enable GPU debug output and push the internal DebugLayer overlay. */
+  bool queue_events            = false; /**< Queue and coalesce window events, delivering them once per frame. */
+  bool headless                = false; /**< Run without a native window or ImGui; implies @c Device::Api::Null. */
+  bool pipelined               = false; /**< Run ticks on a simulation thread, overlapping them with rendering. */
+  std::uint32_t worker_threads = 0;     /**< Job system workers; 0 picks @ref JobSystem::default_worker_count(). */
+
+  std::filesystem::path record_events; /**< If set, window events are recorded to this file for a later replay. */
+  std::filesystem::path replay_events; /**< If set, the recording in this file is replayed instead of OS input. */
+  std::filesystem::path replay_report; /**< If set, frame time statistics of a replay are written here as JSON. */
+  std::filesystem::path profile_trace; /**< If set, the profiler's buffered scopes are written here on exit. */
 };
 
 /** @brief Core singleton that owns the main loop, window, and layer stack.
  *
  *  @details
  *  Application implements a fixed-timestep game loop decoupled from rendering:
- *  - **Update** runs at a fixed 60 TPS (@ref kTickTime).  Each tick advances
- *    every layer via Layer::on_update() with a constant @ref Timestep.
+ *  - **Update** runs at a fixed 60 TPS (@ref kTickTime).  Each tick latches
+ *    the window's @ref InputState and advances every layer via
+ *    Layer::on_update() with a constant @ref Timestep.
  *  - **Render** runs as fast as possible.  The `alpha` parameter passed to
  *    Layer::on_render() is the fractional tick interpolation factor
  *    `lag / kTickTime`, allowing smooth sub-tick interpolation.
  *  - **ImGui** passes are issued once per frame after all render passes.
  *
+ *  After the ticks of a frame every layer copies what it draws into a
+ *  @ref RenderSnapshot (Layer::on_snapshot()), which Layer::on_render() reads
+ *  back through @ref render_snapshot().
+ *
  *  Only one Application may exist at a time (asserted in the constructor).
  *  The global instance is accessible via @ref instance().
  *
@@ -51,6 +78,40 @@ struct ApplicationSpec {
  *  for event delivery.  Overlays (pushed via @ref push_overlay()) always sit
  *  on top of regular layers in the stack.
  *
+ *  Events posted from other threads via @ref post_event() are delivered the
+ *  same way as window events, right after the window events of each frame.
+ *
+ *  With @ref ApplicationSpec::replay_events set, the application replays a
+ *  recording made with @ref ApplicationSpec::record_events: OS input and vsync
+ *  are disabled, every frame runs exactly one tick preceded by the events
+ *  recorded for it (a recorded resize also resizes the window), and the loop
+ *  stops when the recording ends, logging frame time statistics next to the
+ *  tick intervals measured while recording.  Runs of the same recording
+ *  therefore simulate identical ticks and their frame times can be compared
+ *  directly.
+ *
+ *  With @ref ApplicationSpec::headless set there is no native window: the
+ *  null device records rendering commands instead of executing them and no
+ *  ImGui layers or passes run.  Together with a replay this measures the
+ *  engine's CPU-side frame cost on machines without a display or GPU.
+ *
+ *  With @ref ApplicationSpec::pipelined set, ticks run on a separate
+ *  simulation thread at the fixed rate, each one ending with a snapshot that
+ *  is handed to the main thread through a @ref SnapshotBuffer.  The main
+ *  thread polls events, draws the latest snapshot and presents; Layer::on_render()
+ *  receives an alpha of 0.  Event handling, ImGui passes and ticks take turns
+ *  on @c simulation_mutex_, so only rendering overlaps a tick.  When both
+ *  sides are CPU bound a frame costs about max(tick, render) instead of
+ *  tick + render, at the price of up to one tick of extra latency.  Replays
+ *  pace the two threads one to one: the simulation runs at most one tick
+ *  ahead of the frame being drawn and every frame waits for a new tick.  The
+ *  reported frame times are then per-tick costs in both modes, so comparing
+ *  the reports of the same replay with and without pipelining measures the
+ *  gain for a scene.
+ *
+ *  The application runs the @ref JobSystem from construction to destruction,
+ *  with @ref ApplicationSpec::worker_threads workers.
+ *
  *  @note Subclass this and implement @ref create_application() to define the
  *        entry point for a kEn application.
  */
@@ -65,16 +126,39 @@ class Application {
    */
   explicit Application(ApplicationSpec spec = {});
 
-  virtual ~Application() = default;
+  /** @brief Stops the job system before the layers are destroyed. */
+  virtual ~Application();
 
   /** @brief Runs the main loop until the window is closed.
    *
    *  Processes window events, drives fixed-rate updates, and renders each frame.
    *  Updates @ref fps() and @ref tps() counters once per wall-clock second.
    *  Returns only after @ref running_ is set to false (e.g., on WindowCloseEvent).
+   *  With @ref ApplicationSpec::pipelined set, the ticks run on a thread started and joined here.
+   *  With @ref ApplicationSpec::profile_trace set, a Chrome trace is written before returning.
    */
   void run();
 
+  /** @brief Stops the main loop after the current frame. */
+  void close() { running_ = false; }
+
+  /** @brief Snapshot drawn by the current frame.  Only valid on the main thread, in Layer::on_render() and
+   *         Layer::on_imgui().
+   */
+  [[nodiscard]] const RenderSnapshot& render_snapshot() const { return snapshots_.read(); }
+
+  /** @brief Runs @p task on the main thread, e.g. to call into GLFW or the graphics context.
+   *
+   *  Runs it right away when called there; otherwise at the start of the next frame.  Safe to call
+   *  from any thread.
+   *
+   *  @param task  Work to run.
+   */
+  void run_on_main_thread(std::function<void()> task);
+
+  /** @brief Whether the calling thread is the main thread, which owns the window and the graphics context. */
+  [[nodiscard]] bool on_main_thread() const { return std::this_thread::get_id() == main_thread_; }
+
   /** @brief Pushes a layer onto the layer stack below all overlays.
    *  @param layer  Ownership is transferred to the stack; on_attach() is called immediately.
    */
@@ -85,6 +169,20 @@ class Application {
    */
   void push_overlay(std::unique_ptr<Layer> overlay);
 
+  /** @brief Queues an event for delivery on the main thread.  Safe to call from any thread.
+   *
+   *  The event is constructed in place from @p args and delivered like a window event
+   *  (application handlers first, then the layer stack from the top) at the start of
+   *  the next frame, after the window events.
+   *
+   *  @tparam EventType  Event type to construct.
+   *  @param args        Constructor arguments of @p EventType.
+   */
+  template <typename EventType, typename... Args>
+  void post_event(Args&&... args) {
+    posted_events_.template post<EventType>(std::forward<Args>(args)...);
+  }
+
   /** @brief Returns a reference to the application's main window. */
   Window& main_window() const { return *window_; }
 
@@ -108,9 +206,25 @@ class Application {
   static constexpr duration_t kTickTime = std::chrono::microseconds(16667);  // 60 TPS = 16.(6) ms/t
 
  private:
-  /** @brief Advances all layers by one fixed tick. */
+  /** @brief Main loop running ticks and frames on the calling thread. */
+  void run_sequential();
+  /** @brief Main loop rendering on the calling thread while @ref simulate() runs the ticks. */
+  void run_pipelined();
+  /** @brief Tick loop of the simulation thread of a pipelined application. */
+  void simulate(const std::stop_token& stop);
+
+  /** @brief Latches the input snapshot and advances all layers by one fixed tick. */
   void update();
 
+  /** @brief Lets every layer fill the next snapshot and publishes it to the render side. */
+  void take_snapshot();
+
+  /** @brief Runs the tasks queued by @ref run_on_main_thread() from other threads. */
+  void run_main_thread_tasks();
+
+  /** @brief Updates @ref fps() and @ref tps() once a wall-clock second has passed. */
+  void count_frame(duration_t delta);
+
   /** @brief Renders all layers with the given interpolation factor.
    *  @param alpha  Fractional position within the current tick in [0, 1).
    */
@@ -124,16 +238,37 @@ class Application {
    */
   void window_event_handler(BaseEvent& e);
 
+  /** @brief Logs the replay frame time statistics and writes them to the report file, if any. */
+  void report_replay() const;
+
   std::unique_ptr<Window> window_;
   std::unique_ptr<Device> device_;
   EventDispatcher dispatcher_;
-  bool running_   = true;
-  bool minimized_ = false;
+  ConcurrentEventQueue posted_events_;
+  std::atomic<bool> running_ = true;
+  bool minimized_            = false;
   LayerStack layer_stack_;
 
   ApplicationSpec spec_;
   duration_t time_{};
+  std::atomic<std::uint64_t> tick_count_  = 0; /**< Ticks simulated; a replaying main thread waits on it. */
+  std::atomic<std::uint64_t> frame_count_ = 0; /**< Frames rendered; a replaying simulation thread waits on it. */
   uint16_t fps_ = 0, tps_ = 0;
+  duration_t second_{};
+  std::uint64_t second_frames_     = 0;
+  std::uint64_t second_first_tick_ = 0;
+
+  SnapshotBuffer<RenderSnapshot> snapshots_;
+  std::mutex simulation_mutex_; /**< Held by ticks, event handling and ImGui passes. */
+  std::mutex main_thread_mutex_;
+  std::vector<std::function<void()>> main_thread_tasks_; /**< Guarded by @ref main_thread_mutex_. */
+  std::vector<std::function<void()>> running_tasks_;     /**< Tasks of the current frame; main thread only. */
+  std::thread::id main_thread_;
+
+  std::unique_ptr<EventRecorder> recorder_;
+  std::chrono::steady_clock::time_point last_tick_start_; /**< Start of the previous tick while recording. */
+  std::unique_ptr<EventReplay> replay_;
+  std::vector<duration_t> replay_frame_times_;
 
   static Application* instance_;
 };
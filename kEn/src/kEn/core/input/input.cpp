@@ -6,6 +6,7 @@
 #include <mEn/vec2.hpp>
 
 #include <kEn/core/application.hpp>
+#include <kEn/core/input/input_state.hpp>
 #include <kEn/core/input/key_codes.hpp>
 #include <kEn/core/input/mouse_codes.hpp>
 
@@ -19,37 +20,44 @@ namespace {
   return kWindow;
 }
 
+[[nodiscard]] InputState& state() {
+  static InputState& state = Application::instance().main_window().input();
+  return state;
+}
+
 }  // namespace
 
-bool is_key_pressed(Key key) {
-  auto* window         = glfw_window();
-  const auto key_state = glfwGetKey(window, static_cast<int>(key));
-  return key_state == GLFW_PRESS || key_state == GLFW_REPEAT;
-}
+bool is_key_pressed(Key key) { return state().held(key); }
 
-bool is_mouse_button_pressed(MouseButton button) {
-  auto* window            = glfw_window();
-  const auto button_state = glfwGetMouseButton(window, static_cast<int>(button));
-  return button_state == GLFW_PRESS;
-}
+bool was_key_pressed(Key key) { return state().pressed(key); }
 
-mEn::Vec2 mouse_pos() {
-  auto* window = glfw_window();
-  double x     = 0.0;
-  double y     = 0.0;
-  glfwGetCursorPos(window, &x, &y);
+bool was_key_released(Key key) { return state().released(key); }
 
-  return {static_cast<float>(x), static_cast<float>(y)};
-}
+bool is_mouse_button_pressed(MouseButton button) { return state().held(button); }
+
+bool was_mouse_button_pressed(MouseButton button) { return state().pressed(button); }
+
+bool was_mouse_button_released(MouseButton button) { return state().released(button); }
+
+mEn::Vec2 mouse_pos() { return state().mouse_pos(); }
+
+// GLFW may only be called from the main thread, which is not the one running the ticks of a pipelined application.
 
 void set_cursor_visible(bool visible) {
   auto* window = glfw_window();
-  glfwSetInputMode(window, GLFW_CURSOR, visible ? GLFW_CURSOR_NORMAL : GLFW_CURSOR_HIDDEN);
+  if (window == nullptr) {
+    return;
+  }
+  Application::instance().run_on_main_thread(
+      [window, visible] { glfwSetInputMode(window, GLFW_CURSOR, visible ? GLFW_CURSOR_NORMAL : GLFW_CURSOR_HIDDEN); });
 }
 
 void set_mouse_pos(mEn::Vec2 pos) {
-  auto* window = glfw_window();
-  glfwSetCursorPos(window, static_cast<double>(pos.x), static_cast<double>(pos.y));
+  if (auto* window = glfw_window()) {
+    Application::instance().run_on_main_thread(
+        [window, pos] { glfwSetCursorPos(window, static_cast<double>(pos.x), static_cast<double>(pos.y)); });
+  }
+  state().warp_mouse(pos);
 }
 
 }  // namespace kEn::input
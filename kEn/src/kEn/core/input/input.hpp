@@ -12,11 +12,15 @@
 namespace kEn {
 
 /**
- * @brief Stateless input API for querying keyboard and mouse state.
+ * @brief Input API for querying keyboard and mouse state.
  *
  * All functions require the windowing/backend system to be initialized
  * (i.e. an active Application singleton with a valid native window must exist).
  *
+ * Queries read the main window's @ref InputState snapshot, which the
+ * Application latches at the start of every tick.  They cost a bit test and
+ * return the same answer for the whole tick.
+ *
  * @note Mouse position is reported in backend-defined window coordinates.
  *       With GLFW, the origin is the upper-left corner of the client area and
  *       units are screen coordinates (double precision in GLFW, converted to float here).
@@ -24,21 +28,49 @@ namespace kEn {
 namespace input {
 
 /**
- * @brief Check whether a key is currently pressed (or repeating).
+ * @brief Check whether a key is held down this tick.
  * @param key The key to query.
- * @return `true` if the key is down (pressed or repeated), otherwise `false`.
+ * @return `true` if the key was down (pressed or repeated) when the tick started, otherwise `false`.
  */
 [[nodiscard]] bool is_key_pressed(Key key);
 
 /**
- * @brief Check whether a mouse button is currently pressed.
+ * @brief Check whether a key went down since the previous tick.
+ * @param key The key to query.
+ * @return `true` on the first tick after the key was pressed, otherwise `false`.
+ */
+[[nodiscard]] bool was_key_pressed(Key key);
+
+/**
+ * @brief Check whether a key went up since the previous tick.
+ * @param key The key to query.
+ * @return `true` on the first tick after the key was released, otherwise `false`.
+ */
+[[nodiscard]] bool was_key_released(Key key);
+
+/**
+ * @brief Check whether a mouse button is held down this tick.
  * @param button The mouse button to query.
- * @return `true` if the button is down, otherwise `false`.
+ * @return `true` if the button was down when the tick started, otherwise `false`.
  */
 [[nodiscard]] bool is_mouse_button_pressed(MouseButton button);
 
 /**
- * @brief Get the current mouse cursor position in window coordinates.
+ * @brief Check whether a mouse button went down since the previous tick.
+ * @param button The mouse button to query.
+ * @return `true` on the first tick after the button was pressed, otherwise `false`.
+ */
+[[nodiscard]] bool was_mouse_button_pressed(MouseButton button);
+
+/**
+ * @brief Check whether a mouse button went up since the previous tick.
+ * @param button The mouse button to query.
+ * @return `true` on the first tick after the button was released, otherwise `false`.
+ */
+[[nodiscard]] bool was_mouse_button_released(MouseButton button);
+
+/**
+ * @brief Get the mouse cursor position in window coordinates at the start of this tick.
  * @return Cursor position as (x, y).
  */
 [[nodiscard]] mEn::Vec2 mouse_pos();
@@ -49,6 +81,7 @@ namespace input {
  *
  * @note Some backends also offer a "disabled/captured" mode for FPS controls.
  *       This function typically maps to a simple visible/hidden state.
+ * @note During a tick of a pipelined application the change takes effect at the next frame.
  */
 void set_cursor_visible(bool visible);
 
@@ -56,7 +89,10 @@ void set_cursor_visible(bool visible);
  * @brief Warp the cursor to a specific position (window coordinates).
  * @param pos Target position in window coordinates.
  *
+ * The input snapshot is updated as well, so later @ref mouse_pos() calls in the same tick see @p pos.
+ *
  * @warning Warping the cursor may generate cursor-move events depending on backend.
+ * @note During a tick of a pipelined application the OS cursor moves at the next frame.
  */
 void set_mouse_pos(mEn::Vec2 pos);
 
@@ -0,0 +1,79 @@
+#include "input_state.hpp"
+
+#include <cstddef>
+#include <variant>
+
+#include <mEn/vec2.hpp>
+
+#include <kEn/core/input/key_codes.hpp>
+#include <kEn/core/input/mouse_codes.hpp>
+#include <kEn/event/window_event_record.hpp>
+
+namespace kEn {
+
+void InputState::on_key(Key key, bool down) noexcept {
+  const std::size_t i = key::code(key);
+  if (i >= kKeyCount) {
+    return;
+  }
+
+  // Repeats arrive as presses of a key that is already down; they are not new edges.
+  if (down && !live_keys_[i]) {
+    live_pressed_keys_.set(i);
+  } else if (!down && live_keys_[i]) {
+    live_released_keys_.set(i);
+  }
+  live_keys_[i] = down;
+}
+
+void InputState::on_mouse_button(MouseButton button, bool down) noexcept {
+  const std::size_t i = mouse::code(button);
+  if (i >= kButtonCount) {
+    return;
+  }
+
+  if (down && !live_buttons_[i]) {
+    live_pressed_buttons_.set(i);
+  } else if (!down && live_buttons_[i]) {
+    live_released_buttons_.set(i);
+  }
+  live_buttons_[i] = down;
+}
+
+void InputState::apply(const WindowEventRecord& record) noexcept {
+  using namespace window_event;  // NOLINT(google-build-using-namespace)
+
+  if (const auto* e = std::get_if<KeyPress>(&record)) {
+    on_key(e->key, true);
+  } else if (const auto* e = std::get_if<KeyRelease>(&record)) {
+    on_key(e->key, false);
+  } else if (const auto* e = std::get_if<ButtonPress>(&record)) {
+    on_mouse_button(e->button, true);
+  } else if (const auto* e = std::get_if<ButtonRelease>(&record)) {
+    on_mouse_button(e->button, false);
+  } else if (const auto* e = std::get_if<Move>(&record)) {
+    on_mouse_move(e->pos);
+  } else if (const auto* e = std::get_if<Scroll>(&record)) {
+    on_mouse_scroll(e->offset);
+  }
+}
+
+void InputState::latch() noexcept {
+  held_keys_     = live_keys_;
+  pressed_keys_  = live_pressed_keys_;
+  released_keys_ = live_released_keys_;
+  live_pressed_keys_.reset();
+  live_released_keys_.reset();
+
+  held_buttons_     = live_buttons_;
+  pressed_buttons_  = live_pressed_buttons_;
+  released_buttons_ = live_released_buttons_;
+  live_pressed_buttons_.reset();
+  live_released_buttons_.reset();
+
+  mouse_pos_   = live_mouse_pos_;
+  scroll_      = live_scroll_;
+  live_scroll_ = mEn::Vec2{0.F};
+}
+
+}  // namespace kEn
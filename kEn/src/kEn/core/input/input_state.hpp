@@ -0,0 +1,96 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+
+#include <mEn/vec2.hpp>
+
+#include <kEn/core/input/key_codes.hpp>
+#include <kEn/core/input/mouse_codes.hpp>
+#include <kEn/event/window_event_record.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+/**
+ * @brief Keyboard and mouse state latched once per tick.
+ *
+ * The window feeds every key, button, cursor and scroll event into the live
+ * state as the OS reports it.  @ref latch copies the live state into the
+ * snapshot that all queries read, so each query is a bit test and every
+ * component sees the same input for the whole tick, no matter when it runs.
+ *
+ * Besides the held state, the snapshot records which keys and buttons went
+ * down or up since the previous latch.  Presses and releases are accumulated
+ * between latches, so a tap shorter than a tick still reports both edges.
+ */
+class InputState {
+ public:
+  /** @brief Number of key codes tracked; one past the largest @ref Key. */
+  static constexpr std::size_t kKeyCount = key::code(Key::menu) + 1;
+  /** @brief Number of mouse buttons tracked; one past the largest @ref MouseButton. */
+  static constexpr std::size_t kButtonCount = mouse::code(MouseButton::button8) + 1;
+
+  /** @name Live state
+   *  Called by the window for every input event it receives.
+   */
+  ///@{
+  void on_key(Key key, bool down) noexcept;
+  void on_mouse_button(MouseButton button, bool down) noexcept;
+  void on_mouse_move(const mEn::Vec2& pos) noexcept { live_mouse_pos_ = pos; }
+  void on_mouse_scroll(const mEn::Vec2& offset) noexcept { live_scroll_ += offset; }
+  /** @brief Feeds a recorded window event; non-input events are ignored. */
+  void apply(const WindowEventRecord& record) noexcept;
+  /** @brief Moves the cursor in both the live state and the snapshot, for programmatic cursor warps. */
+  void warp_mouse(const mEn::Vec2& pos) noexcept { live_mouse_pos_ = mouse_pos_ = pos; }
+  ///@}
+
+  /** @brief Publishes the live state to the snapshot and starts collecting edges for the next tick. */
+  void latch() noexcept;
+
+  /** @name Snapshot queries */
+  ///@{
+  /** @brief Whether @p key was down at the last latch. */
+  [[nodiscard]] bool held(Key key) const noexcept { return test(held_keys_, key::code(key)); }
+  /** @brief Whether @p key went down between the previous two latches. */
+  [[nodiscard]] bool pressed(Key key) const noexcept { return test(pressed_keys_, key::code(key)); }
+  /** @brief Whether @p key went up between the previous two latches. */
+  [[nodiscard]] bool released(Key key) const noexcept { return test(released_keys_, key::code(key)); }
+
+  /** @brief Whether @p button was down at the last latch. */
+  [[nodiscard]] bool held(MouseButton button) const noexcept { return test(held_buttons_, mouse::code(button)); }
+  /** @brief Whether @p button went down between the previous two latches. */
+  [[nodiscard]] bool pressed(MouseButton button) const noexcept {
+    return test(pressed_buttons_, mouse::code(button));
+  }
+  /** @brief Whether @p button went up between the previous two latches. */
+  [[nodiscard]] bool released(MouseButton button) const noexcept {
+    return test(released_buttons_, mouse::code(button));
+  }
+
+  /** @brief Cursor position at the last latch, in window coordinates. */
+  [[nodiscard]] const mEn::Vec2& mouse_pos() const noexcept { return mouse_pos_; }
+  /** @brief Scroll offset accumulated between the previous two latches. */
+  [[nodiscard]] const mEn::Vec2& scroll() const noexcept { return scroll_; }
+  ///@}
+
+ private:
+  template <std::size_t N>
+  [[nodiscard]] static bool test(const std::bitset<N>& bits, std::size_t i) noexcept {
+    return i < N && bits[i];
+  }
+
+  std::bitset<kKeyCount> live_keys_, live_pressed_keys_, live_released_keys_;
+  std::bitset<kKeyCount> held_keys_, pressed_keys_, released_keys_;
+
+  std::bitset<kButtonCount> live_buttons_, live_pressed_buttons_, live_released_buttons_;
+  std::bitset<kButtonCount> held_buttons_, pressed_buttons_, released_buttons_;
+
+  mEn::Vec2 live_mouse_pos_{0.F}, live_scroll_{0.F};
+  mEn::Vec2 mouse_pos_{0.F}, scroll_{0.F};
+};
+
+}  // namespace kEn
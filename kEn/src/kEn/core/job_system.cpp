@@ -0,0 +1,315 @@
+#include "job_system.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/core/log.hpp>
+#include <kEn/core/profiler.hpp>
+
+namespace kEn {
+
+namespace {
+
+/** @brief Failed searches for a job before a thread goes to sleep. */
+constexpr int kSpinsBeforeSleep = 64;
+
+/** @brief Deque of one worker; the owner pushes and pops at the back, thieves take from the front. */
+struct alignas(64) WorkerQueue {
+  std::mutex mutex;
+  std::deque<Job> jobs;
+  std::atomic<std::uint64_t> executed{0};  ///< Jobs run by the owner.
+  std::atomic<std::uint64_t> stolen{0};    ///< Jobs taken from this deque by other threads.
+};
+
+struct Scheduler {
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  std::mutex shared_mutex;
+  std::deque<Job> shared;                         ///< Jobs submitted by threads that are not workers.
+  std::atomic<std::uint64_t> shared_executed{0};  ///< Jobs run by threads that are not workers.
+  std::atomic<std::uint32_t> epoch{0};            ///< Bumped by every submission; idle workers sleep on it.
+  std::atomic<bool> stopping{false};
+  std::vector<std::jthread> threads;
+};
+
+/** @brief Created and destroyed by the thread calling init() and shutdown(), while no jobs are in flight. */
+std::unique_ptr<Scheduler>& scheduler() {
+  static std::unique_ptr<Scheduler> instance;
+  return instance;
+}
+
+/** @brief Index of the worker running on the calling thread, or -1 on threads that are not workers. */
+int& this_worker() {
+  thread_local int index = -1;
+  return index;
+}
+
+/** @brief Deque the calling thread tries first when it steals, rotated so thieves spread over the workers. */
+std::size_t& next_victim() {
+  thread_local std::size_t victim = 0;
+  return victim;
+}
+
+std::optional<Job> pop_back(WorkerQueue& queue) {
+  const std::scoped_lock lock(queue.mutex);
+  if (queue.jobs.empty()) {
+    return std::nullopt;
+  }
+  Job job = std::move(queue.jobs.back());
+  queue.jobs.pop_back();
+  return job;
+}
+
+std::optional<Job> pop_shared(Scheduler& s) {
+  const std::scoped_lock lock(s.shared_mutex);
+  if (s.shared.empty()) {
+    return std::nullopt;
+  }
+  Job job = std::move(s.shared.front());
+  s.shared.pop_front();
+  return job;
+}
+
+/** @brief Takes the oldest job of another worker; busy deques are skipped rather than waited for. */
+std::optional<Job> steal(Scheduler& s, int self) {
+  const std::size_t count = s.queues.size();
+  const std::size_t start = next_victim()++;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::size_t victim = (start + i) % count;
+    if (static_cast<int>(victim) == self) {
+      continue;
+    }
+    WorkerQueue& queue = *s.queues[victim];
+    const std::unique_lock lock(queue.mutex, std::try_to_lock);
+    if (!lock.owns_lock() || queue.jobs.empty()) {
+      continue;
+    }
+    Job job = std::move(queue.jobs.front());
+    queue.jobs.pop_front();
+    queue.stolen.fetch_add(1, std::memory_order_relaxed);
+    return job;
+  }
+  return std::nullopt;
+}
+
+std::optional<Job> find_job(Scheduler& s) {
+  const int worker = this_worker();
+  if (worker >= 0) {
+    if (auto job = pop_back(*s.queues[worker])) {
+      return job;
+    }
+  }
+  if (auto job = pop_shared(s)) {
+    return job;
+  }
+  return steal(s, worker);
+}
+
+void schedule(Scheduler& s, Job job) {
+  if (const int worker = this_worker(); worker >= 0) {
+    WorkerQueue& queue = *s.queues[worker];
+    const std::scoped_lock lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  } else {
+    const std::scoped_lock lock(s.shared_mutex);
+    s.shared.push_back(std::move(job));
+  }
+  s.epoch.fetch_add(1, std::memory_order_release);
+  s.epoch.notify_one();
+}
+
+}  // namespace
+
+void JobCounter::add() noexcept { pending_.fetch_add(1, std::memory_order_relaxed); }
+
+bool JobCounter::defer(Job& job) {
+  const std::scoped_lock lock(mutex_);
+  if (pending_.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  continuations_.push_back(std::move(job));
+  return true;
+}
+
+std::vector<Job> JobCounter::finish_one() {
+  std::vector<Job> ready;
+  // The decrement to zero happens under the mutex, which waiters take before they return; see JobSystem::wait.
+  const std::scoped_lock lock(mutex_);
+  if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    ready.swap(continuations_);
+    pending_.notify_all();
+  }
+  return ready;
+}
+
+// ---------------- //
+
+std::uint32_t JobSystem::default_worker_count() noexcept {
+  const unsigned hardware = std::thread::hardware_concurrency();
+  return hardware > 2 ? hardware - 1 : 1;
+}
+
+void JobSystem::init(std::uint32_t worker_count) {
+  KEN_CORE_ASSERT(!scheduler(), "Job system is already running");
+  KEN_CORE_ASSERT(worker_count > 0, "Job system needs at least one worker");
+
+  Scheduler& s = *(scheduler() = std::make_unique<Scheduler>());
+  s.queues.reserve(worker_count);
+  for (std::uint32_t i = 0; i < worker_count; ++i) {
+    s.queues.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  s.threads.reserve(worker_count);
+  for (std::uint32_t i = 0; i < worker_count; ++i) {
+    s.threads.emplace_back([&s, index = static_cast<int>(i)] {
+      this_worker() = index;
+      KEN_PROFILE_THREAD(std::format("Worker {}", index));
+
+      int spins = 0;
+      while (true) {
+        const std::uint32_t epoch = s.epoch.load(std::memory_order_acquire);
+        if (auto job = find_job(s)) {
+          execute(*job);
+          spins = 0;
+          continue;
+        }
+        if (s.stopping.load(std::memory_order_acquire)) {
+          return;
+        }
+        if (++spins < kSpinsBeforeSleep) {
+          std::this_thread::yield();
+          continue;
+        }
+        s.epoch.wait(epoch, std::memory_order_acquire);
+        spins = 0;
+      }
+    });
+  }
+  KEN_CORE_INFO("Job system started with {} workers", worker_count);
+}
+
+void JobSystem::shutdown() {
+  Scheduler* s = scheduler().get();
+  if (s == nullptr) {
+    return;
+  }
+
+  s->stopping.store(true, std::memory_order_release);
+  s->epoch.fetch_add(1, std::memory_order_release);
+  s->epoch.notify_all();
+  s->threads.clear();
+
+  const JobStats totals = stats();
+  KEN_CORE_INFO("Job system stopped after {} jobs, {} stolen", totals.executed, totals.stolen);
+  scheduler().reset();
+}
+
+std::uint32_t JobSystem::worker_count() noexcept {
+  const Scheduler* s = scheduler().get();
+  return s != nullptr ? static_cast<std::uint32_t>(s->queues.size()) : 0;
+}
+
+int JobSystem::worker_index() noexcept { return this_worker(); }
+
+void JobSystem::run(JobCounter& counter, std::move_only_function<void()> task, const char* name) {
+  counter.add();
+  dispatch({.task = std::move(task), .counter = &counter, .name = name});
+}
+
+void JobSystem::run_after(JobCounter& dependency, JobCounter& counter, std::move_only_function<void()> task,
+                          const char* name) {
+  counter.add();
+  Job job{.task = std::move(task), .counter = &counter, .name = name};
+  if (!dependency.defer(job)) {
+    dispatch(std::move(job));
+  }
+}
+
+void JobSystem::run_detached(std::move_only_function<void()> task, const char* name) {
+  dispatch({.task = std::move(task), .counter = nullptr, .name = name});
+}
+
+void JobSystem::wait(JobCounter& counter) {
+  KEN_PROFILE_SCOPE("JobSystem::wait");
+
+  int spins = 0;
+  while (true) {
+    const std::uint32_t pending = counter.pending_.load(std::memory_order_acquire);
+    if (pending == 0) {
+      break;
+    }
+    if (Scheduler* s = scheduler().get()) {
+      if (auto job = find_job(*s)) {
+        execute(*job);
+        spins = 0;
+        continue;
+      }
+    }
+    if (++spins < kSpinsBeforeSleep) {
+      std::this_thread::yield();
+      continue;
+    }
+    counter.pending_.wait(pending, std::memory_order_acquire);
+    spins = 0;
+  }
+
+  // The thread that finished the last job may still hold the mutex; the caller may destroy the counter once it is
+  // let go.
+  const std::scoped_lock lock(counter.mutex_);
+}
+
+JobStats JobSystem::stats() noexcept {
+  JobStats totals;
+  const Scheduler* s = scheduler().get();
+  if (s == nullptr) {
+    return totals;
+  }
+  totals.executed = s->shared_executed.load(std::memory_order_relaxed);
+  for (const auto& queue : s->queues) {
+    totals.executed += queue->executed.load(std::memory_order_relaxed);
+    totals.stolen += queue->stolen.load(std::memory_order_relaxed);
+  }
+  return totals;
+}
+
+void JobSystem::dispatch(Job job) {
+  if (Scheduler* s = scheduler().get()) {
+    schedule(*s, std::move(job));
+  } else {
+    execute(job);
+  }
+}
+
+void JobSystem::execute(Job& job) {
+  {
+    // Destroy the task before completing, so a waiter never sees its counter done while captures are still alive.
+    auto task = std::move(job.task);
+    KEN_PROFILE_SCOPE(job.name);
+    task();
+  }
+
+  if (Scheduler* s = scheduler().get()) {
+    const int worker = this_worker();
+    auto& executed   = worker >= 0 ? s->queues[worker]->executed : s->shared_executed;
+    executed.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (job.counter == nullptr) {
+    return;
+  }
+  for (Job& ready : job.counter->finish_one()) {
+    dispatch(std::move(ready));
+  }
+}
+
+}  // namespace kEn
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <kEn/core/core.hpp>
+
+/** @file
+ *  @ingroup ken
+ *
+ *  Work-stealing job system.
+ *
+ *  A fixed pool of worker threads runs jobs: small tasks tracked by a
+ *  @ref JobCounter.  Every worker pushes the jobs it spawns onto a deque of
+ *  its own and runs them newest first; idle workers steal the oldest jobs of
+ *  the others.  Threads that are not workers submit through a shared queue
+ *  and help running jobs while they wait (@ref JobSystem::wait), so the main
+ *  thread never idles on work it could do itself.
+ */
+
+namespace kEn {
+
+class JobCounter;
+
+/** @brief Task queued on the @ref JobSystem, with the counter it completes. */
+struct Job {
+  std::move_only_function<void()> task;
+  JobCounter* counter = nullptr; /**< Completed once the task has run; may be null. */
+  const char* name    = "Job"; /**< Static string; name of the job's profile scope. */
+};
+
+/**
+ * @brief Completion handle of a group of jobs.
+ *
+ * Counts the jobs submitted with it that have not finished yet.  Other jobs
+ * can be held back until a counter reaches zero, see @ref JobSystem::run_after.
+ * A counter can be reused once it is done.
+ *
+ * @warning Jobs refer to their counter until they finish: call
+ *          @ref JobSystem::wait before destroying a counter that is in use.
+ */
+class JobCounter {
+ public:
+  JobCounter()  = default;
+  ~JobCounter() = default;
+
+  DELETE_COPY_MOVE(JobCounter);
+
+  /** @brief Whether every job submitted with this counter, including held-back ones, has finished. */
+  [[nodiscard]] bool done() const noexcept { return pending_.load(std::memory_order_acquire) == 0; }
+
+ private:
+  friend class JobSystem;
+
+  /** @brief Counts one more job. */
+  void add() noexcept;
+  /** @brief Holds @p job back until the counter is done; leaves it untouched and returns @c false if it already is. */
+  bool defer(Job& job);
+  /** @brief Counts one job as finished and returns the jobs held back if it was the last one. */
+  std::vector<Job> finish_one();
+
+  std::atomic<std::uint32_t> pending_{0};
+  std::mutex mutex_;                ///< Guards @ref continuations_ and the decrement to zero.
+  std::vector<Job> continuations_;  ///< Jobs held back until the counter reaches zero.
+};
+
+/** @brief Number of jobs the workers ran and stole since @ref JobSystem::init. */
+struct JobStats {
+  std::uint64_t executed = 0; /**< Jobs run by any thread. */
+  std::uint64_t stolen   = 0; /**< Jobs taken from another worker's deque. */
+};
+
+/**
+ * @brief Process-wide pool of worker threads.
+ *
+ * Started by the Application (@ref ApplicationSpec::worker_threads) and
+ * stopped when it is destroyed.  While no pool is running, jobs run inline
+ * on the submitting thread, so code using the job system also works in tools
+ * and during shutdown.
+ *
+ * With @c KEN_ENABLE_PROFILING every job is a profile scope named after the
+ * job, and the workers show up as "Worker N" in the profiler's timeline.
+ */
+class JobSystem {
+ public:
+  /** @brief Number of @ref parallel_for chunks per thread, so that faster threads can take over the slack. */
+  static constexpr std::size_t kChunksPerThread = 4;
+
+  /** @brief One worker per hardware thread, minus the main thread; at least one. */
+  [[nodiscard]] static std::uint32_t default_worker_count() noexcept;
+
+  /**
+   * @brief Starts @p worker_count worker threads.
+   * @pre No pool is running.  Only the thread that calls @ref shutdown may call this.
+   */
+  static void init(std::uint32_t worker_count = default_worker_count());
+  /** @brief Runs every queued job, then stops and joins the workers.  Does nothing if no pool is running. */
+  static void shutdown();
+
+  /** @brief Number of running workers; 0 if there is no pool. */
+  [[nodiscard]] static std::uint32_t worker_count() noexcept;
+  /** @brief Index of the calling worker in [0, @ref worker_count()), or -1 on any other thread. */
+  [[nodiscard]] static int worker_index() noexcept;
+
+  /**
+   * @brief Queues @p task.
+   * @param counter Incremented now, decremented when @p task has run.
+   * @param task    Work to run on any thread.
+   * @param name    Static string naming the job in the profiler.
+   */
+  static void run(JobCounter& counter, std::move_only_function<void()> task, const char* name = "Job");
+
+  /**
+   * @brief Queues @p task once @p dependency is done; right away if it already is.
+   * @param dependency Counter of the jobs @p task depends on.
+   * @param counter    Incremented now, decremented when @p task has run.
+   * @param task       Work to run on any thread.
+   * @param name       Static string naming the job in the profiler.
+   */
+  static void run_after(JobCounter& dependency, JobCounter& counter, std::move_only_function<void()> task,
+                        const char* name = "Job");
+
+  /**
+   * @brief Queues @p task without a counter, for work that signals its completion by other means.
+   * @param task Work to run on any thread.
+   * @param name Static string naming the job in the profiler.
+   */
+  static void run_detached(std::move_only_function<void()> task, const char* name = "Job");
+
+  /** @brief Runs queued jobs on the calling thread until @p counter is done, then returns. */
+  static void wait(JobCounter& counter);
+
+  /**
+   * @brief Calls @p body(begin, end) on disjoint subranges covering [0, @p count) and waits for all of them.
+   *
+   * The calling thread runs chunks too.  The range is cut into about
+   * @ref kChunksPerThread chunks per thread, but never into chunks smaller
+   * than @p min_grain, so that small ranges do not pay for more jobs than
+   * they save.
+   *
+   * @param count     Size of the range.
+   * @param body      Callable taking <tt>(std::size_t begin, std::size_t end)</tt>; called concurrently.
+   * @param min_grain Smallest number of elements worth a job of its own.
+   * @param name      Static string naming the chunks in the profiler.
+   */
+  template <typename Body>
+  static void parallel_for(std::size_t count, Body&& body, std::size_t min_grain = 1,
+                           const char* name = "parallel_for") {
+    if (count == 0) {
+      return;
+    }
+    const std::size_t threads = std::size_t{worker_count()} + 1;
+    const std::size_t grain   = std::max({min_grain, std::size_t{1}, (count + (threads * kChunksPerThread) - 1) /
+                                                                        (threads * kChunksPerThread)});
+    if (grain >= count) {
+      body(std::size_t{0}, count);
+      return;
+    }
+
+    JobCounter counter;
+    for (std::size_t begin = grain; begin < count; begin += grain) {
+      const std::size_t end = std::min(begin + grain, count);
+      run(counter, [&body, begin, end] { body(begin, end); }, name);
+    }
+    body(std::size_t{0}, grain);
+    wait(counter);
+  }
+
+  /** @brief Totals since the last @ref init. */
+  [[nodiscard]] static JobStats stats() noexcept;
+
+ private:
+  /** @brief Queues @p job, or runs it right away if no pool is running. */
+  static void dispatch(Job job);
+  /** @brief Runs @p job, completes its counter and dispatches the jobs that were waiting for it. */
+  static void execute(Job& job);
+};
+
+}  // namespace kEn
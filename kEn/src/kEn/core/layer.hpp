@@ -12,6 +12,8 @@
 
 namespace kEn {
 
+struct RenderSnapshot;
+
 /**
  * @brief Abstract base class for all engine layers.
  *
@@ -22,11 +24,17 @@ namespace kEn {
  *   on_attach()  -- called once when the layer is pushed onto the stack.
  *   on_detach()  -- called once when the layer is popped or the stack is destroyed.
  *   on_update()  -- called every fixed tick (60 Hz by default) with delta and elapsed time.
+ *   on_snapshot() -- called after the ticks of a frame; copy out what on_render() needs.
  *   on_render()  -- called every frame; alpha is the interpolation factor within the current tick.
  *   on_imgui()   -- called every frame inside an ImguiFrame scope; draw Dear ImGui widgets here.
  *   on_event()   -- called for each event in reverse stack order; return true to consume it.
  *
  * Derived classes override only the hooks they need; all defaults are no-ops.
+ *
+ * With ApplicationSpec::pipelined set, ticks (on_update() and on_snapshot()) run on a simulation
+ * thread while on_render() draws an earlier tick on the main thread.  on_render() must then read
+ * simulation state only through Application::render_snapshot().  on_event() and on_imgui() never
+ * overlap a tick and may touch anything.
  */
 class Layer {
  public:
@@ -47,6 +55,14 @@ class Layer {
    */
   virtual void on_update(Timestep /*delta*/, Timestep /*time*/) {}
 
+  /**
+   * Called at the end of the last tick before a frame (every tick when pipelined), on the thread
+   * that runs on_update().  Copies the state on_render() draws into @p snapshot, which every layer
+   * fills in turn and which on_render() reads back through Application::render_snapshot().
+   * @param snapshot  Snapshot of the finished tick, emptied before the first layer is called.
+   */
+  virtual void on_snapshot(RenderSnapshot& /*snapshot*/) {}
+
   /**
    * Called every frame for rendering.
    * @param alpha  Interpolation factor in [0, 1) between the previous and current tick state.
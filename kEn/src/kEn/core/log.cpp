@@ -1,53 +1,84 @@
 #include "log.hpp"
 
+#include <spdlog/async.h>
+#include <spdlog/async_logger.h>
 #include <spdlog/common.h>
+#include <spdlog/details/thread_pool.h>
 #include <spdlog/logger.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
 
 namespace kEn {
 
-spdlog::logger& Log::core_logger() {
-  static const auto kInstance = []() {
-    auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-#ifdef KEN_DEBUG_BUILD
-    sink->set_pattern("%^[%T][%n/%l][%s:%# %!]: %v%$");
-#else
-    sink->set_pattern("%^[%T][%n/%l]: %v%$");
-#endif
+namespace {
+
+/** @brief Background thread shared by both loggers; its destructor writes out what is still queued. */
+const std::shared_ptr<spdlog::details::thread_pool>& thread_pool() {
+  static const auto kInstance = std::make_shared<spdlog::details::thread_pool>(Log::kQueueSize, 1);
+  return kInstance;
+}
 
-    auto logger = std::make_shared<spdlog::logger>("kEn", sink);
+std::shared_ptr<spdlog::logger> make_logger(std::string name) {
+  auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
 #ifdef KEN_DEBUG_BUILD
-    logger->set_level(spdlog::level::trace);
+  sink->set_pattern("%^[%T][%n/%l][%s:%# %!]: %v%$");
 #else
-    logger->set_level(spdlog::level::warn);
+  sink->set_pattern("%^[%T][%n/%l]: %v%$");
 #endif
 
-    return logger;
-  }();
+  // Loggers only keep a weak reference to the pool; it is constructed first, so it is destroyed after them.
+  auto logger = std::make_shared<spdlog::async_logger>(std::move(name), std::move(sink), thread_pool(),
+                                                       spdlog::async_overflow_policy::overrun_oldest);
+  logger->set_level(static_cast<spdlog::level::level_enum>(KEN_LOG_LEVEL));
+  logger->flush_on(spdlog::level::err);
+  return logger;
+}
+
+}  // namespace
+
+spdlog::logger& Log::core_logger() {
+  static const auto kInstance = make_logger("kEn");
   return *kInstance;
 }
 
 spdlog::logger& Log::client_logger() {
-  static const auto kInstance = []() {
-    auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-#ifdef KEN_DEBUG_BUILD
-    sink->set_pattern("%^[%T][%n/%l][%s:%# %!]: %v%$");
-#else
-    sink->set_pattern("%^[%T][%n/%l]: %v%$");
-#endif
+  static const auto kInstance = make_logger("Client");
+  return *kInstance;
+}
 
-    auto logger = std::make_shared<spdlog::logger>("Client", sink);
-#ifdef KEN_DEBUG_BUILD
-    logger->set_level(spdlog::level::trace);
-#else
-    logger->set_level(spdlog::level::warn);
-#endif
+void Log::flush() {
+  core_logger().flush();
+  client_logger().flush();
+}
 
-    return logger;
-  }();
-  return *kInstance;
+std::size_t Log::dropped_messages() { return thread_pool()->overrun_counter(); }
+
+std::optional<std::uint64_t> LogRateLimiter::admit() noexcept {
+  if (seen_.fetch_add(1, std::memory_order_relaxed) < kBurst) {
+    return 0;
+  }
+
+  const std::int64_t now =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  const std::int64_t interval = std::chrono::duration_cast<std::chrono::nanoseconds>(kInterval).count();
+
+  std::int64_t next = next_ns_.load(std::memory_order_relaxed);
+  if (next == 0) {
+    // First message over the burst: start the interval and drop it.
+    next_ns_.compare_exchange_strong(next, now + interval, std::memory_order_relaxed);
+  } else if (now >= next && next_ns_.compare_exchange_strong(next, now + interval, std::memory_order_relaxed)) {
+    return suppressed_.exchange(0, std::memory_order_relaxed);
+  }
+  suppressed_.fetch_add(1, std::memory_order_relaxed);
+  return std::nullopt;
 }
 
 }  // namespace kEn
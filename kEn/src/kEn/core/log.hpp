@@ -1,5 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
 #include <kEn/core/core.hpp>
 
 #pragma warning(push, 0)
@@ -21,9 +27,19 @@ namespace kEn {
  * Provides two named loggers: one for engine-internal (core) messages and one
  * for client (application) code. Both loggers are initialized on first use.
  * Prefer the KEN_CORE_* / KEN_* macros over calling these methods directly.
+ *
+ * Messages are formatted on the calling thread and written by a background
+ * thread, so logging never waits on the console.  The queue between them is
+ * bounded to @ref kQueueSize messages; when it is full the oldest queued
+ * message is dropped (see @ref dropped_messages).  Errors and critical
+ * messages flush the queue before returning, so they are written before an
+ * assert breaks into the debugger.
  */
 class Log {
  public:
+  /** @brief Capacity of the queue of messages waiting for the background thread. */
+  static constexpr std::size_t kQueueSize = 8192;
+
   /**
    * @brief Returns the engine-internal logger.
    * @return Reference to the spdlog logger used by KEN_CORE_* macros.
@@ -35,12 +51,61 @@ class Log {
    * @return Reference to the spdlog logger used by KEN_* macros.
    */
   static spdlog::logger& client_logger();
+
+  /** @brief Blocks until every queued message has been written. */
+  static void flush();
+
+  /** @brief Number of messages dropped because the queue was full. */
+  [[nodiscard]] static std::size_t dropped_messages();
+};
+
+/**
+ * @brief Per-call-site state of the KEN_*_LIMITED macros.
+ *
+ * Lets the first @ref kBurst messages through, then at most one every
+ * @ref kInterval, which also reports how many were suppressed since the last
+ * one.  Thread-safe.
+ */
+class LogRateLimiter {
+ public:
+  /** @brief Messages logged before limiting starts. */
+  static constexpr std::uint64_t kBurst = 8;
+  /** @brief Shortest time between two messages once limiting has started. */
+  static constexpr std::chrono::seconds kInterval{5};
+
+  /**
+   * @brief Decides whether the current message is logged.
+   * @return Number of messages suppressed since the last logged one, or @c std::nullopt to drop this one.
+   */
+  [[nodiscard]] std::optional<std::uint64_t> admit() noexcept;
+
+ private:
+  std::atomic<std::uint64_t> seen_{0};
+  std::atomic<std::uint64_t> suppressed_{0};
+  std::atomic<std::int64_t> next_ns_{0};  ///< Steady-clock time the next message may pass; 0 until limiting starts.
 };
 
 }  // namespace kEn
 
 // NOLINTBEGIN(cppcoreguidelines-macro-usage)
 
+/**
+ * @def KEN_LOG_LEVEL
+ * @brief Compile-time minimum log level, one of the @c SPDLOG_LEVEL_* values.
+ *
+ * Macros below it expand to nothing, so their arguments are neither evaluated
+ * nor formatted.  Defaults to @c SPDLOG_LEVEL_TRACE in debug builds and
+ * @c SPDLOG_LEVEL_WARN otherwise; set the @c KEN_LOG_LEVEL CMake cache
+ * variable to override it.
+ */
+#ifndef KEN_LOG_LEVEL
+#ifdef KEN_DEBUG_BUILD
+#define KEN_LOG_LEVEL SPDLOG_LEVEL_TRACE
+#else
+#define KEN_LOG_LEVEL SPDLOG_LEVEL_WARN
+#endif
+#endif
+
 /** @brief Resolves to a populated `spdlog::source_loc` in debug builds, empty otherwise. */
 #ifdef KEN_DEBUG_BUILD
 #define KEN_SOURCE_LOC \
@@ -50,47 +115,118 @@ class Log {
   spdlog::source_loc {}
 #endif
 
+#define KEN_INT_LOG(logger, level, ...) (logger).log(KEN_SOURCE_LOC, level, __VA_ARGS__)
+
+#define KEN_INT_LOG_LIMITED(logger, level, ...)                                                               \
+  KEN_STMT(if ((logger).should_log(level)) {                                                                  \
+    static ::kEn::LogRateLimiter ken_int_limiter;                                                             \
+    if (const auto ken_int_suppressed = ken_int_limiter.admit()) {                                            \
+      if (*ken_int_suppressed > 0) {                                                                          \
+        (logger).log(KEN_SOURCE_LOC, level, "{} similar messages suppressed", *ken_int_suppressed);            \
+      }                                                                                                       \
+      KEN_INT_LOG(logger, level, __VA_ARGS__);                                                                \
+    }                                                                                                         \
+  })
+
+#define KEN_INT_LOG_DISABLED() static_cast<void>(0)
+
 /**
  * @defgroup core_log Engine logging macros (KEN_CORE_*)
- * Log through the engine-internal logger. Available at all build types except
- * KEN_CORE_DEBUG, which is stripped in non-debug builds.
+ * Log through the engine-internal logger.  Levels below @ref KEN_LOG_LEVEL
+ * are compiled out; KEN_CORE_DEBUG is stripped in non-debug builds by default.
+ *
+ * The @c _LIMITED variants are for call sites that may fire every frame:
+ * each such call site logs its first few messages, then one in a while
+ * together with the number it suppressed, see @ref kEn::LogRateLimiter.
  * @{
  */
-#define KEN_CORE_TRACE(...) ::kEn::Log::core_logger().log(KEN_SOURCE_LOC, spdlog::level::trace, __VA_ARGS__)
-#define KEN_CORE_INFO(...) ::kEn::Log::core_logger().log(KEN_SOURCE_LOC, spdlog::level::info, __VA_ARGS__)
-#define KEN_CORE_WARN(...) ::kEn::Log::core_logger().log(KEN_SOURCE_LOC, spdlog::level::warn, __VA_ARGS__)
-#define KEN_CORE_ERROR(...) ::kEn::Log::core_logger().log(KEN_SOURCE_LOC, spdlog::level::err, __VA_ARGS__)
-#define KEN_CORE_CRITICAL(...) ::kEn::Log::core_logger().log(KEN_SOURCE_LOC, spdlog::level::critical, __VA_ARGS__)
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+#define KEN_CORE_TRACE(...) KEN_INT_LOG(::kEn::Log::core_logger(), spdlog::level::trace, __VA_ARGS__)
+#define KEN_CORE_TRACE_LIMITED(...) KEN_INT_LOG_LIMITED(::kEn::Log::core_logger(), spdlog::level::trace, __VA_ARGS__)
+#else
+#define KEN_CORE_TRACE(...) KEN_INT_LOG_DISABLED()
+#define KEN_CORE_TRACE_LIMITED(...) KEN_INT_LOG_DISABLED()
+#endif
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define KEN_CORE_DEBUG(...) KEN_INT_LOG(::kEn::Log::core_logger(), spdlog::level::debug, __VA_ARGS__)
+#define KEN_CORE_DEBUG_LIMITED(...) KEN_INT_LOG_LIMITED(::kEn::Log::core_logger(), spdlog::level::debug, __VA_ARGS__)
+#else
+#define KEN_CORE_DEBUG(...) KEN_INT_LOG_DISABLED()
+#define KEN_CORE_DEBUG_LIMITED(...) KEN_INT_LOG_DISABLED()
+#endif
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+#define KEN_CORE_INFO(...) KEN_INT_LOG(::kEn::Log::core_logger(), spdlog::level::info, __VA_ARGS__)
+#define KEN_CORE_INFO_LIMITED(...) KEN_INT_LOG_LIMITED(::kEn::Log::core_logger(), spdlog::level::info, __VA_ARGS__)
+#else
+#define KEN_CORE_INFO(...) KEN_INT_LOG_DISABLED()
+#define KEN_CORE_INFO_LIMITED(...) KEN_INT_LOG_DISABLED()
+#endif
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_WARN
+#define KEN_CORE_WARN(...) KEN_INT_LOG(::kEn::Log::core_logger(), spdlog::level::warn, __VA_ARGS__)
+#define KEN_CORE_WARN_LIMITED(...) KEN_INT_LOG_LIMITED(::kEn::Log::core_logger(), spdlog::level::warn, __VA_ARGS__)
+#else
+#define KEN_CORE_WARN(...) KEN_INT_LOG_DISABLED()
+#define KEN_CORE_WARN_LIMITED(...) KEN_INT_LOG_DISABLED()
+#endif
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_ERROR
+#define KEN_CORE_ERROR(...) KEN_INT_LOG(::kEn::Log::core_logger(), spdlog::level::err, __VA_ARGS__)
+#define KEN_CORE_ERROR_LIMITED(...) KEN_INT_LOG_LIMITED(::kEn::Log::core_logger(), spdlog::level::err, __VA_ARGS__)
+#else
+#define KEN_CORE_ERROR(...) KEN_INT_LOG_DISABLED()
+#define KEN_CORE_ERROR_LIMITED(...) KEN_INT_LOG_DISABLED()
+#endif
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_CRITICAL
+#define KEN_CORE_CRITICAL(...) KEN_INT_LOG(::kEn::Log::core_logger(), spdlog::level::critical, __VA_ARGS__)
+#else
+#define KEN_CORE_CRITICAL(...) KEN_INT_LOG_DISABLED()
+#endif
 /** @} */
 
 /**
  * @defgroup client_log Client logging macros (KEN_*)
- * Log through the application/client logger. Available at all build types
- * except KEN_DEBUG, which is stripped in non-debug builds.
+ * Log through the application/client logger, with the same compile-time
+ * level and @c _LIMITED variants as @ref core_log.
  * @{
  */
-#define KEN_TRACE(...) ::kEn::Log::client_logger().log(KEN_SOURCE_LOC, spdlog::level::trace, __VA_ARGS__)
-#define KEN_INFO(...) ::kEn::Log::client_logger().log(KEN_SOURCE_LOC, spdlog::level::info, __VA_ARGS__)
-#define KEN_WARN(...) ::kEn::Log::client_logger().log(KEN_SOURCE_LOC, spdlog::level::warn, __VA_ARGS__)
-#define KEN_ERROR(...) ::kEn::Log::client_logger().log(KEN_SOURCE_LOC, spdlog::level::err, __VA_ARGS__)
-#define KEN_CRITICAL(...) ::kEn::Log::client_logger().log(KEN_SOURCE_LOC, spdlog::level::critical, __VA_ARGS__)
-/** @} */
-
-/**
- * @def KEN_CORE_DEBUG
- * @brief Engine debug log -- compiled out in non-debug builds.
- * @ingroup core_log
- */
-/**
- * @def KEN_DEBUG
- * @brief Client debug log -- compiled out in non-debug builds.
- * @ingroup client_log
- */
-#ifdef KEN_DEBUG_BUILD
-#define KEN_CORE_DEBUG(...) ::kEn::Log::core_logger().log(KEN_SOURCE_LOC, spdlog::level::debug, __VA_ARGS__)
-#define KEN_DEBUG(...) ::kEn::Log::client_logger().log(KEN_SOURCE_LOC, spdlog::level::debug, __VA_ARGS__)
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+#define KEN_TRACE(...) KEN_INT_LOG(::kEn::Log::client_logger(), spdlog::level::trace, __VA_ARGS__)
+#define KEN_TRACE_LIMITED(...) KEN_INT_LOG_LIMITED(::kEn::Log::client_logger(), spdlog::level::trace, __VA_ARGS__)
+#else
+#define KEN_TRACE(...) KEN_INT_LOG_DISABLED()
+#define KEN_TRACE_LIMITED(...) KEN_INT_LOG_DISABLED()
+#endif
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define KEN_DEBUG(...) KEN_INT_LOG(::kEn::Log::client_logger(), spdlog::level::debug, __VA_ARGS__)
+#define KEN_DEBUG_LIMITED(...) KEN_INT_LOG_LIMITED(::kEn::Log::client_logger(), spdlog::level::debug, __VA_ARGS__)
+#else
+#define KEN_DEBUG(...) KEN_INT_LOG_DISABLED()
+#define KEN_DEBUG_LIMITED(...) KEN_INT_LOG_DISABLED()
+#endif
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+#define KEN_INFO(...) KEN_INT_LOG(::kEn::Log::client_logger(), spdlog::level::info, __VA_ARGS__)
+#define KEN_INFO_LIMITED(...) KEN_INT_LOG_LIMITED(::kEn::Log::client_logger(), spdlog::level::info, __VA_ARGS__)
 #else
-#define KEN_CORE_DEBUG(...)
-#define KEN_DEBUG(...)
+#define KEN_INFO(...) KEN_INT_LOG_DISABLED()
+#define KEN_INFO_LIMITED(...) KEN_INT_LOG_DISABLED()
 #endif
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_WARN
+#define KEN_WARN(...) KEN_INT_LOG(::kEn::Log::client_logger(), spdlog::level::warn, __VA_ARGS__)
+#define KEN_WARN_LIMITED(...) KEN_INT_LOG_LIMITED(::kEn::Log::client_logger(), spdlog::level::warn, __VA_ARGS__)
+#else
+#define KEN_WARN(...) KEN_INT_LOG_DISABLED()
+#define KEN_WARN_LIMITED(...) KEN_INT_LOG_DISABLED()
+#endif
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_ERROR
+#define KEN_ERROR(...) KEN_INT_LOG(::kEn::Log::client_logger(), spdlog::level::err, __VA_ARGS__)
+#define KEN_ERROR_LIMITED(...) KEN_INT_LOG_LIMITED(::kEn::Log::client_logger(), spdlog::level::err, __VA_ARGS__)
+#else
+#define KEN_ERROR(...) KEN_INT_LOG_DISABLED()
+#define KEN_ERROR_LIMITED(...) KEN_INT_LOG_DISABLED()
+#endif
+#if KEN_LOG_LEVEL <= SPDLOG_LEVEL_CRITICAL
+#define KEN_CRITICAL(...) KEN_INT_LOG(::kEn::Log::client_logger(), spdlog::level::critical, __VA_ARGS__)
+#else
+#define KEN_CRITICAL(...) KEN_INT_LOG_DISABLED()
+#endif
+/** @} */
 // NOLINTEND(cppcoreguidelines-macro-usage)
@@ -0,0 +1,223 @@
+#include "memory_tracker.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/core/log.hpp>
+
+namespace kEn {
+
+namespace {
+
+constexpr std::string_view kUnnamed = "(unnamed)";
+
+struct StringHash {
+  using is_transparent = void;
+  [[nodiscard]] std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+};
+
+struct CategoryUsage {
+  MemoryStats total;
+  std::unordered_map<std::string, MemoryStats, StringHash, std::equal_to<>> names;
+  std::size_t budget   = 0;  ///< 0 for none.
+  std::size_t overruns = 0;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::array<CategoryUsage, std::to_underlying(MemoryCategory::Count)> categories;
+};
+
+Registry& registry() {
+  // Leaked on purpose: resources in static storage are released during static destruction.
+  static auto* const kRegistry = new Registry();  // NOLINT(cppcoreguidelines-owning-memory)
+  return *kRegistry;
+}
+
+void add(MemoryStats& stats, std::size_t bytes) {
+  stats.bytes += bytes;
+  stats.peak = std::max(stats.peak, stats.bytes);
+  ++stats.allocations;
+}
+
+void remove(MemoryStats& stats, std::size_t bytes) {
+  KEN_CORE_ASSERT(stats.bytes >= bytes && stats.allocations > 0, "Released more memory than was allocated");
+  stats.bytes -= bytes;
+  --stats.allocations;
+}
+
+}  // namespace
+
+void MemoryTracker::allocate(MemoryCategory category, std::string_view name, std::size_t bytes) {
+  if (name.empty()) {
+    name = kUnnamed;
+  }
+
+  std::size_t budget = 0;
+  std::size_t usage  = 0;
+  {
+    auto& reg = registry();
+    const std::scoped_lock lock(reg.mutex);
+    auto& category_usage = reg.categories[std::to_underlying(category)];
+    add(category_usage.total, bytes);
+
+    auto it = category_usage.names.find(name);
+    if (it == category_usage.names.end()) {
+      it = category_usage.names.emplace(std::string(name), MemoryStats{}).first;
+    }
+    add(it->second, bytes);
+
+    if (category_usage.budget == 0 || category_usage.total.bytes <= category_usage.budget) {
+      return;
+    }
+    ++category_usage.overruns;
+    if (category_usage.total.bytes - bytes > category_usage.budget) {
+      return;  // Already over budget before; only the allocation that crossed it is logged.
+    }
+    budget = category_usage.budget;
+    usage  = category_usage.total.bytes;
+  }
+  KEN_CORE_WARN("{} memory is over budget: {} of {} bytes after allocating {} bytes for {}",
+                memory_category::name(category), usage, budget, bytes, name);
+}
+
+void MemoryTracker::release(MemoryCategory category, std::string_view name, std::size_t bytes) {
+  if (name.empty()) {
+    name = kUnnamed;
+  }
+
+  auto& reg = registry();
+  const std::scoped_lock lock(reg.mutex);
+  auto& usage = reg.categories[std::to_underlying(category)];
+  remove(usage.total, bytes);
+
+  const auto it = usage.names.find(name);
+  KEN_CORE_ASSERT(it != usage.names.end(), "Released memory under a name that never allocated");
+  remove(it->second, bytes);
+}
+
+MemoryStats MemoryTracker::stats(MemoryCategory category) {
+  auto& reg = registry();
+  const std::scoped_lock lock(reg.mutex);
+  return reg.categories[std::to_underlying(category)].total;
+}
+
+MemoryStats MemoryTracker::total(bool gpu) {
+  auto& reg = registry();
+  const std::scoped_lock lock(reg.mutex);
+
+  MemoryStats sum;
+  for (std::size_t i = 0; i < reg.categories.size(); ++i) {
+    if (memory_category::is_gpu(static_cast<MemoryCategory>(i)) != gpu) {
+      continue;
+    }
+    const MemoryStats& stats = reg.categories[i].total;
+    sum.bytes += stats.bytes;
+    sum.peak += stats.peak;
+    sum.allocations += stats.allocations;
+  }
+  return sum;
+}
+
+std::vector<NamedMemoryStats> MemoryTracker::by_name(MemoryCategory category) {
+  std::vector<NamedMemoryStats> result;
+  {
+    auto& reg = registry();
+    const std::scoped_lock lock(reg.mutex);
+    const auto& names = reg.categories[std::to_underlying(category)].names;
+    result.reserve(names.size());
+    for (const auto& [name, stats] : names) {
+      result.push_back({.name = name, .stats = stats});
+    }
+  }
+
+  std::ranges::sort(result, [](const NamedMemoryStats& a, const NamedMemoryStats& b) {
+    return a.stats.bytes != b.stats.bytes ? a.stats.bytes > b.stats.bytes : a.stats.peak > b.stats.peak;
+  });
+  return result;
+}
+
+void MemoryTracker::reset_peaks() {
+  auto& reg = registry();
+  const std::scoped_lock lock(reg.mutex);
+  for (auto& usage : reg.categories) {
+    usage.total.peak = usage.total.bytes;
+    for (auto& [name, stats] : usage.names) {
+      stats.peak = stats.bytes;
+    }
+  }
+}
+
+void MemoryTracker::set_budget(MemoryCategory category, std::size_t bytes) {
+  auto& reg = registry();
+  const std::scoped_lock lock(reg.mutex);
+  auto& usage    = reg.categories[std::to_underlying(category)];
+  usage.budget   = bytes;
+  usage.overruns = 0;
+}
+
+std::size_t MemoryTracker::budget(MemoryCategory category) {
+  auto& reg = registry();
+  const std::scoped_lock lock(reg.mutex);
+  return reg.categories[std::to_underlying(category)].budget;
+}
+
+std::size_t MemoryTracker::overruns(MemoryCategory category) {
+  auto& reg = registry();
+  const std::scoped_lock lock(reg.mutex);
+  return reg.categories[std::to_underlying(category)].overruns;
+}
+
+// ---------------- //
+
+TrackedMemory::TrackedMemory(MemoryCategory category, std::string name, std::size_t bytes)
+    : category_(category), name_(std::move(name)), bytes_(bytes) {
+  MemoryTracker::allocate(category_, name_, bytes_);
+}
+
+TrackedMemory::~TrackedMemory() {
+  if (category_ != MemoryCategory::Count) {
+    MemoryTracker::release(category_, name_, bytes_);
+  }
+}
+
+TrackedMemory::TrackedMemory(TrackedMemory&& other) noexcept
+    : category_(std::exchange(other.category_, MemoryCategory::Count)),
+      name_(std::move(other.name_)),
+      bytes_(std::exchange(other.bytes_, 0)) {}
+
+TrackedMemory& TrackedMemory::operator=(TrackedMemory&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  if (category_ != MemoryCategory::Count) {
+    MemoryTracker::release(category_, name_, bytes_);
+  }
+  category_ = std::exchange(other.category_, MemoryCategory::Count);
+  name_     = std::move(other.name_);
+  bytes_    = std::exchange(other.bytes_, 0);
+  return *this;
+}
+
+void TrackedMemory::resize(std::size_t bytes) {
+  KEN_CORE_ASSERT(category_ != MemoryCategory::Count, "Resizing an empty TrackedMemory");
+  if (bytes == bytes_) {
+    return;
+  }
+  // Counted as a reallocation: the old block is gone, a new one takes its place.
+  MemoryTracker::release(category_, name_, bytes_);
+  bytes_ = bytes;
+  MemoryTracker::allocate(category_, name_, bytes_);
+}
+
+}  // namespace kEn
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <kEn/util/enum_map.hpp>
+
+/** @file
+ *  @ingroup ken
+ *
+ *  Memory accounting of device resources and of the engine's large CPU-side
+ *  containers.
+ */
+
+namespace kEn {
+
+/** @brief What a tracked allocation holds. */
+enum class MemoryCategory : std::uint8_t {
+  Buffer,        /**< GPU buffers. */
+  Texture,       /**< GPU textures. */
+  Framebuffer,   /**< GPU framebuffer attachments. */
+  TriangleBvh,   /**< CPU triangle copies and hierarchies used for picking. */
+  Profiler,      /**< CPU rings of the profiler. */
+  CommandStream, /**< CPU commands and payload recorded by the null backend. */
+  Count,
+};
+
+/** @brief Convenience namespace that imports all @ref MemoryCategory enumerators. */
+namespace memory_category {
+
+using enum MemoryCategory;
+
+namespace detail {
+
+inline constexpr auto kNames = util::make_enum_map<std::string_view>({
+    std::pair{Buffer, std::string_view{"Buffers"}},
+    std::pair{Texture, std::string_view{"Textures"}},
+    std::pair{Framebuffer, std::string_view{"Framebuffers"}},
+    std::pair{TriangleBvh, std::string_view{"Triangle BVHs"}},
+    std::pair{Profiler, std::string_view{"Profiler"}},
+    std::pair{CommandStream, std::string_view{"Command stream"}},
+});
+
+}  // namespace detail
+
+/** @brief Human-readable name of @p category. */
+[[nodiscard]] constexpr std::string_view name(MemoryCategory category) { return detail::kNames[category]; }
+
+/** @brief Whether @p category lives in GPU memory. */
+[[nodiscard]] constexpr bool is_gpu(MemoryCategory category) {
+  return category == Buffer || category == Texture || category == Framebuffer;
+}
+
+}  // namespace memory_category
+
+/** @brief Usage of one category or one name. */
+struct MemoryStats {
+  std::size_t bytes       = 0; /**< Bytes currently allocated. */
+  std::size_t peak        = 0; /**< Most bytes allocated at once since start or @ref MemoryTracker::reset_peaks. */
+  std::size_t allocations = 0; /**< Live allocations. */
+};
+
+/** @brief Usage under one debug name within a category. */
+struct NamedMemoryStats {
+  std::string name;
+  MemoryStats stats;
+};
+
+/**
+ * @brief Process-wide byte counters per @ref MemoryCategory and per debug name.
+ *
+ * Resources report their allocations through a @ref TrackedMemory member, so
+ * the counters always match what is alive.  The tracker only counts what it is
+ * told: GPU sizes are computed from the resource descriptors and ignore
+ * driver padding.  All functions are thread-safe.
+ *
+ * A category can be given a budget with @ref set_budget.  Allocations that
+ * leave the category above it still succeed, but are counted as overruns and
+ * the first one after the category was last within its budget is logged, e.g.
+ * @code
+ * MemoryTracker::set_budget(MemoryCategory::Texture, 256ULL << 20);
+ * // ... load a scene ...
+ * KEN_CORE_ASSERT(MemoryTracker::overruns(MemoryCategory::Texture) == 0);
+ * @endcode
+ */
+class MemoryTracker {
+ public:
+  /** @brief Adds @p bytes to @p category and to @p name within it. */
+  static void allocate(MemoryCategory category, std::string_view name, std::size_t bytes);
+  /** @brief Removes @p bytes previously added under the same @p category and @p name. */
+  static void release(MemoryCategory category, std::string_view name, std::size_t bytes);
+
+  [[nodiscard]] static MemoryStats stats(MemoryCategory category);
+  /** @brief Sum over every GPU or every CPU category; the peak is the sum of the categories' peaks. */
+  [[nodiscard]] static MemoryStats total(bool gpu);
+
+  /** @brief Usage of every name that was ever allocated in @p category, largest first. */
+  [[nodiscard]] static std::vector<NamedMemoryStats> by_name(MemoryCategory category);
+
+  /** @brief Sets every high-water mark to the current usage. */
+  static void reset_peaks();
+
+  /** @brief Limits @p category to @p bytes, 0 for no limit, and restarts its count of @ref overruns. */
+  static void set_budget(MemoryCategory category, std::size_t bytes);
+  /** @brief Budget of @p category, 0 if it has none. */
+  [[nodiscard]] static std::size_t budget(MemoryCategory category);
+  /** @brief Allocations that left @p category above its budget since the budget was set. */
+  [[nodiscard]] static std::size_t overruns(MemoryCategory category);
+};
+
+/**
+ * @brief RAII registration of one allocation with the @ref MemoryTracker.
+ *
+ * Move-only.  A default-constructed instance tracks nothing.
+ */
+class TrackedMemory {
+ public:
+  TrackedMemory() = default;
+  /** @param name Debug name; unnamed allocations are grouped under "(unnamed)". */
+  TrackedMemory(MemoryCategory category, std::string name, std::size_t bytes);
+  ~TrackedMemory();
+
+  TrackedMemory(const TrackedMemory&)            = delete;
+  TrackedMemory& operator=(const TrackedMemory&) = delete;
+  TrackedMemory(TrackedMemory&& other) noexcept;
+  TrackedMemory& operator=(TrackedMemory&& other) noexcept;
+
+  /** @brief Changes the tracked size to @p bytes, e.g. after a reallocation. */
+  void resize(std::size_t bytes);
+
+  [[nodiscard]] std::size_t bytes() const { return bytes_; }
+
+ private:
+  MemoryCategory category_ = MemoryCategory::Count;
+  std::string name_;
+  std::size_t bytes_ = 0;
+};
+
+}  // namespace kEn
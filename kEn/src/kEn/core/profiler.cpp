@@ -0,0 +1,280 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <kEn/core/log.hpp>
+#include <kEn/core/memory_tracker.hpp>
+
+namespace kEn {
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+const clock::time_point kEpoch = clock::now();
+
+/** @brief Ring slot; atomic so that readers may copy it while the owner overwrites it. */
+struct Slot {
+  std::atomic<const char*> name{nullptr};
+  std::atomic<std::int64_t> begin{0};
+  std::atomic<std::int64_t> end{0};
+  std::atomic<std::uint32_t> depth{0};
+};
+
+struct ThreadRing {
+  explicit ThreadRing(std::uint32_t id)
+      : id(id),
+        name(std::format("Thread {}", id)),
+        slots(std::make_unique<Slot[]>(Profiler::kRingCapacity)),
+        memory(MemoryCategory::Profiler, "Rings", Profiler::kRingCapacity * sizeof(Slot)) {}
+
+  std::uint32_t id;
+  std::string name;              ///< Guarded by Registry::mutex.
+  std::unique_ptr<Slot[]> slots;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  std::atomic<std::uint64_t> written{0};  ///< Number of events ever recorded; slot of event i is i % capacity.
+  std::uint32_t depth = 0;                ///< Open scopes; owner only.
+  TrackedMemory memory;
+};
+
+/**
+ * @brief Every ring ever registered.
+ *
+ * Rings are never removed and their slots in @c rings never change once filled, so a thread that was handed a ring or
+ * a track id reads its slot without the mutex.
+ */
+struct Registry {
+  std::mutex mutex;  ///< Guards registration and the ring names, not the rings' contents.
+  std::array<std::unique_ptr<ThreadRing>, Profiler::kMaxTracks> rings;
+  std::uint32_t ring_count = 0;
+
+  std::array<std::int64_t, Profiler::kFrameHistory> frame_ring{};  ///< Main thread only.
+  std::size_t frame_count = 0;                                     ///< Main thread only.
+};
+
+Registry& registry() {
+  // Leaked on purpose: threads still running during static destruction keep recording into it.
+  static auto* const kRegistry = new Registry();  // NOLINT(cppcoreguidelines-owning-memory)
+  return *kRegistry;
+}
+
+/**
+ * @brief Allocates a ring with the next id, or returns @c nullptr once @ref Profiler::kMaxTracks rings exist.
+ * @pre The registry's mutex is held.
+ */
+ThreadRing* add_ring(Registry& reg, std::string_view name) {
+  if (reg.ring_count == Profiler::kMaxTracks) {
+    KEN_CORE_WARN("Profiler is out of rings, {} is not recorded", name);
+    return nullptr;
+  }
+  auto& ring = reg.rings[reg.ring_count];
+  ring       = std::make_unique<ThreadRing>(reg.ring_count++);
+  ring->name = name;
+  return ring.get();
+}
+
+/** @brief Ring of the calling thread, @c nullptr until the thread is named with @ref Profiler::set_thread_name. */
+ThreadRing*& this_ring() noexcept {
+  thread_local ThreadRing* ring = nullptr;
+  return ring;
+}
+
+/**
+ * @brief Appends @p event to @p ring; only the ring's single writer may call this.
+ *
+ * The slot written holds the oldest event, which readers therefore never copy. The fence orders the previous
+ * update of @c written before the new slot contents: a reader that sees any of them also sees that update.
+ */
+void push_event(ThreadRing& ring, const ProfileEvent& event) noexcept {
+  const std::uint64_t index = ring.written.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  Slot& slot = ring.slots[index % Profiler::kRingCapacity];
+  slot.name.store(event.name, std::memory_order_relaxed);
+  slot.begin.store(event.begin, std::memory_order_relaxed);
+  slot.end.store(event.end, std::memory_order_relaxed);
+  slot.depth.store(event.depth, std::memory_order_relaxed);
+  ring.written.store(index + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Copies the events of @p ring that overlap [@p from, @p to] into @p out, in completion order.
+ *
+ * Walks back from the newest event, which is possible because events complete, and are therefore stored, in the
+ * order of their end timestamps.  At most @c kRingCapacity - 1 events are copied, as the writer may be filling the
+ * slot of the oldest one; events whose slots were reused while they were copied are dropped.
+ */
+void copy_ring(const ThreadRing& ring, std::int64_t from, std::int64_t to, std::vector<ProfileEvent>& out) {
+  constexpr std::uint64_t kCapacity = Profiler::kRingCapacity;
+  constexpr std::uint64_t kWindow   = kCapacity - 1;
+  out.clear();
+
+  const std::uint64_t written = ring.written.load(std::memory_order_acquire);
+  const std::uint64_t oldest  = written > kWindow ? written - kWindow : 0;
+  for (std::uint64_t i = written; i > oldest; --i) {
+    const Slot& slot = ring.slots[(i - 1) % kCapacity];
+    const ProfileEvent event{.name  = slot.name.load(std::memory_order_relaxed),
+                             .begin = slot.begin.load(std::memory_order_relaxed),
+                             .end   = slot.end.load(std::memory_order_relaxed),
+                             .depth = slot.depth.load(std::memory_order_relaxed)};
+    if (event.end < from) {
+      break;
+    }
+    out.push_back(event);
+  }
+
+  // out[k] came from event written - 1 - k; anything older than the ring's current window may have been overwritten.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const std::uint64_t now_written = ring.written.load(std::memory_order_relaxed);
+  const std::uint64_t valid_from  = now_written > kWindow ? now_written - kWindow : 0;
+  if (valid_from > oldest) {
+    out.resize(std::min<std::uint64_t>(out.size(), written > valid_from ? written - valid_from : 0));
+  }
+
+  std::erase_if(out, [to](const ProfileEvent& event) { return event.begin > to; });
+  std::ranges::reverse(out);
+}
+
+void write_json_string(std::ofstream& out, std::string_view text) {
+  out << '"';
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << std::format("\\u{:04x}", static_cast<unsigned>(c));
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+}  // namespace
+
+std::int64_t Profiler::now() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - kEpoch).count();
+}
+
+void Profiler::set_thread_name(std::string_view name) {
+  auto& reg = registry();
+  const std::scoped_lock lock(reg.mutex);
+  ThreadRing*& ring = this_ring();
+  if (ring == nullptr) {
+    ring = add_ring(reg, name);
+  } else {
+    ring->name = name;
+  }
+}
+
+std::int64_t Profiler::begin_scope() noexcept {
+  if (ThreadRing* ring = this_ring()) {
+    ++ring->depth;
+  }
+  return now();
+}
+
+void Profiler::end_scope(const char* name, std::int64_t begin) noexcept {
+  const std::int64_t end = now();
+  ThreadRing* ring       = this_ring();
+  if (ring == nullptr) {
+    return;
+  }
+  --ring->depth;
+  push_event(*ring, {.name = name, .begin = begin, .end = end, .depth = ring->depth});
+}
+
+std::uint32_t Profiler::add_track(std::string_view name) {
+  auto& reg = registry();
+  const std::scoped_lock lock(reg.mutex);
+  const ThreadRing* ring = add_ring(reg, name);
+  return ring != nullptr ? ring->id : kMaxTracks;
+}
+
+void Profiler::record(std::uint32_t track, const ProfileEvent& event) noexcept {
+  if (track < kMaxTracks) {
+    push_event(*registry().rings[track], event);
+  }
+}
+
+void Profiler::mark_frame() noexcept {
+  auto& reg              = registry();
+  const std::size_t slot = reg.frame_count++ % kFrameHistory;
+  reg.frame_ring[slot]   = now();
+}
+
+std::vector<std::int64_t> Profiler::frame_starts() {
+  const auto& reg         = registry();
+  const std::size_t count = std::min(reg.frame_count, kFrameHistory);
+  std::vector<std::int64_t> starts;
+  starts.reserve(count);
+  for (std::size_t i = reg.frame_count - count; i < reg.frame_count; ++i) {
+    starts.push_back(reg.frame_ring[i % kFrameHistory]);
+  }
+  return starts;
+}
+
+void Profiler::collect(std::int64_t from, std::int64_t to, std::vector<ProfileThread>& threads) {
+  auto& reg = registry();
+  const std::scoped_lock lock(reg.mutex);
+
+  threads.resize(reg.ring_count);
+  for (std::size_t i = 0; i < reg.ring_count; ++i) {
+    const ThreadRing& ring = *reg.rings[i];
+    threads[i].name        = ring.name;
+    threads[i].id          = ring.id;
+    copy_ring(ring, from, to, threads[i].events);
+  }
+}
+
+bool Profiler::write_chrome_trace(const std::filesystem::path& path) {
+  std::vector<ProfileThread> threads;
+  collect(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(), threads);
+
+  std::ofstream out(path, std::ios::trunc);
+  out << R"({"displayTimeUnit": "ns", "traceEvents": [)";
+  bool first = true;
+  const auto separator = [&] {
+    out << (first ? "\n" : ",\n");
+    first = false;
+  };
+
+  std::size_t count = 0;
+  for (const auto& thread : threads) {
+    separator();
+    out << std::format(R"({{"name": "thread_name", "ph": "M", "pid": 1, "tid": {}, "args": {{"name": )", thread.id);
+    write_json_string(out, thread.name);
+    out << "}}";
+
+    for (const auto& event : thread.events) {
+      separator();
+      out << R"({"name": )";
+      write_json_string(out, event.name);
+      out << std::format(R"(, "cat": "kEn", "ph": "X", "pid": 1, "tid": {}, "ts": {:.3f}, "dur": {:.3f}}})", thread.id,
+                         static_cast<double>(event.begin) / 1000.0,
+                         static_cast<double>(event.end - event.begin) / 1000.0);
+    }
+    count += thread.events.size();
+  }
+  out << "\n]}\n";
+
+  if (!out) {
+    KEN_CORE_ERROR("Failed to write profile trace {}", path.string());
+    return false;
+  }
+  KEN_CORE_INFO("Wrote {} profile events from {} threads to {}", count, threads.size(), path.string());
+  return true;
+}
+
+}  // namespace kEn
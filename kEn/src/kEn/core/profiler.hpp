@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <kEn/core/core.hpp>
+
+/** @file
+ *  @ingroup ken
+ *
+ *  Scoped CPU profiler.
+ *
+ *  @ref KEN_PROFILE_SCOPE and @ref KEN_PROFILE_FUNCTION time the enclosing
+ *  scope.  Every thread named with @ref KEN_PROFILE_THREAD records its finished
+ *  scopes with nanosecond begin and end timestamps into a ring buffer of its
+ *  own, allocated when the thread is named, so recording takes no lock and
+ *  never allocates; once a ring is full its oldest scopes are overwritten.
+ *  Scopes of threads that were never named are not recorded.
+ *  The rings are read for the live timeline of the DebugLayer and for
+ *  Chrome/Perfetto trace export (@ref Profiler::write_chrome_trace).
+ *
+ *  The @c KEN_PROFILE_* macros compile to nothing unless @c KEN_ENABLE_PROFILING
+ *  is defined (CMake option of the same name, on by default).
+ */
+
+namespace kEn {
+
+/** @brief One finished profile scope. */
+struct ProfileEvent {
+  const char* name;    /**< Static string passed to the scope. */
+  std::int64_t begin;  /**< Timestamp, see @ref Profiler::now. */
+  std::int64_t end;    /**< Timestamp, see @ref Profiler::now. */
+  std::uint32_t depth; /**< Number of scopes the event is nested in on its thread. */
+};
+
+/** @brief Events of one thread or track, as returned by @ref Profiler::collect. */
+struct ProfileThread {
+  std::string name;
+  std::uint32_t id = 0; /**< Stable index of the thread or track in the profiler, used as the trace's tid. */
+  std::vector<ProfileEvent> events; /**< In order of completion, so children come before their parents. */
+};
+
+/**
+ * @brief Process-wide registry of the per-thread profile rings.
+ *
+ * Only the owning thread writes to a ring.  Readers copy a ring while it is
+ * written and drop whatever was overwritten during the copy, so neither side
+ * waits for the other.  Rings of exited threads stay readable.
+ *
+ * Besides threads, the profiler holds tracks: rings that other timelines,
+ * such as GPU timings, record already finished events into.
+ */
+class Profiler {
+ public:
+  /** @brief Number of events each thread's ring holds. */
+  static constexpr std::size_t kRingCapacity = std::size_t{1} << 14;
+  /** @brief Number of frame starts kept for @ref frame_starts. */
+  static constexpr std::size_t kFrameHistory = 128;
+  /** @brief Maximum number of named threads and tracks; further ones are not recorded. */
+  static constexpr std::uint32_t kMaxTracks = 256;
+
+  /** @brief Nanoseconds since the profiler's epoch on a steady clock. */
+  [[nodiscard]] static std::int64_t now() noexcept;
+
+  /** @brief Names the calling thread in the timeline and in traces and starts recording its scopes. */
+  static void set_thread_name(std::string_view name);
+
+  /** @brief Opens a scope on the calling thread and returns its begin timestamp. */
+  [[nodiscard]] static std::int64_t begin_scope() noexcept;
+  /** @brief Closes the innermost open scope of the calling thread and records it. */
+  static void end_scope(const char* name, std::int64_t begin) noexcept;
+
+  /** @brief Adds a timeline that is not a thread and returns its id for @ref record, @ref kMaxTracks if full. */
+  [[nodiscard]] static std::uint32_t add_track(std::string_view name);
+  /** @brief Records a finished event on @p track.  Only one thread may record to a track. */
+  static void record(std::uint32_t track, const ProfileEvent& event) noexcept;
+
+  /** @brief Marks the start of a frame, see @ref KEN_PROFILE_FRAME.  Only the main thread may call this. */
+  static void mark_frame() noexcept;
+  /** @brief Starts of the last @ref kFrameHistory frames, oldest first.  Only meaningful on the main thread. */
+  [[nodiscard]] static std::vector<std::int64_t> frame_starts();
+
+  /**
+   * @brief Copy out the events of every thread that overlap [@p from, @p to].
+   * @param from     Start of the window, see @ref now.
+   * @param to       End of the window, see @ref now.
+   * @param threads  Receives one entry per thread that ever recorded and per track; reuses its allocations.
+   */
+  static void collect(std::int64_t from, std::int64_t to, std::vector<ProfileThread>& threads);
+
+  /**
+   * @brief Write every buffered event as Chrome trace JSON, viewable in chrome://tracing and Perfetto.
+   * @param path Output file.
+   * @return @c false if the file could not be written (logged).
+   */
+  static bool write_chrome_trace(const std::filesystem::path& path);
+};
+
+/** @brief RAII scope timer behind @ref KEN_PROFILE_SCOPE. */
+class ProfileScope {
+ public:
+  /** @param name Static string; only the pointer is stored. */
+  explicit ProfileScope(const char* name) noexcept : name_(name), begin_(Profiler::begin_scope()) {}
+  ~ProfileScope() { Profiler::end_scope(name_, begin_); }
+
+  DELETE_COPY_MOVE(ProfileScope);
+
+ private:
+  const char* name_;
+  std::int64_t begin_;
+};
+
+}  // namespace kEn
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define KEN_INT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define KEN_INT_PROFILE_CONCAT(a, b) KEN_INT_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef KEN_ENABLE_PROFILING
+/** @brief Times the rest of the enclosing scope under @p name, a string literal or other static string. */
+#define KEN_PROFILE_SCOPE(name) \
+  const ::kEn::ProfileScope KEN_INT_PROFILE_CONCAT(ken_profile_scope_, __LINE__)(name)
+/** @brief Times the rest of the enclosing function under its signature. */
+#define KEN_PROFILE_FUNCTION() KEN_PROFILE_SCOPE(std::source_location::current().function_name())
+/** @brief Marks the start of a frame on the main thread, for the DebugLayer timeline. */
+#define KEN_PROFILE_FRAME() ::kEn::Profiler::mark_frame()
+/** @brief Names the calling thread and starts recording its scopes; @p name may be any string. */
+#define KEN_PROFILE_THREAD(name) ::kEn::Profiler::set_thread_name(name)
+#else
+#define KEN_PROFILE_SCOPE(name) ((void)0)
+#define KEN_PROFILE_FUNCTION() ((void)0)
+#define KEN_PROFILE_FRAME() ((void)0)
+#define KEN_PROFILE_THREAD(name) ((void)0)
+#endif
+// NOLINTEND(cppcoreguidelines-macro-usage)
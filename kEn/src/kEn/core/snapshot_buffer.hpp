@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include <kEn/core/core.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+/**
+ * @brief Lock-free hand-off of the latest value from one producer thread to one consumer thread.
+ *
+ * The producer fills @ref write() and calls @ref publish(); the consumer calls
+ * @ref acquire() and reads @ref read().  Each side always owns one slot of its
+ * own and the third slot holds the most recently published value, so neither
+ * side ever waits for the other or sees a value while it is being written.
+ * A value published before the consumer got to the previous one replaces it.
+ *
+ * Slots are reused: after @ref publish() the producer gets back an older
+ * value, which it must reset before filling.  Keeping the slots around lets
+ * values such as vectors keep their capacity from one round to the next.
+ *
+ * @tparam T Value type; default constructible.
+ */
+template <typename T>
+class SnapshotBuffer {
+ public:
+  SnapshotBuffer() = default;
+
+  DELETE_COPY_MOVE(SnapshotBuffer);
+
+  /** @brief Slot owned by the producer.  Only the producer may call this. */
+  [[nodiscard]] T& write() noexcept { return slots_[write_]; }
+
+  /** @brief Make the write slot the latest value and take back an unused slot.  Only the producer may call this. */
+  void publish() noexcept {
+    const auto published        = static_cast<std::uint8_t>(write_ | kFresh);
+    const std::uint8_t previous = ready_.exchange(published, std::memory_order_acq_rel);
+    write_                      = static_cast<std::uint8_t>(previous & kIndexMask);
+  }
+
+  /**
+   * @brief Take the latest published value, if there is one the consumer has not seen yet.  Only the consumer may
+   *        call this.
+   * @return @c true if @ref read() now returns a newer value.
+   */
+  bool acquire() noexcept {
+    if ((ready_.load(std::memory_order_relaxed) & kFresh) == 0) {
+      return false;
+    }
+    const std::uint8_t previous = ready_.exchange(read_, std::memory_order_acq_rel);
+    read_                       = static_cast<std::uint8_t>(previous & kIndexMask);
+    return true;
+  }
+
+  /** @brief Slot owned by the consumer: the value taken by the last successful @ref acquire(). */
+  [[nodiscard]] const T& read() const noexcept { return slots_[read_]; }
+  /** @copydoc read() const */
+  [[nodiscard]] T& read() noexcept { return slots_[read_]; }
+
+ private:
+  static constexpr std::uint8_t kIndexMask = 0x3U;
+  static constexpr std::uint8_t kFresh     = 0x4U;  ///< Set while the ready slot holds an unread value.
+
+  std::array<T, 3> slots_{};
+  std::uint8_t write_ = 0;
+  std::uint8_t read_  = 1;
+  std::atomic<std::uint8_t> ready_{2};
+};
+
+}  // namespace kEn
@@ -0,0 +1,46 @@
+#include "task.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <kEn/core/application.hpp>
+#include <kEn/core/job_system.hpp>
+#include <kEn/core/profiler.hpp>
+
+namespace kEn {
+
+void ResumeOnWorker::await_suspend(std::coroutine_handle<> handle) const {
+  JobSystem::run_detached([handle] { handle.resume(); }, name);
+}
+
+bool ResumeOnMainThread::await_ready() const noexcept { return Application::instance().on_main_thread(); }
+
+void ResumeOnMainThread::await_suspend(std::coroutine_handle<> handle) const {
+  Application::instance().run_on_main_thread([handle] { handle.resume(); });
+}
+
+Task<std::vector<std::byte>> read_file(std::filesystem::path path) {
+  co_await resume_on_worker("read_file");
+  KEN_PROFILE_SCOPE("read_file");
+
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    throw std::runtime_error(std::format("Cannot open {}", path.string()));
+  }
+
+  std::vector<std::byte> bytes(static_cast<std::size_t>(in.tellg()));
+  in.seekg(0);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (!in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+    throw std::runtime_error(std::format("Cannot read {}", path.string()));
+  }
+  co_return bytes;
+}
+
+}  // namespace kEn
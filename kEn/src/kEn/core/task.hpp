@@ -0,0 +1,279 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <kEn/core/assert.hpp>
+
+/** @file
+ *  @ingroup ken
+ *
+ *  Coroutine tasks for asynchronous work such as asset loading.
+ *
+ *  A @ref Task is a coroutine that hops between threads with
+ *  <tt>co_await resume_on_worker()</tt> and
+ *  <tt>co_await resume_on_main_thread()</tt>: decode and other CPU work runs
+ *  on the @ref JobSystem, while anything touching the graphics context runs
+ *  on the main thread at the start of a frame.
+ *
+ *  @code
+ *  Task<std::shared_ptr<Texture>> load(std::filesystem::path path) {
+ *    co_await resume_on_worker();
+ *    auto image = Image::load(path, TextureFormat::RGBA8);  // off the main thread
+ *    co_await resume_on_main_thread();
+ *    co_return device().create_texture(path, *image, {}, kFullMipChain);
+ *  }
+ *  @endcode
+ */
+
+namespace kEn {
+
+template <typename T>
+class Task;
+
+namespace detail {
+
+/** @brief Part of a task's promise that does not depend on its result type. */
+class TaskPromiseBase {
+ public:
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+
+  /** @brief Publishes completion, then continues the awaiting coroutine, if it has already suspended. */
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+      TaskPromiseBase& promise                    = handle.promise();
+      const std::coroutine_handle<> continue_with = promise.continuation_;
+      // The frame may be destroyed by a polling thread or by the awaiting coroutine as soon as it learns that the task
+      // finished; touch nothing after the store or the exchange that tells it.
+      promise.completed_.store(true, std::memory_order_release);
+      if (continue_with && promise.rendezvous_.exchange(true, std::memory_order_acq_rel)) {
+        return continue_with;
+      }
+      return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+
+  /**
+   * @brief Runs the task on behalf of @p continuation until it finishes or first suspends.
+   * @return Whether @p continuation must suspend; if not, the task finished and @p continuation goes on inline.
+   *
+   * Resuming the awaiting coroutine of a task that finishes synchronously from its final suspend point would rely on
+   * the compiler turning the transfer into a tail call, which e.g. GCC does not do without optimizations; a loop of
+   * such awaits would then grow the stack without bound.
+   */
+  bool start_awaited(std::coroutine_handle<> self, std::coroutine_handle<> continuation) noexcept {
+    continuation_ = continuation;
+    self.resume();
+    return !rendezvous_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  [[nodiscard]] bool completed() const noexcept { return completed_.load(std::memory_order_acquire); }
+
+ private:
+  std::coroutine_handle<> continuation_;
+  std::atomic<bool> completed_{false};
+  /** @brief Exchanged by the awaiter and the final suspend point; whichever finds it set continues the awaiter. */
+  std::atomic<bool> rendezvous_{false};
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+ public:
+  Task<T> get_return_object() noexcept;
+
+  template <typename U>
+    requires std::is_convertible_v<U&&, T>
+  void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>) {
+    result_.template emplace<1>(std::forward<U>(value));
+  }
+
+  void unhandled_exception() noexcept { result_.template emplace<2>(std::current_exception()); }
+
+  T take_result() {
+    if (result_.index() == 2) {
+      std::rethrow_exception(std::get<2>(result_));
+    }
+    return std::move(std::get<1>(result_));
+  }
+
+ private:
+  std::variant<std::monostate, T, std::exception_ptr> result_;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+ public:
+  Task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+
+  void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+  void take_result() const {
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+  }
+
+ private:
+  std::exception_ptr exception_;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a @p T.
+ *
+ * A task does nothing until it is awaited by another task, which then resumes
+ * once it finishes, or until @ref start() runs it from ordinary code, which
+ * then polls @ref done() and collects the @ref result().  Exceptions thrown
+ * inside the coroutine are rethrown to whoever takes the result.
+ *
+ * Move-only; the task owns the coroutine frame.
+ *
+ * @warning A started task must not be destroyed before it is @ref done().
+ *
+ * @tparam T Result type; @c void for tasks without a result.
+ */
+template <typename T = void>
+class [[nodiscard]] Task {
+ public:
+  using promise_type = detail::TaskPromise<T>;
+
+  Task() = default;
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+  ~Task() { destroy(); }
+
+  Task(const Task&)            = delete;
+  Task& operator=(const Task&) = delete;
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})), started_(other.started_) {}
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      destroy();
+      handle_  = std::exchange(other.handle_, {});
+      started_ = other.started_;
+    }
+    return *this;
+  }
+
+  /** @brief Whether the task holds a coroutine. */
+  [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(handle_); }
+
+  /** @brief Runs the task on the calling thread until it first suspends, e.g. to hop to a worker. */
+  void start() {
+    KEN_CORE_ASSERT(valid() && !started_, "Task is empty or already started");
+    started_ = true;
+    handle_.resume();
+  }
+
+  /** @brief Whether the task has finished, on whatever thread it ran.  Safe to poll from any thread. */
+  [[nodiscard]] bool done() const noexcept { return handle_ && handle_.promise().completed(); }
+
+  /**
+   * @brief Takes the result of a finished task, rethrowing its exception if it failed.
+   * @pre @ref done()
+   */
+  T result() {
+    KEN_CORE_ASSERT(done(), "Task has not finished yet");
+    return handle_.promise().take_result();
+  }
+
+  /** @brief Awaiter that starts the task and resumes the awaiting coroutine when it finishes. */
+  auto operator co_await() noexcept {
+    struct Awaiter {
+      std::coroutine_handle<promise_type> handle;
+
+      bool await_ready() const noexcept { return false; }
+      bool await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+        return handle.promise().start_awaited(handle, awaiting);
+      }
+      T await_resume() const { return handle.promise().take_result(); }
+    };
+
+    KEN_CORE_ASSERT(valid() && !started_, "Task is empty or already started");
+    started_ = true;
+    return Awaiter{handle_};
+  }
+
+ private:
+  void destroy() noexcept {
+    if (handle_) {
+      KEN_CORE_ASSERT(!started_ || done(), "Destroying a task that is still running");
+      handle_.destroy();
+      handle_ = {};
+    }
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+  bool started_ = false;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+  return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+  return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+}  // namespace detail
+
+/** @brief Awaitable that continues the coroutine on a worker of the @ref JobSystem. */
+struct ResumeOnWorker {
+  const char* name; /**< Static string naming the job in the profiler. */
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle) const;
+  void await_resume() const noexcept {}
+};
+
+/** @brief Awaitable that continues the coroutine on the main thread, which owns the graphics context. */
+struct ResumeOnMainThread {
+  /** @brief Continues right away when already on the main thread. */
+  bool await_ready() const noexcept;
+  void await_suspend(std::coroutine_handle<> handle) const;
+  void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Continue on a worker thread.
+ *
+ * Runs inline when the job system has no workers.
+ *
+ * @param name Static string naming the continuation in the profiler.
+ */
+[[nodiscard]] inline ResumeOnWorker resume_on_worker(const char* name = "Task") noexcept { return {name}; }
+
+/**
+ * @brief Continue on the main thread, at the start of the next frame unless already there.
+ * @pre An Application exists.
+ */
+[[nodiscard]] inline ResumeOnMainThread resume_on_main_thread() noexcept { return {}; }
+
+/**
+ * @brief Read the whole file at @p path on a worker thread.
+ *
+ * The awaiting coroutine continues on that worker.
+ *
+ * @throws std::runtime_error if the file cannot be read.
+ */
+Task<std::vector<std::byte>> read_file(std::filesystem::path path);
+
+}  // namespace kEn
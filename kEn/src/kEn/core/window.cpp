@@ -4,14 +4,18 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <variant>
 
 #include <kEn/core/assert.hpp>
 #include <kEn/core/input/key_codes.hpp>
 #include <kEn/core/input/mouse_codes.hpp>
 #include <kEn/core/log.hpp>
 #include <kEn/event/application_events.hpp>
+#include <kEn/event/event_queue.hpp>
 #include <kEn/event/key_events.hpp>
 #include <kEn/event/mouse_events.hpp>
+#include <kEn/event/window_event_record.hpp>
 
 namespace kEn {
 
@@ -39,6 +43,11 @@ Window::Window(const WindowProperties& properties) {
   data_.width  = properties.width;
   data_.height = properties.height;
 
+  if (properties.headless) {
+    KEN_CORE_DEBUG("Creating headless window {0} ({1} x {2})", properties.title, properties.width, properties.height);
+    return;
+  }
+
   KEN_CORE_DEBUG("Creating window {0} ({1} x {2})", properties.title, properties.width, properties.height);
 
   if (glfw_window_count_ == 0) {
@@ -58,9 +67,18 @@ Window::Window(const WindowProperties& properties) {
   glfwSetWindowUserPointer(window_ptr_, &data_);
 
   set_glfw_callbacks();
+
+  double cursor_x{};
+  double cursor_y{};
+  glfwGetCursorPos(window_ptr_, &cursor_x, &cursor_y);
+  data_.input.warp_mouse({static_cast<float>(cursor_x), static_cast<float>(cursor_y)});
 }
 
 Window::~Window() {
+  if (headless()) {
+    return;
+  }
+
   glfwDestroyWindow(window_ptr_);
   --glfw_window_count_;
 
@@ -74,36 +92,43 @@ void Window::set_glfw_callbacks() {
   glfwSetWindowCloseCallback(window_ptr_, [](GLFWwindow* window) {
     const Data& win_data = *static_cast<Data*>(glfwGetWindowUserPointer(window));
     WindowCloseEvent event;
-    win_data.handler(event);
+    win_data.emit(event);
   });
 
   glfwSetWindowSizeCallback(window_ptr_, [](GLFWwindow* window, int width, int height) {
-    Data& win_data  = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    Data& win_data = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    if (win_data.width == static_cast<std::uint32_t>(width) && win_data.height == static_cast<std::uint32_t>(height)) {
+      return;  // Already reported, e.g. by a replayed resize.
+    }
     win_data.width  = static_cast<std::uint32_t>(width);
     win_data.height = static_cast<std::uint32_t>(height);
 
     WindowResizeEvent event(static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height));
-    win_data.handler(event);
+    win_data.emit(event);
   });
 
   glfwSetKeyCallback(window_ptr_, [](GLFWwindow* window, int key, int /*scancode*/, int action, int mods) {
-    Data& win_data       = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    Data& win_data = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    if (!win_data.input_enabled) {
+      return;
+    }
     win_data.active_mods = static_cast<ModKeys>(static_cast<ModKeys::underlying_type>(mods));
+    win_data.input.on_key(static_cast<Key>(key), action != GLFW_RELEASE);
 
     switch (action) {
       case GLFW_PRESS: {
         KeyPressedEvent event(static_cast<Key>(key), win_data.active_mods, false);
-        win_data.handler(event);
+        win_data.emit(event);
         break;
       }
       case GLFW_REPEAT: {
         KeyPressedEvent event(static_cast<Key>(key), win_data.active_mods, true);
-        win_data.handler(event);
+        win_data.emit(event);
         break;
       }
       case GLFW_RELEASE: {
         KeyReleasedEvent event(static_cast<Key>(key), win_data.active_mods);
-        win_data.handler(event);
+        win_data.emit(event);
         break;
       }
       default:
@@ -113,12 +138,18 @@ void Window::set_glfw_callbacks() {
 
   glfwSetCharCallback(window_ptr_, [](GLFWwindow* window, unsigned int keycode) {
     const Data& win_data = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    if (!win_data.input_enabled) {
+      return;
+    }
     KeyTypedEvent event(static_cast<Key>(keycode));
-    win_data.handler(event);
+    win_data.emit(event);
   });
 
   glfwSetMouseButtonCallback(window_ptr_, [](GLFWwindow* window, int button, int action, int mods) {
-    Data& win_data       = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    Data& win_data = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    if (!win_data.input_enabled) {
+      return;
+    }
     win_data.active_mods = static_cast<ModKeys>(static_cast<ModKeys::underlying_type>(mods));
 
     double dx{};
@@ -126,17 +157,18 @@ void Window::set_glfw_callbacks() {
     glfwGetCursorPos(window, &dx, &dy);
     auto x = static_cast<float>(dx);
     auto y = static_cast<float>(dy);
+    win_data.input.on_mouse_button(static_cast<MouseButton>(button), action == GLFW_PRESS);
 
     switch (action) {
       case GLFW_PRESS: {
         MouseButtonPressedEvent event({x, y}, static_cast<MouseButton>(button), win_data.active_mods);
-        win_data.handler(event);
+        win_data.emit(event);
         win_data.drag_state[static_cast<std::size_t>(button)] = {.active = true, .from = {x, y}};
         break;
       }
       case GLFW_RELEASE: {
         MouseButtonReleasedEvent event({x, y}, static_cast<MouseButton>(button), win_data.active_mods);
-        win_data.handler(event);
+        win_data.emit(event);
         win_data.drag_state[static_cast<std::size_t>(button)].active = false;
         break;
       }
@@ -146,32 +178,90 @@ void Window::set_glfw_callbacks() {
   });
 
   glfwSetScrollCallback(window_ptr_, [](GLFWwindow* window, double x_offset, double y_offset) {
-    const Data& win_data = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    Data& win_data = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    if (!win_data.input_enabled) {
+      return;
+    }
+    win_data.input.on_mouse_scroll({x_offset, y_offset});
 
     MouseScrollEvent event({x_offset, y_offset});
-    win_data.handler(event);
+    win_data.emit(event);
   });
 
   glfwSetCursorPosCallback(window_ptr_, [](GLFWwindow* window, double x, double y) {
-    const Data& win_data = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    Data& win_data = *static_cast<Data*>(glfwGetWindowUserPointer(window));
+    if (!win_data.input_enabled) {
+      return;
+    }
+    win_data.input.on_mouse_move({x, y});
 
     MouseMoveEvent event({x, y});
-    win_data.handler(event);
+    win_data.emit(event);
 
     for (std::size_t i = 0; i < GLFW_MOUSE_BUTTON_LAST; ++i) {
       if (win_data.drag_state[i].active) {
         MouseDragEvent drag_event(win_data.drag_state[i].from, {x, y}, static_cast<MouseButton>(i),
                                   win_data.active_mods);
-        win_data.handler(drag_event);
+        win_data.emit(drag_event);
       }
     }
   });
 }
 
-void Window::poll_events() { glfwPollEvents(); }  // NOLINT(readability-convert-member-functions-to-static)
+void Window::poll_events() {
+  if (!headless()) {
+    glfwPollEvents();
+  }
+
+  if (data_.queue != nullptr) {
+    data_.queue->drain(data_.handler);
+  }
+}
+
+void Window::inject_event(BaseEvent& event) {
+  if (const auto record = record_window_event(event)) {
+    if (const auto* resize = std::get_if<window_event::Resize>(&*record)) {
+      resize_to(resize->width, resize->height);
+    }
+    data_.input.apply(*record);
+  }
+  data_.handler(event);
+}
+
+void Window::resize_to(std::uint32_t width, std::uint32_t height) {
+  data_.width  = width;
+  data_.height = height;
+  if (headless()) {
+    return;
+  }
+
+  if (width == 0 || height == 0) {
+    glfwIconifyWindow(window_ptr_);
+    return;
+  }
+  if (glfwGetWindowAttrib(window_ptr_, GLFW_ICONIFIED) == GLFW_TRUE) {
+    glfwRestoreWindow(window_ptr_);
+  }
+  glfwSetWindowSize(window_ptr_, static_cast<int>(width), static_cast<int>(height));
+}
+
+void Window::set_event_queueing(bool enabled) {
+  if (enabled == event_queueing()) {
+    return;
+  }
+
+  if (enabled) {
+    data_.queue = std::make_unique<EventQueue>();
+  } else {
+    data_.queue->drain(data_.handler);
+    data_.queue.reset();
+  }
+}
 
 void Window::set_vsync(const bool enabled) {
-  glfwSwapInterval(enabled ? 1 : 0);
+  if (!headless()) {
+    glfwSwapInterval(enabled ? 1 : 0);
+  }
   data_.vsync = enabled;
 }
 
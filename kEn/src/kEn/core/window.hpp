@@ -5,12 +5,16 @@
 #include <array>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 
 #include <mEn/vec2.hpp>
 
+#include <kEn/core/input/input_state.hpp>
 #include <kEn/core/input/mod_keys.hpp>
 #include <kEn/event/event.hpp>
+#include <kEn/event/event_queue.hpp>
+#include <kEn/event/window_event_record.hpp>
 
 /** @file
  *  @ingroup ken
@@ -28,6 +32,7 @@ struct WindowProperties {
   std::uint32_t width;               /**< Window width in pixels. */
   std::uint32_t height;              /**< Window height in pixels. */
   bool opengl_debug_context = false; /**< Request an OpenGL debug context (GLFW_OPENGL_DEBUG_CONTEXT). */
+  bool headless             = false; /**< Create no native window; see @ref Window::headless(). */
 
   explicit WindowProperties(std::string title = "kEngine", std::uint32_t width = 1280, std::uint32_t height = 720)
       : title(std::move(title)), width(width), height(height) {}
@@ -51,9 +56,24 @@ struct WindowProperties {
  *  - @c MouseDragEvent -- synthesised while a button is held and the cursor moves;
  *    carries the original press position alongside the current position.
  *
+ *  Every key, mouse button, cursor and scroll event also updates the live
+ *  @ref InputState returned by @ref input(), regardless of how or whether the
+ *  event is handled.
+ *
+ *  Events are delivered from inside @ref poll_events().  By default each one
+ *  reaches the handler as soon as GLFW reports it; with event queueing
+ *  enabled (@ref set_event_queueing()) they are collected in an
+ *  @ref EventQueue, which coalesces high-frequency mouse input, and handed
+ *  over in one batch at the end of @ref poll_events().
+ *
  *  4x MSAA is requested unconditionally.
  *  In debug builds a graphics API debug context is requested.
  *
+ *  A headless Window (@ref WindowProperties::headless) creates no native
+ *  window and never touches GLFW.  It keeps its size, input state and event
+ *  handler, so injected events (@ref inject_event()) work as usual; it only
+ *  ever receives events that way.
+ *
  *  @note Only one Window is expected per application in the current design
  *        (Application holds a single @c std::unique_ptr<Window>).
  */
@@ -76,7 +96,7 @@ class Window {
 
   DELETE_COPY_MOVE(Window);
 
-  /** @brief Processes all pending OS events via @c glfwPollEvents(). */
+  /** @brief Processes all pending OS events via @c glfwPollEvents(), then drains the event queue if enabled. */
   void poll_events();
 
   /** @brief Current window width in pixels. */
@@ -97,6 +117,51 @@ class Window {
    */
   void set_event_handler(handler_t handler) { data_.handler = std::move(handler); }
 
+  /** @brief Keyboard and mouse state fed by this window's events; latched once per tick by Application. */
+  [[nodiscard]] InputState& input() { return data_.input; }
+  /** @copydoc input() */
+  [[nodiscard]] const InputState& input() const { return data_.input; }
+
+  /** @brief Enables or disables OS keyboard and mouse input.
+   *
+   *  While disabled, key, button, cursor and scroll events from the OS are dropped
+   *  before they reach the @ref InputState or the handler; window close and resize
+   *  events still arrive.  Used by event replay to shut out the user.
+   *
+   *  @param enabled  @c false to ignore OS input.
+   */
+  void set_input_enabled(bool enabled) { data_.input_enabled = enabled; }
+
+  /** @brief Returns @c true if OS keyboard and mouse input is delivered. */
+  [[nodiscard]] bool input_enabled() const { return data_.input_enabled; }
+
+  /** @brief Delivers @p event as if the OS had reported it, bypassing the event queue.
+   *
+   *  Window events also update the @ref InputState, and a @ref WindowResizeEvent
+   *  resizes the native window (a zero size minimises it).  Works while OS input is disabled.
+   *
+   *  @param event  Event to deliver to the handler.
+   */
+  void inject_event(BaseEvent& event);
+
+  /** @brief Enables or disables queued event delivery.
+   *
+   *  While enabled, events are queued and coalesced during @ref poll_events() and
+   *  delivered in order once it has processed all OS events.  Disabling it
+   *  delivers any still queued events first.
+   *
+   *  @param enabled  @c true to queue events, @c false to deliver them immediately.
+   */
+  void set_event_queueing(bool enabled);
+
+  /** @brief Returns @c true if events are queued until the end of @ref poll_events(). */
+  [[nodiscard]] bool event_queueing() const { return data_.queue != nullptr; }
+
+  /** @brief Returns the event queue counters, or @c nullptr if event queueing is disabled. */
+  [[nodiscard]] const EventQueueStats* event_queue_stats() const {
+    return data_.queue != nullptr ? &data_.queue->stats() : nullptr;
+  }
+
   /** @brief Enables or disables VSync (swap interval 1 or 0).
    *  @param enabled  @c true to enable VSync, @c false to disable.
    */
@@ -105,17 +170,23 @@ class Window {
   /** @brief Returns @c true if VSync is currently enabled. */
   [[nodiscard]] bool vsync() const;
 
-  /** @brief Returns the underlying GLFWwindow pointer for platform-specific use (e.g., ImGui). */
+  /** @brief Returns the underlying GLFWwindow pointer for platform-specific use (e.g., ImGui); null if headless. */
   [[nodiscard]] GLFWwindow* native_window() const { return window_ptr_; }
 
+  /** @brief Returns @c true if the Window has no native window behind it. */
+  [[nodiscard]] bool headless() const { return window_ptr_ == nullptr; }
+
  private:
   /** @brief Registers all GLFW input/window callbacks that produce kEn events. */
   void set_glfw_callbacks();
 
+  /** @brief Sets the window size without reporting it again through the size callback. */
+  void resize_to(std::uint32_t width, std::uint32_t height);
+
   /** @brief Number of live Window instances; controls GLFW init/shutdown. */
   static uint8_t glfw_window_count_;
 
-  GLFWwindow* window_ptr_;
+  GLFWwindow* window_ptr_ = nullptr;
 
   /** @brief Per-button drag tracking: records whether a drag is active and where it started. */
   struct DragState {
@@ -132,8 +203,21 @@ class Window {
 
     std::array<DragState, GLFW_MOUSE_BUTTON_LAST> drag_state{};
     ModKeys active_mods; /**< Modifier key state updated on every key/mouse-button event. */
+    InputState input;
+    bool input_enabled = true;
 
     handler_t handler;
+    std::unique_ptr<EventQueue> queue; /**< Set while event queueing is enabled. */
+
+    /** @brief Queues @p event if queueing is enabled, otherwise delivers it to the handler right away. */
+    template <window_event_type EventType>
+    void emit(EventType& event) const {
+      if (queue != nullptr) {
+        queue->push(event);
+      } else {
+        handler(event);
+      }
+    }
   };
 
   Data data_;
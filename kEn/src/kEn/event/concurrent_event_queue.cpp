@@ -0,0 +1,202 @@
+#include "concurrent_event_queue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <kEn/event/event.hpp>
+
+namespace kEn {
+
+namespace detail {
+
+namespace {
+
+constexpr std::size_t kNodesPerBlock = 256;
+static_assert(kNodesPerBlock > 1);
+
+struct SharedPool {
+  std::atomic<EventNode*> free_list{nullptr};
+  std::atomic<std::size_t> capacity{0};
+
+  std::mutex blocks_mutex;
+  std::vector<std::unique_ptr<EventNode[]>> blocks;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+};
+
+SharedPool& shared_pool() {
+  // Never destroyed: nodes may still be cached by threads that outlive static destruction.
+  static auto* pool = new SharedPool();  // NOLINT(cppcoreguidelines-owning-memory)
+  return *pool;
+}
+
+/** @brief Nodes this thread took from the shared free list; handed back when the thread exits. */
+struct LocalCache {
+  EventNode* first = nullptr;
+
+  LocalCache() = default;
+  ~LocalCache() {
+    if (first != nullptr) {
+      EventNode* last = first;
+      while (EventNode* next = last->next.load(std::memory_order_relaxed)) {
+        last = next;
+      }
+      EventNodePool::release(first, last);
+    }
+  }
+
+  DELETE_COPY_MOVE(LocalCache);
+};
+
+thread_local LocalCache local_cache;
+
+EventNode* grow(SharedPool& pool) {
+  auto block = std::make_unique<EventNode[]>(kNodesPerBlock);  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  for (std::size_t i = 1; i + 1 < kNodesPerBlock; ++i) {
+    block[i].next.store(&block[i + 1], std::memory_order_relaxed);
+  }
+
+  // The first node is handed out, the rest becomes this thread's cache.
+  EventNode* first  = &block[0];
+  local_cache.first = &block[1];
+  pool.capacity.fetch_add(kNodesPerBlock, std::memory_order_relaxed);
+
+  const std::scoped_lock lock(pool.blocks_mutex);
+  pool.blocks.push_back(std::move(block));
+  return first;
+}
+
+}  // namespace
+
+EventNode* EventNodePool::acquire() {
+  if (local_cache.first == nullptr) {
+    // Taking the whole list with one exchange cannot suffer from ABA, unlike popping a single node.
+    local_cache.first = shared_pool().free_list.exchange(nullptr, std::memory_order_acquire);
+    if (local_cache.first == nullptr) {
+      return grow(shared_pool());
+    }
+  }
+
+  EventNode* node   = local_cache.first;
+  local_cache.first = node->next.load(std::memory_order_relaxed);
+  node->next.store(nullptr, std::memory_order_relaxed);
+  return node;
+}
+
+void EventNodePool::release(EventNode* first, EventNode* last) noexcept {
+  auto& free_list = shared_pool().free_list;
+  EventNode* head = free_list.load(std::memory_order_relaxed);
+  do {
+    last->next.store(head, std::memory_order_relaxed);
+  } while (!free_list.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+std::size_t EventNodePool::capacity() noexcept { return shared_pool().capacity.load(std::memory_order_relaxed); }
+
+}  // namespace detail
+
+ConcurrentEventQueue::~ConcurrentEventQueue() {
+  while (detail::EventNode* node = dequeue()) {
+    destroy_event(*node);
+    detail::EventNodePool::release(node, node);
+  }
+}
+
+std::size_t ConcurrentEventQueue::drain(const handler_t& handler) {
+  // Unlink up to the newest node as of now first, so events posted meanwhile, by the handler or by producers that
+  // never stop, wait for the next drain instead of extending this one.
+  const detail::EventNode* const newest = head_.load(std::memory_order_acquire);
+  if (newest == &stub_) {
+    return 0;
+  }
+
+  detail::EventNode* first = nullptr;
+  detail::EventNode* last  = nullptr;
+  while (last != newest) {
+    detail::EventNode* node = dequeue();
+    if (node == nullptr) {
+      break;
+    }
+    if (last != nullptr) {
+      last->next.store(node, std::memory_order_relaxed);
+    } else {
+      first = node;
+    }
+    last = node;
+  }
+  if (last == nullptr) {
+    return 0;
+  }
+  last->next.store(nullptr, std::memory_order_relaxed);
+
+  std::size_t count = 0;
+  for (detail::EventNode* node = first; node != nullptr; node = node->next.load(std::memory_order_relaxed)) {
+    handler(*node->event);
+    destroy_event(*node);
+    ++count;
+  }
+
+  // Returned in one batch, so the shared free list sees a single CAS per drain.
+  detail::EventNodePool::release(first, last);
+  return count;
+}
+
+bool ConcurrentEventQueue::empty() const noexcept {
+  const detail::EventNode* tail = tail_;
+  if (tail == &stub_) {
+    tail = tail->next.load(std::memory_order_acquire);
+  }
+  return tail == nullptr;
+}
+
+void ConcurrentEventQueue::enqueue(detail::EventNode* node) noexcept {
+  node->next.store(nullptr, std::memory_order_relaxed);
+  detail::EventNode* prev = head_.exchange(node, std::memory_order_acq_rel);
+  // Between the exchange and this store the list is briefly split; dequeue() treats that as empty.
+  prev->next.store(node, std::memory_order_release);
+}
+
+detail::EventNode* ConcurrentEventQueue::dequeue() noexcept {
+  detail::EventNode* tail = tail_;
+  detail::EventNode* next = tail->next.load(std::memory_order_acquire);
+
+  if (tail == &stub_) {
+    if (next == nullptr) {
+      return nullptr;
+    }
+    tail_ = next;
+    tail  = next;
+    next  = next->next.load(std::memory_order_acquire);
+  }
+
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+
+  if (tail != head_.load(std::memory_order_acquire)) {
+    // A producer has swapped head_ but not linked its node yet; pick it up on the next drain.
+    return nullptr;
+  }
+
+  // tail is the last node: re-insert the stub behind it so tail can be handed out.
+  enqueue(&stub_);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+void ConcurrentEventQueue::destroy_event(detail::EventNode& node) noexcept {
+  if (node.inline_event) {
+    std::destroy_at(node.event);
+  } else {
+    delete node.event;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+  node.event = nullptr;
+}
+
+}  // namespace kEn
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <utility>
+
+#include <kEn/core/core.hpp>
+#include <kEn/event/event.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+namespace detail {
+
+/**
+ * @brief Queue node holding one posted event.
+ *
+ * Events that fit into @ref kInlineSize bytes are constructed inside the node;
+ * larger ones live on the heap.
+ */
+struct EventNode {
+  static constexpr std::size_t kInlineSize = 128;
+
+  std::atomic<EventNode*> next{nullptr};
+  BaseEvent* event  = nullptr;
+  bool inline_event = false;
+  alignas(std::max_align_t) std::byte storage[kInlineSize];  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+};
+
+/**
+ * @brief Process-wide recycling allocator for @ref EventNode.
+ *
+ * Released nodes go onto a lock-free free list.  A thread that needs a node
+ * takes the whole free list at once into a thread-local cache, which avoids
+ * the ABA problem of popping single nodes from a shared stack.  Only growing
+ * the pool, which happens when every node is in flight, takes a lock.
+ */
+class EventNodePool {
+ public:
+  /** @brief Takes a node from the pool, growing it if needed. */
+  [[nodiscard]] static EventNode* acquire();
+  /** @brief Returns the chain @p first ... @p last, linked through @c next, to the pool. */
+  static void release(EventNode* first, EventNode* last) noexcept;
+  /** @brief Total number of nodes the pool has allocated. */
+  [[nodiscard]] static std::size_t capacity() noexcept;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Lock-free multi-producer, single-consumer queue of events.
+ *
+ * Any thread may @ref post events; one thread, the owner, delivers them with
+ * @ref drain.  Events are constructed in nodes taken from a recycled pool, so
+ * steady-state posting allocates nothing and never blocks.  The queue is an
+ * intrusive Vyukov MPSC list: a post is one atomic exchange, and the consumer
+ * never waits for producers.
+ *
+ * Events posted by one thread are delivered in the order they were posted.
+ * There is no ordering between threads beyond that.
+ *
+ * Events are delivered as @ref BaseEvent references, so subscribers use the
+ * usual @ref EventDispatcher machinery.  An event is destroyed right after
+ * the handler returns.
+ */
+class ConcurrentEventQueue {
+ public:
+  /** @brief Handler the posted events are delivered to. */
+  using handler_t = std::function<void(BaseEvent&)>;
+
+  ConcurrentEventQueue() = default;
+  /** @brief Destroys all undelivered events. */
+  ~ConcurrentEventQueue();
+
+  DELETE_COPY_MOVE(ConcurrentEventQueue);
+
+  /**
+   * @brief Construct an event of type @p EventType and queue it.  Safe to call from any thread.
+   *
+   * @tparam EventType Event type; constructed in place because events are not movable.
+   * @param args Constructor arguments of @p EventType.
+   */
+  template <typename EventType, typename... Args>
+    requires std::derived_from<EventType, BaseEvent> && std::constructible_from<EventType, Args...>
+  void post(Args&&... args) {
+    detail::EventNode* node = detail::EventNodePool::acquire();
+    if constexpr (sizeof(EventType) <= detail::EventNode::kInlineSize &&
+                  alignof(EventType) <= alignof(std::max_align_t)) {
+      node->event        = ::new (static_cast<void*>(node->storage)) EventType(std::forward<Args>(args)...);
+      node->inline_event = true;
+    } else {
+      node->event        = new EventType(std::forward<Args>(args)...);  // NOLINT(cppcoreguidelines-owning-memory)
+      node->inline_event = false;
+    }
+    enqueue(node);
+  }
+
+  /**
+   * @brief Deliver every event posted so far to @p handler.  Only the owning thread may call this.
+   *
+   * Events posted after the drain started, including by the handler itself, are left for the next drain, so
+   * producers that keep posting cannot keep it from returning.
+   *
+   * @param handler Receives each event.
+   * @return Number of delivered events.
+   */
+  std::size_t drain(const handler_t& handler);
+
+  /** @brief Whether no event is waiting.  Only meaningful on the owning thread. */
+  [[nodiscard]] bool empty() const noexcept;
+
+ private:
+  void enqueue(detail::EventNode* node) noexcept;
+  [[nodiscard]] detail::EventNode* dequeue() noexcept;
+  static void destroy_event(detail::EventNode& node) noexcept;
+
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  detail::EventNode stub_;
+  std::atomic<detail::EventNode*> head_{&stub_};              ///< Most recently posted node; written by producers.
+  alignas(kCacheLineSize) detail::EventNode* tail_ = &stub_;  ///< Oldest undelivered node; consumer only.
+};
+
+}  // namespace kEn
@@ -1,15 +1,20 @@
 #pragma once
 
+#include <atomic>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <format>
 #include <functional>
+#include <memory>
+#include <new>
 #include <ostream>
 #include <string>
 #include <string_view>
 #include <type_traits>
-#include <typeindex>
-#include <unordered_map>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include <kEn/core/assert.hpp>
 #include <kEn/core/core.hpp>
@@ -36,8 +41,29 @@
 
 namespace kEn {
 
+/**
+ * @brief Dense integer identifier of an event type.
+ *
+ * Identifiers are assigned on first use of each @ref kEn::Event type, counting up
+ * from 1, so they can index flat per-type tables.  They are stable for the
+ * lifetime of the process but not across runs.
+ */
+using event_id_t = std::uint32_t;
+
+/** @brief Identifier of @ref kEn::BaseEvent, under which catch-all subscribers are stored. */
+inline constexpr event_id_t kCatchAllEventId = 0;
+
 namespace detail {
 
+/**
+ * @brief Allocate the next dense event type identifier.
+ * @return A process-unique identifier greater than @ref kEn::kCatchAllEventId.
+ */
+inline event_id_t next_event_id() noexcept {
+  static std::atomic<event_id_t> next{kCatchAllEventId + 1};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
 /**
  * @brief Extract basic signature traits from simple callables.
  *
@@ -125,11 +151,112 @@ using callable_result_t = typename callable_traits<std::decay_t<F>>::result_t;
 
 }  // namespace detail
 
+struct BaseEvent;
+
+namespace detail {
+
+/**
+ * @brief Move-only @c bool(BaseEvent&) callable with inline storage.
+ *
+ * Callables of up to @ref kInlineSize bytes that are nothrow move constructible
+ * are stored in place, which covers member-function bindings and lambdas with
+ * a few captures; larger ones are stored on the heap.  Invocation is a single
+ * indirect call without the allocation or double indirection of a heap-backed
+ * @c std::move_only_function.
+ */
+class EventHandler {
+ public:
+  /** @brief Size of the inline buffer in bytes. */
+  static constexpr std::size_t kInlineSize = 6 * sizeof(void*);
+
+  /**
+   * @brief Wrap a callable.
+   * @tparam F Callable type, invocable as @c bool(BaseEvent&).
+   * @param fn Callable to store.
+   */
+  template <class F>
+    requires(!std::same_as<std::remove_cvref_t<F>, EventHandler>)
+  explicit EventHandler(F&& fn) {
+    using Fn = std::decay_t<F>;
+    if constexpr (stored_inline<Fn>()) {
+      ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(fn));
+      invoke_ = [](void* storage, BaseEvent& event) -> bool {
+        return (*std::launder(static_cast<Fn*>(storage)))(event);
+      };
+      manage_ = [](void* dst, void* src) noexcept {
+        auto* from = std::launder(static_cast<Fn*>(src));
+        if (dst != nullptr) {
+          ::new (dst) Fn(std::move(*from));
+        }
+        std::destroy_at(from);
+      };
+    } else {
+      ::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<F>(fn)));
+      invoke_ = [](void* storage, BaseEvent& event) -> bool { return (**static_cast<Fn**>(storage))(event); };
+      manage_ = [](void* dst, void* src) noexcept {
+        if (dst != nullptr) {
+          ::new (dst) Fn*(*static_cast<Fn**>(src));
+        } else {
+          delete *static_cast<Fn**>(src);  // NOLINT(cppcoreguidelines-owning-memory)
+        }
+      };
+    }
+  }
+
+  /** @brief Destroy the stored callable. */
+  ~EventHandler() {
+    if (manage_ != nullptr) {
+      manage_(nullptr, storage_);
+    }
+  }
+
+  /** @brief Move the callable out of @p other, leaving it empty. */
+  EventHandler(EventHandler&& other) noexcept : invoke_(other.invoke_), manage_(other.manage_) {
+    if (manage_ != nullptr) {
+      manage_(storage_, other.storage_);
+      other.manage_ = nullptr;
+      other.invoke_ = nullptr;
+    }
+  }
+
+  /** @brief Move-assign the callable out of @p other, leaving it empty. */
+  EventHandler& operator=(EventHandler&& other) noexcept {
+    if (this != &other) {
+      std::destroy_at(this);
+      std::construct_at(this, std::move(other));
+    }
+    return *this;
+  }
+
+  EventHandler(const EventHandler&)            = delete;
+  EventHandler& operator=(const EventHandler&) = delete;
+
+  /** @brief Invoke the stored callable. */
+  bool operator()(BaseEvent& event) { return invoke_(storage_, event); }
+
+ private:
+  template <class Fn>
+  static consteval bool stored_inline() {
+    return sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Fn>;
+  }
+
+  using invoke_t = bool (*)(void*, BaseEvent&);
+  /** Moves the callable from the second buffer into the first one and destroys the source; destroys only if null. */
+  using manage_t = void (*)(void*, void*) noexcept;
+
+  alignas(std::max_align_t) std::byte storage_[kInlineSize];  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  invoke_t invoke_ = nullptr;
+  manage_t manage_ = nullptr;
+};
+
+}  // namespace detail
+
 /**
  * @brief Abstract base type for all events.
  *
  * Events are dispatched via @ref kEn::EventDispatcher. Each event provides:
- * - a stable runtime type identifier via @ref event_id()
+ * - a dense runtime type identifier via @ref event_id(), stored in the event so reading it is not a virtual call
  * - a textual representation via @ref kEn::BaseEvent::to_string()
  *
  * The @ref handled flag is used by the dispatcher to stop propagation early.
@@ -143,16 +270,14 @@ struct BaseEvent {
    */
   bool handled{false};
 
-  /** @brief Default constructor. */
-  constexpr BaseEvent() noexcept = default;
   /** @brief Virtual destructor for polymorphic use. */
   virtual ~BaseEvent() = default;
 
   /**
    * @brief Return the dynamic event type identifier.
-   * @return A type_index identifying the runtime type of the event.
+   * @return The dense identifier of the runtime type of the event.
    */
-  virtual std::type_index event_id() const noexcept = 0;
+  [[nodiscard]] event_id_t event_id() const noexcept { return id_; }
 
   /**
    * @brief Convert the event to a human-readable string.
@@ -161,6 +286,16 @@ struct BaseEvent {
   [[nodiscard]] virtual std::string to_string() const = 0;
 
   DELETE_COPY_MOVE(BaseEvent);
+
+ protected:
+  /**
+   * @brief Construct an event of the type identified by @p id.
+   * @param id Identifier of the concrete event type.
+   */
+  constexpr explicit BaseEvent(event_id_t id) noexcept : id_(id) {}
+
+ private:
+  event_id_t id_;
 };
 
 /**
@@ -175,9 +310,9 @@ inline std::ostream& operator<<(std::ostream& os, const BaseEvent& e) { return o
  * @brief Convenience base class for concrete event types.
  *
  * Inherit your event type from @c Event<YourType> to get:
- * - a stable type identifier via @ref static_id()
+ * - a dense type identifier via @ref static_id()
  * - a default name via @ref static_name()
- * - default implementations of @ref BaseEvent::event_id() and @ref BaseEvent::to_string()
+ * - the identifier stored for @ref BaseEvent::event_id() and a default @ref BaseEvent::to_string()
  *
  * @tparam EventType The concrete event type (usually the derived type).
  *
@@ -189,11 +324,15 @@ template <typename EventType>
 struct Event : public BaseEvent {
   /**
    * @brief Static type identifier for @p EventType.
-   * @return Reference to a process-stable @c std::type_index for @p EventType.
+   * @return The dense identifier of @p EventType; @ref kEn::kCatchAllEventId for @ref kEn::BaseEvent.
    */
-  static const std::type_index& static_id() noexcept {
-    static const std::type_index kId{typeid(EventType)};
-    return kId;
+  static event_id_t static_id() noexcept {
+    if constexpr (std::same_as<EventType, BaseEvent>) {
+      return kCatchAllEventId;
+    } else {
+      static const event_id_t kId = detail::next_event_id();
+      return kId;
+    }
   }
 
   /**
@@ -209,8 +348,8 @@ struct Event : public BaseEvent {
     }
   }
 
-  /** @copydoc kEn::BaseEvent::event_id */
-  std::type_index event_id() const noexcept override { return static_id(); }
+  /** @brief Construct the event, tagging it with @ref static_id(). */
+  Event() noexcept : BaseEvent(static_id()) {}
 
   /** @copydoc kEn::BaseEvent::to_string */
   [[nodiscard]] std::string to_string() const override { return std::string{static_name()}; }
@@ -219,8 +358,10 @@ struct Event : public BaseEvent {
 /**
  * @brief Minimal event dispatcher with type-based subscription.
  *
- * Subscribers are stored in a type-erased callable wrapper:
- * @ref base_callback_t, which takes a @ref kEn::BaseEvent reference and returns @c bool.
+ * Subscribers are stored in a type-erased callable wrapper with inline storage
+ * (@ref kEn::detail::EventHandler), which takes a @ref kEn::BaseEvent reference and returns
+ * @c bool.  They live in a flat table indexed by @ref kEn::BaseEvent::event_id, so finding
+ * the subscribers of an event is an array index followed by a contiguous loop.
  *
  * Dispatch behavior:
  * - First, invoke subscribers registered for the event's dynamic type.
@@ -229,7 +370,7 @@ struct Event : public BaseEvent {
  * - If any subscriber returns true, the event's @ref kEn::BaseEvent::handled flag is set
  *   and dispatch stops early.
  *
- * @note Subscriber iteration order depends on the underlying container and is not guaranteed.
+ * @note Subscribers of one event type are invoked in subscription order.
  * @note This class is not inherently thread-safe; external synchronization is required if used
  *       concurrently.
  */
@@ -262,13 +403,6 @@ class EventDispatcher {
       std::convertible_to<std::invoke_result_t<F, E&>, bool>;
 
  public:
-  /**
-   * @brief Type-erased subscriber callable type.
-   *
-   * The callable receives a @ref kEn::BaseEvent reference and returns @c true if the event is handled.
-   */
-  using base_callback_t = std::move_only_function<bool(BaseEvent&)>;
-
   /**
    * @brief Subscribe a callable to a specific event type.
    *
@@ -276,7 +410,7 @@ class EventDispatcher {
    * @tparam F Callable type. Must be invocable with @c EventType& and return something convertible to @c bool.
    * @param callback_fn Subscriber callable.
    *
-   * @note The callable is wrapped and stored type-erased as a @ref base_callback_t.
+   * @note The callable is wrapped and stored type-erased as a @ref kEn::detail::EventHandler.
    */
   template <typename EventType, typename F>
     requires subscriber_for_v<F, EventType>
@@ -285,7 +419,12 @@ class EventDispatcher {
       return static_cast<bool>(std::invoke(fn, static_cast<EventType&>(event)));
     };
 
-    subscribers_.emplace(Event<EventType>::static_id(), base_callback_t{std::move(wrapper)});
+    const event_id_t id = Event<EventType>::static_id();
+    if (id >= table_.size()) {
+      table_.resize(id + 1);
+    }
+    table_[id].emplace_back(std::move(wrapper));
+    ++size_;
   }
 
   /**
@@ -378,33 +517,50 @@ class EventDispatcher {
     }
 
     // Catch-all subscribers: subscribe<BaseEvent>(...) receives every event.
-    if (id != Event<BaseEvent>::static_id()) {
-      return dispatch_by_id(Event<BaseEvent>::static_id(), event);
+    if (id != kCatchAllEventId) {
+      return dispatch_by_id(kCatchAllEventId, event);
     }
     return false;
   }
 
+  /**
+   * @brief Check whether dispatch() would offer @p event to any subscriber.
+   * @param event Event instance (polymorphic).
+   * @return True if a subscriber for the event's dynamic type or a catch-all subscriber exists.
+   */
+  [[nodiscard]] bool listens_to(const BaseEvent& event) const {
+    return has_subscribers(event.event_id()) || has_subscribers(kCatchAllEventId);
+  }
+
   /** @brief Remove all subscribers. */
-  void clear() noexcept { subscribers_.clear(); }
+  void clear() noexcept {
+    table_.clear();
+    size_ = 0;
+  }
 
   /**
    * @brief Check whether the container is empty.
    * @return True if there are no elements.
    */
-  [[nodiscard]] bool empty() const noexcept { return subscribers_.empty(); }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
   /**
    * @brief Check total number of event subscribers.
    * @return Number of stored subscribers (across all event types).
    */
-  [[nodiscard]] std::size_t size() const noexcept { return subscribers_.size(); }
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
 
  private:
   /**
-   * @brief Subscriber storage keyed by event type identifier.
+   * @brief Subscriber storage indexed by event type identifier.
    *
-   * Multiple subscribers may be registered for the same event type.
+   * Multiple subscribers may be registered for the same event type; the table only
+   * grows up to the largest identifier subscribed to.
    */
-  std::unordered_multimap<std::type_index, base_callback_t> subscribers_;
+  std::vector<std::vector<detail::EventHandler>> table_;
+  /** @brief Total number of subscribers across all event types. */
+  std::size_t size_ = 0;
+
+  [[nodiscard]] bool has_subscribers(event_id_t id) const noexcept { return id < table_.size() && !table_[id].empty(); }
 
   /**
    * @brief Dispatch to subscribers registered under a given type id.
@@ -412,9 +568,12 @@ class EventDispatcher {
    * @param event Event to pass to subscribers.
    * @return True if the event became handled.
    */
-  [[nodiscard]] bool dispatch_by_id(const std::type_index& id, BaseEvent& event) {
-    for (auto [it, end] = subscribers_.equal_range(id); it != end; ++it) {
-      event.handled |= it->second(event);
+  [[nodiscard]] bool dispatch_by_id(event_id_t id, BaseEvent& event) {
+    if (id >= table_.size()) {
+      return false;
+    }
+    for (auto& handler : table_[id]) {
+      event.handled |= handler(event);
       if (event.handled) {
         return true;
       }
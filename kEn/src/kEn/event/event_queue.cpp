@@ -0,0 +1,96 @@
+#include "event_queue.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <kEn/event/event.hpp>
+#include <kEn/event/window_event_record.hpp>
+
+namespace kEn {
+
+EventQueue::EventQueue() : buffer_(kInitialCapacity) {}
+
+bool EventQueue::coalesce(const window_event::Move& move) noexcept {
+  auto* queued = find_coalescible<window_event::Move>([](const window_event::Move&) { return true; });
+  if (queued != nullptr) {
+    queued->pos = move.pos;
+  }
+  return queued != nullptr;
+}
+
+bool EventQueue::coalesce(const window_event::Scroll& scroll) noexcept {
+  auto* queued = find_coalescible<window_event::Scroll>([](const window_event::Scroll&) { return true; });
+  if (queued != nullptr) {
+    queued->offset += scroll.offset;
+  }
+  return queued != nullptr;
+}
+
+bool EventQueue::coalesce(const window_event::Drag& drag) noexcept {
+  auto* queued =
+      find_coalescible<window_event::Drag>([&](const window_event::Drag& d) { return d.button == drag.button; });
+  if (queued != nullptr) {
+    queued->to   = drag.to;
+    queued->mods = drag.mods;
+  }
+  return queued != nullptr;
+}
+
+void EventQueue::drain(const handler_t& handler) {
+  // Events pushed by the handler wait for the next drain, so a handler that re-queues input cannot spin forever.
+  const std::size_t count = size_;
+  stats_.coalesced        = std::exchange(coalesced_, 0);
+  stats_.dispatched       = 0;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    replay_window_event(pop_front(), handler);
+    ++stats_.dispatched;
+  }
+}
+
+void EventQueue::clear() noexcept {
+  head_      = 0;
+  size_      = 0;
+  coalesced_ = 0;
+}
+
+void EventQueue::push_back(const Record& record) {
+  if (size_ == buffer_.size()) {
+    std::vector<Record> grown(buffer_.size() * 2);
+    for (std::size_t i = 0; i < size_; ++i) {
+      grown[i] = std::move(at(i));
+    }
+    buffer_ = std::move(grown);
+    head_   = 0;
+  }
+
+  at(size_) = record;
+  ++size_;
+}
+
+EventQueue::Record EventQueue::pop_front() noexcept {
+  Record record = std::move(buffer_[head_]);
+  head_         = (head_ + 1) & (buffer_.size() - 1);
+  --size_;
+  return record;
+}
+
+template <class T, class Pred>
+T* EventQueue::find_coalescible(Pred matches) noexcept {
+  for (std::size_t i = size_; i-- > 0;) {
+    Record& record = at(i);
+    if (auto* candidate = std::get_if<T>(&record); candidate != nullptr && matches(*candidate)) {
+      ++coalesced_;
+      return candidate;
+    }
+    if (!std::holds_alternative<window_event::Move>(record) && !std::holds_alternative<window_event::Drag>(record) &&
+        !std::holds_alternative<window_event::Scroll>(record)) {
+      return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace kEn
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <kEn/event/event.hpp>
+#include <kEn/event/window_event_record.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+/** @brief Counters of an @ref EventQueue. */
+struct EventQueueStats {
+  std::size_t coalesced  = 0;  ///< Events merged into an already queued event before the last drain.
+  std::size_t dispatched = 0;  ///< Events delivered by the last drain.
+};
+
+/**
+ * @brief Ring buffer of window events that are delivered in one batch per frame.
+ *
+ * The window pushes events into the queue while the OS events are polled and
+ * the whole batch is then drained in push order.  High-frequency input is
+ * coalesced while it is queued:
+ * - consecutive @ref MouseMoveEvent "MouseMoveEvents" keep the last position,
+ * - consecutive @ref MouseDragEvent "MouseDragEvents" of one button keep the last position,
+ * - consecutive @ref MouseScrollEvent "MouseScrollEvents" sum their offsets.
+ *
+ * Events count as consecutive while only other move, drag and scroll events
+ * lie between them, so a 1000 Hz mouse yields at most one event of each kind
+ * between two discrete events (key or button presses, resizes...).  Discrete
+ * events are never reordered or merged.
+ *
+ * Only the event types produced by @ref Window can be queued, because events
+ * are stored by value (@ref WindowEventRecord) and rebuilt on delivery.  The buffer grows on demand, so
+ * no event is ever dropped.
+ */
+class EventQueue {
+ public:
+  /** @brief Handler the queued events are delivered to. */
+  using handler_t = std::function<void(BaseEvent&)>;
+
+  EventQueue();
+
+  /**
+   * @brief Queue a copy of @p event, coalescing it with a queued event where possible.
+   *
+   * The record alternative is picked from the static type of @p event, so
+   * pushing never inspects the runtime event id.
+   *
+   * @param event Event to queue.
+   */
+  template <window_event_type EventType>
+  void push(const EventType& event) {
+    const auto record = to_window_event(event);
+    if (!coalesce(record)) {
+      push_back(record);
+    }
+  }
+
+  /**
+   * @brief Deliver every queued event to @p handler in push order.
+   *
+   * Events pushed by @p handler while draining are kept for the next drain.
+   *
+   * @param handler Receives each event.
+   */
+  void drain(const handler_t& handler);
+
+  /** @brief Discard all queued events. */
+  void clear() noexcept;
+
+  /** @brief Number of queued events. */
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  /** @brief Whether no events are queued. */
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+  /** @brief Returns the counters of the last drain. */
+  [[nodiscard]] const EventQueueStats& stats() const noexcept { return stats_; }
+
+ private:
+  using Record = WindowEventRecord;
+
+  static constexpr std::size_t kInitialCapacity = 64;
+
+  /**
+   * @brief Merge @p record into a queued record of the same kind.
+   * @return @c true if @p record was merged and must not be queued.
+   */
+  bool coalesce(const window_event::Move& move) noexcept;
+  /** @copydoc coalesce(const window_event::Move&) */
+  bool coalesce(const window_event::Scroll& scroll) noexcept;
+  /** @copydoc coalesce(const window_event::Move&) */
+  bool coalesce(const window_event::Drag& drag) noexcept;
+  /** @brief Discrete records are never merged. */
+  static constexpr bool coalesce(const auto& /*record*/) noexcept { return false; }
+
+  void push_back(const Record& record);
+  [[nodiscard]] Record pop_front() noexcept;
+  [[nodiscard]] Record& at(std::size_t i) noexcept { return buffer_[(head_ + i) & (buffer_.size() - 1)]; }
+
+  /**
+   * @brief Find the queued record of type @p T a new event can be merged into.
+   *
+   * Walks back over the trailing run of move, drag and scroll records and
+   * returns the first @p T that @p matches accepts, or null once a discrete
+   * record is reached.
+   */
+  template <class T, class Pred>
+  [[nodiscard]] T* find_coalescible(Pred matches) noexcept;
+
+  std::vector<Record> buffer_;  ///< Power-of-two sized ring.
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+
+  std::size_t coalesced_ = 0;
+  EventQueueStats stats_;
+};
+
+}  // namespace kEn
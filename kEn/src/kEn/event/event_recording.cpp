@@ -0,0 +1,251 @@
+#include "event_recording.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <variant>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/core/input/key_codes.hpp>
+#include <kEn/core/input/mod_keys.hpp>
+#include <kEn/core/input/mouse_codes.hpp>
+#include <kEn/core/log.hpp>
+#include <kEn/core/timestep.hpp>
+#include <kEn/event/event.hpp>
+#include <kEn/event/window_event_record.hpp>
+
+namespace kEn {
+
+namespace {
+
+constexpr std::uint32_t kRecordingMagic   = 0x4345524BU;  // "KREC"
+constexpr std::uint32_t kRecordingVersion = 2;  // 2: tick timing entries.
+constexpr std::uint8_t kTickEntryType     = 0xFEU;
+constexpr std::uint8_t kEndEntryType      = 0xFFU;
+
+struct FileHeader {
+  std::uint32_t magic   = kRecordingMagic;
+  std::uint32_t version = kRecordingVersion;
+  std::int64_t tick_ns  = 0;
+};
+
+/**
+ * @brief One event on disk.  @c type is the @ref WindowEventRecord alternative index.
+ *
+ * Tick timing entries store the interval in nanoseconds as the bit pattern of @c values[0..1].
+ */
+struct FileEntry {
+  std::uint32_t tick     = 0;
+  std::uint8_t type      = 0;
+  std::uint8_t flags     = 0; /**< Bit 0: key repeat. */
+  std::uint8_t mods      = 0;
+  std::uint8_t button    = 0;
+  std::uint16_t key      = 0;
+  std::uint16_t reserved = 0;
+  std::array<float, 4> values{}; /**< Positions/offsets, or the resize width and height. */
+};
+static_assert(sizeof(FileEntry) == 28 && std::is_trivially_copyable_v<FileEntry>);
+
+constexpr std::uint8_t kRepeatFlag = 1U << 0;
+
+/** @brief Index of @p T among the @ref WindowEventRecord alternatives. */
+template <typename T, std::size_t I = 0>
+consteval std::uint8_t index_of() {
+  if constexpr (std::is_same_v<std::variant_alternative_t<I, WindowEventRecord>, T>) {
+    return I;
+  } else {
+    return index_of<T, I + 1>();
+  }
+}
+
+FileEntry encode(const WindowEventRecord& record) {
+  using namespace window_event;  // NOLINT(google-build-using-namespace)
+
+  FileEntry entry{.type = static_cast<std::uint8_t>(record.index())};
+  if (const auto* r = std::get_if<Resize>(&record)) {
+    entry.values = {static_cast<float>(r->width), static_cast<float>(r->height)};
+  } else if (const auto* r = std::get_if<KeyPress>(&record)) {
+    entry.key   = key::code(r->key);
+    entry.mods  = r->mods.value();
+    entry.flags = r->repeat ? kRepeatFlag : 0;
+  } else if (const auto* r = std::get_if<KeyRelease>(&record)) {
+    entry.key  = key::code(r->key);
+    entry.mods = r->mods.value();
+  } else if (const auto* r = std::get_if<KeyType>(&record)) {
+    entry.key = key::code(r->key);
+  } else if (const auto* r = std::get_if<ButtonPress>(&record)) {
+    entry.button = mouse::code(r->button);
+    entry.mods   = r->mods.value();
+    entry.values = {r->pos.x, r->pos.y};
+  } else if (const auto* r = std::get_if<ButtonRelease>(&record)) {
+    entry.button = mouse::code(r->button);
+    entry.mods   = r->mods.value();
+    entry.values = {r->pos.x, r->pos.y};
+  } else if (const auto* r = std::get_if<Move>(&record)) {
+    entry.values = {r->pos.x, r->pos.y};
+  } else if (const auto* r = std::get_if<Scroll>(&record)) {
+    entry.values = {r->offset.x, r->offset.y};
+  } else if (const auto* r = std::get_if<Drag>(&record)) {
+    entry.button = mouse::code(r->button);
+    entry.mods   = r->mods.value();
+    entry.values = {r->from.x, r->from.y, r->to.x, r->to.y};
+  }
+  return entry;
+}
+
+std::optional<WindowEventRecord> decode(const FileEntry& entry) {
+  using namespace window_event;  // NOLINT(google-build-using-namespace)
+
+  const auto key    = static_cast<Key>(entry.key);
+  const auto button = static_cast<MouseButton>(entry.button);
+  const ModKeys mods{entry.mods};
+  const auto& v = entry.values;
+
+  switch (entry.type) {
+    case index_of<Close>():
+      return Close{};
+    case index_of<Resize>():
+      return Resize{.width = static_cast<std::uint32_t>(v[0]), .height = static_cast<std::uint32_t>(v[1])};
+    case index_of<KeyPress>():
+      return KeyPress{.key = key, .mods = mods, .repeat = (entry.flags & kRepeatFlag) != 0};
+    case index_of<KeyRelease>():
+      return KeyRelease{.key = key, .mods = mods};
+    case index_of<KeyType>():
+      return KeyType{.key = key};
+    case index_of<ButtonPress>():
+      return ButtonPress{.pos = {v[0], v[1]}, .button = button, .mods = mods};
+    case index_of<ButtonRelease>():
+      return ButtonRelease{.pos = {v[0], v[1]}, .button = button, .mods = mods};
+    case index_of<Move>():
+      return Move{.pos = {v[0], v[1]}};
+    case index_of<Scroll>():
+      return Scroll{.offset = {v[0], v[1]}};
+    case index_of<Drag>():
+      return Drag{.from = {v[0], v[1]}, .to = {v[2], v[3]}, .button = button, .mods = mods};
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+EventRecorder::EventRecorder(const std::filesystem::path& path, duration_t tick_time)
+    : out_(path, std::ios::binary | std::ios::trunc) {
+  const FileHeader header{.tick_ns = tick_time.count()};
+  out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!out_) {
+    KEN_CORE_ERROR("Failed to open event recording {}", path.string());
+  }
+}
+
+EventRecorder::~EventRecorder() { finish(last_tick_ + 1); }
+
+void EventRecorder::record(std::uint64_t tick, const BaseEvent& event) {
+  if (finished_) {
+    return;
+  }
+  const auto record = record_window_event(event);
+  if (!record) {
+    return;
+  }
+
+  FileEntry entry = encode(*record);
+  entry.tick      = static_cast<std::uint32_t>(tick);
+  out_.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+  last_tick_ = tick;
+}
+
+void EventRecorder::record_tick(std::uint64_t tick, duration_t interval) {
+  if (finished_) {
+    return;
+  }
+
+  FileEntry entry{.tick = static_cast<std::uint32_t>(tick), .type = kTickEntryType};
+  const std::int64_t ns = interval.count();
+  std::memcpy(entry.values.data(), &ns, sizeof(ns));
+  out_.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+  last_tick_ = tick;
+}
+
+void EventRecorder::finish(std::uint64_t tick_count) {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+
+  const FileEntry end{.tick = static_cast<std::uint32_t>(tick_count), .type = kEndEntryType};
+  out_.write(reinterpret_cast<const char*>(&end), sizeof(end));
+  out_.close();
+  if (!out_) {
+    KEN_CORE_ERROR("Failed to write event recording");
+  }
+}
+
+std::unique_ptr<EventReplay> EventReplay::load(const std::filesystem::path& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    KEN_CORE_ERROR("Failed to open event recording {}", path.string());
+    return nullptr;
+  }
+
+  FileHeader header;
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  // Version 1 recordings carry no tick timing but replay the same way.
+  if (!in || header.magic != kRecordingMagic || header.version == 0 || header.version > kRecordingVersion ||
+      header.tick_ns <= 0) {
+    KEN_CORE_ERROR("{} is not a supported event recording", path.string());
+    return nullptr;
+  }
+
+  std::unique_ptr<EventReplay> replay(new EventReplay());  // NOLINT(cppcoreguidelines-owning-memory)
+  replay->tick_time_ = duration_t{header.tick_ns};
+
+  FileEntry entry;
+  while (in.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+    if (entry.type == kEndEntryType) {
+      replay->tick_count_ = entry.tick;
+      return replay;
+    }
+    if (entry.type == kTickEntryType) {
+      if (entry.tick != replay->tick_intervals_.size()) {
+        KEN_CORE_ERROR("Corrupt tick timing in event recording {}", path.string());
+        return nullptr;
+      }
+      std::int64_t ns = 0;
+      std::memcpy(&ns, entry.values.data(), sizeof(ns));
+      replay->tick_intervals_.emplace_back(ns);
+      continue;
+    }
+
+    auto record = decode(entry);
+    if (!record || (!replay->entries_.empty() && entry.tick < replay->entries_.back().tick)) {
+      KEN_CORE_ERROR("Corrupt entry in event recording {}", path.string());
+      return nullptr;
+    }
+    replay->entries_.push_back({.tick = entry.tick, .record = *record});
+  }
+
+  // A recording cut short by a crash still replays up to its last event.
+  KEN_CORE_WARN("Event recording {} has no end marker; replaying up to its last event", path.string());
+  replay->tick_count_ = replay->entries_.empty() ? 0 : replay->entries_.back().tick + 1;
+  replay->tick_count_ = std::max<std::uint64_t>(replay->tick_count_, replay->tick_intervals_.size());
+  return replay;
+}
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+void EventReplay::deliver(std::uint64_t tick, const std::function<void(BaseEvent&)>& handler) {
+  while (next_ < entries_.size() && entries_[next_].tick <= tick) {
+    replay_window_event(entries_[next_++].record, handler);
+  }
+}
+
+}  // namespace kEn
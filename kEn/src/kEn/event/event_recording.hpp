@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <kEn/core/core.hpp>
+#include <kEn/core/timestep.hpp>
+#include <kEn/event/event.hpp>
+#include <kEn/event/window_event_record.hpp>
+
+/** @file
+ *  @ingroup ken
+ *
+ *  Recording and replay of window events for reproducible runs.
+ *
+ *  A recording is a small binary file: a header holding the tick length,
+ *  one fixed-size entry per window event tagged with the number of fixed
+ *  ticks that had run when it arrived, one timing entry per tick holding the
+ *  wall-clock time since the previous tick, and an end entry holding the
+ *  total tick count.  Replaying it at one tick per frame delivers every event
+ *  right before the same tick as during recording, so the simulation sees
+ *  identical input regardless of the machine's frame rate.
+ *
+ *  Entries are written in the host byte order; recordings are meant to be
+ *  replayed on the platform that produced them.
+ */
+
+namespace kEn {
+
+/** @brief Writes window events to a recording file. */
+class EventRecorder {
+ public:
+  /**
+   * @brief Create or truncate the recording at @p path.
+   * @param path      Output file.
+   * @param tick_time Length of one fixed tick, stored for the replay.
+   */
+  EventRecorder(const std::filesystem::path& path, duration_t tick_time);
+  /** @brief If @ref finish was not called, ends the recording right after its last event. */
+  ~EventRecorder();
+
+  DELETE_COPY_MOVE(EventRecorder);
+
+  /** @brief Whether the file could be opened and every write so far succeeded. */
+  [[nodiscard]] bool good() const { return out_.good(); }
+
+  /**
+   * @brief Append @p event; anything that is not a window event is ignored.
+   * @param tick  Number of ticks that have run before the event arrived.
+   * @param event Event to record.
+   */
+  void record(std::uint64_t tick, const BaseEvent& event);
+
+  /**
+   * @brief Append the timing of tick @p tick.  Ticks must be timed in order, starting from 0.
+   * @param tick     Index of the tick about to run.
+   * @param interval Wall-clock time since the previous tick started.
+   */
+  void record_tick(std::uint64_t tick, duration_t interval);
+
+  /**
+   * @brief Write the end entry and close the file.  Later calls do nothing.
+   * @param tick_count Total number of ticks run while recording.
+   */
+  void finish(std::uint64_t tick_count);
+
+ private:
+  std::ofstream out_;
+  std::uint64_t last_tick_ = 0;
+  bool finished_           = false;
+};
+
+/** @brief Reads a recording and feeds its events back tick by tick. */
+class EventReplay {
+ public:
+  /**
+   * @brief Load the recording at @p path.
+   * @param path Recording file.
+   * @return The replay, or null if the file is missing or malformed (logged).
+   */
+  [[nodiscard]] static std::unique_ptr<EventReplay> load(const std::filesystem::path& path);
+
+  /** @brief Length of one tick when the recording was made. */
+  [[nodiscard]] duration_t tick_time() const { return tick_time_; }
+  /** @brief Number of ticks the recording covers. */
+  [[nodiscard]] std::uint64_t tick_count() const { return tick_count_; }
+  /** @brief Wall-clock time between consecutive ticks while recording, indexed by tick; empty for old recordings. */
+  [[nodiscard]] const std::vector<duration_t>& tick_intervals() const { return tick_intervals_; }
+  /** @brief Whether every tick of the recording has been replayed. */
+  [[nodiscard]] bool finished(std::uint64_t tick) const { return tick >= tick_count_; }
+
+  /**
+   * @brief Deliver the events recorded before tick @p tick that were not delivered yet.
+   * @param tick    Index of the tick about to run.
+   * @param handler Receives each rebuilt event.
+   */
+  void deliver(std::uint64_t tick, const std::function<void(BaseEvent&)>& handler);
+
+ private:
+  struct Entry {
+    std::uint64_t tick;
+    WindowEventRecord record;
+  };
+
+  EventReplay() = default;
+
+  std::vector<Entry> entries_;
+  std::vector<duration_t> tick_intervals_;
+  std::size_t next_ = 0;
+  duration_t tick_time_{};
+  std::uint64_t tick_count_ = 0;
+};
+
+}  // namespace kEn
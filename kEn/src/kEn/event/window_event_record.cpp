@@ -0,0 +1,89 @@
+#include "window_event_record.hpp"
+
+#include <functional>
+#include <optional>
+#include <variant>
+
+#include <kEn/event/application_events.hpp>
+#include <kEn/event/event.hpp>
+#include <kEn/event/key_events.hpp>
+#include <kEn/event/mouse_events.hpp>
+
+namespace kEn {
+
+namespace {
+
+template <class... Ts>
+struct Overloaded : Ts... {
+  using Ts::operator()...;
+};
+
+template <window_event_type EventType, window_event_type... Rest>
+[[nodiscard]] std::optional<WindowEventRecord> record_as(const BaseEvent& event) {
+  if (event.event_id() == EventType::static_id()) {
+    return to_window_event(static_cast<const EventType&>(event));
+  }
+  if constexpr (sizeof...(Rest) > 0) {
+    return record_as<Rest...>(event);
+  } else {
+    return std::nullopt;
+  }
+}
+
+}  // namespace
+
+std::optional<WindowEventRecord> record_window_event(const BaseEvent& event) {
+  // Most frequent first.
+  return record_as<MouseMoveEvent, MouseDragEvent, MouseScrollEvent, KeyPressedEvent, KeyReleasedEvent, KeyTypedEvent,
+                   MouseButtonPressedEvent, MouseButtonReleasedEvent, WindowResizeEvent, WindowCloseEvent>(event);
+}
+
+void replay_window_event(const WindowEventRecord& record, const std::function<void(BaseEvent&)>& handler) {
+  using namespace window_event;  // NOLINT(google-build-using-namespace)
+
+  std::visit(Overloaded{
+                 [&](const Close&) {
+                   WindowCloseEvent event;
+                   handler(event);
+                 },
+                 [&](const Resize& r) {
+                   WindowResizeEvent event(r.width, r.height);
+                   handler(event);
+                 },
+                 [&](const KeyPress& r) {
+                   KeyPressedEvent event(r.key, r.mods, r.repeat);
+                   handler(event);
+                 },
+                 [&](const KeyRelease& r) {
+                   KeyReleasedEvent event(r.key, r.mods);
+                   handler(event);
+                 },
+                 [&](const KeyType& r) {
+                   KeyTypedEvent event(r.key);
+                   handler(event);
+                 },
+                 [&](const ButtonPress& r) {
+                   MouseButtonPressedEvent event(r.pos, r.button, r.mods);
+                   handler(event);
+                 },
+                 [&](const ButtonRelease& r) {
+                   MouseButtonReleasedEvent event(r.pos, r.button, r.mods);
+                   handler(event);
+                 },
+                 [&](const Move& r) {
+                   MouseMoveEvent event(r.pos);
+                   handler(event);
+                 },
+                 [&](const Scroll& r) {
+                   MouseScrollEvent event(r.offset);
+                   handler(event);
+                 },
+                 [&](const Drag& r) {
+                   MouseDragEvent event(r.from, r.to, r.button, r.mods);
+                   handler(event);
+                 },
+             },
+             record);
+}
+
+}  // namespace kEn
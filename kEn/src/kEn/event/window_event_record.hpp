@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <variant>
+
+#include <mEn/vec2.hpp>
+
+#include <kEn/core/input/key_codes.hpp>
+#include <kEn/core/input/mod_keys.hpp>
+#include <kEn/core/input/mouse_codes.hpp>
+#include <kEn/event/application_events.hpp>
+#include <kEn/event/event.hpp>
+#include <kEn/event/key_events.hpp>
+#include <kEn/event/mouse_events.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+/**
+ * @brief Plain-data copies of the events a @ref Window produces.
+ *
+ * Events themselves are polymorphic and immovable; these payloads can be
+ * stored, merged and written to disk, and turned back into events with
+ * @ref replay_window_event.
+ */
+namespace window_event {
+
+struct Close {};
+struct Resize {
+  std::uint32_t width;
+  std::uint32_t height;
+};
+struct KeyPress {
+  Key key;
+  ModKeys mods;
+  bool repeat;
+};
+struct KeyRelease {
+  Key key;
+  ModKeys mods;
+};
+struct KeyType {
+  Key key;
+};
+struct ButtonPress {
+  mEn::Vec2 pos;
+  MouseButton button;
+  ModKeys mods;
+};
+struct ButtonRelease {
+  mEn::Vec2 pos;
+  MouseButton button;
+  ModKeys mods;
+};
+struct Move {
+  mEn::Vec2 pos;
+};
+struct Scroll {
+  mEn::Vec2 offset;
+};
+struct Drag {
+  mEn::Vec2 from;
+  mEn::Vec2 to;
+  MouseButton button;
+  ModKeys mods;
+};
+
+}  // namespace window_event
+
+/** @brief Any event a @ref Window produces, stored by value. */
+using WindowEventRecord =
+    std::variant<window_event::Close, window_event::Resize, window_event::KeyPress, window_event::KeyRelease,
+                 window_event::KeyType, window_event::ButtonPress, window_event::ButtonRelease, window_event::Move,
+                 window_event::Scroll, window_event::Drag>;
+
+/**
+ * @name Window event payloads
+ * @brief Copy an event of a statically known window event type into its payload.
+ *
+ * The overload set is the compile-time mapping from event types to
+ * @ref WindowEventRecord alternatives; callers that know the concrete event
+ * type (the @ref Window callbacks, @ref EventQueue::push) use it directly.
+ * @{
+ */
+[[nodiscard]] inline window_event::Close to_window_event(const WindowCloseEvent& /*event*/) { return {}; }
+[[nodiscard]] inline window_event::Resize to_window_event(const WindowResizeEvent& e) {
+  return {.width = e.width(), .height = e.height()};
+}
+[[nodiscard]] inline window_event::KeyPress to_window_event(const KeyPressedEvent& e) {
+  return {.key = e.key(), .mods = e.mod_keys(), .repeat = e.is_repeat()};
+}
+[[nodiscard]] inline window_event::KeyRelease to_window_event(const KeyReleasedEvent& e) {
+  return {.key = e.key(), .mods = e.mod_keys()};
+}
+[[nodiscard]] inline window_event::KeyType to_window_event(const KeyTypedEvent& e) { return {.key = e.key()}; }
+[[nodiscard]] inline window_event::ButtonPress to_window_event(const MouseButtonPressedEvent& e) {
+  return {.pos = e.pos(), .button = e.button(), .mods = e.mod_keys()};
+}
+[[nodiscard]] inline window_event::ButtonRelease to_window_event(const MouseButtonReleasedEvent& e) {
+  return {.pos = e.pos(), .button = e.button(), .mods = e.mod_keys()};
+}
+[[nodiscard]] inline window_event::Move to_window_event(const MouseMoveEvent& e) { return {.pos = e.pos()}; }
+[[nodiscard]] inline window_event::Scroll to_window_event(const MouseScrollEvent& e) { return {.offset = e.offset()}; }
+[[nodiscard]] inline window_event::Drag to_window_event(const MouseDragEvent& e) {
+  return {.from = e.from(), .to = e.to(), .button = e.button(), .mods = e.mod_keys()};
+}
+/** @} */
+
+/** @brief Satisfied by the event types a @ref Window produces. */
+template <class EventType>
+concept window_event_type = requires(const EventType& event) {
+  { to_window_event(event) };
+};
+
+/**
+ * @brief Copy a window event of unknown static type into a record.
+ *
+ * Compares the runtime id against each window event type in turn; prefer
+ * @ref to_window_event when the event type is known.
+ *
+ * @param event Event to copy.
+ * @return The record, or @c std::nullopt if @p event is not one of the window event types.
+ */
+[[nodiscard]] std::optional<WindowEventRecord> record_window_event(const BaseEvent& event);
+
+/**
+ * @brief Rebuild the event stored in @p record and pass it to @p handler.
+ * @param record  Record to rebuild.
+ * @param handler Receives the rebuilt event.
+ */
+void replay_window_event(const WindowEventRecord& record, const std::function<void(BaseEvent&)>& handler);
+
+}  // namespace kEn
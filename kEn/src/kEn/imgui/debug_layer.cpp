@@ -2,11 +2,48 @@
 
 #include <imgui/imgui.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <utility>
+
 #include <kEn/core/application.hpp>
 #include <kEn/core/layer.hpp>
+#include <kEn/core/memory_tracker.hpp>
+#include <kEn/core/profiler.hpp>
+#include <kEn/renderer/render_context.hpp>
 
 namespace kEn {
 
+namespace {
+
+constexpr double kBytesPerMib = 1024.0 * 1024.0;
+
+double mib(std::size_t bytes) { return static_cast<double>(bytes) / kBytesPerMib; }
+
+}  // namespace
+
+#ifdef KEN_ENABLE_PROFILING
+namespace {
+
+constexpr int kMaxProfilerFrames  = 16;
+constexpr const char* kTracePath  = "kEn_trace.json";
+constexpr float kMinScopeWidth    = 1.0F;
+constexpr float kMinLabelledWidth = 24.0F;
+constexpr double kNanosPerMilli   = 1e6;
+
+/** @brief Stable color per scope name, so a scope keeps its color across frames. */
+ImU32 scope_color(const char* name) {
+  const auto hash = std::hash<std::string_view>{}(name);
+  const auto hue  = static_cast<float>(hash % 360) / 360.0F;
+  return ImColor::HSV(hue, 0.45F, 0.75F);
+}
+
+}  // namespace
+#endif
+
 DebugLayer::DebugLayer() : Layer("DebugLayer") {}
 
 void DebugLayer::on_imgui() {
@@ -18,8 +55,145 @@ void DebugLayer::on_imgui() {
     if (ImGui::Checkbox("VSync", &vsync)) {
       app.main_window().set_vsync(vsync);
     }
+    bool queue_events = app.main_window().event_queueing();
+    if (ImGui::Checkbox("Queue Events", &queue_events)) {
+      app.main_window().set_event_queueing(queue_events);
+    }
+    if (const auto* stats = app.main_window().event_queue_stats()) {
+      ImGui::Text("Events: %zu dispatched, %zu coalesced", stats->dispatched, stats->coalesced);
+    }
+    gpu_imgui(app.device().context());
+    memory_imgui();
+#ifdef KEN_ENABLE_PROFILING
+    profiler_imgui();
+#endif
   }
   ImGui::End();
 }
 
-}  // namespace kEn
\ No newline at end of file
+void DebugLayer::gpu_imgui(const RenderContext& context) {
+  const auto timings = context.gpu_timings();
+  if (timings.empty() || !ImGui::CollapsingHeader("GPU")) {
+    return;
+  }
+  for (const auto& timing : timings) {
+    ImGui::Text("%*s%s: %.3f ms", static_cast<int>(timing.depth * 2), "", timing.name, timing.milliseconds);
+  }
+}
+
+void DebugLayer::memory_imgui() {
+  if (!ImGui::CollapsingHeader("Memory")) {
+    return;
+  }
+
+  for (const bool gpu : {true, false}) {
+    const MemoryStats total = MemoryTracker::total(gpu);
+    ImGui::Text("%s: %.2f MiB (peak %.2f MiB)", gpu ? "GPU" : "CPU", mib(total.bytes), mib(total.peak));
+  }
+  if (ImGui::Button("Reset peaks")) {
+    MemoryTracker::reset_peaks();
+  }
+
+  for (std::size_t i = 0; i < std::to_underlying(MemoryCategory::Count); ++i) {
+    const auto category     = static_cast<MemoryCategory>(i);
+    const MemoryStats stats = MemoryTracker::stats(category);
+    const bool open = ImGui::TreeNode(memory_category::name(category).data(), "%s: %.2f MiB (peak %.2f MiB), %zu live",
+                                      memory_category::name(category).data(), mib(stats.bytes), mib(stats.peak),
+                                      stats.allocations);
+    if (!open) {
+      continue;
+    }
+    for (const auto& [name, named] : MemoryTracker::by_name(category)) {
+      if (named.allocations == 0) {
+        continue;
+      }
+      ImGui::Text("%s: %.2f MiB (peak %.2f MiB), %zu live", name.c_str(), mib(named.bytes), mib(named.peak),
+                  named.allocations);
+    }
+    ImGui::TreePop();
+  }
+}
+
+#ifdef KEN_ENABLE_PROFILING
+void DebugLayer::profiler_imgui() {
+  if (!ImGui::CollapsingHeader("Profiler")) {
+    return;
+  }
+
+  ImGui::SliderInt("Frames", &profiler_frames_, 1, kMaxProfilerFrames);
+  ImGui::Checkbox("Pause", &profiler_paused_);
+  ImGui::SameLine();
+  if (ImGui::Button("Export trace")) {
+    Profiler::write_chrome_trace(kTracePath);
+  }
+
+  if (!profiler_paused_) {
+    // The current frame is still running, so the window ends where it started.
+    profiler_frame_starts_ = Profiler::frame_starts();
+    if (profiler_frame_starts_.size() < 2) {
+      return;
+    }
+    const auto frames =
+        std::min(static_cast<std::size_t>(profiler_frames_), profiler_frame_starts_.size() - 1);
+    profiler_from_ = profiler_frame_starts_[profiler_frame_starts_.size() - 1 - frames];
+    profiler_to_   = profiler_frame_starts_.back();
+    Profiler::collect(profiler_from_, profiler_to_, profiler_threads_);
+  }
+  if (profiler_to_ <= profiler_from_) {
+    return;
+  }
+  ImGui::Text("Window: %.3f ms", static_cast<double>(profiler_to_ - profiler_from_) / kNanosPerMilli);
+
+  ImDrawList* draw_list = ImGui::GetWindowDrawList();
+  const float width     = std::max(ImGui::GetContentRegionAvail().x, 1.0F);
+  const float row       = ImGui::GetTextLineHeightWithSpacing();
+  const double scale    = static_cast<double>(width) / static_cast<double>(profiler_to_ - profiler_from_);
+
+  const auto to_x = [&](float origin, std::int64_t t) {
+    t = std::clamp(t, profiler_from_, profiler_to_);
+    return origin + static_cast<float>(static_cast<double>(t - profiler_from_) * scale);
+  };
+
+  for (const auto& thread : profiler_threads_) {
+    if (thread.events.empty()) {
+      continue;
+    }
+    ImGui::TextUnformatted(thread.name.c_str());
+
+    std::uint32_t depth = 0;
+    for (const auto& event : thread.events) {
+      depth = std::max(depth, event.depth);
+    }
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float height  = static_cast<float>(depth + 1) * row;
+
+    for (const std::int64_t start : profiler_frame_starts_) {
+      if (start >= profiler_from_ && start <= profiler_to_) {
+        const float x = to_x(origin.x, start);
+        draw_list->AddLine({x, origin.y}, {x, origin.y + height}, IM_COL32(255, 255, 255, 64));
+      }
+    }
+
+    for (const auto& event : thread.events) {
+      const float x0 = to_x(origin.x, event.begin);
+      const float x1 = std::max(to_x(origin.x, event.end), x0 + kMinScopeWidth);
+      const float y0 = origin.y + (static_cast<float>(event.depth) * row);
+      const ImVec2 min{x0, y0};
+      const ImVec2 max{x1, y0 + row - 1.0F};
+
+      draw_list->AddRectFilled(min, max, scope_color(event.name));
+      if (x1 - x0 >= kMinLabelledWidth) {
+        draw_list->PushClipRect(min, max, true);
+        draw_list->AddText({x0 + 2.0F, y0}, IM_COL32(255, 255, 255, 255), event.name);
+        draw_list->PopClipRect();
+      }
+      if (ImGui::IsMouseHoveringRect(min, max)) {
+        ImGui::SetTooltip("%s\n%.3f ms", event.name, static_cast<double>(event.end - event.begin) / kNanosPerMilli);
+      }
+    }
+    ImGui::Dummy({width, height});
+  }
+}
+#endif
+
+}  // namespace kEn
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include <kEn/core/layer.hpp>
+#include <kEn/core/profiler.hpp>
+#include <kEn/renderer/render_context.hpp>
 
 /** @file
  *  @ingroup ken
@@ -11,7 +16,11 @@ namespace kEn {
 /**
  * @brief Internal engine overlay that renders a debug panel via Dear ImGui.
  *
- * Shows FPS, TPS, and a VSync toggle applied synchronously.
+ * Shows FPS, TPS, a VSync toggle applied synchronously and the GPU time of
+ * every timing scope of the render context (@ref GpuScope), and the memory
+ * counted by the @ref MemoryTracker with its high-water marks.  With
+ * @c KEN_ENABLE_PROFILING it also draws the profiled scopes of the last few
+ * frames as a flame chart, one lane per thread, and exports them as a trace.
  * Registered automatically by Application in debug builds.
  */
 class DebugLayer final : public Layer {
@@ -22,6 +31,24 @@ class DebugLayer final : public Layer {
   void on_imgui() override;
 
   DELETE_COPY_MOVE(DebugLayer);
+
+ private:
+  /** @brief Renders the GPU section: the latest GPU timings, indented by nesting. */
+  static void gpu_imgui(const RenderContext& context);
+  /** @brief Renders the Memory section: GPU and CPU totals, then every category broken down by debug name. */
+  static void memory_imgui();
+
+#ifdef KEN_ENABLE_PROFILING
+  /** @brief Renders the Profiler section: frame count, pause, trace export and the flame chart. */
+  void profiler_imgui();
+
+  int profiler_frames_        = 3;
+  bool profiler_paused_       = false;
+  std::int64_t profiler_from_ = 0;
+  std::int64_t profiler_to_   = 0;
+  std::vector<std::int64_t> profiler_frame_starts_;
+  std::vector<ProfileThread> profiler_threads_;
+#endif
 };
 
-}  // namespace kEn
\ No newline at end of file
+}  // namespace kEn
@@ -12,10 +12,13 @@ namespace kEn::ui {
 
 void Material(kEn::Material& mat) {
   if (ImGui::TreeNode("Phong properties")) {
-    ImGui::SliderFloat("ambient", &mat.ambient_factor, 0, 1);
-    ImGui::SliderFloat("diffuse", &mat.diffuse_factor, 0, 1);
-    ImGui::SliderFloat("specular", &mat.specular_factor, 0, 1);
-    ImGui::SliderFloat("shininess", &mat.shininess_factor, 1, 100);
+    bool changed = ImGui::SliderFloat("ambient", &mat.ambient_factor, 0, 1);
+    changed      = ImGui::SliderFloat("diffuse", &mat.diffuse_factor, 0, 1) || changed;
+    changed      = ImGui::SliderFloat("specular", &mat.specular_factor, 0, 1) || changed;
+    changed      = ImGui::SliderFloat("shininess", &mat.shininess_factor, 1, 100) || changed;
+    if (changed) {
+      mat.bake();
+    }
 
     ImGui::TreePop();
   }
@@ -5,6 +5,7 @@
 #include <functional>
 #include <memory>
 #include <span>
+#include <string>
 
 #include <kEn/core/core.hpp>
 #include <kEn/renderer/shader.hpp>
@@ -89,6 +90,7 @@ struct BufferDesc {
   BufferUsage usage{BufferUsage::Default}; /**< CPU/GPU access pattern hint. */
   BufferBinds bind_flags;                  /**< Which pipeline stages may bind this buffer. */
   std::size_t stride{};                    /**< Element stride in bytes; 0 if not applicable. */
+  std::string debug_name;                  /**< Label for memory accounting and graphics debuggers. */
 };
 
 /**
@@ -0,0 +1,44 @@
+#include "device.hpp"
+
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/core/log.hpp>
+#include <kEn/core/task.hpp>
+#include <kEn/renderer/image.hpp>
+#include <platform/null/null_device.hpp>
+#include <platform/opengl/opengl_device.hpp>
+
+namespace kEn {
+
+std::unique_ptr<Device> Device::create(Device::Api api, GLFWwindow* window, bool enable_debug) {
+  switch (api) {
+    case Device::Api::OpenGL:
+      KEN_CORE_ASSERT(window != nullptr, "The OpenGL device requires a native window");
+      return std::make_unique<OpenglDevice>(window, enable_debug);
+    case Device::Api::Null:
+      return std::make_unique<NullDevice>();
+    default:
+      KEN_CORE_CRITICAL("Only OpenGL and Null are currently supported");
+      KEN_UNREACHABLE();
+  }
+}
+
+Task<std::shared_ptr<Texture>> Device::create_texture_async(std::filesystem::path path, SamplerDesc sampler,
+                                                            TextureFormat format, std::uint32_t mip_levels) {
+  co_await resume_on_worker("Decode texture");
+  std::optional<Image> image = Image::load(path, format);
+
+  co_await resume_on_main_thread();
+  if (!image) {
+    throw std::runtime_error(std::format("Cannot load texture {}", path.string()));
+  }
+  co_return create_texture(path, *image, sampler, mip_levels);
+}
+
+}  // namespace kEn
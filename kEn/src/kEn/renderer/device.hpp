@@ -5,9 +5,11 @@
 #include <memory>
 #include <string_view>
 
+#include <kEn/core/task.hpp>
 #include <kEn/imgui/imgui_backend.hpp>
 #include <kEn/renderer/buffer.hpp>
 #include <kEn/renderer/framebuffer.hpp>
+#include <kEn/renderer/image.hpp>
 #include <kEn/renderer/render_context.hpp>
 #include <kEn/renderer/render_state.hpp>
 #include <kEn/renderer/shader.hpp>
@@ -31,17 +33,19 @@ namespace kEn {
  * @c Application::instance().device() or the free function @c kEn::device().
  *
  * Concrete implementations are selected at runtime via @ref create().
- * Currently only @c Api::OpenGL is supported.
+ * Currently @c Api::OpenGL and @c Api::Null are supported.  The null device
+ * records every command into memory without touching a GPU and needs no
+ * window, which makes the CPU side of rendering measurable anywhere.
  */
 class Device {
  public:
   /** @brief Selects the graphics API for the concrete Device implementation. */
-  enum class Api : std::uint8_t { OpenGL, D3D11 };
+  enum class Api : std::uint8_t { OpenGL, D3D11, Null };
 
   /**
    * @brief Creates and returns the concrete Device for the given API.
    * @param api           Graphics API to instantiate.
-   * @param window        Native window handle used to create the graphics context.
+   * @param window        Native window handle used to create the graphics context; may be null for @c Api::Null.
    * @param enable_debug  Request a debug context with validation messages.
    */
   [[nodiscard]] static std::unique_ptr<Device> create(Api api, GLFWwindow* window, bool enable_debug = false);
@@ -143,6 +147,31 @@ class Device {
     return create_texture(path, sampler, format, kFullMipChain);
   }
 
+  /**
+   * @brief Upload an already decoded image, caching the texture under @p path like the loading overload.
+   * @param path       File the image was decoded from; the cache key and debug name.
+   * @param image      Decoded pixels, see @ref Image::load.
+   * @param sampler    Sampling parameters.
+   * @param mip_levels Number of mip levels to generate; pass @c kFullMipChain for a full chain.
+   * @note Returns the cached texture, ignoring @p image, if @p path was loaded before.
+   */
+  [[nodiscard]] virtual std::shared_ptr<Texture> create_texture(const std::filesystem::path& path, const Image& image,
+                                                                const SamplerDesc& sampler,
+                                                                std::uint32_t mip_levels) = 0;
+
+  /**
+   * @brief Load a texture without stalling the main thread.
+   *
+   * Decodes the file on a worker, then continues on the main thread to create
+   * the texture, so the awaiting coroutine resumes there.
+   *
+   * @throws std::runtime_error if the file cannot be decoded.
+   */
+  [[nodiscard]] Task<std::shared_ptr<Texture>> create_texture_async(std::filesystem::path path,
+                                                                    SamplerDesc sampler      = {},
+                                                                    TextureFormat format     = TextureFormat::RGBA8,
+                                                                    std::uint32_t mip_levels = kFullMipChain);
+
   /** @brief Create a new @ref VertexInput (VAO abstraction) for this device. */
   [[nodiscard]] virtual std::unique_ptr<VertexInput> create_vertex_input() = 0;
 
@@ -2,8 +2,10 @@
 
 #include <imgui/imgui.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <span>
+#include <string>
 #include <vector>
 
 #include <mEn/vec4.hpp>
@@ -94,6 +96,20 @@ struct FramebufferSpec {
   std::uint32_t array_size = 1; /**< Texture array layers (currently only 1 is supported). */
 
   FramebufferAttachmentSpec attachments; /**< Color and optional depth attachment specifications. */
+  std::string debug_name;                /**< Label for memory accounting and graphics debuggers. */
+
+  /** @brief Bytes of storage of all attachments at the current size, ignoring driver padding. */
+  [[nodiscard]] std::size_t memory_size() const noexcept {
+    const std::size_t texels = std::size_t{width} * height * samples;
+    std::size_t bytes        = 0;
+    for (const auto& attachment : attachments.color_attachments) {
+      bytes += texels * texture_format::bytes_per_block(attachment.texture_format);
+    }
+    if (attachments.depth_attachment) {
+      bytes += texels * texture_format::bytes_per_block(attachments.depth_attachment->texture_format);
+    }
+    return bytes;
+  }
 };
 
 /**
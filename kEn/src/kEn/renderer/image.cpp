@@ -0,0 +1,67 @@
+#include "image.hpp"
+
+#include <stb_image.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/core/log.hpp>
+#include <kEn/core/profiler.hpp>
+#include <kEn/renderer/texture_format.hpp>
+
+namespace kEn {
+
+namespace {
+
+[[nodiscard]] constexpr bool is_byte_color_format(TextureFormat format) noexcept {
+  return texture_format::is_color_format(format) && !texture_format::is_integer_format(format) &&
+         texture_format::bytes_per_block(format) == texture_format::color_channel_count(format);
+}
+
+}  // namespace
+
+std::optional<Image> Image::load(const std::filesystem::path& path, TextureFormat format) {
+  KEN_PROFILE_FUNCTION();
+  KEN_ASSERT(is_byte_color_format(format));
+
+  int width    = 0;
+  int height   = 0;
+  int channels = 0;
+
+  const int desired_channels = static_cast<int>(texture_format::color_channel_count(format));
+
+  // The thread-local flag keeps concurrent decodes from racing on stb_image's global one.
+  stbi_set_flip_vertically_on_load_thread(1);
+  stbi_uc* data = stbi_load(path.string().c_str(), &width, &height, &channels, desired_channels);
+
+  if (data == nullptr) {
+    KEN_CORE_CRITICAL("stb_image load error: {0}", stbi_failure_reason());
+    return std::nullopt;
+  }
+
+  KEN_ASSERT(width > 0);
+  KEN_ASSERT(height > 0);
+
+  Image image;
+  image.width_           = static_cast<std::uint32_t>(width);
+  image.height_          = static_cast<std::uint32_t>(height);
+  image.source_channels_ = static_cast<std::uint32_t>(channels);
+  image.format_          = format;
+  image.pixels_.reset(reinterpret_cast<std::byte*>(data));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+  KEN_CORE_INFO("Loaded image '{}' ({}x{}, source channels: {}, requested channels: {})", path.string(), width,
+                height, channels, desired_channels);
+  return image;
+}
+
+std::span<const std::byte> Image::pixels() const noexcept {
+  return {pixels_.get(), static_cast<std::size_t>(width_) * height_ * texture_format::bytes_per_block(format_)};
+}
+
+void Image::PixelDeleter::operator()(std::byte* pixels) const noexcept { stbi_image_free(pixels); }
+
+}  // namespace kEn
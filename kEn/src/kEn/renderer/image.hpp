@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include <kEn/renderer/texture.hpp>
+#include <kEn/renderer/texture_format.hpp>
+
+/** @file
+ *  @ingroup ken
+ *  @brief CPU-side decoding of image files into texture-ready pixels.
+ */
+
+namespace kEn {
+
+/**
+ * @brief Pixels decoded from an image file, ready to be uploaded with Texture::set_data().
+ *
+ * Decoding is independent of the graphics backend and thread-safe, so it can
+ * run on worker threads while only the upload happens on the main thread.
+ * Move-only.
+ */
+class Image {
+ public:
+  /**
+   * @brief Decodes the image file at @p path with stb_image.
+   *
+   * Rows are flipped to bottom-first, as OpenGL expects them.
+   *
+   * @param path   Image file in any format supported by stb_image.
+   * @param format Byte color format to convert the pixels to, e.g. @c TextureFormat::RGBA8.
+   * @return @c std::nullopt if the file cannot be read or decoded (logged).
+   */
+  [[nodiscard]] static std::optional<Image> load(const std::filesystem::path& path, TextureFormat format);
+
+  [[nodiscard]] std::uint32_t width() const noexcept { return width_; }
+  [[nodiscard]] std::uint32_t height() const noexcept { return height_; }
+  [[nodiscard]] TextureFormat format() const noexcept { return format_; }
+  /** @brief Number of channels stored in the file, before conversion to @ref format(). */
+  [[nodiscard]] std::uint32_t source_channels() const noexcept { return source_channels_; }
+
+  /** @brief Tightly packed pixels of mip level 0. */
+  [[nodiscard]] std::span<const std::byte> pixels() const noexcept;
+
+  /** @brief Descriptor of a 2D texture holding the image with @p mip_levels levels. */
+  [[nodiscard]] TextureDesc texture_desc(std::uint32_t mip_levels) const noexcept {
+    return TextureDesc::texture_2d(width_, height_, format_, mip_levels);
+  }
+
+ private:
+  /** @brief Releases pixels allocated by stb_image. */
+  struct PixelDeleter {
+    void operator()(std::byte* pixels) const noexcept;
+  };
+
+  Image() = default;
+
+  std::uint32_t width_           = 0;
+  std::uint32_t height_          = 0;
+  std::uint32_t source_channels_ = 0;
+  TextureFormat format_          = TextureFormat::RGBA8;
+  std::unique_ptr<std::byte[], PixelDeleter> pixels_;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+};
+
+}  // namespace kEn
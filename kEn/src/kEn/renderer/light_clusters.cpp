@@ -0,0 +1,207 @@
+#include "light_clusters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <mEn/functions/geometric.hpp>
+#include <mEn/functions/matrix_common.hpp>
+#include <mEn/mat4.hpp>
+#include <mEn/vec3.hpp>
+#include <mEn/vec4.hpp>
+
+#include <kEn/core/job_system.hpp>
+#include <kEn/core/profiler.hpp>
+
+namespace kEn {
+
+namespace {
+
+/** @brief Closest near plane used for slicing, so that orthographic views starting at 0 still get a finite scale. */
+constexpr float kMinNear = 1e-3F;
+
+constexpr std::uint32_t cluster_index(std::uint32_t x, std::uint32_t y, std::uint32_t z) {
+  return (((z * LightClusters::kTilesY) + y) * LightClusters::kTilesX) + x;
+}
+
+}  // namespace
+
+LightClusters::LightClusters() {
+  for (auto& slice : slices_) {
+    slice.indices.reserve(kTilesX * kTilesY);
+  }
+}
+
+void LightClusters::update_bounds(const mEn::Mat4& projection) {
+  if (projection == projection_) {
+    return;
+  }
+  projection_ = projection;
+
+  // OpenGL-style projections: perspective ones copy -z into w, orthographic ones leave w = 1.
+  const auto& p          = projection;
+  const bool perspective = p[2][3] != 0.F;
+  const float z_near     = std::max(perspective ? p[3][2] / (p[2][2] - 1.F) : (p[3][2] + 1.F) / p[2][2], kMinNear);
+  const float z_far      = perspective ? p[3][2] / (p[2][2] + 1.F) : (p[3][2] - 1.F) / p[2][2];
+
+  const float log_ratio = std::log(z_far / z_near);
+  header_.depth_scale   = static_cast<float>(kSlices) / log_ratio;
+  header_.depth_bias    = -header_.depth_scale * std::log(z_near);
+  for (std::uint32_t z = 0; z <= kSlices; ++z) {
+    slice_depths_[z] = z_near * std::exp(log_ratio * static_cast<float>(z) / static_cast<float>(kSlices));
+  }
+
+  // Tile corners on the near plane, in view space.
+  const mEn::Mat4 inverse = mEn::inverse(projection);
+  std::array<mEn::Vec3, (kTilesX + 1) * (kTilesY + 1)> corners;
+  for (std::uint32_t y = 0; y <= kTilesY; ++y) {
+    for (std::uint32_t x = 0; x <= kTilesX; ++x) {
+      const float ndc_x      = (2.F * static_cast<float>(x) / static_cast<float>(kTilesX)) - 1.F;
+      const float ndc_y      = (2.F * static_cast<float>(y) / static_cast<float>(kTilesY)) - 1.F;
+      const mEn::Vec4 corner = inverse * mEn::Vec4(ndc_x, ndc_y, -1.F, 1.F);
+
+      corners[(y * (kTilesX + 1)) + x] = mEn::Vec3(corner) / corner.w;
+    }
+  }
+
+  // A corner at view depth d lies on the ray through the near plane corner, or straight behind it.
+  const auto at_depth = [&](const mEn::Vec3& corner, float depth) {
+    return perspective ? corner * (depth / -corner.z) : mEn::Vec3(corner.x, corner.y, -depth);
+  };
+  for (std::uint32_t z = 0; z < kSlices; ++z) {
+    for (std::uint32_t y = 0; y < kTilesY; ++y) {
+      for (std::uint32_t x = 0; x < kTilesX; ++x) {
+        Aabb box;
+        for (const std::uint32_t corner : {(y * (kTilesX + 1)) + x, (y * (kTilesX + 1)) + x + 1,
+                                           ((y + 1) * (kTilesX + 1)) + x, ((y + 1) * (kTilesX + 1)) + x + 1}) {
+          for (const float depth : {slice_depths_[z], slice_depths_[z + 1]}) {
+            const mEn::Vec3 point = at_depth(corners[corner], depth);
+            box.min               = mEn::min(box.min, point);
+            box.max               = mEn::max(box.max, point);
+          }
+        }
+        const std::uint32_t index = cluster_index(x, y, z);
+        boxes_[index]             = box;
+        spheres_[index]           = {.center = box.center(), .radius = mEn::length(box.extents())};
+      }
+    }
+  }
+}
+
+void LightClusters::build(const mEn::Mat4& view, const mEn::Mat4& projection,
+                          std::span<const PointLight::Data> point_lights,
+                          std::span<const SpotLight::Data> spot_lights) {
+  KEN_PROFILE_FUNCTION();
+  update_bounds(projection);
+
+  point_spheres_.clear();
+  for (const auto& light : point_lights) {
+    point_spheres_.push_back({.center = mEn::Vec3(view * mEn::Vec4(light.pos, 1.F)), .radius = light.atten.radius()});
+  }
+
+  spot_spheres_.clear();
+  spot_cones_.clear();
+  for (const auto& light : spot_lights) {
+    const mEn::Vec3 tip = mEn::Vec3(view * mEn::Vec4(light.pos, 1.F));
+    const float range   = light.atten.radius();
+    const float cos     = std::clamp(light.outer_cutoff, -1.F, 1.F);
+    spot_spheres_.push_back({.center = tip, .radius = range});
+    spot_cones_.push_back({.tip       = tip,
+                           .dir       = mEn::normalize(mEn::Vec3(view * mEn::Vec4(light.dir, 0.F))),
+                           .range     = range,
+                           .cos_angle = cos,
+                           .sin_angle = std::sqrt(1.F - (cos * cos))});
+  }
+
+  JobSystem::parallel_for(
+      kSlices,
+      [this](std::size_t begin, std::size_t end) {
+        for (auto z = static_cast<std::uint32_t>(begin); z < end; ++z) {
+          assign_slice(z);
+        }
+      },
+      1, "LightClusters::build");
+
+  // Concatenate the slices' lists and make their offsets absolute.
+  indices_.clear();
+  stats_ = {.point_lights = point_lights.size(), .spot_lights = spot_lights.size()};
+  for (std::uint32_t z = 0; z < kSlices; ++z) {
+    const auto offset = static_cast<std::uint32_t>(indices_.size());
+    for (std::uint32_t tile = 0; tile < kTilesX * kTilesY; ++tile) {
+      Cluster& cluster = clusters_[cluster_index(0, 0, z) + tile];
+      cluster.first += offset;
+      stats_.max_lights = std::max<std::size_t>(stats_.max_lights, cluster.point_count + cluster.spot_count);
+    }
+    indices_.insert(indices_.end(), slices_[z].indices.begin(), slices_[z].indices.end());
+  }
+  stats_.references = indices_.size();
+}
+
+void LightClusters::assign_slice(std::uint32_t z) {
+  Slice& slice = slices_[z];
+  slice.indices.clear();
+
+  // View space looks down -z: a light overlaps the slice if its depth range does.
+  const float front   = slice_depths_[z];
+  const float back    = slice_depths_[z + 1];
+  const auto overlaps = [front, back](const Sphere& sphere) {
+    return -sphere.center.z + sphere.radius >= front && -sphere.center.z - sphere.radius <= back;
+  };
+  slice.points.clear();
+  for (std::uint32_t i = 0; i < point_spheres_.size(); ++i) {
+    if (overlaps(point_spheres_[i])) {
+      slice.points.push_back(i);
+    }
+  }
+  slice.spots.clear();
+  for (std::uint32_t i = 0; i < spot_spheres_.size(); ++i) {
+    if (overlaps(spot_spheres_[i])) {
+      slice.spots.push_back(i);
+    }
+  }
+
+  for (std::uint32_t tile = 0; tile < kTilesX * kTilesY; ++tile) {
+    const std::uint32_t index = cluster_index(0, 0, z) + tile;
+    const Aabb& box           = boxes_[index];
+    Cluster& cluster          = clusters_[index];
+    cluster.first             = static_cast<std::uint32_t>(slice.indices.size());
+
+    for (const std::uint32_t light : slice.points) {
+      if (point_spheres_[light].overlaps(box)) {
+        slice.indices.push_back(light);
+      }
+    }
+    cluster.point_count = static_cast<std::uint32_t>(slice.indices.size()) - cluster.first;
+
+    const Sphere& bounds = spheres_[index];
+    for (const std::uint32_t light : slice.spots) {
+      if (!spot_spheres_[light].overlaps(box)) {
+        continue;
+      }
+      // Cones wider than 90 degrees reach behind their tip, which the test below rejects; the sphere test has to do.
+      const Cone& cone = spot_cones_[light];
+      if (cone.cos_angle < 0.F) {
+        slice.indices.push_back(light);
+        continue;
+      }
+
+      // Sphere against cone: distance from the sphere center to the cone's surface, and its front and back caps.
+      const mEn::Vec3 to   = bounds.center - cone.tip;
+      const float along    = mEn::dot(to, cone.dir);
+      const float across   = std::sqrt(std::max(mEn::dot(to, to) - (along * along), 0.F));
+      const float distance = (cone.cos_angle * across) - (along * cone.sin_angle);
+      const bool outside   = distance > bounds.radius;
+      const bool beyond    = along > bounds.radius + cone.range;
+      const bool behind    = along < -bounds.radius;
+      if (!outside && !beyond && !behind) {
+        slice.indices.push_back(light);
+      }
+    }
+    cluster.spot_count = static_cast<std::uint32_t>(slice.indices.size()) - cluster.first - cluster.point_count;
+  }
+}
+
+}  // namespace kEn
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <mEn/mat4.hpp>
+#include <mEn/vec3.hpp>
+
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/components/light.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+/**
+ * @brief CPU assignment of point and spot lights to the clusters of a view frustum.
+ *
+ * The frustum is cut into @ref kTilesX x @ref kTilesY screen tiles and
+ * @ref kSlices depth slices whose thickness grows exponentially with the
+ * distance, so that clusters stay roughly cubic.  @ref build tests the view-space
+ * bounds of every light against every cluster it may touch, one depth slice per
+ * job, and produces one compact list of light indices per cluster.  Fragment
+ * shaders find their cluster from their position (see `light.glsl`) and only
+ * shade the lights in its list.
+ *
+ * Point lights are bounded by a sphere of their attenuation radius, where
+ * `light.glsl` fades their attenuation out to 0; spot lights are additionally
+ * tested as a cone against the bounding sphere of the cluster.
+ */
+class LightClusters {
+ public:
+  static constexpr std::uint32_t kTilesX       = 16;
+  static constexpr std::uint32_t kTilesY       = 9;
+  static constexpr std::uint32_t kSlices       = 24;
+  static constexpr std::uint32_t kClusterCount = kTilesX * kTilesY * kSlices;
+
+  /** @brief std430 header of the `LightClusters` buffer in `light.glsl`. */
+  struct Header {
+    std::uint32_t tiles_x = kTilesX;
+    std::uint32_t tiles_y = kTilesY;
+    std::uint32_t slices  = kSlices;
+    std::uint32_t pad0    = 0;
+    float depth_scale     = 0.F;  ///< Slice of view depth @c z is <tt>log(z) * depth_scale + depth_bias</tt>.
+    float depth_bias      = 0.F;  ///< @copydoc depth_scale
+    float pad1            = 0.F;
+    float pad2            = 0.F;
+  };
+  static_assert(sizeof(Header) == 32, "Header must match the std430 layout of the LightClusters block");
+
+  /** @brief std430 layout of one entry of the cluster array; its point lights come first in the index list. */
+  struct Cluster {
+    std::uint32_t first       = 0;  ///< Offset of the cluster's lights in @ref indices().
+    std::uint32_t point_count = 0;
+    std::uint32_t spot_count  = 0;
+    std::uint32_t pad0        = 0;
+  };
+  static_assert(sizeof(Cluster) == 16, "Cluster must match the std430 light_cluster struct");
+
+  /** @brief Counters of the last @ref build. */
+  struct Stats {
+    std::size_t point_lights = 0;
+    std::size_t spot_lights  = 0;
+    std::size_t references   = 0;  ///< Total length of the index lists.
+    std::size_t max_lights   = 0;  ///< Longest list of a single cluster.
+  };
+
+  LightClusters();
+
+  /**
+   * @brief Rebuilds the clusters of a view and assigns @p point_lights and @p spot_lights to them.
+   *
+   * Indices in the lists refer to positions in the given spans, which must be
+   * uploaded in the same order.
+   *
+   * @param view       World-to-view matrix.
+   * @param projection OpenGL-style projection matrix; near and far planes are read from it.
+   */
+  void build(const mEn::Mat4& view, const mEn::Mat4& projection, std::span<const PointLight::Data> point_lights,
+             std::span<const SpotLight::Data> spot_lights);
+
+  [[nodiscard]] const Header& header() const noexcept { return header_; }
+  /** @brief Clusters ordered by slice, then row, then column. */
+  [[nodiscard]] std::span<const Cluster> clusters() const noexcept { return clusters_; }
+  /** @brief Concatenated light lists of all clusters. */
+  [[nodiscard]] std::span<const std::uint32_t> indices() const noexcept { return indices_; }
+  [[nodiscard]] const Stats& stats() const noexcept { return stats_; }
+
+ private:
+  /** @brief View-space bounding cone of a spot light. */
+  struct Cone {
+    mEn::Vec3 tip;
+    mEn::Vec3 dir;
+    float range;
+    float cos_angle;
+    float sin_angle;
+  };
+
+  /** @brief Per-slice output and scratch, written by one job only. */
+  struct Slice {
+    std::vector<std::uint32_t> indices;  ///< Light lists of the slice's clusters, relative to the slice.
+    std::vector<std::uint32_t> points;   ///< Point lights overlapping the slice's depth range.
+    std::vector<std::uint32_t> spots;    ///< Spot lights overlapping the slice's depth range.
+  };
+
+  /** @brief Recomputes the cluster bounds when the projection changed since the last build. */
+  void update_bounds(const mEn::Mat4& projection);
+  /** @brief Assigns the lights overlapping slice @p z to its clusters. */
+  void assign_slice(std::uint32_t z);
+
+  mEn::Mat4 projection_{0.F};
+  Header header_;
+  std::array<Cluster, kClusterCount> clusters_{};
+  std::array<Aabb, kClusterCount> boxes_{};      ///< View-space bounds of each cluster.
+  std::array<Sphere, kClusterCount> spheres_{};  ///< Bounding spheres of @ref boxes_, for the cone test.
+  std::array<float, kSlices + 1> slice_depths_{};
+  std::array<Slice, kSlices> slices_{};
+
+  std::vector<Sphere> point_spheres_;
+  std::vector<Sphere> spot_spheres_;
+  std::vector<Cone> spot_cones_;
+  std::vector<std::uint32_t> indices_;
+  Stats stats_;
+};
+
+}  // namespace kEn
@@ -1,20 +1,45 @@
 #include "material.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <format>
+#include <cstring>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include <kEn/core/assert.hpp>
+#include <kEn/core/log.hpp>
 #include <kEn/renderer/render_context.hpp>
 #include <kEn/renderer/shader.hpp>
 #include <kEn/renderer/texture.hpp>
+#include <kEn/renderer/uniform_id.hpp>
 
 namespace kEn {
 
+namespace {
+
+constexpr UniformId kMaterialIndex{"u_MaterialIndex"};
+
+}  // namespace
+
+std::vector<Material::Packed> MaterialTable::blocks_;
+std::vector<std::uint32_t> MaterialTable::references_;
+std::vector<std::uint32_t> MaterialTable::free_;
+std::unordered_map<Material::Packed, std::uint32_t, MaterialTable::BytesHash, MaterialTable::BytesEqual>
+    MaterialTable::index_;
+std::size_t MaterialTable::dirty_begin_ = 0;
+std::size_t MaterialTable::dirty_end_   = 0;
+
 void Material::set_texture(TextureType type, std::shared_ptr<kEn::Texture> texture, std::size_t id) {
+  // The bindings point at the textures, which may be about to go away.
+  block_.reset();
+  texture_bindings_.clear();
+
   auto& texs = textures_[to_index(type)];
   if (id < texs.size()) {
     texs[id] = std::move(texture);
@@ -35,29 +60,149 @@ std::shared_ptr<Texture> Material::texture(TextureType type, std::size_t id) con
 
 std::size_t Material::texture_count(TextureType type) const noexcept { return textures_[to_index(type)].size(); }
 
-void Material::apply(Shader& shader, RenderContext& context, std::string_view name) const {
-  shader.set_uniform(std::format("{}.ka", name), ambient_factor);
-  shader.set_uniform(std::format("{}.kd", name), diffuse_factor);
-  shader.set_uniform(std::format("{}.ks", name), specular_factor);
-  shader.set_uniform(std::format("{}.m", name), shininess_factor);
-  shader.set_uniform(std::format("{}.emissive", name), emissive);
-  shader.set_uniform(std::format("{}.surface_color", name), surface_color);
-
-  for (auto i = std::uint8_t{0}; i < std::to_underlying(TextureType::Count); ++i) {
-    const int count = static_cast<int>(textures_[i].size());
-    shader.set_uniform(std::format("{}.{}_count", name, texture_type::name_of(static_cast<TextureType>(i))), count);
-  }
+void Material::bake() {
+  Packed packed{.ka             = ambient_factor,
+                .kd             = diffuse_factor,
+                .ks             = specular_factor,
+                .m              = shininess_factor,
+                .surface_color  = surface_color,
+                .emissive       = emissive ? 1U : 0U,
+                .texture_counts = {}};
 
-  std::uint32_t texture_id = 0;
+  texture_bindings_.clear();
   for (auto i = std::uint8_t{0}; i < std::to_underlying(TextureType::Count); ++i) {
     const auto& texs = textures_[i];
-    for (std::size_t j = 0; j < texs.size(); ++j) {
-      shader.set_uniform(std::format("{}_{}[{}]", name, texture_type::name_of(static_cast<TextureType>(i)), j),
-                         static_cast<int>(texture_id));
-      context.bind_texture(texture_id, ShaderStage::Fragment, *texs[j]);
-      ++texture_id;
+    if (texs.size() > kMaxTexturesPerType) {
+      KEN_CORE_WARN("Material has {0} {1} textures, only the first {2} are bound", texs.size(),
+                    texture_type::name_of(static_cast<TextureType>(i)), kMaxTexturesPerType);
+    }
+
+    const std::size_t count  = std::min(texs.size(), kMaxTexturesPerType);
+    packed.texture_counts[i] = static_cast<std::int32_t>(count);
+    for (std::size_t j = 0; j < count; ++j) {
+      texture_bindings_.push_back(
+          {.unit = static_cast<std::uint32_t>((i * kMaxTexturesPerType) + j), .texture = texs[j].get()});
     }
   }
+
+  block_.assign(packed);
+}
+
+void Material::apply(Shader& shader, RenderContext& context) const {
+  KEN_CORE_ASSERT(baked(), "Material applied before it was baked");
+  if (!shader.has_uniform(kMaterialIndex)) {
+    return;
+  }
+
+  shader.set_uniform(kMaterialIndex, block_.index());
+  for (const auto& binding : texture_bindings_) {
+    context.bind_texture(binding.unit, ShaderStage::Fragment, *binding.texture);
+  }
+}
+
+Material::BlockRef::BlockRef(const BlockRef& other) : index_(other.index_) {
+  if (index_ != kNoBlock) {
+    MaterialTable::retain(index_);
+  }
+}
+
+Material::BlockRef::BlockRef(BlockRef&& other) noexcept : index_(std::exchange(other.index_, kNoBlock)) {}
+
+Material::BlockRef& Material::BlockRef::operator=(const BlockRef& other) {
+  if (other.index_ != kNoBlock) {
+    MaterialTable::retain(other.index_);
+  }
+  reset();
+  index_ = other.index_;
+  return *this;
+}
+
+Material::BlockRef& Material::BlockRef::operator=(BlockRef&& other) noexcept {
+  if (this != &other) {
+    reset();
+    index_ = std::exchange(other.index_, kNoBlock);
+  }
+  return *this;
+}
+
+Material::BlockRef::~BlockRef() { reset(); }
+
+void Material::BlockRef::assign(const Material::Packed& packed) { index_ = MaterialTable::replace(index_, packed); }
+
+void Material::BlockRef::reset() noexcept {
+  if (index_ != kNoBlock) {
+    MaterialTable::release(std::exchange(index_, kNoBlock));
+  }
+}
+
+std::uint32_t MaterialTable::intern(const Material::Packed& block) {
+  const auto [it, inserted] = index_.try_emplace(block, 0);
+  if (!inserted) {
+    ++references_[it->second];
+    return it->second;
+  }
+
+  if (free_.empty()) {
+    it->second = static_cast<std::uint32_t>(blocks_.size());
+    blocks_.push_back(block);
+    references_.push_back(1);
+  } else {
+    it->second = free_.back();
+    free_.pop_back();
+    blocks_[it->second]     = block;
+    references_[it->second] = 1;
+  }
+  mark_dirty(it->second);
+  return it->second;
+}
+
+std::uint32_t MaterialTable::replace(std::uint32_t index, const Material::Packed& block) {
+  if (index != Material::kNoBlock && references_[index] == 1 && !index_.contains(block)) {
+    index_.erase(blocks_[index]);
+    blocks_[index] = block;
+    index_.emplace(block, index);
+    mark_dirty(index);
+    return index;
+  }
+
+  // Interned first, so that a block equal to the current one is not freed on the way.
+  const std::uint32_t result = intern(block);
+  if (index != Material::kNoBlock) {
+    release(index);
+  }
+  return result;
+}
+
+void MaterialTable::retain(std::uint32_t index) {
+  KEN_CORE_ASSERT(references_[index] > 0, "Retaining a free material block");
+  ++references_[index];
+}
+
+void MaterialTable::release(std::uint32_t index) {
+  KEN_CORE_ASSERT(references_[index] > 0, "Releasing a free material block");
+  if (--references_[index] == 0) {
+    index_.erase(blocks_[index]);
+    free_.push_back(index);
+  }
+}
+
+void MaterialTable::mark_dirty(std::uint32_t index) noexcept {
+  if (dirty_begin_ == dirty_end_) {
+    dirty_begin_ = index;
+    dirty_end_   = index + 1;
+    return;
+  }
+  dirty_begin_ = std::min<std::size_t>(dirty_begin_, index);
+  dirty_end_   = std::max<std::size_t>(dirty_end_, index + 1);
+}
+
+std::size_t MaterialTable::BytesHash::operator()(const Material::Packed& block) const noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(&block), sizeof(block)));
+}
+
+bool MaterialTable::BytesEqual::operator()(const Material::Packed& lhs, const Material::Packed& rhs) const noexcept {
+  return std::memcmp(&lhs, &rhs, sizeof(Material::Packed)) == 0;
 }
 
 }  // namespace kEn
@@ -2,8 +2,11 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <mEn.hpp>
@@ -53,11 +56,38 @@ inline constexpr util::EnumMap kNames{{
  * @brief Phong-shaded surface description passed to a @ref Shader.
  *
  * Stores per-type texture arrays alongside scalar Phong coefficients and
- * surface flags. Call @ref apply to upload uniforms and activate texture
- * units in a single step before drawing.
+ * surface flags. Once set up, a material is baked: its parameters are packed
+ * into a block of the @ref MaterialTable, shared with every material that has
+ * the same ones, and the texture units of its textures are resolved. @ref apply
+ * then only selects the block and binds the textures. Changes to the public
+ * fields take effect at the next @ref bake. Copies of a baked material hold
+ * their own reference to its block; the last one to go frees it.
  */
 class Material {
  public:
+  /** @brief Textures of each type a shader can sample; see @c MAX_TEXTURES in @c material.glsl. */
+  static constexpr std::size_t kMaxTexturesPerType = 3;
+  /** @brief Value of @ref block before the material is baked. */
+  static constexpr std::uint32_t kNoBlock = ~0U;
+
+  /** @brief std430 layout of @c material in @c material.glsl. */
+  struct alignas(16) Packed {
+    float ka;
+    float kd;
+    float ks;
+    float m;
+    mEn::Vec3 surface_color;
+    std::uint32_t emissive;
+    std::array<std::int32_t, static_cast<std::size_t>(TextureType::Count)> texture_counts;
+  };
+  static_assert(sizeof(Packed) == 48, "Packed must match the std430 material struct");
+
+  /** @brief Texture and the unit @ref apply binds it to. */
+  struct TextureBinding {
+    std::uint32_t unit;
+    const Texture* texture;
+  };
+
   Material() = default;
 
   /**
@@ -65,7 +95,7 @@ class Material {
    *
    * Textures must be added in ascending @p id order; gaps are not allowed.
    * Assigning to an existing @p id replaces it; assigning to `id == size`
-   * appends.
+   * appends. The material must be baked again before it is drawn.
    *
    * @param type    Semantic category (e.g. @c TextureType::Diffuse).
    * @param texture Shared ownership of the texture to store.
@@ -93,18 +123,33 @@ class Material {
   [[nodiscard]] std::size_t texture_count(TextureType type) const noexcept;
 
   /**
-   * @brief Upload Phong uniforms and bind all textures to consecutive units.
+   * @brief Pack the parameters into a shared block and resolve the texture units.
+   *
+   * Textures of type @c t are bound to units <tt>t * kMaxTexturesPerType</tt>
+   * onwards, where the sampler arrays of @c material.glsl expect them; textures
+   * past @ref kMaxTexturesPerType of one type are left out. Must be called on
+   * the main thread.
+   */
+  void bake();
+
+  /** @brief Returns whether @ref bake was called since the textures last changed. */
+  [[nodiscard]] bool baked() const noexcept { return block_.index() != kNoBlock; }
+  /** @brief Index of the material's parameters in @ref MaterialTable::blocks(), or @ref kNoBlock. */
+  [[nodiscard]] std::uint32_t block() const noexcept { return block_.index(); }
+  /** @brief Textures bound by @ref apply, in unit order. */
+  [[nodiscard]] std::span<const TextureBinding> texture_bindings() const noexcept { return texture_bindings_; }
+
+  /**
+   * @brief Select the material's block and bind its textures.
    *
-   * Uploads `<name>.ka/kd/ks/m/emissive/surface_color` and one sampler
-   * uniform per stored texture, then activates each texture unit via
-   * @p context. Texture units are assigned in @ref TextureType declaration
-   * order (AmbientOcclusion first, Specular last).
+   * Sets the `u_MaterialIndex` uniform and binds the baked textures via
+   * @p context. Shaders without that uniform, e.g. depth-only ones, are left
+   * untouched.
    *
    * @param shader  Target shader program.
    * @param context The active RenderContext to route texture binding through.
-   * @param name    GLSL struct name prefix (default @c "u_Material").
    */
-  void apply(Shader& shader, RenderContext& context, std::string_view name = "u_Material") const;
+  void apply(Shader& shader, RenderContext& context) const;
 
   float ambient_factor   = 0.5F;
   float diffuse_factor   = 0.5F;
@@ -122,6 +167,86 @@ class Material {
   }
 
   std::array<std::vector<std::shared_ptr<Texture>>, static_cast<std::size_t>(TextureType::Count)> textures_;
+
+  /** @brief Counted reference to a @ref MaterialTable block, so that materials stay copyable. */
+  class BlockRef {
+   public:
+    BlockRef() = default;
+    BlockRef(const BlockRef& other);
+    BlockRef(BlockRef&& other) noexcept;
+    BlockRef& operator=(const BlockRef& other);
+    BlockRef& operator=(BlockRef&& other) noexcept;
+    ~BlockRef();
+
+    /** @brief Refer to a block equal to @p packed instead, overwriting the current one if nothing else uses it. */
+    void assign(const Material::Packed& packed);
+    /** @brief Drop the reference. */
+    void reset() noexcept;
+
+    [[nodiscard]] std::uint32_t index() const noexcept { return index_; }
+
+   private:
+    std::uint32_t index_ = kNoBlock;
+  };
+
+  BlockRef block_;
+  std::vector<TextureBinding> texture_bindings_;
+};
+
+/**
+ * @brief Hash-consed, reference-counted parameter blocks of all baked materials.
+ *
+ * Materials with equal parameters share one block. A block keeps its index
+ * while it is referenced; once it is not, its slot is reused by the next new
+ * block, and a block with a single reference is rewritten in place when its
+ * material is baked again, so editing materials does not grow the table. The
+ * renderer uploads the blocks written since its last upload to the
+ * `Materials` storage buffer of @c material.glsl. Main thread only.
+ */
+class MaterialTable {
+ public:
+  /** @brief Returns the index of the block equal to @p block, adding it if there is none, and references it. */
+  [[nodiscard]] static std::uint32_t intern(const Material::Packed& block);
+  /**
+   * @brief Moves a reference from block @p index to one equal to @p block and returns that one's index.
+   *
+   * If nothing else references @p index and no block equals @p block, @p index is overwritten in place.
+   * @p index may be @ref Material::kNoBlock, which makes this @ref intern.
+   */
+  [[nodiscard]] static std::uint32_t replace(std::uint32_t index, const Material::Packed& block);
+  /** @brief References block @p index once more. */
+  static void retain(std::uint32_t index);
+  /** @brief Drops a reference to block @p index; its slot is reused once none are left. */
+  static void release(std::uint32_t index);
+
+  /** @brief All blocks, indexed by @ref Material::block(); unreferenced ones hold stale parameters. */
+  [[nodiscard]] static std::span<const Material::Packed> blocks() noexcept { return blocks_; }
+  /** @brief Number of references to block @p index. */
+  [[nodiscard]] static std::uint32_t references(std::uint32_t index) { return references_.at(index); }
+  /** @brief Smallest range of @ref blocks() holding every block written since the last @ref clear_dirty. */
+  [[nodiscard]] static std::span<const Material::Packed> dirty_blocks() noexcept {
+    return std::span(blocks_).subspan(dirty_begin_, dirty_end_ - dirty_begin_);
+  }
+  /** @brief Marks every block as uploaded. */
+  static void clear_dirty() noexcept { dirty_begin_ = dirty_end_ = 0; }
+
+ private:
+  /** @brief Blocks are compared bitwise, so that hashing and equality agree on e.g. @c -0.F. */
+  struct BytesHash {
+    std::size_t operator()(const Material::Packed& block) const noexcept;
+  };
+  struct BytesEqual {
+    bool operator()(const Material::Packed& lhs, const Material::Packed& rhs) const noexcept;
+  };
+
+  static void mark_dirty(std::uint32_t index) noexcept;
+
+  static std::vector<Material::Packed> blocks_;
+  static std::vector<std::uint32_t> references_;  ///< Per block; 0 for free slots.
+  static std::vector<std::uint32_t> free_;        ///< Free slots, reused before the table grows.
+  static std::unordered_map<Material::Packed, std::uint32_t, BytesHash, BytesEqual> index_;  ///< Referenced blocks.
+  static std::size_t dirty_begin_;
+  static std::size_t dirty_end_;
 };
 
 }  // namespace kEn
@@ -2,9 +2,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
 #include <mEn/vec4.hpp>
 
+#include <kEn/core/core.hpp>
 #include <kEn/renderer/framebuffer.hpp>
 #include <kEn/renderer/render_state.hpp>
 #include <kEn/renderer/shader.hpp>
@@ -41,6 +43,13 @@ using enum RenderMode;
 
 }  // namespace render_mode
 
+/** @brief GPU time of one timing scope, see @ref RenderContext::begin_gpu_scope. */
+struct GpuTiming {
+  const char* name;    /**< Name passed to @ref RenderContext::begin_gpu_scope. */
+  double milliseconds; /**< GPU time between the scope's begin and end. */
+  std::uint32_t depth; /**< Number of scopes the scope is nested in. */
+};
+
 /**
  * @brief Abstract rendering context providing GPU pipeline control.
  *
@@ -49,6 +58,11 @@ using enum RenderMode;
  * state, shader and vertex input binding, resource binding, render targets, and
  * tessellation parameters.
  *
+ * GPU timing scopes measure how long the GPU spends on the commands issued
+ * between @ref begin_gpu_scope() and @ref end_gpu_scope().  Results arrive a
+ * few frames late and are never waited for; @ref gpu_timings() returns those
+ * of the newest frame whose results are in.
+ *
  * Instances are obtained from the platform layer and are not created directly.
  */
 class RenderContext {
@@ -228,6 +242,37 @@ class RenderContext {
    * @return Maximum tessellation generation level.
    */
   [[nodiscard]] virtual std::size_t max_tessellation_level() const = 0;
+
+  /**
+   * @brief Opens a GPU timing scope.  Scopes may nest and must be closed in the frame they were opened in.
+   * @param name Static string; only the pointer is stored.
+   */
+  virtual void begin_gpu_scope(const char* name) = 0;
+
+  /** @brief Closes the innermost open GPU timing scope. */
+  virtual void end_gpu_scope() = 0;
+
+  /**
+   * @brief Returns the GPU timings of the newest frame whose results are available.
+   * @return Timings in the order the scopes were opened; empty if the backend does not measure GPU time.
+   */
+  [[nodiscard]] virtual std::span<const GpuTiming> gpu_timings() const = 0;
+};
+
+/** @brief RAII GPU timing scope, see @ref RenderContext::begin_gpu_scope. */
+class GpuScope {
+ public:
+  /**
+   * @param context Context the scope's commands are issued to.
+   * @param name    Static string; only the pointer is stored.
+   */
+  GpuScope(RenderContext& context, const char* name) : context_(&context) { context_->begin_gpu_scope(name); }
+  ~GpuScope() { context_->end_gpu_scope(); }
+
+  DELETE_COPY_MOVE(GpuScope);
+
+ private:
+  RenderContext* context_;
 };
 
 }  // namespace kEn
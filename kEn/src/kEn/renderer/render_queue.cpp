@@ -0,0 +1,128 @@
+#include "render_queue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <mEn/functions/matrix_common.hpp>
+#include <mEn/mat4.hpp>
+
+#include <kEn/core/profiler.hpp>
+
+namespace kEn {
+
+namespace {
+
+// Key layout, most significant first:
+//   opaque:      pass:2 | shader:14 | material:16 | vertex input:16 | depth:16
+//   transparent: pass:2 | inverted depth:16 | shader:14 | material:16 | vertex input:16
+constexpr int kPassBits   = 2;
+constexpr int kShaderBits = 14;
+constexpr int kObjectBits = 16;
+constexpr int kDepthBits  = 16;
+
+constexpr int kRadixBits       = 8;
+constexpr std::size_t kBuckets = std::size_t{1} << kRadixBits;
+constexpr int kDigits          = 64 / kRadixBits;
+
+/** @brief Fibonacci hash of a pointer, reduced to its top @p bits bits. */
+std::uint64_t hash_bits(const void* ptr, int bits) noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto value = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr));
+  value ^= value >> 29U;
+  value *= 0x9E3779B97F4A7C15ULL;
+  return value >> (64 - bits);
+}
+
+/** @brief Top bits of a non-negative float, which order the same way as the float itself. */
+std::uint64_t depth_bits(float depth) noexcept {
+  return std::bit_cast<std::uint32_t>(std::max(depth, 0.F)) >> (32 - kDepthBits);
+}
+
+}  // namespace
+
+ObjectData ObjectData::from(const mEn::Mat4& world, const mEn::Mat4& world_to_local, const mEn::Mat4& previous_world) {
+  return {.world = world, .normal = mEn::transpose(world_to_local), .previous_world = previous_world};
+}
+
+ObjectData ObjectData::from(const mEn::Mat4& world) { return from(world, mEn::inverse(world), world); }
+
+std::uint64_t RenderQueue::make_key(RenderPass pass, const Shader& shader, const Material* material,
+                                    const VertexInput& vertex_input, float depth) noexcept {
+  const std::uint64_t shader_bits   = hash_bits(&shader, kShaderBits);
+  const std::uint64_t material_bits = material != nullptr ? hash_bits(material, kObjectBits) : 0;
+  const std::uint64_t input_bits    = hash_bits(&vertex_input, kObjectBits);
+  const std::uint64_t state         = (((shader_bits << kObjectBits) | material_bits) << kObjectBits) | input_bits;
+
+  std::uint64_t key = static_cast<std::uint64_t>(pass) << (64 - kPassBits);
+  if (pass == RenderPass::Transparent) {
+    const std::uint64_t far_first = ((std::uint64_t{1} << kDepthBits) - 1) - depth_bits(depth);
+    key |= (far_first << (kShaderBits + (2 * kObjectBits))) | state;
+  } else {
+    key |= (state << kDepthBits) | depth_bits(depth);
+  }
+  return key;
+}
+
+void RenderQueue::clear() {
+  packets_.clear();
+  objects_.clear();
+  entries_.clear();
+  order_.clear();
+}
+
+std::uint32_t RenderQueue::add_object(const ObjectData& object) {
+  objects_.push_back(object);
+  return static_cast<std::uint32_t>(objects_.size() - 1);
+}
+
+void RenderQueue::push(std::uint64_t key, const DrawPacket& packet) {
+  const auto index = static_cast<std::uint32_t>(packets_.size());
+  packets_.push_back(packet);
+  entries_.push_back({.key = key, .packet = index});
+  order_.push_back(index);
+}
+
+void RenderQueue::sort() {
+  KEN_PROFILE_FUNCTION();
+  const std::size_t count = entries_.size();
+  if (count < 2) {
+    return;
+  }
+
+  // One histogram per digit, all filled in a single pass.
+  std::array<std::array<std::uint32_t, kBuckets>, kDigits> histograms{};
+  for (const auto& entry : entries_) {
+    for (int digit = 0; digit < kDigits; ++digit) {
+      ++histograms[digit][(entry.key >> (digit * kRadixBits)) & (kBuckets - 1)];
+    }
+  }
+
+  scratch_.resize(count);
+  for (int digit = 0; digit < kDigits; ++digit) {
+    auto& histogram   = histograms[digit];
+    const int shift   = digit * kRadixBits;
+    const auto sample = (entries_.front().key >> shift) & (kBuckets - 1);
+    if (histogram[sample] == count) {
+      continue;  // Every key has the same digit here
+    }
+
+    std::uint32_t offset = 0;
+    for (auto& bucket : histogram) {
+      offset += std::exchange(bucket, offset);
+    }
+    for (const auto& entry : entries_) {
+      scratch_[histogram[(entry.key >> shift) & (kBuckets - 1)]++] = entry;
+    }
+    entries_.swap(scratch_);
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    order_[i] = entries_[i].packet;
+  }
+}
+
+}  // namespace kEn
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <mEn/mat4.hpp>
+
+#include <kEn/renderer/render_context.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+class Material;
+class Shader;
+class VertexInput;
+
+/** @brief Coarse draw ordering bucket; the most significant bits of a sort key. */
+enum class RenderPass : std::uint8_t {
+  Opaque,      /**< Sorted by state to minimize binds, then front to back. */
+  Transparent, /**< Drawn after opaque geometry, back to front. */
+};
+
+/**
+ * @brief Per-object constants, mirroring the std430 `object_data` struct of `object.glsl`.
+ *
+ * Every view gathers the objects it draws into one array that is uploaded as
+ * a storage buffer; draws find their entry through the base instance.
+ */
+struct ObjectData {
+  mEn::Mat4 world;           /**< Local-to-world matrix. */
+  mEn::Mat4 normal;          /**< Transposed world-to-local matrix, for normals. */
+  mEn::Mat4 previous_world;  /**< @ref world of the previous frame. */
+
+  /**
+   * @brief Builds the constants of an object from matrices that are already known, e.g. cached by a @ref Transform.
+   * @param world          Local-to-world matrix.
+   * @param world_to_local Inverse of @p world.
+   * @param previous_world Local-to-world matrix of the previous frame.
+   */
+  [[nodiscard]] static ObjectData from(const mEn::Mat4& world, const mEn::Mat4& world_to_local,
+                                       const mEn::Mat4& previous_world);
+  /** @brief Builds the constants of a static object, inverting @p world. */
+  [[nodiscard]] static ObjectData from(const mEn::Mat4& world);
+};
+static_assert(sizeof(ObjectData) == 3 * sizeof(mEn::Mat4), "ObjectData must match the std430 object_data struct");
+
+/**
+ * @brief Everything needed to issue one draw call later.
+ *
+ * Refers to its shader, vertex input and material by pointer: they must stay
+ * alive until the queue is executed.
+ */
+struct DrawPacket {
+  static constexpr std::uint32_t kNoObject = ~0U;  ///< Drawn with a base instance of 0.
+
+  Shader* shader                  = nullptr;
+  const VertexInput* vertex_input = nullptr;
+  const Material* material        = nullptr;       /**< Applied before the draw; may be null. */
+  std::uint32_t object            = kNoObject;     /**< Index into @ref RenderQueue::objects(), the base instance. */
+  std::uint32_t first             = 0;             /**< First index or vertex. */
+  std::uint32_t count             = 0;             /**< Number of indices or vertices. */
+  std::uint32_t instance_count    = 1;
+  std::uint32_t patch_vertices    = 0;             /**< Control points per patch of tessellated draws, else 0. */
+  RenderMode mode                 = RenderMode::Triangles;
+  bool indexed                    = false;
+};
+
+/**
+ * @brief Draws of one view, collected during a frame and executed in sort-key order.
+ *
+ * Every packet gets a 64-bit key built by @ref make_key.  Opaque keys order by
+ * shader, material and vertex input, so that draws sharing state end up next
+ * to each other, and then front to back.  Transparent keys put depth first, so
+ * that they are drawn back to front.  @ref sort is a stable LSD radix sort
+ * that skips the byte positions all keys agree on, so in practice it takes
+ * four to six passes over the queue.
+ */
+class RenderQueue {
+ public:
+  /**
+   * @brief Builds the sort key of a draw.
+   *
+   * Shader, material and vertex input are hashed into a few bits each: a
+   * collision only costs grouping quality, as redundant binds are detected by
+   * comparing the pointers themselves.
+   *
+   * @param depth Distance of the drawn object from the camera; negative values are clamped to 0.
+   */
+  [[nodiscard]] static std::uint64_t make_key(RenderPass pass, const Shader& shader, const Material* material,
+                                              const VertexInput& vertex_input, float depth) noexcept;
+
+  /** @brief Removes all packets and objects, keeping the allocations. */
+  void clear();
+
+  /** @brief Stores the constants of an object for packets to refer to, returning its index. */
+  [[nodiscard]] std::uint32_t add_object(const ObjectData& object);
+  /** @brief Appends @p packet with sort key @p key. */
+  void push(std::uint64_t key, const DrawPacket& packet);
+
+  /** @brief Orders the queue by key; packets with equal keys keep their submission order. */
+  void sort();
+
+  [[nodiscard]] std::size_t size() const noexcept { return packets_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return packets_.empty(); }
+
+  /** @brief Packets in submission order. */
+  [[nodiscard]] std::span<const DrawPacket> packets() const noexcept { return packets_; }
+  /** @brief Indices into @ref packets() in execution order; submission order until @ref sort is called. */
+  [[nodiscard]] std::span<const std::uint32_t> order() const noexcept { return order_; }
+  /** @brief Objects in the order they were added; packets refer to them by index. */
+  [[nodiscard]] std::span<const ObjectData> objects() const noexcept { return objects_; }
+
+ private:
+  struct SortEntry {
+    std::uint64_t key;
+    std::uint32_t packet;
+  };
+
+  std::vector<DrawPacket> packets_;
+  std::vector<ObjectData> objects_;
+  std::vector<SortEntry> entries_;
+  std::vector<SortEntry> scratch_;
+  std::vector<std::uint32_t> order_;
+};
+
+}  // namespace kEn
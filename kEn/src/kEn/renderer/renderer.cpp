@@ -1,56 +1,281 @@
 #include "renderer.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <string>
+#include <span>
+#include <vector>
+
+#include <mEn/functions/geometric.hpp>
+#include <mEn/mat4.hpp>
+#include <mEn/vec3.hpp>
+#include <mEn/vec4.hpp>
 
 #include <kEn/core/assert.hpp>
+#include <kEn/core/profiler.hpp>
+#include <kEn/renderer/buffer.hpp>
+#include <kEn/renderer/device.hpp>
+#include <kEn/renderer/light_clusters.hpp>
+#include <kEn/renderer/material.hpp>
 #include <kEn/renderer/render_context.hpp>
+#include <kEn/renderer/render_queue.hpp>
 #include <kEn/renderer/shader.hpp>
 #include <kEn/renderer/vertex_input.hpp>
+#include <kEn/scene/assets/mesh_lod.hpp>
+#include <kEn/scene/bounds.hpp>
 #include <kEn/scene/components/camera.hpp>
 
 namespace kEn {
 
 std::unique_ptr<Renderer::SceneData> Renderer::scene_data_ = std::make_unique<SceneData>();
 
+void Renderer::init(Device& device) {
+  scene_data_->camera_buffer = device.create_mutable_buffer({.size       = sizeof(CameraBlock),
+                                                             .usage      = BufferUsage::Dynamic,
+                                                             .bind_flags = BufferBind::Uniform,
+                                                             .debug_name = "Renderer camera"});
+  scene_data_->camera_ubo    = device.create_uniform_buffer(scene_data_->camera_buffer->underlying_buffer());
+  scene_data_->objects.create(device, kInitialObjects * sizeof(ObjectData), "Renderer objects");
+  scene_data_->directional_light_array.create(
+      device, kLightHeaderSize + (kInitialLights * sizeof(DirectionalLight::Data::Packed)), "Directional lights");
+  scene_data_->point_light_array.create(device, kLightHeaderSize + (kInitialLights * sizeof(PointLight::Data::Packed)),
+                                        "Point lights");
+  scene_data_->spot_light_array.create(device, kLightHeaderSize + (kInitialLights * sizeof(SpotLight::Data::Packed)),
+                                       "Spot lights");
+  scene_data_->light_cluster_array.create(
+      device, sizeof(LightClusters::Header) + (LightClusters::kClusterCount * sizeof(LightClusters::Cluster)),
+      "Light clusters");
+  scene_data_->light_index_array.create(device, kInitialLightIndices * sizeof(std::uint32_t), "Light indices");
+  scene_data_->material_array.create(device, kInitialMaterials * sizeof(Material::Packed), "Materials");
+  scene_data_->uploaded_materials = 0;
+}
+
+void Renderer::shutdown() {
+  scene_data_->material_array.reset();
+  scene_data_->light_index_array.reset();
+  scene_data_->light_cluster_array.reset();
+  scene_data_->spot_light_array.reset();
+  scene_data_->point_light_array.reset();
+  scene_data_->directional_light_array.reset();
+  scene_data_->objects.reset();
+  scene_data_->camera_ubo.reset();
+  scene_data_->camera_buffer.reset();
+}
+
 void Renderer::begin_scene(const Camera& camera, RenderContext& ctx) {
-  scene_data_->ctx        = &ctx;
   scene_data_->v_matrix   = camera.view_matrix();
   scene_data_->p_matrix   = camera.projection_matrix();
   scene_data_->vp_matrix  = camera.view_projection_matrix();
   scene_data_->camera_pos = camera.transform().world_pos();
+  begin_view(ctx);
 }
 
 void Renderer::begin_scene(const mEn::Vec3& camera_pos, const mEn::Mat4& view, const mEn::Mat4& projection,
                            RenderContext& ctx) {
-  scene_data_->ctx        = &ctx;
   scene_data_->v_matrix   = view;
   scene_data_->p_matrix   = projection;
   scene_data_->vp_matrix  = projection * view;
   scene_data_->camera_pos = camera_pos;
+  begin_view(ctx);
+}
+
+void Renderer::begin_view(RenderContext& ctx) {
+  scene_data_->ctx        = &ctx;
+  scene_data_->frustum    = Frustum::from_matrix(scene_data_->vp_matrix);
+  scene_data_->cull_stats = {};
+  scene_data_->lod_stats  = {};
+  scene_data_->queue.clear();
+  set_lod_view(0, kDefaultLodViewportHeight);
+
+  // Draws without an object of their own use a base instance of 0, so that entry must be the identity.
+  const mEn::Mat4 identity(1.F);
+  const ObjectData object                    = ObjectData::from(identity, identity, identity);
+  [[maybe_unused]] const std::uint32_t index = scene_data_->queue.add_object(object);
+  KEN_CORE_ASSERT(index == kIdentityObject, "The identity object must come first in the view");
+
+  KEN_CORE_ASSERT(scene_data_->camera_ubo != nullptr, "Renderer::begin_scene called before Renderer::init");
+  const CameraBlock block{.view            = scene_data_->v_matrix,
+                          .projection      = scene_data_->p_matrix,
+                          .view_projection = scene_data_->vp_matrix,
+                          .position        = scene_data_->camera_pos,
+                          .ambient         = scene_data_->ambient};
+  scene_data_->camera_buffer->update_data(0, &block, sizeof(block));
+  ctx.bind_uniform_buffer(kCameraBinding, ShaderStage::Vertex, *scene_data_->camera_ubo);
+}
+
+void Renderer::end_scene() {
+  KEN_CORE_ASSERT(scene_data_->ctx != nullptr, "Renderer::end_scene called without begin_scene");
+  execute_queue();
+}
+
+void Renderer::StorageArray::create(Device& device, std::size_t size, const char* debug_name) {
+  buffer = device.create_mutable_buffer(
+      {.size = size, .usage = BufferUsage::Dynamic, .bind_flags = BufferBind::Storage, .debug_name = debug_name});
+  ssbo = device.create_shader_storage_buffer(buffer->underlying_buffer());
+}
+
+void Renderer::StorageArray::reset() {
+  ssbo.reset();
+  buffer.reset();
+}
+
+void Renderer::StorageArray::bind(RenderContext& ctx, std::uint32_t binding, ShaderStage stage) const {
+  ctx.bind_storage_buffer(binding, stage, *ssbo);
+}
+
+void Renderer::StorageArray::upload(RenderContext& ctx, std::uint32_t binding, ShaderStage stage,
+                                    std::span<const std::byte> header, std::span<const std::byte> elements) {
+  // The storage buffer view keeps referring to the same buffer when it grows.
+  const std::size_t bytes = header.size() + elements.size();
+  const std::size_t size  = buffer->underlying_buffer()->size();
+  if (bytes > size) {
+    buffer->resize(std::max(bytes, 2 * size));
+  }
+  buffer->update_data(0, header.data(), header.size());
+  buffer->update_data(header.size(), elements.data(), elements.size());
+  bind(ctx, binding, stage);
 }
 
-void Renderer::end_scene() {}
+void Renderer::StorageArray::update(RenderContext& ctx, std::uint32_t binding, ShaderStage stage, std::size_t offset,
+                                    std::span<const std::byte> elements) {
+  KEN_CORE_ASSERT(offset + elements.size() <= buffer->underlying_buffer()->size(), "Storage array update out of range");
+  buffer->update_data(offset, elements.data(), elements.size());
+  bind(ctx, binding, stage);
+}
 
-void Renderer::prepare(Shader& shader) {
-  shader.set_uniform("u_PointCount", static_cast<int>(scene_data_->point_lights.size()));
-  int i = 0;
-  for (const auto& light : scene_data_->point_lights) {
-    light->load("u_PointLights[" + std::to_string(i++) + "]", shader);
+template <typename Data>
+void Renderer::upload_lights(StorageArray& array, std::uint32_t binding, std::span<const Data> lights,
+                             std::vector<typename Data::Packed>& scratch) {
+  scratch.clear();
+  for (const auto& light : lights) {
+    scratch.push_back(light.pack());
   }
 
-  shader.set_uniform("u_DirectionalCount", static_cast<int>(scene_data_->directional_lights.size()));
-  i = 0;
-  for (const auto& light : scene_data_->directional_lights) {
-    light->load("u_DirectionalLights[" + std::to_string(i++) + "]", shader);
+  const std::array<std::uint32_t, kLightHeaderSize / sizeof(std::uint32_t)> header{
+      static_cast<std::uint32_t>(scratch.size())};
+  array.upload(*scene_data_->ctx, binding, ShaderStage::Fragment, std::as_bytes(std::span(header)),
+               std::as_bytes(std::span(scratch)));
+}
+
+void Renderer::prepare() {
+  const auto gather = [](const auto& lights, auto& data) {
+    data.clear();
+    for (const auto* light : lights) {
+      data.push_back(light->data());
+    }
+  };
+  gather(scene_data_->point_lights, scene_data_->point_light_data);
+  gather(scene_data_->directional_lights, scene_data_->directional_light_data);
+  gather(scene_data_->spot_lights, scene_data_->spot_light_data);
+  prepare(scene_data_->point_light_data, scene_data_->directional_light_data, scene_data_->spot_light_data);
+}
+
+void Renderer::prepare(std::span<const PointLight::Data> point_lights,
+                       std::span<const DirectionalLight::Data> directional_lights,
+                       std::span<const SpotLight::Data> spot_lights) {
+  KEN_PROFILE_FUNCTION();
+  KEN_CORE_ASSERT(scene_data_->ctx != nullptr, "Renderer::prepare called outside begin_scene/end_scene");
+  upload_lights(scene_data_->directional_light_array, kDirectionalLightBinding, directional_lights,
+                scene_data_->packed_directional_lights);
+  upload_lights(scene_data_->point_light_array, kPointLightBinding, point_lights, scene_data_->packed_point_lights);
+  upload_lights(scene_data_->spot_light_array, kSpotLightBinding, spot_lights, scene_data_->packed_spot_lights);
+
+  auto& clusters = scene_data_->light_clusters;
+  clusters.build(scene_data_->v_matrix, scene_data_->p_matrix, point_lights, spot_lights);
+  scene_data_->light_cluster_array.upload(*scene_data_->ctx, kLightClusterBinding, ShaderStage::Fragment,
+                                          std::as_bytes(std::span(&clusters.header(), 1)),
+                                          std::as_bytes(clusters.clusters()));
+  scene_data_->light_index_array.upload(*scene_data_->ctx, kLightIndexBinding, ShaderStage::Fragment, {},
+                                        std::as_bytes(clusters.indices()));
+}
+
+std::span<const std::uint8_t> Renderer::cull(std::span<const Bounds> bounds, const mEn::Mat4& world) {
+  auto& mask = scene_data_->visibility;
+  mask.assign(bounds.size(), 1);
+
+  if (!scene_data_->frustum_culling) {
+    scene_data_->cull_stats.visible += bounds.size();
+    return mask;
   }
 
-  shader.set_uniform("u_SpotCount", static_cast<int>(scene_data_->spot_lights.size()));
-  i = 0;
-  for (const auto& light : scene_data_->spot_lights) {
-    light->load("u_SpotLights[" + std::to_string(i++) + "]", shader);
+  const auto& frustum      = scene_data_->frustum;
+  const float radius_scale = max_axis_scale(world);
+
+  std::size_t visible = 0;
+  for (std::size_t i = 0; i < bounds.size(); ++i) {
+    const Sphere sphere{.center = mEn::Vec3(world * mEn::Vec4(bounds[i].sphere.center, 1.F)),
+                        .radius = bounds[i].sphere.radius * radius_scale};
+
+    auto containment = frustum.classify(sphere);
+    if (containment == Containment::Intersects) {
+      containment = frustum.classify(bounds[i].box.transformed(world));
+    }
+
+    mask[i] = containment != Containment::Outside ? 1 : 0;
+    visible += mask[i];
   }
+
+  scene_data_->cull_stats.visible += visible;
+  scene_data_->cull_stats.culled += bounds.size() - visible;
+  return mask;
+}
+
+void Renderer::set_lod_view(std::uint32_t slot, float viewport_height) {
+  KEN_CORE_ASSERT(slot < kMaxLodViews, "LOD view slot out of range");
+  const auto& p = scene_data_->p_matrix;
+
+  // OpenGL-style projections: perspective ones copy -z into w, orthographic ones leave w = 1.
+  scene_data_->lod_view        = slot;
+  scene_data_->perspective     = p[2][3] != 0.F;
+  scene_data_->lod_pixel_scale = 0.5F * p[1][1] * viewport_height;
+}
+
+std::uint8_t Renderer::select_lod(std::span<const LodLevel> levels, const Bounds& bounds, const mEn::Mat4& world,
+                                  std::uint8_t current) {
+  constexpr float kMinDistance = 1e-4F;
+
+  const auto& settings = scene_data_->lod_settings;
+  auto& stats          = scene_data_->lod_stats;
+  if (levels.empty()) {
+    return 0;
+  }
+  stats.full_triangles += levels[0].index_count / 3;
+  if (!settings.enabled || levels.size() == 1) {
+    stats.submitted_triangles += levels[0].index_count / 3;
+    return 0;
+  }
+
+  const float scale     = max_axis_scale(world);
+  float pixels_per_unit = scene_data_->lod_pixel_scale * scale;
+  if (scene_data_->perspective) {
+    const mEn::Vec3 center = mEn::Vec3(world * mEn::Vec4(bounds.sphere.center, 1.F));
+    const float distance   = mEn::distance(center, scene_data_->camera_pos) - (bounds.sphere.radius * scale);
+    pixels_per_unit /= std::max(distance, kMinDistance);
+  }
+
+  const auto projected  = [&](std::size_t level) { return levels[level].error * pixels_per_unit; };
+  const float threshold = settings.max_pixel_error;
+
+  std::size_t desired = 0;
+  while (desired + 1 < levels.size() && projected(desired + 1) <= threshold) {
+    ++desired;
+  }
+
+  std::size_t selected = std::min<std::size_t>(current, levels.size() - 1);
+  if (desired > selected) {
+    // Coarsen only as far as stays comfortably under the threshold.
+    while (desired > selected && projected(desired) > threshold * (1.F - settings.hysteresis)) {
+      --desired;
+    }
+    selected = desired;
+  } else if (desired < selected && projected(selected) > threshold * (1.F + settings.hysteresis)) {
+    selected = desired;
+  }
+
+  stats.submitted_triangles += levels[selected].index_count / 3;
+  return static_cast<std::uint8_t>(selected);
 }
 
 void Renderer::set_render_target(Framebuffer& fb) {
@@ -65,80 +290,216 @@ void Renderer::bind_default_render_target() {
 }
 
 void Renderer::submit(Shader& shader, const VertexInput& vertex_input, RenderMode mode) {
-  shader.set_uniform("u_V", scene_data_->v_matrix);
-  shader.set_uniform("u_P", scene_data_->p_matrix);
-  shader.set_uniform("u_VP", scene_data_->vp_matrix);
-  shader.set_uniform("u_CameraPos", scene_data_->camera_pos);
-  shader.set_uniform("u_Ambient", scene_data_->ambient);
-
-  KEN_CORE_ASSERT(scene_data_->ctx != nullptr, "Renderer::submit called outside begin_scene/end_scene");
-  auto& ctx = *scene_data_->ctx;
-  ctx.set_shader(shader);
-  ctx.set_vertex_input(vertex_input);
-  if (vertex_input.index_buffer()) {
-    ctx.draw_indexed(vertex_input.element_count(), 0, 0, mode);
-  } else {
-    ctx.draw(vertex_input.element_count(), 0, mode);
-  }
+  KEN_PROFILE_FUNCTION();
+  enqueue({.shader       = &shader,
+           .vertex_input = &vertex_input,
+           .count        = static_cast<std::uint32_t>(vertex_input.element_count()),
+           .mode         = mode,
+           .indexed      = vertex_input.index_buffer() != nullptr});
 }
 
 void Renderer::submit(Shader& shader, const VertexInput& vertex_input, const Transform& transform, RenderMode mode) {
-  shader.set_uniform("u_V", scene_data_->v_matrix);
-  shader.set_uniform("u_P", scene_data_->p_matrix);
-  shader.set_uniform("u_VP", scene_data_->vp_matrix);
-  shader.set_uniform("u_CameraPos", scene_data_->camera_pos);
-  shader.set_uniform("u_M", transform.local_to_world_matrix());
-  shader.set_uniform("u_Ambient", scene_data_->ambient);
+  KEN_PROFILE_FUNCTION();
+  enqueue({.shader       = &shader,
+           .vertex_input = &vertex_input,
+           .object       = add_object(transform),
+           .count        = static_cast<std::uint32_t>(vertex_input.element_count()),
+           .mode         = mode,
+           .indexed      = vertex_input.index_buffer() != nullptr});
+}
 
-  KEN_CORE_ASSERT(scene_data_->ctx != nullptr, "Renderer::submit called outside begin_scene/end_scene");
-  auto& ctx = *scene_data_->ctx;
-  ctx.set_shader(shader);
-  ctx.set_vertex_input(vertex_input);
-  if (vertex_input.index_buffer()) {
-    ctx.draw_indexed(vertex_input.element_count(), 0, 0, mode);
-  } else {
-    ctx.draw(vertex_input.element_count(), 0, mode);
-  }
+void Renderer::submit(Shader& shader, const VertexInput& vertex_input, const Transform& transform, IndexRange range,
+                      RenderMode mode) {
+  KEN_PROFILE_FUNCTION();
+  KEN_CORE_ASSERT(vertex_input.index_buffer() != nullptr, "Renderer::submit with an index range needs an index buffer");
+  enqueue({.shader       = &shader,
+           .vertex_input = &vertex_input,
+           .object       = add_object(transform),
+           .first        = range.first,
+           .count        = static_cast<std::uint32_t>(range.count),
+           .mode         = mode,
+           .indexed      = true});
+}
+
+void Renderer::submit(Shader& shader, const VertexInput& vertex_input, const mEn::Mat4& world, IndexRange range,
+                      RenderMode mode) {
+  KEN_PROFILE_FUNCTION();
+  KEN_CORE_ASSERT(vertex_input.index_buffer() != nullptr, "Renderer::submit with an index range needs an index buffer");
+  enqueue({.shader       = &shader,
+           .vertex_input = &vertex_input,
+           .object       = add_object(ObjectData::from(world)),
+           .first        = range.first,
+           .count        = static_cast<std::uint32_t>(range.count),
+           .mode         = mode,
+           .indexed      = true});
+}
+
+void Renderer::submit(Shader& shader, const VertexInput& vertex_input, const Material& material, std::uint32_t object,
+                      IndexRange range, const mEn::Vec3& sort_origin, RenderMode mode) {
+  KEN_PROFILE_FUNCTION();
+  KEN_CORE_ASSERT(vertex_input.index_buffer() != nullptr, "Renderer::submit with an index range needs an index buffer");
+  KEN_CORE_ASSERT(object < scene_data_->queue.objects().size(), "Renderer::submit with an unknown object");
+  KEN_CORE_ASSERT(material.baked(), "Renderer::submit with a material that was not baked");
+  enqueue({.shader       = &shader,
+           .vertex_input = &vertex_input,
+           .material     = &material,
+           .object       = object,
+           .first        = range.first,
+           .count        = static_cast<std::uint32_t>(range.count),
+           .mode         = mode,
+           .indexed      = true},
+          sort_origin);
 }
 
 void Renderer::submit_instanced(Shader& shader, const VertexInput& vertex_input, std::size_t instance_count,
                                 RenderMode mode) {
-  shader.set_uniform("u_V", scene_data_->v_matrix);
-  shader.set_uniform("u_P", scene_data_->p_matrix);
-  shader.set_uniform("u_VP", scene_data_->vp_matrix);
-  shader.set_uniform("u_CameraPos", scene_data_->camera_pos);
-  shader.set_uniform("u_Ambient", scene_data_->ambient);
-
-  KEN_CORE_ASSERT(scene_data_->ctx != nullptr, "Renderer::submit_instanced called outside begin_scene/end_scene");
-  auto& ctx = *scene_data_->ctx;
-  ctx.set_shader(shader);
-  ctx.set_vertex_input(vertex_input);
-  if (vertex_input.index_buffer()) {
-    ctx.draw_indexed_instanced(vertex_input.element_count(), instance_count, 0, 0, 0, mode);
-  } else {
-    ctx.draw_instanced(vertex_input.element_count(), instance_count, 0, 0, mode);
-  }
+  KEN_PROFILE_FUNCTION();
+  enqueue({.shader         = &shader,
+           .vertex_input   = &vertex_input,
+           .count          = static_cast<std::uint32_t>(vertex_input.element_count()),
+           .instance_count = static_cast<std::uint32_t>(instance_count),
+           .mode           = mode,
+           .indexed        = vertex_input.index_buffer() != nullptr});
 }
 
 void Renderer::submit_tessellated(Shader& shader, const VertexInput& vertex_input, std::size_t patch_vertex_count,
                                   const Transform& transform) {
-  shader.set_uniform("u_V", scene_data_->v_matrix);
-  shader.set_uniform("u_P", scene_data_->p_matrix);
-  shader.set_uniform("u_VP", scene_data_->vp_matrix);
-  shader.set_uniform("u_CameraPos", scene_data_->camera_pos);
-  shader.set_uniform("u_M", transform.local_to_world_matrix());
-  shader.set_uniform("u_Ambient", scene_data_->ambient);
-
-  KEN_CORE_ASSERT(scene_data_->ctx != nullptr, "Renderer::submit_tessellated called outside begin_scene/end_scene");
-  auto& ctx = *scene_data_->ctx;
-  ctx.set_tessellation_patch_vertices(patch_vertex_count);
-  ctx.set_shader(shader);
-  ctx.set_vertex_input(vertex_input);
-  if (vertex_input.index_buffer()) {
-    ctx.draw_indexed(vertex_input.element_count(), 0, 0, render_mode::Patches);
+  KEN_PROFILE_FUNCTION();
+  enqueue({.shader         = &shader,
+           .vertex_input   = &vertex_input,
+           .object         = add_object(transform),
+           .count          = static_cast<std::uint32_t>(vertex_input.element_count()),
+           .patch_vertices = static_cast<std::uint32_t>(patch_vertex_count),
+           .mode           = render_mode::Patches,
+           .indexed        = vertex_input.index_buffer() != nullptr});
+}
+
+std::uint32_t Renderer::add_object(const ObjectData& object) {
+  KEN_CORE_ASSERT(scene_data_->ctx != nullptr, "Renderer::add_object called outside begin_scene/end_scene");
+  return scene_data_->queue.add_object(object);
+}
+
+std::uint32_t Renderer::add_object(const Transform& transform) {
+  const mEn::Mat4& world = transform.local_to_world_matrix();
+  return add_object(ObjectData::from(world, transform.world_to_local_matrix(), world));
+}
+
+void Renderer::enqueue(const DrawPacket& packet, const mEn::Vec3& sort_origin) {
+  KEN_CORE_ASSERT(scene_data_->ctx != nullptr, "Renderer::submit called outside begin_scene/end_scene");
+  auto& queue = scene_data_->queue;
+
+  float depth = 0.F;
+  if (packet.object != DrawPacket::kNoObject) {
+    const mEn::Mat4& world = queue.objects()[packet.object].world;
+    depth                  = mEn::distance(mEn::Vec3(world * mEn::Vec4(sort_origin, 1.F)), scene_data_->camera_pos);
+  }
+
+  const RenderPass pass =
+      packet.material != nullptr && packet.material->transparent ? RenderPass::Transparent : RenderPass::Opaque;
+  queue.push(RenderQueue::make_key(pass, *packet.shader, packet.material, *packet.vertex_input, depth), packet);
+}
+
+void Renderer::upload_objects() {
+  KEN_PROFILE_FUNCTION();
+  const auto objects = scene_data_->queue.objects();
+  if (objects.empty()) {
+    return;
+  }
+  scene_data_->objects.upload(*scene_data_->ctx, kObjectBinding, ShaderStage::Vertex, {}, std::as_bytes(objects));
+}
+
+void Renderer::upload_materials() {
+  const auto blocks = MaterialTable::blocks();
+  if (blocks.empty()) {
+    return;
+  }
+
+  // New blocks are dirty too, so only a fresh or growing buffer needs the whole table.
+  auto& materials  = scene_data_->material_array;
+  const auto dirty = MaterialTable::dirty_blocks();
+  if (scene_data_->uploaded_materials == 0 || blocks.size_bytes() > materials.buffer->underlying_buffer()->size()) {
+    materials.upload(*scene_data_->ctx, kMaterialBinding, ShaderStage::Fragment, {}, std::as_bytes(blocks));
+  } else if (!dirty.empty()) {
+    const auto offset = static_cast<std::size_t>(dirty.data() - blocks.data()) * sizeof(Material::Packed);
+    materials.update(*scene_data_->ctx, kMaterialBinding, ShaderStage::Fragment, offset, std::as_bytes(dirty));
   } else {
-    ctx.draw(vertex_input.element_count(), 0, render_mode::Patches);
+    materials.bind(*scene_data_->ctx, kMaterialBinding, ShaderStage::Fragment);
   }
+  scene_data_->uploaded_materials = blocks.size();
+  MaterialTable::clear_dirty();
+}
+
+void Renderer::execute_queue() {
+  KEN_PROFILE_FUNCTION();
+  auto& queue = scene_data_->queue;
+  auto& stats = scene_data_->queue_stats;
+  auto& ctx   = *scene_data_->ctx;
+
+  // A material's index uniform lives in the shader program, so switching shaders invalidates it too.
+  const auto count_changes = [&queue]() {
+    StateChanges changes;
+    const DrawPacket* previous = nullptr;
+    for (const std::uint32_t index : queue.order()) {
+      const DrawPacket& packet = queue.packets()[index];
+      const bool new_shader    = previous == nullptr || packet.shader != previous->shader;
+      const bool new_material  = packet.material != nullptr && (new_shader || packet.material != previous->material);
+      const bool new_input     = previous == nullptr || packet.vertex_input != previous->vertex_input;
+      changes.shaders += new_shader ? 1 : 0;
+      changes.materials += new_material ? 1 : 0;
+      changes.vertex_inputs += new_input ? 1 : 0;
+      previous = &packet;
+    }
+    return changes;
+  };
+
+  stats.draws    = queue.size();
+  stats.unsorted = count_changes();
+  queue.sort();
+  stats.sorted = {};
+  upload_objects();
+  upload_materials();
+
+  Shader* shader                  = nullptr;
+  const Material* material        = nullptr;
+  const VertexInput* vertex_input = nullptr;
+  for (const std::uint32_t index : queue.order()) {
+    const DrawPacket& packet = queue.packets()[index];
+    if (packet.shader != shader) {
+      shader   = packet.shader;
+      material = nullptr;
+      ctx.set_shader(*shader);
+      ++stats.sorted.shaders;
+    }
+    if (packet.material != nullptr && packet.material != material) {
+      material = packet.material;
+      material->apply(*shader, ctx);
+      ++stats.sorted.materials;
+    }
+    if (packet.vertex_input != vertex_input) {
+      vertex_input = packet.vertex_input;
+      ctx.set_vertex_input(*vertex_input);
+      ++stats.sorted.vertex_inputs;
+    }
+    if (packet.patch_vertices != 0) {
+      ctx.set_tessellation_patch_vertices(packet.patch_vertices);
+    }
+
+    // The object index travels as the base instance, which shaders see as gl_BaseInstance.
+    if (packet.object != DrawPacket::kNoObject || packet.instance_count != 1) {
+      const std::uint32_t base_instance = packet.object != DrawPacket::kNoObject ? packet.object : 0;
+      if (packet.indexed) {
+        ctx.draw_indexed_instanced(packet.count, packet.instance_count, packet.first, 0, base_instance, packet.mode);
+      } else {
+        ctx.draw_instanced(packet.count, packet.instance_count, packet.first, base_instance, packet.mode);
+      }
+    } else if (packet.indexed) {
+      ctx.draw_indexed(packet.count, packet.first, 0, packet.mode);
+    } else {
+      ctx.draw(packet.count, packet.first, packet.mode);
+    }
+  }
+
+  queue.clear();
 }
 
 }  // namespace kEn
@@ -1,12 +1,22 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
 #include <mEn.hpp>
 #include <mEn/vec3.hpp>
 
 #include <kEn/core/transform.hpp>
 #include <kEn/renderer/framebuffer.hpp>
+#include <kEn/renderer/light_clusters.hpp>
 #include <kEn/renderer/render_context.hpp>
+#include <kEn/renderer/render_queue.hpp>
 #include <kEn/renderer/shader.hpp>
 #include <kEn/renderer/vertex_input.hpp>
+#include <kEn/scene/assets/mesh_lod.hpp>
+#include <kEn/scene/bounds.hpp>
 #include <kEn/scene/components/camera.hpp>
 #include <kEn/scene/components/light.hpp>
 
@@ -16,19 +26,109 @@
 
 namespace kEn {
 
+class Device;
+struct MutableBuffer;
+struct ShaderStorageBuffer;
+struct UniformBuffer;
+
 /**
  * @brief High-level scene renderer facade.
  *
  * Static class that manages per-frame camera data, persistent light state, and submission of geometry
  * to the active RenderContext. Expected per-frame call sequence:
  * `begin_scene -> [prepare] -> submit* -> end_scene`.
+ *
+ * submit() does not draw right away: it queues a @ref DrawPacket in the view's @ref RenderQueue, which
+ * end_scene() sorts and executes, binding each shader, material and vertex input only when it differs
+ * from the previous draw's. Uniforms set on a shader between begin_scene() and end_scene() therefore
+ * apply to all of the view's draws with that shader.
+ *
+ * The camera matrices, camera position and ambient colour of a view are written once by begin_scene()
+ * into a std140 uniform buffer bound at @ref kCameraBinding, which shaders read through the
+ * `#include "camera"` block. The world, normal and previous-frame matrices of every object drawn in a
+ * view are gathered into one storage buffer, uploaded once by end_scene() and bound at
+ * @ref kObjectBinding; each draw passes the index of its object as the base instance, which vertex
+ * shaders read through `#include "object"`. No uniforms are set per draw.
+ *
+ * Lit views shade with clustered forward lighting: prepare() assigns the point and spot lights to the
+ * clusters of the view frustum (see @ref LightClusters) and uploads one light list per cluster, so that
+ * each fragment only evaluates the lights that can reach it.
+ *
+ * Materials are drawn from their baked blocks (see @ref MaterialTable), which end_scene() uploads to a
+ * storage buffer at @ref kMaterialBinding as they are written; applying a material sets one index
+ * uniform and binds its textures.
+ *
+ * begin_scene() also extracts the view frustum from the view-projection matrix; callers that know
+ * object-space bounds cull against it with cull() before submitting, and pick a level of detail with
+ * select_lod().
  */
 class Renderer {
  public:
+  /** @brief Frustum culling counters of the current view, reset by begin_scene(). */
+  struct CullStats {
+    std::size_t visible = 0;
+    std::size_t culled  = 0;
+  };
+
+  /** @brief Screen-space error based level-of-detail selection parameters. */
+  struct LodSettings {
+    bool enabled          = true;
+    float max_pixel_error = 1.F;    ///< Largest tolerated projected geometric error, in pixels.
+    float hysteresis      = 0.25F;  ///< Relative band around the threshold inside which the current level is kept.
+  };
+
+  /** @brief Triangle counters of the current view, reset by begin_scene(). */
+  struct LodStats {
+    std::size_t full_triangles      = 0;  ///< Triangles the selected meshes have at level 0.
+    std::size_t submitted_triangles = 0;  ///< Triangles of the levels actually selected.
+  };
+
+  /** @brief Number of binds of each kind of state, see QueueStats. */
+  struct StateChanges {
+    std::size_t shaders       = 0;
+    std::size_t materials     = 0;
+    std::size_t vertex_inputs = 0;
+  };
+
+  /** @brief Render queue counters of the last view, filled by end_scene(). */
+  struct QueueStats {
+    std::size_t draws = 0;
+    StateChanges unsorted;  ///< Binds the draws would have needed in submission order.
+    StateChanges sorted;    ///< Binds actually issued after sorting.
+  };
+
+  /** @brief Range of an index buffer to draw. */
+  struct IndexRange {
+    std::uint32_t first = 0;
+    std::size_t count   = 0;
+  };
+
+  /** @brief Number of views that keep separate LOD hysteresis state, see set_lod_view(). */
+  static constexpr std::uint32_t kMaxLodViews = 4;
+  /** @brief Uniform buffer binding point of the per-view `Camera` block, see `kEn/assets/shaders/camera.glsl`. */
+  static constexpr std::uint32_t kCameraBinding = 0;
+  /** @brief Storage buffer binding point of the per-view `Objects` array, see `kEn/assets/shaders/object.glsl`. */
+  static constexpr std::uint32_t kObjectBinding = 1;
+  /** @brief Storage buffer binding points of the light arrays, see `kEn/assets/shaders/light.glsl`. */
+  static constexpr std::uint32_t kDirectionalLightBinding = 2;
+  static constexpr std::uint32_t kPointLightBinding       = 3;  ///< @copydoc kDirectionalLightBinding
+  static constexpr std::uint32_t kSpotLightBinding        = 4;  ///< @copydoc kDirectionalLightBinding
+  /** @brief Storage buffer binding points of the light clusters and their light lists, see `light.glsl`. */
+  static constexpr std::uint32_t kLightClusterBinding = 5;
+  static constexpr std::uint32_t kLightIndexBinding   = 6;  ///< @copydoc kLightClusterBinding
+  /** @brief Storage buffer binding point of the baked material blocks, see `kEn/assets/shaders/material.glsl`. */
+  static constexpr std::uint32_t kMaterialBinding = 7;
+
+  /** @brief Allocates the renderer's GPU resources on @p device; called by the Application. */
+  static void init(Device& device);
+  /** @brief Releases the GPU resources allocated by init(), before the device goes away. */
+  static void shutdown();
+
   /**
    * @brief Begin a new render frame.
    *
-   * Stores the camera matrices and the RenderContext for this frame. Expected call sequence:
+   * Stores the camera matrices and the RenderContext for this frame, and uploads them with the
+   * ambient colour to the `Camera` uniform block. Expected call sequence:
    * `begin_scene -> [prepare] -> submit* -> end_scene`.
    */
   static void begin_scene(const Camera& camera, RenderContext& ctx);
@@ -39,12 +139,15 @@ class Renderer {
   /**
    * @brief End the current render frame.
    *
-   * This is intentionally a no-op. Lights are persistent scene state: they are registered once via
-   * add_light() and remain until explicitly removed. Calling end_scene() does NOT clear lights -- it
-   * only closes the per-frame submission window opened by begin_scene().
+   * Sorts the draws queued since begin_scene() and issues them, see queue_stats(). Lights are
+   * persistent scene state: they are registered once via add_light() and remain until explicitly
+   * removed. Calling end_scene() does NOT clear lights.
    */
   static void end_scene();
 
+  /** @brief Returns the render queue counters of the last end_scene(). */
+  [[nodiscard]] static const QueueStats& queue_stats() { return scene_data_->queue_stats; }
+
   /**
    * @brief Register a persistent point light.
    *
@@ -56,17 +159,86 @@ class Renderer {
   static void add_light(DirectionalLight& light) { scene_data_->directional_lights.push_back(&light); }
   /** @copydoc add_light(PointLight&) */
   static void add_light(SpotLight& light) { scene_data_->spot_lights.push_back(&light); }
-  /** @brief Set the scene ambient light colour applied to all lit submissions. */
+  /** @brief Set the scene ambient light colour applied to all lit submissions, from the next begin_scene() on. */
   static void set_ambient(const mEn::Vec3& ambient) { scene_data_->ambient = ambient; }
 
   /**
-   * @brief Upload light and ambient uniforms to a shader.
+   * @brief Upload the registered lights to the light storage buffers, assign them to the view's clusters and bind them.
+   *
+   * Lights are packed into std430 arrays, one storage buffer per light type, which every shader
+   * including `light.glsl` reads; their number is only limited by memory. Point and spot lights are
+   * then binned into the clusters of the current view, see light_cluster_stats(). This is an opt-in
+   * step required only for lit passes: call it inside the begin_scene / end_scene block of every lit
+   * view, as the clusters depend on the camera. Depth-only passes do not need it.
+   */
+  static void prepare();
+  /**
+   * @brief Upload the given light copies instead of the registered lights.
+   *
+   * Same as prepare(), for lights that were copied out of the scene, e.g. into a @ref RenderSnapshot.
+   */
+  static void prepare(std::span<const PointLight::Data> point_lights,
+                      std::span<const DirectionalLight::Data> directional_lights,
+                      std::span<const SpotLight::Data> spot_lights);
+
+  /** @brief Returns the light clustering counters of the last prepare(). */
+  [[nodiscard]] static const LightClusters::Stats& light_cluster_stats() { return scene_data_->light_clusters.stats(); }
+
+  /**
+   * @brief Frustum-cull a batch of object-space bounds that share one world matrix.
+   *
+   * Each entry is first tested as a bounding sphere; the box is transformed and tested only when the
+   * sphere straddles a plane. Results are added to cull_stats(). Must be called inside a
+   * begin_scene / end_scene block.
+   *
+   * @param bounds Object-space bounds, typically one per mesh of a model.
+   * @param world  Local-to-world matrix shared by all entries.
+   * @return Mask with one entry per element of @p bounds, non-zero when visible. Valid until the next
+   *         call to cull().
+   */
+  [[nodiscard]] static std::span<const std::uint8_t> cull(std::span<const Bounds> bounds, const mEn::Mat4& world);
+
+  /** @brief Enable or disable frustum culling; when disabled cull() reports everything visible. */
+  static void set_frustum_culling(bool enabled) { scene_data_->frustum_culling = enabled; }
+  /** @brief Returns whether frustum culling is enabled. */
+  [[nodiscard]] static bool frustum_culling() { return scene_data_->frustum_culling; }
+  /** @brief Returns the culling counters accumulated since the last begin_scene(). */
+  [[nodiscard]] static const CullStats& cull_stats() { return scene_data_->cull_stats; }
+
+  /**
+   * @brief Pick the level of detail of one mesh for the current view.
+   *
+   * Projects each level's error to the screen at the distance of the mesh's world-space bounding
+   * sphere and returns the coarsest level that stays under LodSettings::max_pixel_error. To avoid
+   * flicker a coarser level is only taken once it is comfortably under the threshold, and @p current
+   * is only refined once its own error is clearly above it; LodSettings::hysteresis sets the width of
+   * that band. Results are added to lod_stats(). Must be called inside a begin_scene / end_scene block.
+   *
+   * @param levels  The mesh's LOD chain, finest first, with non-decreasing errors.
+   * @param bounds  Object-space bounds of the mesh.
+   * @param world   Local-to-world matrix of the mesh.
+   * @param current Level selected for this mesh in this view last frame.
+   * @return Index into @p levels.
+   */
+  [[nodiscard]] static std::uint8_t select_lod(std::span<const LodLevel> levels, const Bounds& bounds,
+                                               const mEn::Mat4& world, std::uint8_t current);
+
+  /**
+   * @brief Set which LOD hysteresis slot and viewport height the current view uses.
    *
-   * This is an opt-in step required only for lit passes. Shadow passes and other depth-only passes
-   * should call submit() directly without calling prepare(). Call once per shader before the first
-   * submit() that uses that shader in a lit pass.
+   * Views that draw the same objects in one frame (e.g. a shadow pass and the main pass) should use
+   * different slots so that they do not fight over each other's hysteresis state. begin_scene()
+   * resets the view to slot 0 and a 1080 pixel tall viewport.
    */
-  static void prepare(Shader& shader);
+  static void set_lod_view(std::uint32_t slot, float viewport_height);
+  /** @brief Returns the LOD hysteresis slot of the current view. */
+  [[nodiscard]] static std::uint32_t lod_view() { return scene_data_->lod_view; }
+  /** @brief Replace the level-of-detail selection parameters. */
+  static void set_lod_settings(const LodSettings& settings) { scene_data_->lod_settings = settings; }
+  /** @brief Returns the level-of-detail selection parameters. */
+  [[nodiscard]] static const LodSettings& lod_settings() { return scene_data_->lod_settings; }
+  /** @brief Returns the LOD counters accumulated since the last begin_scene(). */
+  [[nodiscard]] static const LodStats& lod_stats() { return scene_data_->lod_stats; }
 
   /** @brief Redirect subsequent rendering to @p fb. */
   static void set_render_target(Framebuffer& fb);
@@ -76,22 +248,56 @@ class Renderer {
   /**
    * @brief Submit geometry for rendering without a model transform.
    *
-   * Uploads camera uniforms and draws @p vertex_input using @p shader. Must be called inside a
-   * begin_scene / end_scene block.
+   * Queues a draw of @p vertex_input using @p shader; the camera data comes from the `Camera` block and
+   * the object matrices are the identity. Must be called inside a begin_scene / end_scene block.
    */
   static void submit(Shader& shader, const VertexInput& vertex_input, RenderMode mode = RenderMode::Triangles);
   /**
    * @brief Submit geometry for rendering with a world-space model transform.
    *
-   * Uploads camera uniforms and the `u_M` model matrix from @p transform, then draws @p vertex_input.
-   * Must be called inside a begin_scene / end_scene block.
+   * Like submit(Shader&, const VertexInput&, RenderMode), drawn as a new object with the cached
+   * matrices of @p transform. Must be called inside a begin_scene / end_scene block.
    */
   static void submit(Shader& shader, const VertexInput& vertex_input, const Transform& transform,
                      RenderMode mode = RenderMode::Triangles);
+  /**
+   * @brief Submit part of an indexed mesh with a world-space model transform.
+   *
+   * Like submit(Shader&, const VertexInput&, const Transform&, RenderMode), but draws only the
+   * indices in @p range, e.g. one level of a LOD chain.
+   */
+  static void submit(Shader& shader, const VertexInput& vertex_input, const Transform& transform, IndexRange range,
+                     RenderMode mode = RenderMode::Triangles);
+  /** @copydoc submit(Shader&, const VertexInput&, const Transform&, IndexRange, RenderMode) */
+  static void submit(Shader& shader, const VertexInput& vertex_input, const mEn::Mat4& world, IndexRange range,
+                     RenderMode mode = RenderMode::Triangles);
+  /**
+   * @brief Store the constants of an object drawn in the current view.
+   *
+   * Several submissions may share one object, e.g. all meshes of a model. Must be called inside a
+   * begin_scene / end_scene block.
+   *
+   * @return Index to pass to submit().
+   */
+  [[nodiscard]] static std::uint32_t add_object(const ObjectData& object);
+  /** @brief Same as above, with the matrices cached by @p transform and no motion since the previous frame. */
+  [[nodiscard]] static std::uint32_t add_object(const Transform& transform);
+  /**
+   * @brief Submit part of an indexed mesh drawn with @p material.
+   *
+   * The material is applied right before the draw unless the previous draw used the same one. Transparent
+   * materials are drawn after all opaque ones, back to front by the distance of @p sort_origin (in object
+   * space, e.g. the center of the mesh bounds) from the camera. @p material must be baked and stay alive
+   * until end_scene().
+   *
+   * @param object Index returned by add_object() in the current view.
+   */
+  static void submit(Shader& shader, const VertexInput& vertex_input, const Material& material, std::uint32_t object,
+                     IndexRange range, const mEn::Vec3& sort_origin, RenderMode mode = RenderMode::Triangles);
   /**
    * @brief Submit geometry for hardware-instanced rendering.
    *
-   * Draws @p instance_count instances of @p vertex_input. Instanced attributes must be configured in
+   * Queues @p instance_count instances of @p vertex_input. Instanced attributes must be configured in
    * the vertex input's buffer layout. Must be called inside a begin_scene / end_scene block.
    */
   static void submit_instanced(Shader& shader, const VertexInput& vertex_input, std::size_t instance_count,
@@ -99,13 +305,63 @@ class Renderer {
   /**
    * @brief Submit geometry for tessellated rendering.
    *
-   * Configures @p patch_vertex_count control points per patch, uploads camera uniforms and `u_M`,
-   * then draws using the Patches primitive topology. Must be called inside a begin_scene / end_scene block.
+   * Queues a draw using the Patches primitive topology with @p patch_vertex_count control points per
+   * patch, drawn as a new object with the cached matrices of @p transform. Must be called inside a
+   * begin_scene / end_scene block.
    */
   static void submit_tessellated(Shader& shader, const VertexInput& vertex_input, std::size_t patch_vertex_count,
                                  const Transform& transform);
 
  private:
+  /**
+   * @brief Queues @p packet in the current view, keyed by its state and distance to the camera.
+   * @param sort_origin Object-space point of the packet's object whose distance to the camera orders the draw.
+   */
+  static void enqueue(const DrawPacket& packet, const mEn::Vec3& sort_origin = {});
+  /** @brief Uploads the objects of the current view and binds them at @ref kObjectBinding. */
+  static void upload_objects();
+  /** @brief Uploads the material blocks if new ones were baked since, and binds them at @ref kMaterialBinding. */
+  static void upload_materials();
+  /** @brief Resets the per-view state and uploads the `Camera` block; the camera must already be stored. */
+  static void begin_view(RenderContext& ctx);
+  /** @brief Sorts and issues the current view's draws. */
+  static void execute_queue();
+
+  /** @brief Storage buffer holding one std430 array after an optional header; grows as needed. */
+  struct StorageArray {
+    std::shared_ptr<MutableBuffer> buffer;
+    std::shared_ptr<ShaderStorageBuffer> ssbo;
+
+    /** @brief Allocates @p size bytes on @p device. */
+    void create(Device& device, std::size_t size, const char* debug_name);
+    void reset();
+    /** @brief Binds the buffer at @p binding for the shader @p stage that reads it. */
+    void bind(RenderContext& ctx, std::uint32_t binding, ShaderStage stage) const;
+    /** @brief Writes @p header followed by @p elements, growing the buffer geometrically, and binds it. */
+    void upload(RenderContext& ctx, std::uint32_t binding, ShaderStage stage, std::span<const std::byte> header,
+                std::span<const std::byte> elements);
+    /** @brief Overwrites @p elements at byte @p offset, which the buffer must already hold, and binds it. */
+    void update(RenderContext& ctx, std::uint32_t binding, ShaderStage stage, std::size_t offset,
+                std::span<const std::byte> elements);
+  };
+
+  /** @brief Packs @p lights and uploads them with their count to @p array. */
+  template <typename Data>
+  static void upload_lights(StorageArray& array, std::uint32_t binding, std::span<const Data> lights,
+                            std::vector<typename Data::Packed>& scratch);
+
+  /** @brief CPU mirror of the std140 `Camera` block in `camera.glsl`. */
+  struct CameraBlock {
+    mEn::Mat4 view;
+    mEn::Mat4 projection;
+    mEn::Mat4 view_projection;
+    mEn::Vec3 position;
+    float pad0 = 0.F;
+    mEn::Vec3 ambient;
+    float pad1 = 0.F;
+  };
+  static_assert(sizeof(CameraBlock) == 224, "CameraBlock must match the std140 layout of the Camera block");
+
   struct SceneData {
     RenderContext* ctx = nullptr;
     mEn::Mat4 v_matrix;
@@ -116,8 +372,53 @@ class Renderer {
     std::vector<DirectionalLight*> directional_lights;
     std::vector<SpotLight*> spot_lights;
     mEn::Vec3 ambient{};
+
+    Frustum frustum{};
+    bool frustum_culling = true;
+    CullStats cull_stats;
+    std::vector<std::uint8_t> visibility;
+
+    LodSettings lod_settings;
+    LodStats lod_stats;
+    std::uint32_t lod_view = 0;
+    float lod_pixel_scale  = 0.F;  ///< Pixels per world unit, at unit distance for perspective projections.
+    bool perspective       = true;
+
+    RenderQueue queue;
+    QueueStats queue_stats;
+
+    std::shared_ptr<MutableBuffer> camera_buffer;
+    std::shared_ptr<UniformBuffer> camera_ubo;
+    StorageArray objects;
+
+    StorageArray directional_light_array;
+    StorageArray point_light_array;
+    StorageArray spot_light_array;
+    std::vector<DirectionalLight::Data::Packed> packed_directional_lights;  ///< Reused between uploads.
+    std::vector<PointLight::Data::Packed> packed_point_lights;              ///< Reused between uploads.
+    std::vector<SpotLight::Data::Packed> packed_spot_lights;                ///< Reused between uploads.
+    std::vector<PointLight::Data> point_light_data;                         ///< Registered lights, reused by prepare().
+    std::vector<DirectionalLight::Data> directional_light_data;             ///< Registered lights, reused by prepare().
+    std::vector<SpotLight::Data> spot_light_data;                           ///< Registered lights, reused by prepare().
+
+    LightClusters light_clusters;
+    StorageArray light_cluster_array;
+    StorageArray light_index_array;
+
+    StorageArray material_array;
+    std::size_t uploaded_materials = 0;  ///< Number of @ref MaterialTable blocks in @ref material_array.
   };
 
+  /** @brief Object of every view that draws submitted without a transform read, through a base instance of 0. */
+  static constexpr std::uint32_t kIdentityObject = 0;
+
+  static constexpr float kDefaultLodViewportHeight  = 1080.F;
+  static constexpr std::size_t kInitialObjects      = 256;   ///< Capacity of the object buffer before it first grows.
+  static constexpr std::size_t kInitialLights       = 16;    ///< Capacity of each light buffer before it first grows.
+  static constexpr std::size_t kLightHeaderSize     = 16;    ///< Light count, padded to the alignment of the array.
+  static constexpr std::size_t kInitialLightIndices = 4096;  ///< Capacity of the cluster light lists before they grow.
+  static constexpr std::size_t kInitialMaterials    = 64;    ///< Capacity of the material buffer before it first grows.
+
   static std::unique_ptr<SceneData> scene_data_;
 };
 
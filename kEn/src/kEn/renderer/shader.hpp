@@ -8,6 +8,7 @@
 #include <mEn.hpp>
 
 #include <kEn/core/core.hpp>
+#include <kEn/renderer/uniform_id.hpp>
 
 /** @file
  *  @ingroup ken
@@ -80,6 +81,11 @@ struct ShaderConfig {
  *
  * A Shader represents a linked GPU program. Implementations are responsible for
  * compiling, linking, binding, and updating uniforms/uniform blocks.
+ *
+ * Uniforms are looked up by @ref UniformId: setting one by name hashes the
+ * name first, so hot paths should keep ids built once (e.g. from
+ * @c "..."_uniform literals).  Backends remember the last value written to
+ * each uniform and skip writes that would not change it.
  */
 class Shader {
  public:
@@ -96,15 +102,23 @@ class Shader {
   // <Uniforms>
 
   /**
-   * @brief Set a uniform by name using a type-erased value.
+   * @brief Set a uniform using a type-erased value, unless it already holds @p value.
    *
-   * @param name  Uniform name as declared in the shader.
+   * @param id    Uniform name as declared in the shader, with its hash.
    * @param value Value to upload; must be one of UniformValue's alternatives.
    *
    * @note Backends may log a warning if the uniform is not found/active.
    * @note Not guaranteed to be thread-safe; intended for the render thread.
    */
-  virtual void set_uniform_any(std::string_view name, const UniformValue& value) const = 0;
+  virtual void set_uniform_any(UniformId id, const UniformValue& value) const = 0;
+
+  /** @brief Same as above, hashing @p name first. */
+  void set_uniform_any(std::string_view name, const UniformValue& value) const {
+    set_uniform_any(UniformId(name), value);
+  }
+
+  /** @brief Returns whether the program has an active uniform named @p id. */
+  [[nodiscard]] virtual bool has_uniform(UniformId id) const = 0;
 
   /**
    * @brief Set a 1D scalar uniform array by name using a type-erased span.
@@ -125,7 +139,13 @@ class Shader {
    */
   template <class T>
   void set_uniform(std::string_view name, const T& value) const {
-    set_uniform_any(name, UniformValue{value});
+    set_uniform_any(UniformId(name), UniformValue{value});
+  }
+
+  /** @brief Convenience typed wrapper around set_uniform_any(UniformId, const UniformValue&) const. */
+  template <class T>
+  void set_uniform(UniformId id, const T& value) const {
+    set_uniform_any(id, UniformValue{value});
   }
 
   /**
@@ -157,8 +177,9 @@ class Shader {
    *
    * @param block_name  Uniform block name as declared in the shader.
    * @param stage       Shader stage hint used by the backend to select the correct binding point.
-   * @return The binding point, or @c std::nullopt if the block does not exist or
-   *         has not been bound yet.
+   * @return The binding point, either declared in the shader or set by bind_uniform_block(), or
+   *         @c std::nullopt if the block does not exist.  Backends that cannot reflect the
+   *         declared binding only know blocks that have been bound.
    */
   [[nodiscard]] virtual std::optional<std::uint32_t> uniform_block_binding(std::string_view block_name,
                                                                            ShaderStage stage) const = 0;
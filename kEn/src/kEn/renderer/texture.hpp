@@ -4,8 +4,10 @@
 
 #include <algorithm>
 #include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <span>
+#include <string>
 
 #include <kEn/core/core.hpp>
 #include <kEn/renderer/render_context.hpp>
@@ -88,6 +90,8 @@ struct TextureDesc {
   TextureFormat format     = TextureFormat::RGBA8;
   std::uint32_t mip_levels = 1;  // Use kFullMipChain for a full chain.
 
+  std::string debug_name; /**< Label for memory accounting and graphics debuggers. */
+
   /** @brief Maximum mip levels supported by the texture dimensions. */
   [[nodiscard]] constexpr std::uint32_t max_mip_levels() const noexcept {
     const std::uint32_t max_dim =
@@ -112,6 +116,23 @@ struct TextureDesc {
     }
   }
 
+  /** @brief Bytes of texel storage over every mip level, layer and face, ignoring driver padding. */
+  [[nodiscard]] constexpr std::size_t memory_size() const noexcept {
+    const auto [block_width, block_height] = texture_format::block_extent(format);
+    const std::size_t images               = cube_face_count() != 0 ? cube_face_count() : layers;
+
+    std::size_t bytes = 0;
+    for (std::uint32_t level = 0; level < resolved_mip_levels(); ++level) {
+      const std::size_t w      = std::max(width >> level, 1U);
+      const std::size_t h      = std::max(height >> level, 1U);
+      const std::size_t d      = kind == TextureKind::Tex3D ? std::max(depth >> level, 1U) : 1U;
+      const std::size_t blocks =
+          ((w + block_width - 1) / block_width) * ((h + block_height - 1) / block_height) * d * images;
+      bytes += blocks * texture_format::bytes_per_block(format);
+    }
+    return bytes;
+  }
+
   /** @brief Returns true if @ref mip_levels is either @ref kFullMipChain or does not exceed @ref max_mip_levels(). */
   [[nodiscard]] constexpr bool has_valid_mip_request() const noexcept {
     return mip_levels == kFullMipChain || mip_levels <= max_mip_levels();
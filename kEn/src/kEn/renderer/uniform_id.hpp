@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+/**
+ * @brief Uniform name paired with its 64-bit FNV-1a hash.
+ *
+ * Shaders reflect their active uniforms at link time and index them by this
+ * hash, so setting a uniform through an id costs one integer lookup instead of
+ * hashing and comparing the name.  Ids built from literals are hashed at
+ * compile time:
+ * @code{.cpp}
+ * using namespace kEn::literals;
+ * constexpr kEn::UniformId kShadowBias = "u_ShadowBias"_uniform;
+ * shader.set_uniform(kShadowBias, bias);
+ * @endcode
+ *
+ * The id only views its name, which is kept for diagnostics: names that are
+ * not literals must outlive the id.
+ */
+class UniformId {
+ public:
+  constexpr explicit UniformId(std::string_view name) noexcept : name_(name), hash_(hash(name)) {}
+
+  /** @brief FNV-1a hash of @p name, the key shaders index their uniforms by. */
+  [[nodiscard]] static constexpr std::uint64_t hash(std::string_view name) noexcept {
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    for (const char c : name) {
+      hash ^= static_cast<std::uint8_t>(c);
+      hash *= 0x100000001B3ULL;
+    }
+    return hash;
+  }
+
+  [[nodiscard]] constexpr std::string_view name() const noexcept { return name_; }
+  [[nodiscard]] constexpr std::uint64_t hash() const noexcept { return hash_; }
+
+  [[nodiscard]] constexpr bool operator==(const UniformId& other) const noexcept { return hash_ == other.hash_; }
+
+ private:
+  std::string_view name_;
+  std::uint64_t hash_;
+};
+
+namespace literals {
+
+/** @brief Builds a @ref UniformId from a literal, hashed at compile time. */
+[[nodiscard]] consteval UniformId operator""_uniform(const char* name, std::size_t size) {
+  return UniformId(std::string_view(name, size));
+}
+
+}  // namespace literals
+
+}  // namespace kEn
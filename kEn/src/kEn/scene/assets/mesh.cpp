@@ -1,40 +1,99 @@
 #include "mesh.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include <mEn/functions/geometric.hpp>
+
 #include <kEn/core/application.hpp>
+#include <kEn/core/assert.hpp>
 #include <kEn/core/transform.hpp>
 #include <kEn/renderer/buffer.hpp>
 #include <kEn/renderer/material.hpp>
 #include <kEn/renderer/renderer.hpp>
 #include <kEn/renderer/vertex_input.hpp>
+#include <kEn/scene/assets/mesh_lod.hpp>
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/triangle_bvh.hpp>
 
 namespace kEn {
 
+namespace {
+
+Bounds compute_bounds(const std::vector<Vertex>& vertices) {
+  Bounds bounds;
+  for (const auto& v : vertices) {
+    bounds.box.expand(v.pos);
+  }
+  if (!bounds.box.valid()) {
+    return bounds;
+  }
+
+  bounds.sphere.center = bounds.box.center();
+  for (const auto& v : vertices) {
+    bounds.sphere.radius = std::max(bounds.sphere.radius, mEn::distance(bounds.sphere.center, v.pos));
+  }
+  return bounds;
+}
+
+}  // namespace
+
 Mesh::Mesh(std::string_view name, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
-           kEn::Material material)
-    : name(name), material(std::move(material)) {
+           kEn::Material material, bool keep_triangles)
+    : name(name), material(std::move(material)), bounds_(compute_bounds(vertices)) {
+  this->material.bake();
+
   auto& dev = device();
   vao_      = dev.create_vertex_input();
 
-  const std::shared_ptr<Buffer> vbo = dev.create_buffer(
-      {.size = vertices.size() * sizeof(Vertex), .usage = BufferUsage::Immutable, .bind_flags = BufferBind::Vertex},
-      vertices.data());
+  const std::shared_ptr<Buffer> vbo = dev.create_buffer({.size       = vertices.size() * sizeof(Vertex),
+                                                         .usage      = BufferUsage::Immutable,
+                                                         .bind_flags = BufferBind::Vertex,
+                                                         .debug_name = this->name},
+                                                        vertices.data());
   vao_->add_vertex_stream({.buffer = vbo, .layout = kVertexLayout});
 
-  const std::shared_ptr<Buffer> ebo = dev.create_buffer(
-      {.size = indices.size() * sizeof(uint32_t), .usage = BufferUsage::Immutable, .bind_flags = BufferBind::Index},
-      indices.data());
+  const std::shared_ptr<Buffer> ebo = dev.create_buffer({.size       = indices.size() * sizeof(uint32_t),
+                                                         .usage      = BufferUsage::Immutable,
+                                                         .bind_flags = BufferBind::Index,
+                                                         .debug_name = this->name},
+                                                        indices.data());
+  vao_->set_index_buffer(ebo);
+  lods_.push_back({.first_index = 0, .index_count = static_cast<std::uint32_t>(indices.size()), .error = 0.F});
+
+  if (!keep_triangles) {
+    return;
+  }
+  std::vector<mEn::Vec3> positions;
+  positions.reserve(vertices.size());
+  for (const auto& v : vertices) {
+    positions.push_back(v.pos);
+  }
+  triangles_ = std::make_unique<TriangleBvh>(std::move(positions), indices, this->name);
+}
+
+void Mesh::set_lods(const LodChain& chain) {
+  KEN_CORE_ASSERT(!chain.levels.empty() && chain.levels[0].index_count == lods_[0].index_count,
+                  "LOD chain does not match the mesh");
+
+  const std::shared_ptr<Buffer> ebo = device().create_buffer({.size       = chain.indices.size() * sizeof(uint32_t),
+                                                              .usage      = BufferUsage::Immutable,
+                                                              .bind_flags = BufferBind::Index,
+                                                              .debug_name = name + " (LODs)"},
+                                                             chain.indices.data());
   vao_->set_index_buffer(ebo);
+  lods_ = chain.levels;
 }
 
-void Mesh::render(Shader& shader, const Transform& transform) const {
-  material.apply(shader, device().context());
-  Renderer::submit(shader, *vao_, transform);
+void Mesh::render(Shader& shader, std::uint32_t object, std::size_t lod) const {
+  const auto& level = lods_[std::min(lod, lods_.size() - 1)];
+  Renderer::submit(shader, *vao_, material, object, {.first = level.first_index, .count = level.index_count},
+                   bounds_.box.center());
 }
 
 }  // namespace kEn
@@ -7,7 +7,10 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -20,6 +23,9 @@
 #include <kEn/renderer/material.hpp>
 #include <kEn/renderer/shader.hpp>
 #include <kEn/renderer/vertex_input.hpp>
+#include <kEn/scene/assets/mesh_lod.hpp>
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/triangle_bvh.hpp>
 
 namespace kEn {
 
@@ -41,11 +47,17 @@ struct Vertex {
  * @brief A single draw call unit: a VAO plus a @ref Material.
  *
  * Vertex and index data are uploaded to immutable GPU buffers at construction
- * and the CPU copies are discarded immediately.  The mesh is therefore
+ * and the full vertices are discarded immediately; only the object-space
+ * @ref bounds are kept, plus a position/index copy for CPU ray casts if the
+ * mesh was created with @c keep_triangles.  The mesh is therefore
  * move-only; copying is deleted because the VAO cannot be duplicated cheaply.
  *
- * @ref render applies the material uniforms and issues a single indexed draw
- * call via @ref Renderer::submit.
+ * A mesh starts with a single level of detail; a simplified chain generated
+ * off-thread can be attached later with @ref set_lods, which replaces the
+ * index buffer while keeping the vertex buffer.
+ *
+ * @ref render queues a single indexed draw with the mesh's material via
+ * @ref Renderer::submit; the material is applied when the queue is executed.
  */
 class Mesh {
  public:
@@ -53,15 +65,17 @@ class Mesh {
   kEn::Material material;  ///< Surface description applied before each draw.
 
   /**
-   * @brief Upload vertex and index data to immutable GPU buffers.
+   * @brief Upload vertex and index data to immutable GPU buffers and compute
+   *        the object-space bounds.
    *
-   * @param name      Debug name (stored as-is).
-   * @param vertices  Vertex data; copied into a GPU buffer and then discarded.
-   * @param indices   Index data; copied into a GPU buffer and then discarded.
-   * @param material  Surface material moved into the mesh.
+   * @param name            Debug name (stored as-is).
+   * @param vertices        Vertex data; copied into a GPU buffer.
+   * @param indices         Index data; copied into a GPU buffer.
+   * @param material        Surface material moved into the mesh and baked.
+   * @param keep_triangles  Keep a copy of the positions and indices so that @ref raycast works.
    */
   Mesh(std::string_view name, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
-       kEn::Material material);
+       kEn::Material material, bool keep_triangles = false);
 
   Mesh(const Mesh&)            = delete;
   Mesh& operator=(const Mesh&) = delete;
@@ -69,12 +83,39 @@ class Mesh {
   Mesh& operator=(Mesh&&)      = default;
 
   /**
-   * @brief Apply the material and issue an indexed draw call.
+   * @brief Queue an indexed draw call with the mesh's material.
+   *
+   * @param shader  The active shader program.
+   * @param object  Index of the object drawn, see @ref Renderer::add_object.
+   * @param lod     Level of detail to draw; clamped to the available levels.
+   */
+  void render(Shader& shader, std::uint32_t object, std::size_t lod = 0) const;
+
+  /** @brief Levels of detail, finest first; always holds at least the source mesh. */
+  [[nodiscard]] std::span<const LodLevel> lods() const noexcept { return lods_; }
+
+  /**
+   * @brief Replace the index buffer with all levels of @p chain.
    *
-   * @param shader     The active shader program.
-   * @param transform  World transform uploaded as model matrix uniforms.
+   * Must be called on the render thread.  The chain's level 0 must be the
+   * index list the mesh was created with.
    */
-  void render(Shader& shader, const Transform& transform) const;
+  void set_lods(const LodChain& chain);
+
+  /** @brief Object-space AABB and bounding sphere of the vertex positions. */
+  [[nodiscard]] const Bounds& bounds() const noexcept { return bounds_; }
+
+  /**
+   * @brief Finds the closest triangle hit by the object-space @p ray closer than @p max_t.
+   *
+   * The triangle BVH is built on the first call.  Never hits if the mesh keeps no triangles.
+   */
+  [[nodiscard]] std::optional<TriangleHit> raycast(const Ray& ray, float max_t) const {
+    return triangles_ != nullptr ? triangles_->raycast(ray, max_t) : std::nullopt;
+  }
+
+  /** @brief Returns the CPU-side triangle hierarchy used by @ref raycast, or @c nullptr if none is kept. */
+  [[nodiscard]] const TriangleBvh* triangles() const noexcept { return triangles_.get(); }
 
   /**
    * @brief Compile-time vertex attribute layout for VAO setup.
@@ -91,6 +132,9 @@ class Mesh {
 
  private:
   std::unique_ptr<VertexInput> vao_;
+  Bounds bounds_;
+  std::vector<LodLevel> lods_;
+  std::unique_ptr<TriangleBvh> triangles_;  ///< Only with @c keep_triangles.
 };
 
 }  // namespace kEn
@@ -0,0 +1,581 @@
+#include "mesh_lod.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <queue>
+#include <random>
+#include <span>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include <mEn/functions/geometric.hpp>
+#include <mEn/fwd.hpp>
+#include <mEn/vec2.hpp>
+#include <mEn/vec3.hpp>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/core/log.hpp>
+#include <kEn/scene/assets/mesh.hpp>
+#include <kEn/scene/bounds.hpp>
+
+namespace kEn {
+
+namespace {
+
+/** @brief Minimum cosine between a triangle's normal before and after a collapse. */
+constexpr float kMinNormalDot = 0.25F;
+
+/** @brief A level is only emitted if it removes at least this fraction of the previous level's triangles. */
+constexpr float kMinReduction = 0.1F;
+
+/** @brief Bumped whenever the simplifier or the cache layout changes, invalidating old cache entries. */
+constexpr std::uint32_t kCacheVersion = 1;
+constexpr std::uint32_t kCacheMagic   = 0x444F4C4B;  // "KLOD"
+
+/** @brief Symmetric 4x4 error quadric, stored as its upper triangle. */
+struct Quadric {
+  std::array<double, 10> q{};
+
+  /** @brief Returns the area-weighted quadric of the plane n.p + d = 0; @p n must be unit length. */
+  static Quadric from_plane(const mEn::Vec3& n, double d, double weight) {
+    const double a = n.x;
+    const double b = n.y;
+    const double c = n.z;
+
+    Quadric result;
+    result.q = {a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d};
+    for (auto& value : result.q) {
+      value *= weight;
+    }
+    return result;
+  }
+
+  Quadric& operator+=(const Quadric& other) {
+    for (size_t i = 0; i < q.size(); ++i) {
+      q[i] += other.q[i];
+    }
+    return *this;
+  }
+
+  /** @brief Returns the weighted sum of squared distances of @p p to the accumulated planes. */
+  [[nodiscard]] double evaluate(const mEn::Vec3& p) const {
+    const double x = p.x;
+    const double y = p.y;
+    const double z = p.z;
+    return (q[0] * x * x) + (2. * q[1] * x * y) + (2. * q[2] * x * z) + (2. * q[3] * x) + (q[4] * y * y) +
+           (2. * q[5] * y * z) + (2. * q[6] * y) + (q[7] * z * z) + (2. * q[8] * z) + q[9];
+  }
+};
+
+/** @brief Bit patterns of the attributes that decide whether two vertices are welded. */
+using WeldKey = std::array<std::uint32_t, 8>;
+
+struct WeldKeyHash {
+  size_t operator()(const WeldKey& key) const noexcept {
+    size_t hash = 0;
+    for (const auto word : key) {
+      hash = (hash * 0x100000001B3ULL) ^ word;
+    }
+    return hash;
+  }
+};
+
+struct WeldedVertex {
+  mEn::Vec3 pos;
+  mEn::Vec3 normal;
+  mEn::Vec2 uv;
+  std::uint32_t source = 0;  ///< First source vertex of the welded group; emitted into the LOD indices.
+};
+
+/** @brief Greedy half-edge collapse over a welded copy of one mesh. */
+class Simplifier {
+ public:
+  Simplifier(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices, const LodOptions& options) {
+    weld(vertices, indices);
+    lock_borders_and_seams();
+
+    Aabb box;
+    for (const auto& v : verts_) {
+      box.expand(v.pos);
+    }
+    radius_ = box.valid() ? mEn::length(box.extents()) : 0.F;
+
+    const double normal_weight = static_cast<double>(options.normal_weight * radius_);
+    const double uv_weight     = static_cast<double>(options.uv_weight * radius_);
+    const double max_error     = static_cast<double>(options.max_error * radius_);
+    normal_weight2_            = normal_weight * normal_weight;
+    uv_weight2_                = uv_weight * uv_weight;
+    max_cost_                  = max_error * max_error;
+
+    compute_quadrics();
+    for (std::uint32_t v = 0; v < verts_.size(); ++v) {
+      push_best(v);
+    }
+  }
+
+  [[nodiscard]] size_t triangle_count() const noexcept { return alive_tris_; }
+
+  /** @brief Collapses edges until at most @p target triangles remain.  Returns false once nothing is left to do. */
+  bool simplify_to(size_t target) {
+    while (alive_tris_ > target) {
+      if (heap_.empty()) {
+        return false;
+      }
+
+      const Candidate top = heap_.top();
+      heap_.pop();
+      if (removed_[top.from] || top.stamp != stamps_[top.from]) {
+        continue;
+      }
+      if (removed_[top.to] || !can_collapse(top.from, top.to)) {
+        push_best(top.from);
+        continue;
+      }
+      if (top.cost > max_cost_) {
+        return false;
+      }
+
+      error_ = std::max(error_, top.cost);
+      collapse(top.from, top.to);
+    }
+
+    return true;
+  }
+
+  /** @brief Object-space error of the current state: the largest collapse cost spent so far, as a distance. */
+  [[nodiscard]] float error() const noexcept { return static_cast<float>(std::sqrt(error_)); }
+
+  /** @brief Appends the surviving triangles, in source vertex indices, to @p out. */
+  void emit(std::vector<std::uint32_t>& out) const {
+    for (size_t t = 0; t < tris_.size(); ++t) {
+      if (tri_alive_[t]) {
+        for (const auto v : tris_[t]) {
+          out.push_back(verts_[v].source);
+        }
+      }
+    }
+  }
+
+ private:
+  struct Candidate {
+    double cost;
+    std::uint32_t from;
+    std::uint32_t to;
+    std::uint32_t stamp;
+
+    bool operator>(const Candidate& other) const noexcept { return cost > other.cost; }
+  };
+
+  void weld(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices) {
+    std::unordered_map<WeldKey, std::uint32_t, WeldKeyHash> welded;
+    std::vector<std::uint32_t> remap(vertices.size());
+
+    for (std::uint32_t i = 0; i < vertices.size(); ++i) {
+      const auto& v     = vertices[i];
+      const WeldKey key = {std::bit_cast<std::uint32_t>(v.pos.x + 0.F),
+                           std::bit_cast<std::uint32_t>(v.pos.y + 0.F),
+                           std::bit_cast<std::uint32_t>(v.pos.z + 0.F),
+                           std::bit_cast<std::uint32_t>(v.normal.x + 0.F),
+                           std::bit_cast<std::uint32_t>(v.normal.y + 0.F),
+                           std::bit_cast<std::uint32_t>(v.normal.z + 0.F),
+                           std::bit_cast<std::uint32_t>(v.texture_coord.x + 0.F),
+                           std::bit_cast<std::uint32_t>(v.texture_coord.y + 0.F)};
+
+      const auto [it, inserted] = welded.try_emplace(key, static_cast<std::uint32_t>(verts_.size()));
+      if (inserted) {
+        verts_.push_back({.pos = v.pos, .normal = v.normal, .uv = v.texture_coord, .source = i});
+      }
+      remap[i] = it->second;
+    }
+
+    vertex_tris_.resize(verts_.size());
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+      const std::array<std::uint32_t, 3> tri = {remap[indices[i]], remap[indices[i + 1]], remap[indices[i + 2]]};
+      if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2]) {
+        continue;
+      }
+
+      const auto t = static_cast<std::uint32_t>(tris_.size());
+      tris_.push_back(tri);
+      for (const auto v : tri) {
+        vertex_tris_[v].push_back(t);
+      }
+    }
+
+    tri_alive_.assign(tris_.size(), true);
+    alive_tris_ = tris_.size();
+  }
+
+  void lock_borders_and_seams() {
+    locked_.assign(verts_.size(), false);
+    removed_.assign(verts_.size(), false);
+    stamps_.assign(verts_.size(), 0);
+
+    // Edges used by exactly one triangle are borders; more than two make the surface non-manifold.
+    std::unordered_map<std::uint64_t, std::uint32_t> edge_use;
+    for (const auto& tri : tris_) {
+      for (size_t k = 0; k < 3; ++k) {
+        const std::uint32_t a = std::min(tri[k], tri[(k + 1) % 3]);
+        const std::uint32_t b = std::max(tri[k], tri[(k + 1) % 3]);
+        ++edge_use[(static_cast<std::uint64_t>(a) << 32U) | b];
+      }
+    }
+    for (const auto& [edge, uses] : edge_use) {
+      if (uses != 2) {
+        locked_[edge >> 32U]        = true;
+        locked_[edge & 0xFFFFFFFFU] = true;
+      }
+    }
+
+    // Vertices sharing a position with another welded vertex lie on an attribute seam.
+    std::unordered_map<WeldKey, std::uint32_t, WeldKeyHash> position_use;
+    const auto position_key = [](const mEn::Vec3& p) {
+      return WeldKey{std::bit_cast<std::uint32_t>(p.x + 0.F), std::bit_cast<std::uint32_t>(p.y + 0.F),
+                     std::bit_cast<std::uint32_t>(p.z + 0.F)};
+    };
+    for (const auto& v : verts_) {
+      ++position_use[position_key(v.pos)];
+    }
+    for (size_t v = 0; v < verts_.size(); ++v) {
+      if (position_use[position_key(verts_[v].pos)] > 1) {
+        locked_[v] = true;
+      }
+    }
+  }
+
+  void compute_quadrics() {
+    quadrics_.assign(verts_.size(), {});
+    areas_.assign(verts_.size(), 0.);
+
+    for (const auto& tri : tris_) {
+      const mEn::Vec3& a = verts_[tri[0]].pos;
+      const mEn::Vec3 n  = mEn::cross(verts_[tri[1]].pos - a, verts_[tri[2]].pos - a);
+      const float len    = mEn::length(n);
+      if (len <= 0.F) {
+        continue;
+      }
+
+      const mEn::Vec3 unit  = n / len;
+      const double area     = 0.5 * static_cast<double>(len);
+      const Quadric quadric = Quadric::from_plane(unit, -static_cast<double>(mEn::dot(unit, a)), area);
+      for (const auto v : tri) {
+        quadrics_[v] += quadric;
+        areas_[v] += area / 3.;
+      }
+    }
+  }
+
+  [[nodiscard]] double cost(std::uint32_t from, std::uint32_t to) const {
+    constexpr double kMinArea = 1e-20;
+
+    Quadric quadric = quadrics_[from];
+    quadric += quadrics_[to];
+    const double area      = std::max(areas_[from] + areas_[to], kMinArea);
+    const double geometric = std::max(quadric.evaluate(verts_[to].pos), 0.) / area;
+
+    const mEn::Vec3 dn  = verts_[from].normal - verts_[to].normal;
+    const mEn::Vec2 duv = verts_[from].uv - verts_[to].uv;
+    return geometric + (normal_weight2_ * static_cast<double>(mEn::dot(dn, dn))) +
+           (uv_weight2_ * static_cast<double>(mEn::dot(duv, duv)));
+  }
+
+  /** @brief Replaces the contents of @p ring with the sorted, unique one-ring of @p v, reusing its storage. */
+  void neighbors(std::uint32_t v, std::vector<std::uint32_t>& ring) const {
+    ring.clear();
+    for (const auto t : vertex_tris_[v]) {
+      if (tri_alive_[t]) {
+        for (const auto w : tris_[t]) {
+          if (w != v) {
+            ring.push_back(w);
+          }
+        }
+      }
+    }
+    std::ranges::sort(ring);
+    const auto [first, last] = std::ranges::unique(ring);
+    ring.erase(first, last);
+  }
+
+  [[nodiscard]] bool can_collapse(std::uint32_t from, std::uint32_t to) {
+    if (locked_[from]) {
+      return false;
+    }
+
+    // Link condition: an interior edge must have exactly two opposite vertices, or the collapse pinches the surface.
+    neighbors(from, from_ring_);
+    neighbors(to, to_ring_);
+    shared_ring_.clear();
+    std::ranges::set_intersection(from_ring_, to_ring_, std::back_inserter(shared_ring_));
+    if (shared_ring_.size() != 2) {
+      return false;
+    }
+
+    const mEn::Vec3& target = verts_[to].pos;
+    for (const auto t : vertex_tris_[from]) {
+      const auto& tri = tris_[t];
+      if (!tri_alive_[t] || std::ranges::find(tri, to) != tri.end()) {
+        continue;
+      }
+
+      std::array<mEn::Vec3, 3> p = {verts_[tri[0]].pos, verts_[tri[1]].pos, verts_[tri[2]].pos};
+      const mEn::Vec3 before     = mEn::cross(p[1] - p[0], p[2] - p[0]);
+      for (size_t k = 0; k < 3; ++k) {
+        if (tri[k] == from) {
+          p[k] = target;
+        }
+      }
+      const mEn::Vec3 after = mEn::cross(p[1] - p[0], p[2] - p[0]);
+
+      const float before_len = mEn::length(before);
+      const float after_len  = mEn::length(after);
+      if (after_len <= 0.F) {
+        return false;
+      }
+      if (before_len > 0.F && mEn::dot(before, after) < kMinNormalDot * before_len * after_len) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /** @brief Queues the cheapest valid collapse of @p v, invalidating any queued one. */
+  void push_best(std::uint32_t v) {
+    ++stamps_[v];
+    if (locked_[v] || removed_[v]) {
+      return;
+    }
+
+    std::optional<Candidate> best;
+    neighbors(v, candidate_ring_);
+    for (const auto w : candidate_ring_) {
+      const double c = cost(v, w);
+      if ((!best || c < best->cost) && can_collapse(v, w)) {
+        best = Candidate{.cost = c, .from = v, .to = w, .stamp = stamps_[v]};
+      }
+    }
+
+    if (best) {
+      heap_.push(*best);
+    }
+  }
+
+  void collapse(std::uint32_t from, std::uint32_t to) {
+    for (const auto t : vertex_tris_[from]) {
+      if (!tri_alive_[t]) {
+        continue;
+      }
+
+      auto& tri = tris_[t];
+      if (std::ranges::find(tri, to) != tri.end()) {
+        tri_alive_[t] = false;
+        --alive_tris_;
+        continue;
+      }
+
+      std::ranges::replace(tri, from, to);
+      vertex_tris_[to].push_back(t);
+    }
+
+    quadrics_[to] += quadrics_[from];
+    areas_[to] += areas_[from];
+    removed_[from] = true;
+    vertex_tris_[from].clear();
+    std::erase_if(vertex_tris_[to], [this](std::uint32_t t) { return !tri_alive_[t]; });
+
+    // Only the one-ring of the target changed; requeue it.
+    push_best(to);
+    neighbors(to, requeue_ring_);
+    for (const auto w : requeue_ring_) {
+      push_best(w);
+    }
+  }
+
+  std::vector<WeldedVertex> verts_;
+  std::vector<Quadric> quadrics_;
+  std::vector<double> areas_;
+  std::vector<bool> locked_;
+  std::vector<bool> removed_;
+  std::vector<std::uint32_t> stamps_;
+
+  std::vector<std::array<std::uint32_t, 3>> tris_;
+  std::vector<bool> tri_alive_;
+  std::vector<std::vector<std::uint32_t>> vertex_tris_;
+  size_t alive_tris_ = 0;
+
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> heap_;
+
+  // One-ring scratch buffers, one per caller since push_best() runs inside collapse() and calls can_collapse().
+  std::vector<std::uint32_t> from_ring_;
+  std::vector<std::uint32_t> to_ring_;
+  std::vector<std::uint32_t> shared_ring_;
+  std::vector<std::uint32_t> candidate_ring_;
+  std::vector<std::uint32_t> requeue_ring_;
+
+  float radius_          = 0.F;
+  double normal_weight2_ = 0.;
+  double uv_weight2_     = 0.;
+  double max_cost_       = 0.;
+  double error_          = 0.;
+};
+
+/** @brief 64-bit FNV-1a over @p bytes, continuing from @p hash. */
+std::uint64_t fnv1a(std::span<const std::byte> bytes, std::uint64_t hash = 0xCBF29CE484222325ULL) {
+  for (const auto b : bytes) {
+    hash = (hash ^ static_cast<std::uint64_t>(b)) * 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+std::uint64_t cache_key(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices,
+                        const LodOptions& options) {
+  const std::array<float, 5> params = {options.ratio, options.max_error, options.normal_weight, options.uv_weight,
+                                       static_cast<float>(kCacheVersion)};
+  const std::array<std::uint64_t, 2> limits = {options.max_levels, options.min_triangles};
+
+  std::uint64_t hash = fnv1a(std::as_bytes(vertices));
+  hash               = fnv1a(std::as_bytes(indices), hash);
+  hash               = fnv1a(std::as_bytes(std::span(params)), hash);
+  return fnv1a(std::as_bytes(std::span(limits)), hash);
+}
+
+struct CacheHeader {
+  std::uint32_t magic       = kCacheMagic;
+  std::uint32_t version     = kCacheVersion;
+  std::uint32_t level_count = 0;
+  std::uint32_t index_count = 0;
+};
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+std::optional<LodChain> read_cache(const std::filesystem::path& file, size_t vertex_count) {
+  std::ifstream in(file, std::ios::binary);
+  if (!in) {
+    return std::nullopt;
+  }
+
+  CacheHeader header;
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!in || header.magic != kCacheMagic || header.version != kCacheVersion || header.level_count == 0) {
+    return std::nullopt;
+  }
+
+  LodChain chain;
+  chain.levels.resize(header.level_count);
+  chain.indices.resize(header.index_count);
+  in.read(reinterpret_cast<char*>(chain.levels.data()),
+          static_cast<std::streamsize>(chain.levels.size() * sizeof(LodLevel)));
+  in.read(reinterpret_cast<char*>(chain.indices.data()),
+          static_cast<std::streamsize>(chain.indices.size() * sizeof(std::uint32_t)));
+  if (!in) {
+    return std::nullopt;
+  }
+
+  const bool ranges_valid = std::ranges::all_of(chain.levels, [&](const LodLevel& level) {
+    return static_cast<size_t>(level.first_index) + level.index_count <= chain.indices.size();
+  });
+  const bool indices_valid = std::ranges::all_of(chain.indices, [&](std::uint32_t i) { return i < vertex_count; });
+  if (!ranges_valid || !indices_valid) {
+    return std::nullopt;
+  }
+
+  return chain;
+}
+
+void write_cache(const std::filesystem::path& file, const LodChain& chain) {
+  std::error_code ec;
+  std::filesystem::create_directories(file.parent_path(), ec);
+
+  // Write to a temporary and rename, so a concurrent reader never sees a partial entry.  Its name is unique to this
+  // call, as other threads or processes may be writing the same entry.
+  thread_local std::mt19937_64 rng(std::random_device{}());
+  auto temp = file;
+  temp += std::format(".{:016x}.tmp", rng());
+  {
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    const CacheHeader header{.level_count = static_cast<std::uint32_t>(chain.levels.size()),
+                             .index_count = static_cast<std::uint32_t>(chain.indices.size())};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(chain.levels.data()),
+              static_cast<std::streamsize>(chain.levels.size() * sizeof(LodLevel)));
+    out.write(reinterpret_cast<const char*>(chain.indices.data()),
+              static_cast<std::streamsize>(chain.indices.size() * sizeof(std::uint32_t)));
+    if (!out) {
+      KEN_CORE_WARN("Failed to write LOD cache entry {}", temp.string());
+      return;
+    }
+  }
+
+  std::filesystem::rename(temp, file, ec);
+  if (ec) {
+    KEN_CORE_WARN("Failed to write LOD cache entry {}: {}", file.string(), ec.message());
+    std::filesystem::remove(temp, ec);
+  }
+}
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+}  // namespace
+
+LodChain build_lod_chain(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices,
+                         const LodOptions& options) {
+  KEN_CORE_ASSERT(indices.size() % 3 == 0, "LOD generation requires a triangle list");
+
+  LodChain chain;
+  chain.indices.assign(indices.begin(), indices.end());
+  chain.levels.push_back({.first_index = 0, .index_count = static_cast<std::uint32_t>(indices.size()), .error = 0.F});
+
+  if (indices.size() / 3 <= options.min_triangles || options.max_levels <= 1) {
+    return chain;
+  }
+
+  Simplifier simplifier(vertices, indices, options);
+  size_t previous = indices.size() / 3;
+
+  while (chain.levels.size() < options.max_levels && previous > options.min_triangles) {
+    const auto target = std::max(options.min_triangles,
+                                 static_cast<size_t>(static_cast<float>(previous) * options.ratio));
+    const bool reached = simplifier.simplify_to(target);
+
+    const size_t count = simplifier.triangle_count();
+    if (static_cast<float>(count) > static_cast<float>(previous) * (1.F - kMinReduction)) {
+      break;
+    }
+
+    const auto first = static_cast<std::uint32_t>(chain.indices.size());
+    simplifier.emit(chain.indices);
+    chain.levels.push_back({.first_index = first,
+                            .index_count = static_cast<std::uint32_t>(chain.indices.size()) - first,
+                            .error       = simplifier.error()});
+    previous = count;
+
+    if (!reached) {
+      break;
+    }
+  }
+
+  return chain;
+}
+
+LodChain load_or_build_lod_chain(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices,
+                                 const std::filesystem::path& cache_dir, const LodOptions& options) {
+  const auto file = cache_dir / std::format("{:016x}.lod", cache_key(vertices, indices, options));
+  if (auto cached = read_cache(file, vertices.size())) {
+    return *std::move(cached);
+  }
+
+  LodChain chain = build_lod_chain(vertices, indices, options);
+  write_cache(file, chain);
+  return chain;
+}
+
+}  // namespace kEn
@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * @file mesh_lod.hpp
+ * @brief Level-of-detail chains generated by quadric edge-collapse simplification.
+ * @ingroup ken
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace kEn {
+
+struct Vertex;
+
+/** @brief One level of detail: a range of a mesh's index buffer plus its simplification error. */
+struct LodLevel {
+  std::uint32_t first_index = 0;    ///< Offset of the first index of this level.
+  std::uint32_t index_count = 0;    ///< Number of indices (three per triangle).
+  float error               = 0.F;  ///< Object-space geometric error; zero for the source mesh.
+};
+
+/**
+ * @brief Index data of all levels of one mesh, finest first.
+ *
+ * Every level indexes the original vertex buffer, so a single vertex buffer
+ * and a single index buffer serve the whole chain.  Level 0 is always the
+ * source index list with an error of zero; errors are non-decreasing.
+ */
+struct LodChain {
+  std::vector<std::uint32_t> indices;
+  std::vector<LodLevel> levels;
+};
+
+/** @brief Parameters of @ref build_lod_chain. */
+struct LodOptions {
+  float ratio               = 0.5F;   ///< Target triangle count of each level relative to the previous one.
+  std::size_t max_levels    = 5;      ///< Maximum number of levels, including the source mesh.
+  std::size_t min_triangles = 64;     ///< Levels are not simplified below this triangle count.
+  float max_error           = 0.1F;   ///< Stop once a collapse costs more than this fraction of the mesh radius.
+  float normal_weight       = 0.05F;  ///< Cost of a unit normal change, as a fraction of the mesh radius.
+  float uv_weight           = 0.05F;  ///< Cost of a unit texture coordinate change, as a fraction of the mesh radius.
+};
+
+/**
+ * @brief Builds a LOD chain by greedy half-edge collapse with attribute-aware quadric errors.
+ *
+ * Vertices with identical position, normal and texture coordinates are welded
+ * for connectivity.  Each collapse moves a vertex onto a neighbour, so no new
+ * vertices are created.  Its cost is the area-normalized Garland-Heckbert
+ * quadric error plus the weighted squared change of normal and texture
+ * coordinates, expressed as an object-space distance.  Collapses that would
+ * flip a triangle or make the surface non-manifold are rejected.  Border and
+ * seam vertices stay locked, so open edges and UV seams keep their shape.
+ *
+ * A level is emitted each time the triangle count reaches the next target;
+ * its error is the largest collapse cost spent so far.
+ *
+ * @param vertices Source vertices.
+ * @param indices  Source triangle list.
+ * @param options  Simplification parameters.
+ */
+[[nodiscard]] LodChain build_lod_chain(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices,
+                                       const LodOptions& options = {});
+
+/**
+ * @brief Returns a LOD chain from the on-disk cache, building and storing it on a miss.
+ *
+ * Cache entries are keyed on a hash of the vertex data, the index data and
+ * @p options, so edited assets never hit stale entries.  Unreadable or
+ * corrupt entries are rebuilt; failing to write one only logs a warning.
+ * Safe to call from worker threads.
+ *
+ * @param vertices  Source vertices.
+ * @param indices   Source triangle list.
+ * @param cache_dir Directory holding the cache entries; created on demand.  Models use @ref Model::lod_cache_dir.
+ * @param options   Simplification parameters.
+ */
+[[nodiscard]] LodChain load_or_build_lod_chain(std::span<const Vertex> vertices,
+                                               std::span<const std::uint32_t> indices,
+                                               const std::filesystem::path& cache_dir, const LodOptions& options = {});
+
+}  // namespace kEn
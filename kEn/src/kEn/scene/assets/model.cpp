@@ -7,30 +7,44 @@
 #include <assimp/types.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <span>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <mEn/functions/geometric.hpp>
 #include <mEn/fwd.hpp>
+#include <mEn/mat4.hpp>
 #include <mEn/vec2.hpp>
 #include <mEn/vec3.hpp>
 
 #include <kEn/core/application.hpp>
+#include <kEn/core/assert.hpp>
+#include <kEn/core/job_system.hpp>
 #include <kEn/core/log.hpp>
+#include <kEn/core/profiler.hpp>
+#include <kEn/core/task.hpp>
 #include <kEn/core/transform.hpp>
 #include <kEn/renderer/material.hpp>
+#include <kEn/renderer/image.hpp>
+#include <kEn/renderer/renderer.hpp>
 #include <kEn/renderer/shader.hpp>
 #include <kEn/renderer/texture.hpp>
 #include <kEn/renderer/texture_format.hpp>
 #include <kEn/scene/assets/mesh.hpp>
+#include <kEn/scene/assets/mesh_lod.hpp>
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/triangle_bvh.hpp>
 
 #include <assimp/Importer.hpp>
 
@@ -40,8 +54,16 @@ extern "C" {
 
 namespace {
 
-void load_material_textures(aiMaterial* mat, kEn::Material& material, const kEn::SamplerDesc& sampler,
-                            const std::filesystem::path& directory, std::uint32_t mip_levels) {
+/** @brief Texture of a material, decoded and created once the mesh is imported. */
+struct TextureRequest {
+  kEn::TextureType type;
+  std::size_t slot;
+  std::filesystem::path path;
+  std::uint32_t mip_levels;
+};
+
+void collect_texture_requests(aiMaterial* mat, const std::filesystem::path& directory, std::uint32_t mip_levels,
+                              std::vector<TextureRequest>& requests) {
   static constexpr std::pair<kEn::TextureType, aiTextureType> kTypes[] = {
       {kEn::TextureType::Diffuse, aiTextureType_DIFFUSE},
       {kEn::TextureType::Height, aiTextureType_HEIGHT},
@@ -53,9 +75,8 @@ void load_material_textures(aiMaterial* mat, kEn::Material& material, const kEn:
     for (unsigned int i = 0; i < mat->GetTextureCount(ai_type); ++i) {
       aiString str;
       mat->GetTexture(ai_type, i, &str);
-      const std::shared_ptr<kEn::Texture> texture = kEn::device().create_texture(
-          absolute(directory / str.C_Str()), sampler, kEn::TextureFormat::RGBA8, mip_levels);
-      material.set_texture(type, texture, i);
+      requests.push_back(
+          {.type = type, .slot = i, .path = absolute(directory / str.C_Str()), .mip_levels = mip_levels});
     }
   }
 }
@@ -128,6 +149,7 @@ void expand_indexed_mesh(std::vector<kEn::Vertex>& vertices, std::vector<std::ui
 }
 
 void generate_mikktspace(std::vector<kEn::Vertex>& vertices, std::vector<std::uint32_t>& indices) {
+  KEN_PROFILE_FUNCTION();
   if (indices.empty()) {
     return;
   }
@@ -159,10 +181,10 @@ void generate_mikktspace(std::vector<kEn::Vertex>& vertices, std::vector<std::ui
   }
 }
 
-kEn::Mesh process_mesh(aiMesh* mesh, const aiScene* scene, const kEn::SamplerDesc& sampler,
-                       const std::filesystem::path& directory) {
+kEn::Material process_mesh(aiMesh* mesh, const aiScene* scene, const std::filesystem::path& directory,
+                           std::vector<kEn::Vertex>& vertices, std::vector<uint32_t>& indices,
+                           std::vector<TextureRequest>& textures) {
   // Vertices
-  std::vector<kEn::Vertex> vertices;
   vertices.reserve(mesh->mNumVertices);
 
   for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
@@ -206,7 +228,6 @@ kEn::Mesh process_mesh(aiMesh* mesh, const aiScene* scene, const kEn::SamplerDes
   }
 
   // Indices
-  std::vector<uint32_t> indices;
   indices.reserve(mesh->mNumFaces * 3);
   for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
     const aiFace& face = mesh->mFaces[i];
@@ -244,43 +265,224 @@ kEn::Mesh process_mesh(aiMesh* mesh, const aiScene* scene, const kEn::SamplerDes
     material.transparent = true;
   }
 
-  load_material_textures(mat, material, sampler, directory, mip_levels);
+  collect_texture_requests(mat, directory, mip_levels, textures);
 
-  return {mesh->mName.C_Str(), vertices, indices, material};
+  return material;
 }
 
 }  // namespace
 
 namespace kEn {
 
+struct Model::ImportedMesh {
+  std::string name;
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+  Material material;
+  std::vector<TextureRequest> textures;
+};
+
+struct Model::PendingLods {
+  std::vector<LodSource> sources;  ///< Each is cleared by its job once its chain is built.
+  std::vector<LodChain> chains;    ///< Same order as @ref mesh_bounds_.
+  std::atomic<std::size_t> remaining{0};
+  std::atomic<bool> failed{false};
+};
+
 std::unordered_map<std::filesystem::path, std::shared_ptr<Model>> Model::loaded_resources_;
 
-std::shared_ptr<Model> Model::load(const std::filesystem::path& path, const SamplerDesc& sampler, bool flip_uvs) {
+std::shared_ptr<Model> Model::load(const std::filesystem::path& path, const SamplerDesc& sampler, bool flip_uvs,
+                                   bool pickable) {
   if (const auto it = loaded_resources_.find(path); it != loaded_resources_.end()) {
+    check_pickable(*it->second, path, pickable);
     return it->second;
   }
 
-  auto model = std::make_shared<Model>(path, sampler, flip_uvs);
+  auto model = std::make_shared<Model>(path, sampler, flip_uvs, pickable);
   return loaded_resources_.emplace(path, std::move(model)).first->second;
 }
 
+Task<std::shared_ptr<Model>> Model::load_async(std::filesystem::path path, SamplerDesc sampler, bool flip_uvs,
+                                               bool pickable) {
+  if (const auto it = loaded_resources_.find(path); it != loaded_resources_.end()) {
+    check_pickable(*it->second, path, pickable);
+    co_return it->second;
+  }
+
+  co_await resume_on_worker("Import model");
+  std::vector<ImportedMesh> meshes = import(kModelPath / path, flip_uvs);
+
+  // Decode every distinct texture once; the device caches textures by path anyway.
+  std::vector<std::filesystem::path> texture_paths;
+  std::unordered_map<std::filesystem::path, std::size_t> texture_index;
+  for (const auto& mesh : meshes) {
+    for (const auto& request : mesh.textures) {
+      if (texture_index.try_emplace(request.path, texture_paths.size()).second) {
+        texture_paths.push_back(request.path);
+      }
+    }
+  }
+
+  std::vector<std::optional<Image>> images(texture_paths.size());
+  JobSystem::parallel_for(
+      texture_paths.size(),
+      [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          images[i] = Image::load(texture_paths[i], TextureFormat::RGBA8);
+        }
+      },
+      1, "Decode textures");
+
+  co_await resume_on_main_thread();
+  KEN_PROFILE_SCOPE("Model::load_async upload");
+  if (const auto it = loaded_resources_.find(path); it != loaded_resources_.end()) {
+    check_pickable(*it->second, path, pickable);
+    co_return it->second;  // Loaded by someone else in the meantime
+  }
+
+  for (auto& mesh : meshes) {
+    for (const auto& request : mesh.textures) {
+      if (const auto& image = images[texture_index.at(request.path)]) {
+        mesh.material.set_texture(
+            request.type, device().create_texture(request.path, *image, sampler, request.mip_levels), request.slot);
+      }
+    }
+  }
+
+  std::shared_ptr<Model> model(new Model());  // NOLINT(cppcoreguidelines-owning-memory)
+  model->build(std::move(meshes), pickable);
+  co_return loaded_resources_.emplace(std::move(path), std::move(model)).first->second;
+}
+
+void Model::check_pickable(const Model& model, const std::filesystem::path& path, bool pickable) {
+  if (pickable && !model.pickable()) {
+    KEN_CORE_WARN("Model {} was loaded without triangles; ray casts will miss it", path.string());
+  }
+}
+
 std::span<const Mesh> Model::opaque_meshes() const noexcept { return opaque_meshes_; }
 std::span<Mesh> Model::opaque_meshes() noexcept { return opaque_meshes_; }
 std::span<const Mesh> Model::transparent_meshes() const noexcept { return transparent_meshes_; }
 std::span<Mesh> Model::transparent_meshes() noexcept { return transparent_meshes_; }
 
-void Model::render(Shader& shader, const Transform& transform) const {
-  for (const auto& mesh : opaque_meshes_) {
-    mesh.render(shader, transform);
+void Model::render(Shader& shader, const Transform& transform, std::span<std::uint8_t> lod_state) const {
+  const mEn::Mat4& world = transform.local_to_world_matrix();
+  render(shader, ObjectData::from(world, transform.world_to_local_matrix(), world), lod_state);
+}
+
+void Model::render(Shader& shader, const mEn::Mat4& world, std::span<std::uint8_t> lod_state) const {
+  render(shader, ObjectData::from(world), lod_state);
+}
+
+void Model::render(Shader& shader, const ObjectData& object, std::span<std::uint8_t> lod_state) const {
+  KEN_PROFILE_FUNCTION();
+  const mEn::Mat4& world = object.world;
+  KEN_CORE_ASSERT(lod_state.empty() || lod_state.size() == lod_state_size(), "LOD state does not match the model");
+  const auto visible = Renderer::cull(mesh_bounds_, world);
+
+  // Slot i covers mesh_bounds_[i]; each view keeps its own block of hysteresis state.
+  const std::size_t view_offset = Renderer::lod_view() * mesh_bounds_.size();
+
+  // Added on the first visible mesh, so that culled models take no space in the object buffer.
+  std::uint32_t object_index = DrawPacket::kNoObject;
+
+  const auto draw = [&](const Mesh& mesh, std::size_t slot) {
+    std::uint8_t* state    = lod_state.empty() ? nullptr : &lod_state[view_offset + slot];
+    const std::uint8_t lod = Renderer::select_lod(mesh.lods(), mesh_bounds_[slot], world, state ? *state : 0);
+    if (state != nullptr) {
+      *state = lod;
+    }
+    if (object_index == DrawPacket::kNoObject) {
+      object_index = Renderer::add_object(object);
+    }
+    mesh.render(shader, object_index, lod);
+  };
+
+  for (std::size_t i = 0; i < opaque_meshes_.size(); ++i) {
+    if (visible[i] != 0) {
+      draw(opaque_meshes_[i], i);
+    }
   }
 
-  // TODO(kuzu): implement depth (re)sorting at render time
-  for (const auto& mesh : transparent_meshes_) {
-    mesh.render(shader, transform);
+  // Depth ordering of transparent meshes is done by the render queue.
+  for (std::size_t i = 0; i < transparent_meshes_.size(); ++i) {
+    const std::size_t slot = opaque_meshes_.size() + i;
+    if (visible[slot] != 0) {
+      draw(transparent_meshes_[i], slot);
+    }
+  }
+}
+
+bool Model::poll_lods() {
+  KEN_PROFILE_FUNCTION();
+  if (pending_lods_ == nullptr || pending_lods_->remaining.load(std::memory_order_acquire) != 0) {
+    return false;
+  }
+
+  const std::shared_ptr<PendingLods> pending = std::move(pending_lods_);
+  if (pending->failed.load(std::memory_order_relaxed)) {
+    return false;
+  }
+
+  auto& chains     = pending->chains;
+  std::size_t slot = 0;
+  for (auto& mesh : opaque_meshes_) {
+    mesh.set_lods(chains[slot++]);
+  }
+  for (auto& mesh : transparent_meshes_) {
+    mesh.set_lods(chains[slot++]);
   }
+  return true;
 }
 
-void Model::load_model(const std::filesystem::path& path, const SamplerDesc& sampler, bool flip_uvs) {
+std::optional<MeshHit> Model::raycast(const Ray& ray, float max_t) const {
+  if (!pickable_ || !ray.intersect(bounds_.box, max_t)) {
+    return std::nullopt;
+  }
+
+  // Visit meshes in order of box entry distance so that the nearest hit prunes the rest.
+  std::vector<std::pair<float, const Mesh*>> candidates;
+  const auto collect = [&](std::span<const Mesh> meshes) {
+    for (const auto& mesh : meshes) {
+      if (const auto t = ray.intersect(mesh.bounds().box, max_t)) {
+        candidates.emplace_back(*t, &mesh);
+      }
+    }
+  };
+  collect(opaque_meshes_);
+  collect(transparent_meshes_);
+  std::ranges::sort(candidates, {}, &std::pair<float, const Mesh*>::first);
+
+  std::optional<MeshHit> best;
+  for (const auto& [entry, mesh] : candidates) {
+    if (entry > max_t) {
+      break;
+    }
+    if (const auto hit = mesh->raycast(ray, max_t)) {
+      best  = MeshHit{.mesh = mesh, .hit = *hit};
+      max_t = hit->distance;
+    }
+  }
+
+  return best;
+}
+
+void Model::load_model(const std::filesystem::path& path, const SamplerDesc& sampler, bool flip_uvs,
+                       bool pickable) {
+  KEN_PROFILE_FUNCTION();
+  std::vector<ImportedMesh> meshes = import(path, flip_uvs);
+  for (auto& mesh : meshes) {
+    for (const auto& request : mesh.textures) {
+      mesh.material.set_texture(
+          request.type, device().create_texture(request.path, sampler, TextureFormat::RGBA8, request.mip_levels),
+          request.slot);
+    }
+  }
+  build(std::move(meshes), pickable);
+}
+
+std::vector<Model::ImportedMesh> Model::import(const std::filesystem::path& path, bool flip_uvs) {
+  KEN_PROFILE_FUNCTION();
   Assimp::Importer importer;
   const unsigned int flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | (flip_uvs ? aiProcess_FlipUVs : 0U);
   const aiScene* scene     = importer.ReadFile(path.string(), flags);
@@ -290,23 +492,76 @@ void Model::load_model(const std::filesystem::path& path, const SamplerDesc& sam
     throw std::runtime_error(importer.GetErrorString());
   }
 
-  process_node(scene->mRootNode, scene, sampler, path.parent_path());
+  std::vector<ImportedMesh> meshes;
+  process_node(scene->mRootNode, scene, path.parent_path(), meshes);
+  return meshes;
 }
 
-void Model::process_node(aiNode* node, const aiScene* scene, const SamplerDesc& sampler,
-                         const std::filesystem::path& directory) {
+void Model::process_node(aiNode* node, const aiScene* scene, const std::filesystem::path& directory,
+                         std::vector<ImportedMesh>& meshes) {
   for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
-    aiMesh* mesh   = scene->mMeshes[node->mMeshes[i]];
-    Mesh processed = process_mesh(mesh, scene, sampler, directory);
-    if (processed.material.transparent) {
-      transparent_meshes_.push_back(std::move(processed));
+    aiMesh* mesh      = scene->mMeshes[node->mMeshes[i]];
+    auto& imported    = meshes.emplace_back();
+    imported.name     = mesh->mName.C_Str();
+    imported.material = process_mesh(mesh, scene, directory, imported.vertices, imported.indices, imported.textures);
+  }
+
+  for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+    process_node(node->mChildren[i], scene, directory, meshes);
+  }
+}
+
+void Model::build(std::vector<ImportedMesh> meshes, bool pickable) {
+  KEN_PROFILE_FUNCTION();
+  pickable_ = pickable;
+  std::vector<LodSource> lod_sources;
+  lod_sources.reserve(meshes.size());
+  for (auto& imported : meshes) {
+    Mesh mesh{imported.name, imported.vertices, imported.indices, imported.material, pickable};
+    if (imported.material.transparent) {
+      transparent_meshes_.push_back(std::move(mesh));
     } else {
-      opaque_meshes_.push_back(std::move(processed));
+      opaque_meshes_.push_back(std::move(mesh));
     }
+    lod_sources.push_back({.vertices    = std::move(imported.vertices),
+                           .indices     = std::move(imported.indices),
+                           .transparent = imported.material.transparent});
   }
 
-  for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-    process_node(node->mChildren[i], scene, sampler, directory);
+  mesh_bounds_.reserve(opaque_meshes_.size() + transparent_meshes_.size());
+  for (const auto& mesh : opaque_meshes_) {
+    mesh_bounds_.push_back(mesh.bounds());
+  }
+  for (const auto& mesh : transparent_meshes_) {
+    mesh_bounds_.push_back(mesh.bounds());
+  }
+  for (const auto& mesh_bounds : mesh_bounds_) {
+    bounds_ = bounds_.merged(mesh_bounds);
+  }
+
+  // Match the opaque-then-transparent order of the mesh lists; both keep their import order.
+  std::ranges::stable_partition(lod_sources, [](const LodSource& source) { return !source.transparent; });
+
+  // The jobs share ownership of the state, so the model may be destroyed while they run.
+  auto pending = std::make_shared<PendingLods>();
+  pending->chains.resize(lod_sources.size());
+  pending->remaining.store(lod_sources.size(), std::memory_order_relaxed);
+  pending->sources = std::move(lod_sources);
+  pending_lods_    = pending;
+  for (std::size_t i = 0; i < pending->sources.size(); ++i) {
+    JobSystem::run_detached(
+        [pending, i] {
+          try {
+            const LodSource& source = pending->sources[i];
+            pending->chains[i]      = load_or_build_lod_chain(source.vertices, source.indices, lod_cache_dir());
+          } catch (const std::exception& e) {
+            KEN_CORE_ERROR("LOD generation failed: {}", e.what());
+            pending->failed.store(true, std::memory_order_relaxed);
+          }
+          pending->sources[i] = {};
+          pending->remaining.fetch_sub(1, std::memory_order_release);
+        },
+        "Build LOD chain");
   }
 }
 
@@ -6,16 +6,25 @@
  * @ingroup ken
  */
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <span>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include <kEn/core/core.hpp>
+#include <kEn/core/task.hpp>
+#include <kEn/renderer/renderer.hpp>
 #include <kEn/renderer/shader.hpp>
 #include <kEn/renderer/texture.hpp>
 #include <kEn/scene/assets/mesh.hpp>
+#include <kEn/scene/assets/mesh_lod.hpp>
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/triangle_bvh.hpp>
 
 // NOLINTBEGIN(readability-identifier-naming)
 struct aiNode;
@@ -24,21 +33,37 @@ struct aiScene;
 
 namespace kEn {
 
+/** @brief Closest triangle of a @ref Model hit by a ray. */
+struct MeshHit {
+  const Mesh* mesh = nullptr;
+  TriangleHit hit;
+};
+
 /**
  * @brief A collection of @ref Mesh objects loaded from a single asset file.
  *
  * Models are loaded via Assimp and split at construction into two ordered
  * vectors: @ref opaque_meshes_ for fully opaque surfaces and
  * @ref transparent_meshes_ for surfaces that carry an opacity map.  Opaque
- * meshes are rendered before transparent ones; proper back-to-front depth
- * sorting of transparent meshes is not yet implemented (see MESH-08).
+ * meshes are submitted before transparent ones; the renderer's queue then
+ * draws transparent meshes after all opaque geometry, back to front by the
+ * distance of their bounds' center from the camera.
  *
  * Tangent space is sourced from the file when present.  When the file does
  * not embed tangents, MikkTSpace is run as a fallback.
  *
+ * After import, a LOD chain is generated for every mesh by a job of its own
+ * on the @ref JobSystem (or read from the on-disk cache in
+ * @ref lod_cache_dir).  Until @ref poll_lods adopts the results, once every
+ * job has finished, the meshes render at full detail.
+ *
+ * Meshes keep no CPU copy of their geometry unless the model is loaded as
+ * @c pickable, which is what @ref raycast needs to find exact triangle hits.
+ *
  * Use the @ref load factory to share a single @c Model instance across
  * multiple consumers.  The per-path cache is keyed on the path passed to
  * @ref load, so the same relative path always returns the same object.
+ * @ref load_async fills the same cache without stalling the main thread.
  *
  * @note Copy and move are deleted; models are always shared via
  *       @c std::shared_ptr.
@@ -50,27 +75,69 @@ class Model {
    *
    * Resolves @p path relative to @ref kModelPath, imports the scene through
    * Assimp, generates MikkTSpace tangents for any mesh that lacks embedded
-   * tangents, and uploads all geometry to immutable GPU buffers.
+   * tangents, and uploads all geometry to immutable GPU buffers.  LOD
+   * generation is started in the background.
    *
    * @param path      Path relative to @c assets/models/.
    * @param sampler   Sampler description forwarded to each texture load.
    * @param flip_uvs  Pass @c true for assets whose UVs are vertically flipped
    *                  (e.g. OBJ files exported from certain tools).
+   * @param pickable  Keep the triangles on the CPU for @ref raycast.
    * @throws std::runtime_error if Assimp cannot open or parse the file.
    */
-  explicit Model(const std::filesystem::path& path, const SamplerDesc& sampler = {}, bool flip_uvs = false) {
-    load_model(kModelPath / path, sampler, flip_uvs);
+  explicit Model(const std::filesystem::path& path, const SamplerDesc& sampler = {}, bool flip_uvs = false,
+                 bool pickable = false) {
+    load_model(kModelPath / path, sampler, flip_uvs, pickable);
   }
 
   DELETE_COPY_MOVE(Model);
 
   /**
-   * @brief Render all opaque meshes followed by all transparent meshes.
+   * @brief Render all visible opaque meshes followed by all visible transparent meshes.
+   *
+   * All mesh bounds are frustum-culled in one batch through @ref Renderer::cull
+   * before anything is submitted.  Each visible mesh is drawn at the level
+   * picked by @ref Renderer::select_lod.
    *
    * @param shader     The active shader program.
    * @param transform  World transform of this model.
+   * @param lod_state  Per-instance LOD hysteresis state of @ref lod_state_size
+   *                   entries, updated in place; when empty, levels are
+   *                   selected without hysteresis.
+   */
+  void render(Shader& shader, const Transform& transform, std::span<std::uint8_t> lod_state = {}) const;
+  /** @brief Same as above, with the object constants given directly, e.g. taken from a @ref RenderSnapshot. */
+  void render(Shader& shader, const ObjectData& object, std::span<std::uint8_t> lod_state = {}) const;
+  /** @brief Same as above for a static object with the given local-to-world matrix. */
+  void render(Shader& shader, const mEn::Mat4& world, std::span<std::uint8_t> lod_state = {}) const;
+
+  /**
+   * @brief Adopt the background-generated LOD chains once they are ready.
+   *
+   * Uploads the new index buffers, so it must be called on the render thread.
+   * Cheap when there is nothing to adopt.
+   *
+   * @return @c true if the chains were adopted by this call.
    */
-  void render(Shader& shader, const Transform& transform) const;
+  bool poll_lods();
+
+  /** @brief Returns the number of hysteresis entries an instance needs to pass to @ref render. */
+  [[nodiscard]] std::size_t lod_state_size() const noexcept { return mesh_bounds_.size() * Renderer::kMaxLodViews; }
+
+  /** @brief Object-space bounds enclosing every mesh of the model. */
+  [[nodiscard]] const Bounds& bounds() const noexcept { return bounds_; }
+
+  /** @brief Returns whether the meshes keep their triangles for @ref raycast. */
+  [[nodiscard]] bool pickable() const noexcept { return pickable_; }
+
+  /**
+   * @brief Finds the closest triangle hit by the object-space @p ray closer than @p max_t.
+   *
+   * Meshes whose bounds the ray misses are skipped; the others are queried
+   * through their triangle BVHs, nearest box first.  Never hits unless the
+   * model is @ref pickable.
+   */
+  [[nodiscard]] std::optional<MeshHit> raycast(const Ray& ray, float max_t) const;
 
   /**
    * @brief Return a read-only view of the opaque mesh list.
@@ -93,30 +160,87 @@ class Model {
    *
    * Looks up @p path in a process-wide cache.  On a cache miss the model is
    * constructed and inserted before being returned.  A failed construction
-   * does not pollute the cache.
+   * does not pollute the cache.  Asking for a pickable model that is cached
+   * without triangles logs a warning; load it as pickable the first time.
    *
    * @param path      Path relative to @c assets/models/.
    * @param sampler   Sampler description forwarded on a cache miss.
    * @param flip_uvs  UV-flip flag forwarded on a cache miss.
+   * @param pickable  Pickable flag forwarded on a cache miss.
    * @return Shared ownership of the loaded model.
    * @throws std::runtime_error (forwarded from the constructor) on load failure.
    */
   static std::shared_ptr<Model> load(const std::filesystem::path& path, const SamplerDesc& sampler = {},
-                                     bool flip_uvs = false);
+                                     bool flip_uvs = false, bool pickable = false);
+
+  /**
+   * @brief Asynchronous @ref load.
+   *
+   * Imports the file and decodes its textures on the @ref JobSystem, then
+   * continues on the main thread only to create the GPU textures and buffers.
+   * Textures that fail to decode are left unset.
+   *
+   * @param path      Path relative to @c assets/models/.
+   * @param sampler   Sampler description forwarded on a cache miss.
+   * @param flip_uvs  UV-flip flag forwarded on a cache miss.
+   * @param pickable  Pickable flag forwarded on a cache miss.
+   * @return Task producing the cached model; the awaiting coroutine resumes on the main thread.
+   * @throws std::runtime_error (from the task's result) if Assimp cannot open or parse the file.
+   * @pre Started on the main thread of a running Application.
+   */
+  static Task<std::shared_ptr<Model>> load_async(std::filesystem::path path, SamplerDesc sampler = {},
+                                                 bool flip_uvs = false, bool pickable = false);
 
   /** @brief Root directory for all model assets. */
   static constexpr std::string_view kModelPath = "assets/models";
+  /** @brief Directory of the LOD cache, relative to the asset root that holds @ref kModelPath. */
+  static constexpr std::string_view kLodCachePath = "cache/lod";
+
+  /** @brief Returns the LOD cache directory, resolved against the same asset root as @ref kModelPath. */
+  [[nodiscard]] static std::filesystem::path lod_cache_dir() {
+    return std::filesystem::path{kModelPath}.parent_path() / kLodCachePath;
+  }
 
  private:
-  void load_model(const std::filesystem::path& path, const SamplerDesc& sampler, bool flip_uvs);
-  void process_node(aiNode* node, const aiScene* scene, const SamplerDesc& sampler,
-                    const std::filesystem::path& directory);
+  /** @brief Geometry, material and texture paths of one imported mesh, before anything touches the GPU. */
+  struct ImportedMesh;
+
+  /** @brief CPU copy of one mesh's geometry, handed to the LOD worker. */
+  struct LodSource {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    bool transparent = false;
+  };
+
+  /** @brief LOD chains being generated, shared by the model and the jobs that generate them. */
+  struct PendingLods;
+
+  Model() = default;
+
+  void load_model(const std::filesystem::path& path, const SamplerDesc& sampler, bool flip_uvs, bool pickable);
+
+  /** @brief Reads and processes the file without touching the GPU, so it may run on any thread. */
+  static std::vector<ImportedMesh> import(const std::filesystem::path& path, bool flip_uvs);
+  static void process_node(aiNode* node, const aiScene* scene, const std::filesystem::path& directory,
+                           std::vector<ImportedMesh>& meshes);
+
+  /** @brief Uploads the imported meshes, computes the bounds and starts LOD generation. */
+  void build(std::vector<ImportedMesh> meshes, bool pickable);
+
+  /** @brief Warns if a pickable model was requested but @p model was cached without triangles. */
+  static void check_pickable(const Model& model, const std::filesystem::path& path, bool pickable);
 
   // TODO(kuzu): move towards central asset manager
   static std::unordered_map<std::filesystem::path, std::shared_ptr<Model>> loaded_resources_;
 
   std::vector<Mesh> opaque_meshes_;
   std::vector<Mesh> transparent_meshes_;
+
+  Bounds bounds_;
+  bool pickable_ = false;
+  std::vector<Bounds> mesh_bounds_;  ///< Opaque meshes first, then transparent, matching render order.
+
+  std::shared_ptr<PendingLods> pending_lods_;  ///< Null once adopted.
 };
 
 }  // namespace kEn
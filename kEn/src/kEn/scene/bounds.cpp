@@ -0,0 +1,156 @@
+#include "bounds.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include <mEn/functions/common.hpp>
+#include <mEn/functions/geometric.hpp>
+#include <mEn/fwd.hpp>
+#include <mEn/mat4.hpp>
+#include <mEn/vec4.hpp>
+
+namespace kEn {
+
+Aabb Aabb::transformed(const mEn::Mat4& m) const noexcept {
+  if (!valid()) {
+    return {};
+  }
+
+  const mEn::Vec3 c = center();
+  const mEn::Vec3 e = extents();
+
+  mEn::Vec3 new_center(m[3]);
+  mEn::Vec3 new_extents(0.F);
+  for (mEn::length_t col = 0; col < 3; ++col) {
+    for (mEn::length_t row = 0; row < 3; ++row) {
+      new_center[row] += m[col][row] * c[col];
+      new_extents[row] += std::abs(m[col][row]) * e[col];
+    }
+  }
+
+  return from_center_extents(new_center, new_extents);
+}
+
+bool Sphere::overlaps(const Aabb& box) const noexcept {
+  const mEn::Vec3 closest = mEn::clamp(center, box.min, box.max);
+  const mEn::Vec3 d       = closest - center;
+  return mEn::dot(d, d) <= radius * radius;
+}
+
+float max_axis_scale(const mEn::Mat4& m) noexcept {
+  const float sx = mEn::dot(mEn::Vec3(m[0]), mEn::Vec3(m[0]));
+  const float sy = mEn::dot(mEn::Vec3(m[1]), mEn::Vec3(m[1]));
+  const float sz = mEn::dot(mEn::Vec3(m[2]), mEn::Vec3(m[2]));
+  return std::sqrt(std::max({sx, sy, sz}));
+}
+
+Sphere Sphere::transformed(const mEn::Mat4& m) const noexcept {
+  return {.center = mEn::Vec3(m * mEn::Vec4(center, 1.F)), .radius = radius * max_axis_scale(m)};
+}
+
+Bounds Bounds::merged(const Bounds& other) const noexcept {
+  if (!other.box.valid()) {
+    return *this;
+  }
+  if (!box.valid()) {
+    return other;
+  }
+
+  const Aabb merged_box = box.merged(other.box);
+  const mEn::Vec3 c     = merged_box.center();
+
+  // Enclose both spheres around the merged box center; never larger than the box's own bounding sphere.
+  const float r = std::max(mEn::distance(c, sphere.center) + sphere.radius,
+                           mEn::distance(c, other.sphere.center) + other.sphere.radius);
+  return {.box = merged_box, .sphere = {.center = c, .radius = std::min(r, mEn::length(merged_box.extents()))}};
+}
+
+Ray::Ray(const mEn::Vec3& origin, const mEn::Vec3& direction, float max_distance) noexcept
+    : origin(origin), direction(direction), inv_direction(1.F / direction), max_distance(max_distance) {}
+
+std::optional<float> Ray::intersect(const Aabb& box, float max_t) const noexcept {
+  float t_min = 0.F;
+  float t_max = max_t;
+
+  for (mEn::length_t axis = 0; axis < 3; ++axis) {
+    // Division by a zero component yields +-inf, which the min/max below handle
+    // correctly except for the 0 * inf case when the origin lies on a slab plane.
+    float t0 = (box.min[axis] - origin[axis]) * inv_direction[axis];
+    float t1 = (box.max[axis] - origin[axis]) * inv_direction[axis];
+    if (std::isnan(t0) || std::isnan(t1)) {
+      continue;
+    }
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+
+    t_min = std::max(t_min, t0);
+    t_max = std::min(t_max, t1);
+    if (t_min > t_max) {
+      return std::nullopt;
+    }
+  }
+
+  return t_min;
+}
+
+Frustum Frustum::from_matrix(const mEn::Mat4& view_projection) noexcept {
+  const auto& m  = view_projection;
+  const auto row = [&m](mEn::length_t r) { return mEn::Vec4(m[0][r], m[1][r], m[2][r], m[3][r]); };
+
+  const mEn::Vec4 r0 = row(0);
+  const mEn::Vec4 r1 = row(1);
+  const mEn::Vec4 r2 = row(2);
+  const mEn::Vec4 r3 = row(3);
+
+  const std::array<mEn::Vec4, 6> raw = {r3 + r0, r3 - r0, r3 + r1, r3 - r1, r3 + r2, r3 - r2};
+
+  Frustum frustum{};
+  for (size_t i = 0; i < raw.size(); ++i) {
+    const mEn::Vec3 n   = mEn::Vec3(raw[i]);
+    const float inv_len = 1.F / mEn::length(n);
+    frustum.planes[i]   = {.normal = n * inv_len, .distance = raw[i].w * inv_len};
+  }
+
+  return frustum;
+}
+
+Containment Frustum::classify(const Sphere& sphere) const noexcept {
+  auto result = Containment::Inside;
+  for (const auto& p : planes) {
+    const float d = p.signed_distance(sphere.center);
+    if (d < -sphere.radius) {
+      return Containment::Outside;
+    }
+    if (d < sphere.radius) {
+      result = Containment::Intersects;
+    }
+  }
+
+  return result;
+}
+
+Containment Frustum::classify(const Aabb& box) const noexcept {
+  const mEn::Vec3 c = box.center();
+  const mEn::Vec3 e = box.extents();
+
+  auto result = Containment::Inside;
+  for (const auto& p : planes) {
+    const float r = std::abs(p.normal.x) * e.x + std::abs(p.normal.y) * e.y + std::abs(p.normal.z) * e.z;
+    const float d = p.signed_distance(c);
+    if (d < -r) {
+      return Containment::Outside;
+    }
+    if (d < r) {
+      result = Containment::Intersects;
+    }
+  }
+
+  return result;
+}
+
+}  // namespace kEn
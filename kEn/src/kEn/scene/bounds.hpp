@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+#include <mEn/functions/common.hpp>
+#include <mEn/fwd.hpp>
+#include <mEn/vec3.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+/**
+ * @brief Axis-aligned bounding box.
+ *
+ * A default-constructed box is empty (min = +inf, max = -inf) so that it acts
+ * as the identity for merged() and expand().
+ */
+struct Aabb {
+  mEn::Vec3 min{std::numeric_limits<float>::infinity()};
+  mEn::Vec3 max{-std::numeric_limits<float>::infinity()};
+
+  /** @brief Returns a box centered at @p center with half-sizes @p extents. */
+  [[nodiscard]] static Aabb from_center_extents(const mEn::Vec3& center, const mEn::Vec3& extents) {
+    return {.min = center - extents, .max = center + extents};
+  }
+
+  /** @brief Returns true if min <= max on every axis. */
+  [[nodiscard]] bool valid() const noexcept { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+  /** @brief Returns the center of the box. */
+  [[nodiscard]] mEn::Vec3 center() const noexcept { return (min + max) * 0.5F; }
+  /** @brief Returns the half-sizes of the box. */
+  [[nodiscard]] mEn::Vec3 extents() const noexcept { return (max - min) * 0.5F; }
+
+  /** @brief Returns the surface area, used as the SAH cost metric. Zero for empty boxes. */
+  [[nodiscard]] float surface_area() const noexcept {
+    if (!valid()) {
+      return 0.F;
+    }
+    const mEn::Vec3 d = max - min;
+    return 2.F * (d.x * d.y + d.y * d.z + d.z * d.x);
+  }
+
+  /** @brief Returns true if @p other lies entirely inside this box. */
+  [[nodiscard]] bool contains(const Aabb& other) const noexcept {
+    return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z && max.x >= other.max.x &&
+           max.y >= other.max.y && max.z >= other.max.z;
+  }
+
+  /** @brief Returns true if @p point lies inside or on the boundary of this box. */
+  [[nodiscard]] bool contains(const mEn::Vec3& point) const noexcept {
+    return min.x <= point.x && min.y <= point.y && min.z <= point.z && max.x >= point.x && max.y >= point.y &&
+           max.z >= point.z;
+  }
+
+  /** @brief Returns true if the two boxes overlap (touching counts). */
+  [[nodiscard]] bool overlaps(const Aabb& other) const noexcept {
+    return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y &&
+           min.z <= other.max.z && max.z >= other.min.z;
+  }
+
+  /** @brief Returns the smallest box enclosing both boxes. */
+  [[nodiscard]] Aabb merged(const Aabb& other) const noexcept {
+    return {.min = mEn::min(min, other.min), .max = mEn::max(max, other.max)};
+  }
+
+  /** @brief Grows the box to include @p point. */
+  void expand(const mEn::Vec3& point) noexcept {
+    min = mEn::min(min, point);
+    max = mEn::max(max, point);
+  }
+
+  /** @brief Returns the box grown by @p margin on every side. */
+  [[nodiscard]] Aabb fattened(float margin) const noexcept {
+    return {.min = min - mEn::Vec3(margin), .max = max + mEn::Vec3(margin)};
+  }
+
+  /**
+   * @brief Returns the world-space box enclosing this box transformed by @p m.
+   *
+   * Uses the center/extents form (Arvo), so the cost is a single matrix-vector
+   * product plus an absolute 3x3 product regardless of the box size.
+   */
+  [[nodiscard]] Aabb transformed(const mEn::Mat4& m) const noexcept;
+};
+
+/** @brief Returns the largest axis scale of @p m, i.e. the length of its longest basis column. */
+[[nodiscard]] float max_axis_scale(const mEn::Mat4& m) noexcept;
+
+/** @brief Bounding sphere. */
+struct Sphere {
+  mEn::Vec3 center{};
+  float radius = 0.F;
+
+  /** @brief Returns true if the sphere overlaps @p box. */
+  [[nodiscard]] bool overlaps(const Aabb& box) const noexcept;
+
+  /**
+   * @brief Returns the sphere transformed by @p m.  The radius is scaled by the
+   *        largest axis scale, so the result is conservative under non-uniform scale.
+   */
+  [[nodiscard]] Sphere transformed(const mEn::Mat4& m) const noexcept;
+};
+
+/**
+ * @brief Object-space bounding volumes of a piece of geometry.
+ *
+ * The sphere gives a cheap first test; the box is used when the sphere alone
+ * is inconclusive.
+ */
+struct Bounds {
+  Aabb box;
+  Sphere sphere;
+
+  /** @brief Returns bounds enclosing both @p *this and @p other. */
+  [[nodiscard]] Bounds merged(const Bounds& other) const noexcept;
+};
+
+/**
+ * @brief Half-line used by ray queries.
+ *
+ * @c inv_direction is cached on construction for the slab test; use the
+ * constructor rather than aggregate initialization.
+ */
+struct Ray {
+  Ray(const mEn::Vec3& origin, const mEn::Vec3& direction,
+      float max_distance = std::numeric_limits<float>::infinity()) noexcept;
+
+  mEn::Vec3 origin;
+  mEn::Vec3 direction;
+  mEn::Vec3 inv_direction;
+  float max_distance;
+
+  /** @brief Returns the point at parameter @p t along the ray. */
+  [[nodiscard]] mEn::Vec3 at(float t) const noexcept { return origin + direction * t; }
+
+  /**
+   * @brief Slab test against @p box.
+   * @return Entry distance clamped to 0, or std::nullopt if the ray misses the box
+   *         or enters it beyond @p max_t.
+   */
+  [[nodiscard]] std::optional<float> intersect(const Aabb& box, float max_t) const noexcept;
+  /** @copydoc intersect(const Aabb&, float) const */
+  [[nodiscard]] std::optional<float> intersect(const Aabb& box) const noexcept { return intersect(box, max_distance); }
+};
+
+/** @brief Plane in the form dot(normal, p) + distance = 0, normal pointing inside. */
+struct Plane {
+  mEn::Vec3 normal{0, 1, 0};
+  float distance = 0.F;
+
+  /** @brief Returns the signed distance from @p point to the plane. */
+  [[nodiscard]] float signed_distance(const mEn::Vec3& point) const noexcept {
+    return normal.x * point.x + normal.y * point.y + normal.z * point.z + distance;
+  }
+};
+
+/** @brief Result of a containment test against a Frustum. */
+enum class Containment : std::uint8_t { Outside, Intersects, Inside };
+
+/**
+ * @brief Six-plane view frustum extracted from a view-projection matrix.
+ *
+ * Plane order is left, right, bottom, top, near, far.  All normals point
+ * toward the inside of the frustum and are normalized.
+ */
+struct Frustum {
+  std::array<Plane, 6> planes;
+
+  /**
+   * @brief Extracts the frustum planes from a view-projection matrix
+   *        (Gribb/Hartmann, OpenGL clip space).
+   */
+  [[nodiscard]] static Frustum from_matrix(const mEn::Mat4& view_projection) noexcept;
+
+  /** @brief Conservative box test: may report a hit for boxes near frustum corners. */
+  [[nodiscard]] bool overlaps(const Aabb& box) const noexcept { return classify(box) != Containment::Outside; }
+  /** @brief Returns true if the sphere is not entirely behind any plane. */
+  [[nodiscard]] bool overlaps(const Sphere& sphere) const noexcept { return classify(sphere) != Containment::Outside; }
+
+  /** @brief Classifies @p box as fully outside, straddling, or fully inside the frustum. */
+  [[nodiscard]] Containment classify(const Aabb& box) const noexcept;
+  /** @copydoc classify(const Aabb&) const */
+  [[nodiscard]] Containment classify(const Sphere& sphere) const noexcept;
+};
+
+}  // namespace kEn
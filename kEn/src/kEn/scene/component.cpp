@@ -1,11 +1,22 @@
 #include "component.hpp"
 
+#include <optional>
+
 #include <kEn/core/assert.hpp>
+#include <kEn/core/timestep.hpp>
 #include <kEn/core/transform.hpp>
+#include <kEn/event/event.hpp>
 #include <kEn/scene/game_object.hpp>
+#include <kEn/scene/update_scheduler.hpp>
 
 namespace kEn {
 
+GameComponent::~GameComponent() {
+  if (scheduler_ != nullptr) {
+    scheduler_->remove(*this);
+  }
+}
+
 const kEn::Transform& GameComponent::transform() const { return parent().transform(); }
 kEn::Transform& GameComponent::transform() { return parent().transform(); }
 
@@ -18,7 +29,46 @@ void GameComponent::attach_to(GameObject& go) {
 void GameComponent::detach_from_parent() noexcept {
   KEN_CORE_ASSERT(parent_ != nullptr);
   on_detach();
+  if (scheduler_ != nullptr) {
+    scheduler_->remove(*this);
+  }
   parent_ = nullptr;
 }
 
+bool GameComponent::on_event(BaseEvent& event) {
+  if (scheduler_ != nullptr && update_policy_.wake_on_event && dispatcher_.listens_to(event)) {
+    wake();
+  }
+  return dispatcher_.dispatch(event);
+}
+
+bool GameComponent::sleeping() const noexcept {
+  return scheduler_ != nullptr && scheduler_->entries_[schedule_slot_].state == UpdateScheduler::State::Sleeping;
+}
+
+void GameComponent::wake() {
+  if (scheduler_ != nullptr) {
+    scheduler_->wake(schedule_slot_);
+  }
+}
+
+void GameComponent::set_update_policy(const UpdatePolicy& policy) {
+  update_policy_ = policy;
+  if (scheduler_ != nullptr) {
+    scheduler_->apply_policy(schedule_slot_);
+  }
+}
+
+void GameComponent::sleep() {
+  if (scheduler_ != nullptr) {
+    scheduler_->sleep(schedule_slot_, std::nullopt);
+  }
+}
+
+void GameComponent::sleep_for(Timestep duration) {
+  if (scheduler_ != nullptr) {
+    scheduler_->sleep(schedule_slot_, duration);
+  }
+}
+
 }  // namespace kEn
@@ -6,17 +6,20 @@
  * @ingroup ken
  */
 
+#include <cstdint>
 #include <memory>
 
 #include <kEn/core/assert.hpp>
 #include <kEn/core/timestep.hpp>
 #include <kEn/core/transform.hpp>
 #include <kEn/event/event.hpp>
+#include <kEn/scene/update_scheduler.hpp>
 
 namespace kEn {
 
 class GameObject;
 class Shader;
+struct RenderSnapshot;
 
 /**
  * @brief Abstract base for all components attached to a @ref GameObject.
@@ -35,8 +38,8 @@ class Shader;
  */
 class GameComponent {
  public:
-  GameComponent()          = default;
-  virtual ~GameComponent() = default;
+  GameComponent() = default;
+  virtual ~GameComponent();
 
   /**
    * @brief Return a heap-allocated deep copy of this component.
@@ -66,7 +69,8 @@ class GameComponent {
   /**
    * @brief Fixed-timestep game logic update.
    *
-   * @param delta  Time elapsed since the previous tick.
+   * @param delta  Time elapsed since the previous update of this component;
+   *               longer than a tick when it is throttled or was asleep.
    * @param time   Total elapsed simulation time.
    */
   virtual void update(Timestep /*delta*/, Timestep /*time*/) {}
@@ -80,6 +84,18 @@ class GameComponent {
    */
   virtual void render(Shader& /*shader*/, double /*alpha*/) {}
 
+  /**
+   * @brief Per-tick render state extraction.
+   *
+   * Copies whatever this component contributes to the rendered scene (model
+   * instances, lights) into @p snapshot, in world space, so that it can be
+   * drawn without touching the scene again.  Runs on the thread that runs
+   * @ref update.
+   *
+   * @param snapshot  Snapshot of the tick being finished.
+   */
+  virtual void snapshot(RenderSnapshot& /*snapshot*/) const {}
+
   /**
    * @brief Per-frame ImGui callback for debug/editor UI.
    */
@@ -88,9 +104,29 @@ class GameComponent {
   /**
    * @brief Dispatch @p event through the component's internal dispatcher.
    *
+   * Wakes the component first if it sleeps with UpdatePolicy::wake_on_event
+   * and subscribes to the event.
+   *
    * @return @c true if the event was handled and should stop propagating.
    */
-  bool on_event(BaseEvent& event) { return dispatcher_.dispatch(event); }
+  bool on_event(BaseEvent& event);
+
+  /** @name Update scheduling */
+  /** @{ */
+
+  /** @brief Returns the scheduling hints given to an @ref UpdateScheduler. */
+  [[nodiscard]] const UpdatePolicy& update_policy() const noexcept { return update_policy_; }
+
+  /** @brief Returns whether an @ref UpdateScheduler drives this component's updates. */
+  [[nodiscard]] bool scheduled() const noexcept { return scheduler_ != nullptr; }
+
+  /** @brief Returns whether the component is asleep in its @ref UpdateScheduler. */
+  [[nodiscard]] bool sleeping() const noexcept;
+
+  /** @brief Resumes updates of a sleeping component from the next tick.  No-op if awake or unscheduled. */
+  void wake();
+
+  /** @} */
 
   /**
    * @brief Return whether this component is currently attached to an owner.
@@ -124,6 +160,24 @@ class GameComponent {
   DELETE_COPY_MOVE(GameComponent);
 
  protected:
+  /**
+   * @brief Replace the scheduling hints; takes effect immediately when scheduled.
+   *
+   * May be called before the component is registered, e.g. from its constructor
+   * or @ref on_attach.
+   */
+  void set_update_policy(const UpdatePolicy& policy);
+
+  /**
+   * @brief Stops updates until @ref wake is called or a wake condition of the policy fires.
+   *
+   * Only has an effect when scheduled; calling it from @ref update is fine.
+   */
+  void sleep();
+
+  /** @brief Like @ref sleep, but also wakes up after @p duration of simulation time. */
+  void sleep_for(Timestep duration);
+
   /** @brief Event dispatcher; subscribe to engine events from @ref on_attach. */
   kEn::EventDispatcher dispatcher_;
 
@@ -133,7 +187,12 @@ class GameComponent {
 
   GameObject* parent_ = nullptr;
 
+  UpdatePolicy update_policy_;
+  UpdateScheduler* scheduler_  = nullptr;
+  std::uint32_t schedule_slot_ = 0;
+
   friend GameObject;
+  friend UpdateScheduler;
 };
 
 }  // namespace kEn
@@ -15,6 +15,7 @@
 #include <kEn/core/application.hpp>
 #include <kEn/core/assert.hpp>
 #include <kEn/core/input/input.hpp>
+#include <kEn/core/input/input_state.hpp>
 #include <kEn/core/input/key_codes.hpp>
 #include <kEn/core/timestep.hpp>
 #include <kEn/core/window.hpp>
@@ -35,12 +36,14 @@ void FreeLookComponent::on_attach() {
 }
 
 void FreeLookComponent::update(Timestep /*delta*/, Timestep /*time*/) {
-  if (kEn::input::is_key_pressed(kEn::key::escape)) {
+  const InputState& input = kEn::Application::instance().main_window().input();
+
+  if (input.pressed(kEn::key::escape)) {
     kEn::input::set_cursor_visible(true);
     update_ = false;
   }
 
-  if (kEn::input::is_key_pressed(kEn::key::f)) {
+  if (input.pressed(kEn::key::f)) {
     kEn::input::set_mouse_pos(window_center_);
     kEn::input::set_cursor_visible(false);
     update_ = true;
@@ -50,7 +53,7 @@ void FreeLookComponent::update(Timestep /*delta*/, Timestep /*time*/) {
     return;
   }
 
-  auto delta_pos                     = kEn::input::mouse_pos() - window_center_;
+  auto delta_pos                     = input.mouse_pos() - window_center_;
   const mEn::vec<2, bool> did_change = mEn::notNear(delta_pos, 0.0F);
 
   if (did_change.x) {
@@ -87,27 +90,28 @@ void FreeMoveComponent::update(Timestep delta, Timestep /*time*/) {
   constexpr mEn::Vec3 kWorldUp{0.0F, 1.0F, 0.0F};
 
   using enum kEn::Key;
-  const bool sprint       = kEn::input::is_key_pressed(left_control);
+  const InputState& input = kEn::Application::instance().main_window().input();
+  const bool sprint       = input.held(left_control);
   const auto dt           = static_cast<float>(delta.seconds());
   const float move_amount = sprint ? kSprintMultiplier * dt * speed_ : dt * speed_;
 
   mEn::Vec3 direction{0.F};
-  if (kEn::input::is_key_pressed(up) || kEn::input::is_key_pressed(w)) {
+  if (input.held(up) || input.held(w)) {
     direction += transform().local_front();
   }
-  if (kEn::input::is_key_pressed(down) || kEn::input::is_key_pressed(s)) {
+  if (input.held(down) || input.held(s)) {
     direction -= transform().local_front();
   }
-  if (kEn::input::is_key_pressed(right) || kEn::input::is_key_pressed(d)) {
+  if (input.held(right) || input.held(d)) {
     direction += transform().local_right();
   }
-  if (kEn::input::is_key_pressed(left) || kEn::input::is_key_pressed(a)) {
+  if (input.held(left) || input.held(a)) {
     direction -= transform().local_right();
   }
-  if (kEn::input::is_key_pressed(space) || kEn::input::is_key_pressed(e)) {
+  if (input.held(space) || input.held(e)) {
     direction += world_y_ ? kWorldUp : transform().local_up();
   }
-  if (kEn::input::is_key_pressed(left_shift) || kEn::input::is_key_pressed(q)) {
+  if (input.held(left_shift) || input.held(q)) {
     direction -= world_y_ ? kWorldUp : transform().local_up();
   }
 
@@ -65,9 +65,9 @@ class FreeLookComponent : public GameComponent {
 /**
  * @brief Keyboard-driven translation controller.
  *
- * Reads arrow keys, WASD, Space/E (up), and Shift/Q (down) each tick and
- * moves the owning object along the resulting direction.  Holding Left Control
- * triples the movement speed.
+ * Reads arrow keys, WASD, Space/E (up), and Shift/Q (down) from the tick's
+ * @ref InputState snapshot and moves the owning object along the resulting
+ * direction.  Holding Left Control triples the movement speed.
  *
  * When @p world_y is @c true the vertical axis is always world Y; when
  * @c false, up and down follow the object's local up direction.
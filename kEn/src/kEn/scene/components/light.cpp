@@ -1,25 +1,26 @@
 #include "light.hpp"
 
-#include <format>
 #include <memory>
-#include <string_view>
 
 #include <mEn/functions/trigonometric.hpp>
 
 #include <kEn/core/assert.hpp>
 #include <kEn/imgui/editors/light.hpp>
-#include <kEn/renderer/shader.hpp>
 #include <kEn/scene/component.hpp>
+#include <kEn/scene/render_snapshot.hpp>
 
 namespace kEn {
 
 void DirectionalLight::imgui() { ui::DirectionalLight(*this); }
 
-void DirectionalLight::load(std::string_view name, Shader& shader) const {
-  shader.set_uniform(std::format("{}.color", name), color);
-  shader.set_uniform(std::format("{}.dir", name), transform().world_front());
+void DirectionalLight::snapshot(RenderSnapshot& snapshot) const { snapshot.directional_lights.push_back(data()); }
+
+DirectionalLight::Data DirectionalLight::data() const {
+  return {.color = color, .dir = transform().world_front(), .pos = transform().world_pos()};
 }
 
+DirectionalLight::Data::Packed DirectionalLight::Data::pack() const noexcept { return {.color = color, .dir = dir}; }
+
 std::unique_ptr<GameComponent> DirectionalLight::clone() const {
   auto ptr   = std::make_unique<DirectionalLight>();
   ptr->color = color;
@@ -28,11 +29,16 @@ std::unique_ptr<GameComponent> DirectionalLight::clone() const {
 
 void PointLight::imgui() { ui::PointLight(*this); }
 
-void PointLight::load(std::string_view name, Shader& shader) const {
-  shader.set_uniform(std::format("{}.color", name), color);
-  shader.set_uniform(std::format("{}.atten.linear", name), atten.linear());
-  shader.set_uniform(std::format("{}.atten.quadratic", name), atten.quadratic());
-  shader.set_uniform(std::format("{}.pos", name), transform().world_pos());
+void PointLight::snapshot(RenderSnapshot& snapshot) const { snapshot.point_lights.push_back(data()); }
+
+PointLight::Data PointLight::data() const { return {.color = color, .pos = transform().world_pos(), .atten = atten}; }
+
+PointLight::Data::Packed PointLight::Data::pack() const noexcept {
+  return {.color     = color,
+          .linear    = atten.linear(),
+          .pos       = pos,
+          .quadratic = atten.quadratic(),
+          .radius    = atten.radius()};
 }
 
 std::unique_ptr<GameComponent> PointLight::clone() const {
@@ -50,14 +56,26 @@ void SpotLight::set_cutoff_angles(float inner_deg, float outer_deg) {
   outer_cutoff_angle_ = outer_deg;
 }
 
-void SpotLight::load(std::string_view name, Shader& shader) const {
-  shader.set_uniform(std::format("{}.color", name), color);
-  shader.set_uniform(std::format("{}.atten.linear", name), atten.linear());
-  shader.set_uniform(std::format("{}.atten.quadratic", name), atten.quadratic());
-  shader.set_uniform(std::format("{}.pos", name), transform().world_pos());
-  shader.set_uniform(std::format("{}.dir", name), transform().world_front());
-  shader.set_uniform(std::format("{}.cutoff", name), mEn::cos(mEn::radians(inner_cutoff_angle_)));
-  shader.set_uniform(std::format("{}.outerCutoff", name), mEn::cos(mEn::radians(outer_cutoff_angle_)));
+void SpotLight::snapshot(RenderSnapshot& snapshot) const { snapshot.spot_lights.push_back(data()); }
+
+SpotLight::Data SpotLight::data() const {
+  return {.color        = color,
+          .pos          = transform().world_pos(),
+          .dir          = transform().world_front(),
+          .atten        = atten,
+          .cutoff       = mEn::cos(mEn::radians(inner_cutoff_angle_)),
+          .outer_cutoff = mEn::cos(mEn::radians(outer_cutoff_angle_))};
+}
+
+SpotLight::Data::Packed SpotLight::Data::pack() const noexcept {
+  return {.color        = color,
+          .linear       = atten.linear(),
+          .pos          = pos,
+          .quadratic    = atten.quadratic(),
+          .dir          = dir,
+          .cutoff       = cutoff,
+          .outer_cutoff = outer_cutoff,
+          .radius       = atten.radius()};
 }
 
 std::unique_ptr<GameComponent> SpotLight::clone() const {
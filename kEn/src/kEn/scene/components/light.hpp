@@ -6,7 +6,7 @@
  * @ingroup ken
  */
 
-#include <string_view>
+#include <memory>
 
 #include <mEn/vec3.hpp>
 
@@ -15,7 +15,7 @@
 
 namespace kEn {
 
-class Shader;
+struct RenderSnapshot;
 
 /**
  * @brief Quadratic attenuation model parameterized by an effective radius.
@@ -33,7 +33,9 @@ struct Attenuation {
    * @brief Constructs an @ref Attenuation from an effective radius.
    *
    * The effective radius @p radius is the distance at which the attenuation
-   * factor drops below a visually negligible threshold.
+   * factor drops below a visually negligible threshold.  Shaders fade the
+   * factor out so that it reaches 0 there, which is where light clustering
+   * stops assigning the light.
    * Coefficients: @f$ l = 4.5 / r,\; q = 75 / r^2 @f$.
    *
    * @param radius Effective light radius in world units; must be positive.
@@ -79,7 +81,9 @@ struct Attenuation {
  * @brief Abstract base for all light components.
  *
  * Carries a RGB @ref color and requires subclasses to implement
- * @ref load (shader upload) and @ref clone (deep copy for serialization).
+ * @ref clone (deep copy for serialization).  Subclasses expose their world
+ * space parameters as a @c Data struct, which the renderer packs into the
+ * light storage buffers.
  * The direction or position of the light is provided by the owning
  * @ref GameObject's @ref Transform.
  */
@@ -91,17 +95,6 @@ class BaseLight : public GameComponent {
   /** @brief Returns a deep copy of this light component. */
   [[nodiscard]] std::unique_ptr<GameComponent> clone() const override = 0;
 
-  /**
-   * @brief Uploads this light's parameters to @p shader under the given @p name prefix.
-   *
-   * The prefix corresponds to the GLSL struct instance name,
-   * e.g. @c "u_DirLight" maps to @c u_DirLight.color, @c u_DirLight.dir, etc.
-   *
-   * @param name   GLSL uniform struct prefix.
-   * @param shader Shader to receive the uniforms.
-   */
-  virtual void load(std::string_view name, Shader& shader) const = 0;
-
   /** @brief RGB light color; defaults to white @f$ (1, 1, 1) @f$. */
   mEn::Vec3 color{1.F};
 };
@@ -110,31 +103,69 @@ class BaseLight : public GameComponent {
  * @brief Infinitely distant directional light.
  *
  * Direction is taken from the owning @ref Transform's world forward vector.
- * Uploads @c .color and @c .dir to the shader.
  */
 class DirectionalLight : public BaseLight {
  public:
+  /** @brief Copy of the light's parameters in world space, detached from the scene (see @ref RenderSnapshot). */
+  struct Data {
+    mEn::Vec3 color;
+    mEn::Vec3 dir;
+    mEn::Vec3 pos; /**< World position of the owning object; only used to place shadow views. */
+
+    /** @brief std430 layout of @c directional_light in @c light.glsl. */
+    struct alignas(16) Packed {
+      mEn::Vec3 color;
+      float pad0 = 0.F;
+      mEn::Vec3 dir;
+    };
+
+    /** @brief Returns the light in the layout of the light storage buffer. */
+    [[nodiscard]] Packed pack() const noexcept;
+  };
+
+  /** @brief Returns the light's current parameters in world space. */
+  [[nodiscard]] Data data() const;
+
   void imgui() override;
+  void snapshot(RenderSnapshot& snapshot) const override;
 
   [[nodiscard]] std::unique_ptr<GameComponent> clone() const override;
-
-  void load(std::string_view name, Shader& shader) const override;
 };
 
 /**
  * @brief Omnidirectional point light with quadratic attenuation.
  *
  * Position is taken from the owning @ref Transform's world position.
- * Uploads @c .color, @c .pos, @c .atten.linear, and @c .atten.quadratic to the shader.
  */
 class PointLight : public BaseLight {
  public:
+  /** @brief Copy of the light's parameters in world space, detached from the scene (see @ref RenderSnapshot). */
+  struct Data {
+    mEn::Vec3 color;
+    mEn::Vec3 pos;
+    Attenuation atten;
+
+    /** @brief std430 layout of @c point_light in @c light.glsl. */
+    struct alignas(16) Packed {
+      mEn::Vec3 color;
+      float linear;
+      mEn::Vec3 pos;
+      float quadratic;
+      float radius;  ///< Attenuation reaches 0 here, see @c calc_attenuation in @c light.glsl.
+    };
+
+    /** @brief Returns the light in the layout of the light storage buffer. */
+    [[nodiscard]] Packed pack() const noexcept;
+  };
+
+  /** @brief Returns the light's current parameters in world space. */
+  [[nodiscard]] Data data() const;
+
   void imgui() override;
+  void snapshot(RenderSnapshot& snapshot) const override;
 
   [[nodiscard]] std::unique_ptr<GameComponent> clone() const override;
 
-  void load(std::string_view name, Shader& shader) const override;
-
   /** @brief Attenuation parameters derived from the effective radius. */
   Attenuation atten = Attenuation::from_radius(50.0F);
 };
@@ -147,18 +178,42 @@ class PointLight : public BaseLight {
  * shader receives their cosines.  Intensity falls off smoothly between the
  * two angles.  The invariant @f$ \theta_{inner} \le \theta_{outer} @f$ is
  * enforced by @ref set_cutoff_angles.
- *
- * Uploads @c .color, @c .pos, @c .dir, @c .atten.linear, @c .atten.quadratic,
- * @c .cutoff, and @c .outerCutoff to the shader.
  */
 class SpotLight : public BaseLight {
  public:
+  /** @brief Copy of the light's parameters in world space, detached from the scene (see @ref RenderSnapshot). */
+  struct Data {
+    mEn::Vec3 color;
+    mEn::Vec3 pos;
+    mEn::Vec3 dir;
+    Attenuation atten;
+    float cutoff;       /**< Cosine of the inner cutoff angle. */
+    float outer_cutoff; /**< Cosine of the outer cutoff angle. */
+
+    /** @brief std430 layout of @c spot_light in @c light.glsl. */
+    struct alignas(16) Packed {
+      mEn::Vec3 color;
+      float linear;
+      mEn::Vec3 pos;
+      float quadratic;
+      mEn::Vec3 dir;
+      float cutoff;
+      float outer_cutoff;
+      float radius;  ///< @copydoc PointLight::Data::Packed::radius
+    };
+
+    /** @brief Returns the light in the layout of the light storage buffer. */
+    [[nodiscard]] Packed pack() const noexcept;
+  };
+
+  /** @brief Returns the light's current parameters in world space. */
+  [[nodiscard]] Data data() const;
+
   void imgui() override;
+  void snapshot(RenderSnapshot& snapshot) const override;
 
   [[nodiscard]] std::unique_ptr<GameComponent> clone() const override;
 
-  void load(std::string_view name, Shader& shader) const override;
-
   /**
    * @brief Sets the inner and outer cutoff angles of the spotlight cone.
    *
@@ -182,4 +237,8 @@ class SpotLight : public BaseLight {
   float outer_cutoff_angle_ = 10.0F;
 };
 
+static_assert(sizeof(DirectionalLight::Data::Packed) == 32, "Must match directional_light in light.glsl");
+static_assert(sizeof(PointLight::Data::Packed) == 48, "Must match point_light in light.glsl");
+static_assert(sizeof(SpotLight::Data::Packed) == 64, "Must match spot_light in light.glsl");
+
 }  // namespace kEn
@@ -1,16 +1,40 @@
 #include "model_component.hpp"
 
 #include <memory>
+#include <optional>
+#include <span>
+
+#include <mEn/mat4.hpp>
 
 #include <kEn/core/assert.hpp>
+#include <kEn/core/timestep.hpp>
 #include <kEn/renderer/shader.hpp>
 #include <kEn/scene/component.hpp>
+#include <kEn/scene/render_snapshot.hpp>
 
 namespace kEn {
 
+void ModelComponent::update(Timestep /*delta*/, Timestep /*time*/) {
+  if (scheduled()) {
+    sleep();
+  }
+}
+
 void ModelComponent::render(Shader& shader, double /*alpha*/) {
   KEN_CORE_ASSERT(has_parent(), "Can't render parentless model!");
-  model_->render(shader, transform());
+  model_->poll_lods();
+  model_->render(shader, transform(), std::span(lod_state_.get(), model_->lod_state_size()));
+}
+
+void ModelComponent::snapshot(RenderSnapshot& snapshot) const {
+  KEN_CORE_ASSERT(has_parent(), "Can't snapshot parentless model!");
+  const mEn::Mat4& world = transform().local_to_world_matrix();
+  snapshot.objects.push_back({.model          = model_,
+                              .world          = world,
+                              .world_to_local = transform().world_to_local_matrix(),
+                              .previous_world = previous_world_.value_or(world),
+                              .lod_state      = lod_state_});
+  previous_world_ = world;
 }
 
 std::unique_ptr<GameComponent> ModelComponent::clone() const { return std::make_unique<ModelComponent>(model_); }
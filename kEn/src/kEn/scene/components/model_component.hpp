@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 
+#include <mEn/mat4.hpp>
+
+#include <kEn/core/timestep.hpp>
 #include <kEn/imgui/editors/model.hpp>
 #include <kEn/scene/assets/model.hpp>
 #include <kEn/scene/component.hpp>
@@ -18,19 +23,31 @@ namespace kEn {
  *
  * Holds a shared reference to a @ref Model and submits it to the renderer each
  * frame via @ref render.  Multiple @c ModelComponent instances may share the
- * same underlying @ref Model.
+ * same underlying @ref Model; each keeps its own LOD hysteresis state.
  */
 class ModelComponent : public GameComponent {
  public:
   /** @brief Construct with the given model asset. */
-  explicit ModelComponent(std::shared_ptr<Model> model) : model_(std::move(model)) {}
+  explicit ModelComponent(std::shared_ptr<Model> model)
+      : model_(std::move(model)), lod_state_(std::make_shared<std::uint8_t[]>(model_->lod_state_size())) {}
 
+  /** @brief Models have no per-tick work, so a scheduled component goes to sleep on its first update. */
+  void update(Timestep delta, Timestep time) override;
   void render(Shader& shader, double alpha) override;
+  /**
+   * @brief Adds the model with its world matrices; the snapshot shares this instance's LOD state.
+   *
+   * The previous world matrix is the one of this component's last snapshot, or the current one for its first.
+   */
+  void snapshot(RenderSnapshot& snapshot) const override;
   void imgui() override { ui::Model(*model_); }
   [[nodiscard]] std::unique_ptr<GameComponent> clone() const override;
 
  private:
   std::shared_ptr<Model> model_;
+  std::shared_ptr<std::uint8_t[]> lod_state_;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  /** @brief World matrix of the last snapshot, taken once per tick; frames that redraw a snapshot see no motion. */
+  mutable std::optional<mEn::Mat4> previous_world_;
 };
 
 }  // namespace kEn
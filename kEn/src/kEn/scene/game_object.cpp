@@ -18,6 +18,7 @@
 #include <kEn/renderer/shader.hpp>
 #include <kEn/scene/component.hpp>
 #include <kEn/scene/id_registry.hpp>
+#include <kEn/scene/spatial_index.hpp>
 
 namespace kEn {
 
@@ -29,6 +30,10 @@ GameObject::GameObject(mEn::Vec3 pos, mEn::Quat rot, mEn::Vec3 scale, std::strin
 }
 
 GameObject::~GameObject() {
+  if (spatial_index_ != nullptr) {
+    spatial_index_->remove(*this);
+  }
+
   for (const auto& component : components_) {
     component->detach_from_parent();
   }
@@ -115,6 +120,18 @@ void GameObject::render(Shader& shader, double alpha, bool recursive) const {
   }
 }
 
+void GameObject::snapshot(RenderSnapshot& snapshot, bool recursive) const {
+  for (const auto& component : components_) {
+    component->snapshot(snapshot);
+  }
+
+  if (recursive) {
+    for (const auto* child : children_) {
+      child->snapshot(snapshot);
+    }
+  }
+}
+
 void GameObject::imgui(bool recursive) {
   for (const auto& component : components_) {
     component->imgui();
@@ -129,7 +146,9 @@ void GameObject::imgui(bool recursive) {
 
 void GameObject::update(Timestep delta, Timestep time, bool recursive) {
   for (auto& component : components_) {
-    component->update(delta, time);
+    if (!component->scheduled()) {
+      component->update(delta, time);
+    }
   }
 
   if (recursive) {
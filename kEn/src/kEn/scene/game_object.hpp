@@ -13,6 +13,7 @@
 #include <kEn/renderer/shader.hpp>
 #include <kEn/scene/component.hpp>
 #include <kEn/scene/id_registry.hpp>
+#include <kEn/scene/update_scheduler.hpp>
 
 /** @file
  *  @ingroup ken
@@ -20,6 +21,8 @@
 
 namespace kEn {
 
+class SpatialIndex;
+
 /**
  * @brief Scene node that owns a Transform, a list of GameComponents, and a
  *        parent-child hierarchy.
@@ -60,9 +63,9 @@ class GameObject {
                       std::string_view name = "GameObject");
 
   /**
-   * @brief Destructor.  Calls on_detach() on all components, detaches all
-   *        children (they become roots), and removes this object from its
-   *        parent's child list.
+   * @brief Destructor.  Removes this object from its @ref SpatialIndex, calls
+   *        on_detach() on all components, detaches all children (they become
+   *        roots), and removes this object from its parent's child list.
    */
   ~GameObject();
 
@@ -193,6 +196,13 @@ class GameObject {
    */
   void render(Shader& shader, double alpha, bool recursive = true) const;
 
+  /**
+   * @brief Adds the render state of all components to @p snapshot, then optionally recurses.
+   * @param snapshot  Snapshot being filled for the current tick.
+   * @param recursive If true, recurses into child objects (default: true).
+   */
+  void snapshot(RenderSnapshot& snapshot, bool recursive = true) const;
+
   /**
    * @brief Runs the ImGui widgets for all components, then optionally recurses.
    * @param recursive If true, recurses into child objects (default: true).
@@ -201,6 +211,10 @@ class GameObject {
 
   /**
    * @brief Updates all components, then optionally recurses into children.
+   *
+   * Components registered with an @ref UpdateScheduler are skipped; the
+   * scheduler drives them instead.
+   *
    * @param delta     Time elapsed since the last update tick.
    * @param time      Total elapsed simulation time.
    * @param recursive If true, recurses into child objects (default: true).
@@ -229,6 +243,9 @@ class GameObject {
   /** @copydoc transform() */
   [[nodiscard]] const kEn::Transform& transform() const { return transform_; }
 
+  /** @brief Returns the @ref SpatialIndex this object is registered in, or @c nullptr. */
+  [[nodiscard]] SpatialIndex* spatial_index() const { return spatial_index_; }
+
   /** @} */
 
   /** @name Registry lookup */
@@ -275,6 +292,10 @@ class GameObject {
   GameObject* parent_ = nullptr;
   std::vector<GameObject*> children_;
   std::vector<std::unique_ptr<GameComponent>> components_;
+  SpatialIndex* spatial_index_ = nullptr;
+
+  friend UpdateScheduler;
+  friend SpatialIndex;
 };
 
 }  // namespace kEn
@@ -0,0 +1,40 @@
+#include "render_snapshot.hpp"
+
+#include <span>
+
+#include <kEn/renderer/render_queue.hpp>
+#include <kEn/renderer/renderer.hpp>
+#include <kEn/renderer/shader.hpp>
+#include <kEn/scene/components/camera.hpp>
+
+namespace kEn {
+
+RenderSnapshot::View RenderSnapshot::View::from(const Camera& camera) {
+  return {.position   = camera.transform().world_pos(),
+          .view       = camera.view_matrix(),
+          .projection = camera.projection_matrix()};
+}
+
+void RenderSnapshot::Object::render(Shader& shader) const {
+  model->poll_lods();
+  const std::span<std::uint8_t> state =
+      lod_state != nullptr ? std::span(lod_state.get(), model->lod_state_size()) : std::span<std::uint8_t>{};
+  model->render(shader, ObjectData::from(world, world_to_local, previous_world), state);
+}
+
+void RenderSnapshot::prepare() const { Renderer::prepare(point_lights, directional_lights, spot_lights); }
+
+void RenderSnapshot::redraw() {
+  for (auto& object : objects) {
+    object.previous_world = object.world;
+  }
+}
+
+void RenderSnapshot::clear() {
+  objects.clear();
+  point_lights.clear();
+  directional_lights.clear();
+  spot_lights.clear();
+}
+
+}  // namespace kEn
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <mEn/fwd.hpp>
+#include <mEn/mat4.hpp>
+#include <mEn/vec3.hpp>
+
+#include <kEn/renderer/shader.hpp>
+#include <kEn/scene/assets/model.hpp>
+#include <kEn/scene/components/camera.hpp>
+#include <kEn/scene/components/light.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+/**
+ * @brief Everything needed to draw one simulation tick, copied out of the scene.
+ *
+ * Layers fill a snapshot in @ref Layer::on_snapshot at the end of a tick,
+ * usually through @ref GameObject::snapshot, and draw from it in
+ * @ref Layer::on_render.  A snapshot holds world matrices, light parameters
+ * and the camera by value and models by shared ownership, so drawing it never
+ * reads the scene graph and stays valid while the next tick changes it.
+ *
+ * The application reuses snapshots; @ref clear() empties one but keeps the
+ * capacity of its vectors.
+ */
+struct RenderSnapshot {
+  /** @brief Camera matrices of a view. */
+  struct View {
+    mEn::Vec3 position{};
+    mEn::Mat4 view{1.F};
+    mEn::Mat4 projection{1.F};
+
+    /** @brief Copies the current matrices and world position of @p camera. */
+    [[nodiscard]] static View from(const Camera& camera);
+  };
+
+  /** @brief One model instance. */
+  struct Object {
+    std::shared_ptr<Model> model;
+    mEn::Mat4 world{1.F};
+    mEn::Mat4 world_to_local{1.F};  ///< Inverse of @ref world.
+    mEn::Mat4 previous_world{1.F};  ///< @ref world in the previous frame, see @ref redraw.
+    /** @brief LOD hysteresis state of @ref Model::lod_state_size entries, or null; only touched by rendering. */
+    std::shared_ptr<std::uint8_t[]> lod_state;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+    /** @brief Adopts finished LOD chains and renders the model, see @ref Model::render. */
+    void render(Shader& shader) const;
+  };
+
+  std::uint64_t tick = 0; /**< Number of ticks run when the snapshot was taken. */
+  View camera;
+  std::vector<Object> objects;
+  std::vector<PointLight::Data> point_lights;
+  std::vector<DirectionalLight::Data> directional_lights;
+  std::vector<SpotLight::Data> spot_lights;
+
+  /** @brief Uploads the snapshot's lights to the light storage buffers, see @ref Renderer::prepare. */
+  void prepare() const;
+
+  /** @brief Removes all objects and lights; the camera and tick are left as they are. */
+  void clear();
+
+  /**
+   * @brief Readies the snapshot to be drawn again in a new frame.
+   *
+   * Objects of a new snapshot move from their world matrix of the previous
+   * tick; a snapshot drawn for several frames only moves in the first one, so
+   * this makes every object's previous world its current one.
+   */
+  void redraw();
+};
+
+}  // namespace kEn
@@ -0,0 +1,673 @@
+#include "spatial_index.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <mEn/fwd.hpp>
+#include <mEn/mat4.hpp>
+#include <mEn/vec4.hpp>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/scene/assets/model.hpp>
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/game_object.hpp>
+
+namespace kEn {
+
+namespace {
+
+/** @brief Number of centroid bins evaluated per axis by the SAH builder. */
+constexpr size_t kSahBins = 12;
+
+/**
+ * @brief Depth below which the builder switches from SAH to median splits, so that
+ *        degenerate inputs keep the traversals within their inline stack.
+ */
+constexpr size_t kMaxSahDepth = 48;
+
+}  // namespace
+
+SpatialIndex::SpatialIndex(SpatialIndexConfig config) : config_(config) {}
+
+SpatialIndex::~SpatialIndex() {
+  if (rebuild_.valid()) {
+    rebuild_.wait();
+  }
+
+  for (const auto& proxy : proxies_) {
+    if (proxy.object != nullptr) {
+      proxy.object->transform().unsubscribe_on_changed(this);
+      proxy.object->spatial_index_ = nullptr;
+    }
+  }
+}
+
+float SpatialIndex::Tree::cost() const noexcept {
+  if (root == kNullNode) {
+    return 0.F;
+  }
+  const float root_area = nodes[static_cast<size_t>(root)].box.surface_area();
+  return root_area > 0.F ? internal_area / root_area : 0.F;
+}
+
+void SpatialIndex::insert(GameObject& object, const Aabb& local_bounds) {
+  KEN_CORE_ASSERT(object.spatial_index_ == nullptr, "Object is already in a spatial index");
+
+  uint32_t id = 0;
+  if (free_proxies_.empty()) {
+    id = static_cast<uint32_t>(proxies_.size());
+    proxies_.emplace_back();
+  } else {
+    id = free_proxies_.back();
+    free_proxies_.pop_back();
+  }
+
+  // A recycled slot keeps its moved/stale bookkeeping: it may still be queued.
+  auto& proxy        = proxies_[id];
+  proxy.object       = &object;
+  proxy.local_bounds = local_bounds;
+  proxy.world_bounds = local_bounds.transformed(object.transform().local_to_world_matrix());
+
+  const int32_t leaf                           = allocate_node();
+  tree_.nodes[static_cast<size_t>(leaf)].box   = fat_box(proxy.world_bounds);
+  tree_.nodes[static_cast<size_t>(leaf)].proxy = id;
+  insert_leaf(leaf);
+  proxy.leaf = leaf;
+
+  lookup_.emplace(&object, id);
+  object.spatial_index_ = this;
+  mark_stale(id);
+  object.transform().subscribe_on_changed(this, [this, id] { mark_moved(id); });
+}
+
+void SpatialIndex::insert(GameObject& object, std::shared_ptr<const Model> model) {
+  KEN_CORE_ASSERT(model != nullptr, "Model must not be null");
+  insert(object, model->bounds().box);
+  proxies_[proxy_of(object)].model = std::move(model);
+}
+
+void SpatialIndex::remove(GameObject& object) {
+  const auto it = lookup_.find(&object);
+  if (it == lookup_.end()) {
+    return;
+  }
+
+  const uint32_t id = it->second;
+  lookup_.erase(it);
+  object.transform().unsubscribe_on_changed(this);
+  object.spatial_index_ = nullptr;
+
+  auto& proxy = proxies_[id];
+  remove_leaf(proxy.leaf);
+  free_node(proxy.leaf);
+  mark_stale(id);
+
+  proxy.object = nullptr;
+  proxy.model.reset();
+  proxy.leaf = kNullNode;
+  free_proxies_.push_back(id);
+}
+
+void SpatialIndex::set_local_bounds(GameObject& object, const Aabb& local_bounds) {
+  const uint32_t id         = proxy_of(object);
+  proxies_[id].local_bounds = local_bounds;
+  mark_moved(id);
+}
+
+const Aabb& SpatialIndex::world_bounds(const GameObject& object) const {
+  return proxies_[proxy_of(object)].world_bounds;
+}
+
+void SpatialIndex::update() {
+  poll_rebuild(false);
+
+  stats_.moved      = moved_.size();
+  stats_.reinserted = 0;
+  for (const uint32_t id : moved_) {
+    if (refit(id)) {
+      ++stats_.reinserted;
+    }
+  }
+  moved_.clear();
+
+  // A rebuilt tree of flat or coincident boxes can cost 0; that is a baseline like any other, not a missing one.
+  if (!rebuild_.valid() && size() >= config_.min_rebuild_proxies &&
+      (!baseline_cost_ || tree_.cost() > *baseline_cost_ * config_.rebuild_cost_ratio)) {
+    start_rebuild();
+  }
+
+  stats_.proxies             = size();
+  stats_.cost                = tree_.cost();
+  stats_.baseline_cost       = baseline_cost_.value_or(0.F);
+  stats_.rebuild_in_progress = rebuild_.valid();
+}
+
+std::optional<RaycastHit> SpatialIndex::raycast(const Ray& ray) const {
+  std::optional<RaycastHit> best;
+
+  raycast_proxies(ray, [&best, &ray](const Proxy& proxy, float max_t) {
+    if (!proxy.model || !proxy.model->pickable()) {
+      const auto t = ray.intersect(proxy.world_bounds, max_t);
+      if (!t) {
+        return max_t;
+      }
+      best = RaycastHit{.object = proxy.object, .mesh = nullptr, .triangle = 0, .distance = *t};
+      return *t;
+    }
+
+    // The direction is transformed without renormalization so that distances along the
+    // object-space ray equal distances along the world-space one.
+    const auto& world_to_local = proxy.object->transform().world_to_local_matrix();
+    const Ray local_ray(mEn::Vec3(world_to_local * mEn::Vec4(ray.origin, 1.F)),
+                        mEn::Vec3(world_to_local * mEn::Vec4(ray.direction, 0.F)), max_t);
+
+    const auto hit = proxy.model->raycast(local_ray, max_t);
+    if (!hit) {
+      return max_t;
+    }
+    best = RaycastHit{
+        .object = proxy.object, .mesh = hit->mesh, .triangle = hit->hit.triangle, .distance = hit->hit.distance};
+    return hit->hit.distance;
+  });
+
+  return best;
+}
+
+uint32_t SpatialIndex::proxy_of(const GameObject& object) const {
+  const auto it = lookup_.find(&object);
+  KEN_CORE_ASSERT(it != lookup_.end(), "Object is not in the spatial index");
+  return it->second;
+}
+
+Aabb SpatialIndex::fat_box(const Aabb& tight) const noexcept {
+  const mEn::Vec3 e  = tight.extents();
+  const float margin = std::max(config_.min_fat_margin, config_.fat_margin_ratio * std::max({e.x, e.y, e.z}));
+  return tight.fattened(margin);
+}
+
+void SpatialIndex::mark_moved(uint32_t proxy) {
+  if (!proxies_[proxy].moved) {
+    proxies_[proxy].moved = true;
+    moved_.push_back(proxy);
+  }
+}
+
+void SpatialIndex::mark_stale(uint32_t proxy) {
+  if (rebuild_.valid() && !proxies_[proxy].stale) {
+    proxies_[proxy].stale = true;
+    stale_.push_back(proxy);
+  }
+}
+
+bool SpatialIndex::refit(uint32_t id) {
+  auto& proxy = proxies_[id];
+  proxy.moved = false;
+  if (proxy.object == nullptr) {
+    return false;
+  }
+
+  proxy.world_bounds = proxy.local_bounds.transformed(proxy.object->transform().local_to_world_matrix());
+
+  const int32_t leaf = proxy.leaf;
+  if (tree_.nodes[static_cast<size_t>(leaf)].box.contains(proxy.world_bounds)) {
+    return false;
+  }
+
+  remove_leaf(leaf);
+  tree_.nodes[static_cast<size_t>(leaf)].box = fat_box(proxy.world_bounds);
+  insert_leaf(leaf);
+  mark_stale(id);
+  return true;
+}
+
+int32_t SpatialIndex::allocate_node() {
+  int32_t index = 0;
+  if (tree_.free_list == kNullNode) {
+    index = static_cast<int32_t>(tree_.nodes.size());
+    tree_.nodes.emplace_back();
+  } else {
+    index           = tree_.free_list;
+    tree_.free_list = tree_.nodes[static_cast<size_t>(index)].parent;
+  }
+
+  tree_.nodes[static_cast<size_t>(index)] = Node{};
+  return index;
+}
+
+void SpatialIndex::free_node(int32_t index) {
+  auto& node = tree_.nodes[static_cast<size_t>(index)];
+  if (!node.is_leaf()) {
+    tree_.internal_area -= node.box.surface_area();
+  }
+
+  node            = Node{};
+  node.parent     = tree_.free_list;
+  node.height     = -1;
+  tree_.free_list = index;
+}
+
+void SpatialIndex::set_internal_box(int32_t index, const Aabb& box) {
+  auto& node = tree_.nodes[static_cast<size_t>(index)];
+  tree_.internal_area += box.surface_area() - node.box.surface_area();
+  node.box = box;
+}
+
+void SpatialIndex::insert_leaf(int32_t leaf) {
+  auto& nodes   = tree_.nodes;
+  const auto at = [&nodes](int32_t i) -> Node& { return nodes[static_cast<size_t>(i)]; };
+
+  if (tree_.root == kNullNode) {
+    tree_.root      = leaf;
+    at(leaf).parent = kNullNode;
+    return;
+  }
+
+  // Descend towards the sibling with the lowest SAH cost increase.
+  const Aabb leaf_box = at(leaf).box;
+  int32_t index       = tree_.root;
+  while (!at(index).is_leaf()) {
+    const auto& node          = at(index);
+    const float area          = node.box.surface_area();
+    const float combined_area = node.box.merged(leaf_box).surface_area();
+
+    const float cost        = 2.F * combined_area;
+    const float inheritance = 2.F * (combined_area - area);
+
+    const auto descend_cost = [&](int32_t child) {
+      const auto& c     = at(child);
+      const float grown = leaf_box.merged(c.box).surface_area();
+      return (c.is_leaf() ? grown : grown - c.box.surface_area()) + inheritance;
+    };
+
+    const float cost1 = descend_cost(node.child1);
+    const float cost2 = descend_cost(node.child2);
+    if (cost < cost1 && cost < cost2) {
+      break;
+    }
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+
+  const int32_t sibling    = index;
+  const int32_t new_parent = allocate_node();
+  const int32_t old_parent = at(sibling).parent;
+
+  at(new_parent).parent = old_parent;
+  at(new_parent).child1 = sibling;
+  at(new_parent).child2 = leaf;
+  at(new_parent).height = at(sibling).height + 1;
+  set_internal_box(new_parent, leaf_box.merged(at(sibling).box));
+
+  if (old_parent == kNullNode) {
+    tree_.root = new_parent;
+  } else if (at(old_parent).child1 == sibling) {
+    at(old_parent).child1 = new_parent;
+  } else {
+    at(old_parent).child2 = new_parent;
+  }
+  at(sibling).parent = new_parent;
+  at(leaf).parent    = new_parent;
+
+  for (index = at(leaf).parent; index != kNullNode; index = at(index).parent) {
+    index = balance(index);
+
+    const auto& node = at(index);
+    at(index).height = 1 + std::max(at(node.child1).height, at(node.child2).height);
+    set_internal_box(index, at(node.child1).box.merged(at(node.child2).box));
+  }
+}
+
+void SpatialIndex::remove_leaf(int32_t leaf) {
+  auto& nodes   = tree_.nodes;
+  const auto at = [&nodes](int32_t i) -> Node& { return nodes[static_cast<size_t>(i)]; };
+
+  if (leaf == tree_.root) {
+    tree_.root = kNullNode;
+    return;
+  }
+
+  const int32_t parent       = at(leaf).parent;
+  const int32_t grand_parent = at(parent).parent;
+  const int32_t sibling      = at(parent).child1 == leaf ? at(parent).child2 : at(parent).child1;
+
+  at(leaf).parent = kNullNode;
+
+  if (grand_parent == kNullNode) {
+    tree_.root         = sibling;
+    at(sibling).parent = kNullNode;
+    free_node(parent);
+    return;
+  }
+
+  if (at(grand_parent).child1 == parent) {
+    at(grand_parent).child1 = sibling;
+  } else {
+    at(grand_parent).child2 = sibling;
+  }
+  at(sibling).parent = grand_parent;
+  free_node(parent);
+
+  for (int32_t index = grand_parent; index != kNullNode; index = at(index).parent) {
+    index = balance(index);
+
+    const auto& node = at(index);
+    at(index).height = 1 + std::max(at(node.child1).height, at(node.child2).height);
+    set_internal_box(index, at(node.child1).box.merged(at(node.child2).box));
+  }
+}
+
+int32_t SpatialIndex::balance(int32_t ia) {
+  auto& nodes   = tree_.nodes;
+  const auto at = [&nodes](int32_t i) -> Node& { return nodes[static_cast<size_t>(i)]; };
+
+  Node& a = at(ia);
+  if (a.is_leaf() || a.height < 2) {
+    return ia;
+  }
+
+  const int32_t ib = a.child1;
+  const int32_t ic = a.child2;
+  Node& b          = at(ib);
+  Node& c          = at(ic);
+
+  // Replaces `from` with `to` in the parent of `to` (which is now `from`'s old parent).
+  const auto relink_parent = [&](int32_t from, int32_t to) {
+    const int32_t parent = at(to).parent;
+    if (parent == kNullNode) {
+      tree_.root = to;
+    } else if (at(parent).child1 == from) {
+      at(parent).child1 = to;
+    } else {
+      at(parent).child2 = to;
+    }
+  };
+
+  const int32_t balance_factor = c.height - b.height;
+
+  // Rotate C up.
+  if (balance_factor > 1) {
+    const int32_t i_f = c.child1;
+    const int32_t i_g = c.child2;
+    Node& f           = at(i_f);
+    Node& g           = at(i_g);
+
+    c.child1 = ia;
+    c.parent = a.parent;
+    a.parent = ic;
+    relink_parent(ia, ic);
+
+    if (f.height > g.height) {
+      c.child2 = i_f;
+      a.child2 = i_g;
+      g.parent = ia;
+      set_internal_box(ia, b.box.merged(g.box));
+      set_internal_box(ic, a.box.merged(f.box));
+      a.height = 1 + std::max(b.height, g.height);
+      c.height = 1 + std::max(a.height, f.height);
+    } else {
+      c.child2 = i_g;
+      a.child2 = i_f;
+      f.parent = ia;
+      set_internal_box(ia, b.box.merged(f.box));
+      set_internal_box(ic, a.box.merged(g.box));
+      a.height = 1 + std::max(b.height, f.height);
+      c.height = 1 + std::max(a.height, g.height);
+    }
+    return ic;
+  }
+
+  // Rotate B up.
+  if (balance_factor < -1) {
+    const int32_t i_d = b.child1;
+    const int32_t i_e = b.child2;
+    Node& d           = at(i_d);
+    Node& e           = at(i_e);
+
+    b.child1 = ia;
+    b.parent = a.parent;
+    a.parent = ib;
+    relink_parent(ia, ib);
+
+    if (d.height > e.height) {
+      b.child2 = i_d;
+      a.child1 = i_e;
+      e.parent = ia;
+      set_internal_box(ia, c.box.merged(e.box));
+      set_internal_box(ib, a.box.merged(d.box));
+      a.height = 1 + std::max(c.height, e.height);
+      b.height = 1 + std::max(a.height, d.height);
+    } else {
+      b.child2 = i_e;
+      a.child1 = i_d;
+      d.parent = ia;
+      set_internal_box(ia, c.box.merged(d.box));
+      set_internal_box(ib, a.box.merged(e.box));
+      a.height = 1 + std::max(c.height, d.height);
+      b.height = 1 + std::max(a.height, e.height);
+    }
+    return ib;
+  }
+
+  return ia;
+}
+
+void SpatialIndex::start_rebuild() {
+  std::vector<RebuildItem> items;
+  items.reserve(size());
+  for (uint32_t id = 0; id < proxies_.size(); ++id) {
+    if (proxies_[id].object != nullptr) {
+      items.push_back({.proxy = id, .box = tree_.nodes[static_cast<size_t>(proxies_[id].leaf)].box});
+    }
+  }
+
+  if (config_.background_rebuild) {
+    rebuild_ = std::async(std::launch::async, &SpatialIndex::build, std::move(items));
+  } else {
+    adopt_rebuild(build(std::move(items)));
+  }
+}
+
+void SpatialIndex::poll_rebuild(bool wait) {
+  if (!rebuild_.valid()) {
+    return;
+  }
+  if (!wait && rebuild_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return;
+  }
+
+  adopt_rebuild(rebuild_.get());
+}
+
+void SpatialIndex::adopt_rebuild(RebuildResult result) {
+  tree_ = std::move(result.tree);
+
+  // Snapshot leaves of proxies that changed while the tree was being built are
+  // dropped and reinserted from their current state.
+  for (size_t i = 0; i < result.items.size(); ++i) {
+    auto& proxy        = proxies_[result.items[i].proxy];
+    const int32_t leaf = result.leaves[i];
+    if (proxy.stale || proxy.object == nullptr) {
+      remove_leaf(leaf);
+      free_node(leaf);
+    } else {
+      proxy.leaf = leaf;
+    }
+  }
+
+  for (const uint32_t id : stale_) {
+    auto& proxy = proxies_[id];
+    proxy.stale = false;
+    if (proxy.object == nullptr) {
+      continue;
+    }
+
+    const int32_t leaf                           = allocate_node();
+    tree_.nodes[static_cast<size_t>(leaf)].box   = fat_box(proxy.world_bounds);
+    tree_.nodes[static_cast<size_t>(leaf)].proxy = id;
+    insert_leaf(leaf);
+    proxy.leaf = leaf;
+  }
+  stale_.clear();
+
+  baseline_cost_ = tree_.cost();
+  ++stats_.rebuilds;
+}
+
+SpatialIndex::RebuildResult SpatialIndex::build(std::vector<RebuildItem> items) {
+  RebuildResult result;
+  result.leaves.assign(items.size(), kNullNode);
+
+  const size_t count = items.size();
+  if (count == 0) {
+    result.items = std::move(items);
+    return result;
+  }
+
+  auto& tree = result.tree;
+  tree.nodes.reserve(2 * count - 1);
+
+  std::vector<mEn::Vec3> centroids(count);
+  for (size_t i = 0; i < count; ++i) {
+    centroids[i] = items[i].box.center();
+  }
+
+  std::vector<size_t> order(count);
+  std::iota(order.begin(), order.end(), 0);
+
+  struct Task {
+    int32_t node;
+    size_t begin;
+    size_t end;
+    size_t depth;
+  };
+
+  tree.nodes.emplace_back();
+  tree.root = 0;
+  std::vector<Task> tasks{{.node = 0, .begin = 0, .end = count, .depth = 0}};
+
+  while (!tasks.empty()) {
+    const auto [index, begin, end, depth] = tasks.back();
+    tasks.pop_back();
+
+    if (end - begin == 1) {
+      const size_t item   = order[begin];
+      auto& leaf          = tree.nodes[static_cast<size_t>(index)];
+      leaf.box            = items[item].box;
+      leaf.proxy          = items[item].proxy;
+      result.leaves[item] = index;
+      continue;
+    }
+
+    Aabb bounds;
+    Aabb centroid_bounds;
+    for (size_t i = begin; i < end; ++i) {
+      bounds = bounds.merged(items[order[i]].box);
+      centroid_bounds.expand(centroids[order[i]]);
+    }
+
+    const auto first = order.begin() + static_cast<std::ptrdiff_t>(begin);
+    const auto last  = order.begin() + static_cast<std::ptrdiff_t>(end);
+    auto middle      = first;
+
+    const mEn::Vec3 extent = centroid_bounds.max - centroid_bounds.min;
+
+    // Binned SAH over all three axes.
+    if (depth < kMaxSahDepth) {
+      float best_cost   = static_cast<float>(end - begin) * bounds.surface_area();
+      size_t best_axis  = 0;
+      size_t best_split = 0;
+      const auto bin_of = [&](size_t item, size_t axis) {
+        const float offset = (centroids[item][axis] - centroid_bounds.min[axis]) / extent[axis];
+        return std::min(kSahBins - 1, static_cast<size_t>(offset * static_cast<float>(kSahBins)));
+      };
+
+      for (size_t axis = 0; axis < 3; ++axis) {
+        if (extent[axis] <= 0.F) {
+          continue;
+        }
+
+        std::array<Aabb, kSahBins> bin_boxes{};
+        std::array<size_t, kSahBins> bin_counts{};
+        for (size_t i = begin; i < end; ++i) {
+          const size_t bin = bin_of(order[i], axis);
+          bin_boxes[bin]   = bin_boxes[bin].merged(items[order[i]].box);
+          ++bin_counts[bin];
+        }
+
+        std::array<float, kSahBins> right_cost{};
+        Aabb right_box;
+        size_t right_count = 0;
+        for (size_t bin = kSahBins - 1; bin > 0; --bin) {
+          right_box = right_box.merged(bin_boxes[bin]);
+          right_count += bin_counts[bin];
+          right_cost[bin] = static_cast<float>(right_count) * right_box.surface_area();
+        }
+
+        Aabb left_box;
+        size_t left_count = 0;
+        for (size_t split = 1; split < kSahBins; ++split) {
+          left_box = left_box.merged(bin_boxes[split - 1]);
+          left_count += bin_counts[split - 1];
+          if (left_count == 0 || left_count == end - begin) {
+            continue;
+          }
+
+          const float cost = static_cast<float>(left_count) * left_box.surface_area() + right_cost[split];
+          if (cost < best_cost) {
+            best_cost  = cost;
+            best_axis  = axis;
+            best_split = split;
+          }
+        }
+      }
+
+      if (best_split != 0) {
+        middle = std::partition(first, last, [&](size_t item) { return bin_of(item, best_axis) < best_split; });
+      }
+    }
+
+    // Median split along the widest centroid axis when SAH found nothing useful.
+    if (middle == first || middle == last) {
+      const size_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+      middle            = first + static_cast<std::ptrdiff_t>((end - begin) / 2);
+      std::nth_element(first, middle, last,
+                       [&](size_t lhs, size_t rhs) { return centroids[lhs][axis] < centroids[rhs][axis]; });
+    }
+
+    const auto mid  = static_cast<size_t>(middle - order.begin());
+    const auto left = static_cast<int32_t>(tree.nodes.size());
+
+    tree.nodes.emplace_back().parent = index;
+    tree.nodes.emplace_back().parent = index;
+
+    auto& node  = tree.nodes[static_cast<size_t>(index)];
+    node.child1 = left;
+    node.child2 = left + 1;
+    node.box    = bounds;
+    tree.internal_area += bounds.surface_area();
+
+    tasks.push_back({.node = left + 1, .begin = mid, .end = end, .depth = depth + 1});
+    tasks.push_back({.node = left, .begin = begin, .end = mid, .depth = depth + 1});
+  }
+
+  // Children are stored after their parent, so a reverse pass sees them first.
+  for (auto it = tree.nodes.rbegin(); it != tree.nodes.rend(); ++it) {
+    if (!it->is_leaf()) {
+      it->height = 1 + std::max(tree.nodes[static_cast<size_t>(it->child1)].height,
+                                tree.nodes[static_cast<size_t>(it->child2)].height);
+    }
+  }
+
+  result.items = std::move(items);
+  return result;
+}
+
+}  // namespace kEn
@@ -0,0 +1,437 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <kEn/core/core.hpp>
+#include <kEn/scene/bounds.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+class GameObject;
+class Mesh;
+class Model;
+
+/** @brief Tuning knobs for a SpatialIndex. */
+struct SpatialIndexConfig {
+  /**
+   * @brief Fraction of a proxy's largest half-extent added on every side of its
+   *        tree box.  Small movements inside the fat box do not touch the tree.
+   */
+  float fat_margin_ratio = 0.2F;
+  /** @brief Absolute lower bound for the fat margin, in world units. */
+  float min_fat_margin = 0.05F;
+  /**
+   * @brief A rebuild is started once the tree cost exceeds the cost measured
+   *        right after the previous rebuild by this factor.
+   */
+  float rebuild_cost_ratio = 1.5F;
+  /** @brief Trees with fewer proxies than this are never rebuilt. */
+  size_t min_rebuild_proxies = 64;
+  /** @brief If true, rebuilds run on a worker thread and are swapped in by a later update(). */
+  bool background_rebuild = true;
+};
+
+/** @brief Counters describing the state of a SpatialIndex after the last update(). */
+struct SpatialIndexStats {
+  size_t proxies           = 0;
+  size_t moved             = 0;  ///< Proxies whose transform changed since the previous update().
+  size_t reinserted        = 0;  ///< Moved proxies that escaped their fat box and were reinserted.
+  size_t rebuilds          = 0;  ///< Total number of completed full rebuilds.
+  float cost               = 0.F;
+  float baseline_cost      = 0.F;
+  bool rebuild_in_progress = false;
+};
+
+/** @brief Closest object hit by SpatialIndex::raycast. */
+struct RaycastHit {
+  GameObject* object = nullptr;
+  const Mesh* mesh   = nullptr;  ///< nullptr when the object was registered without a pickable Model.
+  uint32_t triangle  = 0;        ///< Triangle index within @c mesh; meaningless when @c mesh is nullptr.
+  float distance     = 0.F;      ///< Distance along the ray, in units of the ray direction.
+};
+
+/** @brief Shapes accepted by SpatialIndex::query. */
+template <typename T>
+concept SpatialQueryShape = std::same_as<T, Aabb> || std::same_as<T, Sphere> || std::same_as<T, Frustum>;
+
+/**
+ * @brief Dynamic bounding volume hierarchy over GameObjects.
+ *
+ * Each registered object contributes one leaf whose box is its object-space
+ * bounds transformed by the world matrix and enlarged by a margin ("fat" box).
+ * The index subscribes to the object's Transform change notification, so only
+ * objects that actually moved are revisited by update(); a moved object is
+ * reinserted only when its tight box escapes the fat one.  Per-tick cost is
+ * therefore O(moved * log n) and independent of the scene size.
+ *
+ * Incremental insertion (Box2D-style, with AVL rotations) keeps the tree
+ * balanced but slowly degrades its surface-area cost.  The cost is tracked
+ * incrementally; once it grows past SpatialIndexConfig::rebuild_cost_ratio
+ * a binned-SAH rebuild is started from a snapshot of the leaf boxes, optionally
+ * on a worker thread.  Queries keep using the live tree until the new tree is
+ * swapped in; changes made in the meantime are replayed onto it.
+ *
+ * Visitors passed to the query functions receive a @c GameObject& and may
+ * return @c bool, in which case returning @c false stops the traversal.
+ *
+ * The index is meant to be owned by the scene holding the objects, next to
+ * its @ref UpdateScheduler.  An object belongs to at most one index and
+ * removes itself when destroyed; objects still registered when the index is
+ * destroyed are released.
+ *
+ * @warning Not thread-safe.
+ */
+class SpatialIndex {
+ public:
+  explicit SpatialIndex(SpatialIndexConfig config = {});
+  ~SpatialIndex();
+
+  /** @name Registration */
+  /** @{ */
+
+  /**
+   * @brief Adds @p object with object-space bounds @p local_bounds.
+   * @pre The object is not in any index.
+   */
+  void insert(GameObject& object, const Aabb& local_bounds);
+
+  /**
+   * @brief Adds @p object rendered with @p model, using the model bounds.
+   *
+   * If the model is @ref Model::pickable, its triangle hierarchies are used by
+   * raycast(const Ray&) to find the exact hit instead of stopping at the bounding box.
+   * @pre The object is not in any index.
+   */
+  void insert(GameObject& object, std::shared_ptr<const Model> model);
+
+  /** @brief Removes @p object.  No-op if it is not in the index.  Called by the destructor of @p object. */
+  void remove(GameObject& object);
+
+  /** @brief Replaces the object-space bounds of @p object; the tree is updated on the next update(). */
+  void set_local_bounds(GameObject& object, const Aabb& local_bounds);
+
+  /** @brief Returns true if @p object is in the index. */
+  [[nodiscard]] bool contains(const GameObject& object) const { return lookup_.contains(&object); }
+
+  /** @brief Returns the number of objects in the index. */
+  [[nodiscard]] size_t size() const noexcept { return lookup_.size(); }
+
+  /** @brief Returns the tight world-space bounds computed for @p object at the last update(). */
+  [[nodiscard]] const Aabb& world_bounds(const GameObject& object) const;
+
+  /** @} */
+
+  /**
+   * @brief Refits objects whose transform changed since the last call, swaps in
+   *        a finished background rebuild and starts a new one if needed.
+   *
+   * Call once per tick, after the simulation moved the objects.
+   */
+  void update();
+
+  /** @brief Returns the counters gathered by the last update(). */
+  [[nodiscard]] const SpatialIndexStats& stats() const noexcept { return stats_; }
+
+  /** @name Queries */
+  /** @{ */
+
+  /** @brief Visits every object whose world bounds overlap @p shape. */
+  template <SpatialQueryShape Shape, typename F>
+  void query(const Shape& shape, F&& visitor) const {
+    traverse(shape, [&visitor](GameObject& object) { return invoke_visitor(visitor, object); });
+  }
+
+  /**
+   * @brief Writes objects whose world bounds overlap @p shape into @p out.
+   * @return Number of objects written; the traversal stops once @p out is full.
+   */
+  template <SpatialQueryShape Shape>
+  size_t query(const Shape& shape, std::span<GameObject*> out) const {
+    size_t count = 0;
+    if (out.empty()) {
+      return count;
+    }
+    traverse(shape, [&](GameObject& object) {
+      out[count++] = &object;
+      return count < out.size();
+    });
+    return count;
+  }
+
+  /**
+   * @brief Visits objects whose world bounds are hit by @p ray, roughly front to back.
+   *
+   * @p visitor is called as @c float(GameObject& object, float max_distance) and
+   * returns the new maximum distance: return @p max_distance unchanged to keep
+   * going, or the distance of a confirmed hit to prune everything behind it.
+   */
+  template <typename F>
+    requires std::is_invocable_r_v<float, F, GameObject&, float>
+  void raycast(const Ray& ray, F&& visitor) const {
+    raycast_proxies(ray, [&visitor](const Proxy& proxy, float max_t) {
+      return static_cast<float>(std::invoke(visitor, *proxy.object, max_t));
+    });
+  }
+
+  /**
+   * @brief Returns the closest object hit by @p ray.
+   *
+   * Objects registered with a pickable Model are tested against its triangles
+   * in object space, so no GPU read-back is involved; other objects report a
+   * hit on their world bounds.  Uses the bounds computed by the last update().
+   */
+  [[nodiscard]] std::optional<RaycastHit> raycast(const Ray& ray) const;
+
+  /** @} */
+
+  DELETE_COPY_MOVE(SpatialIndex);
+
+ private:
+  static constexpr int32_t kNullNode   = -1;
+  static constexpr uint32_t kNullProxy = ~0U;
+  static constexpr size_t kMaxDepth    = 128;  ///< Traversal stack entries kept on the call stack.
+
+  struct Node {
+    Aabb box;
+    int32_t parent = kNullNode;
+    int32_t child1 = kNullNode;
+    int32_t child2 = kNullNode;
+    int32_t height = 0;  ///< 0 for leaves, -1 for free nodes.
+    uint32_t proxy = kNullProxy;
+
+    [[nodiscard]] bool is_leaf() const noexcept { return child1 == kNullNode; }
+  };
+
+  struct Tree {
+    std::vector<Node> nodes;
+    int32_t root        = kNullNode;
+    int32_t free_list   = kNullNode;
+    float internal_area = 0.F;  ///< Sum of internal node surface areas, kept up to date incrementally.
+
+    [[nodiscard]] float cost() const noexcept;
+  };
+
+  struct Proxy {
+    GameObject* object = nullptr;
+    std::shared_ptr<const Model> model;
+    Aabb local_bounds;
+    Aabb world_bounds;
+    int32_t leaf = kNullNode;
+    bool moved   = false;  ///< Queued in moved_ for the next update().
+    bool stale   = false;  ///< Changed since the in-flight rebuild snapshot was taken.
+  };
+
+  struct RebuildItem {
+    uint32_t proxy;
+    Aabb box;
+  };
+
+  struct RebuildResult {
+    Tree tree;
+    std::vector<RebuildItem> items;  ///< The snapshot the tree was built from.
+    std::vector<int32_t> leaves;     ///< Leaf node of each snapshot item, in snapshot order.
+  };
+
+  /** @brief Node stack of the traversals; moves to the heap for trees too deep for @ref kMaxDepth entries. */
+  class TraversalStack {
+   public:
+    TraversalStack() = default;
+    DELETE_COPY_MOVE(TraversalStack);
+
+    void push(int32_t node) {
+      if (top_ == capacity_) [[unlikely]] {
+        grow();
+      }
+      data_[top_++] = node;
+    }
+    [[nodiscard]] int32_t pop() noexcept { return data_[--top_]; }
+    [[nodiscard]] bool empty() const noexcept { return top_ == 0; }
+
+   private:
+    void grow() {
+      std::vector<int32_t> heap(2 * capacity_);
+      std::copy_n(data_, top_, heap.begin());
+      heap_     = std::move(heap);
+      data_     = heap_.data();
+      capacity_ = heap_.size();
+    }
+
+    std::array<int32_t, kMaxDepth> inline_{};
+    std::vector<int32_t> heap_;
+    int32_t* data_   = inline_.data();
+    size_t capacity_ = kMaxDepth;
+    size_t top_      = 0;
+  };
+
+  template <typename F>
+  static bool invoke_visitor(F& visitor, GameObject& object) {
+    if constexpr (std::is_same_v<std::invoke_result_t<F&, GameObject&>, bool>) {
+      return std::invoke(visitor, object);
+    } else {
+      std::invoke(visitor, object);
+      return true;
+    }
+  }
+
+  [[nodiscard]] static bool node_overlaps(const Aabb& node, const Aabb& shape) noexcept { return node.overlaps(shape); }
+  [[nodiscard]] static bool node_overlaps(const Aabb& node, const Sphere& shape) noexcept {
+    return shape.overlaps(node);
+  }
+  [[nodiscard]] static bool node_overlaps(const Aabb& node, const Frustum& shape) noexcept {
+    return shape.overlaps(node);
+  }
+
+  /** @brief Visits all leaves below @p node without further tests.  Returns false if stopped. */
+  template <typename F>
+  bool visit_subtree(int32_t node_index, F& visit) const {
+    TraversalStack stack;
+    stack.push(node_index);
+    while (!stack.empty()) {
+      const auto& node = tree_.nodes[static_cast<size_t>(stack.pop())];
+      if (node.is_leaf()) {
+        if (!visit(*proxies_[node.proxy].object)) {
+          return false;
+        }
+        continue;
+      }
+      stack.push(node.child1);
+      stack.push(node.child2);
+    }
+    return true;
+  }
+
+  template <typename Shape, typename F>
+  void traverse(const Shape& shape, F&& visit) const {
+    if (tree_.root == kNullNode) {
+      return;
+    }
+
+    TraversalStack stack;
+    stack.push(tree_.root);
+
+    while (!stack.empty()) {
+      const int32_t index = stack.pop();
+      const auto& node    = tree_.nodes[static_cast<size_t>(index)];
+
+      if constexpr (std::same_as<Shape, Frustum>) {
+        const auto containment = shape.classify(node.box);
+        if (containment == Containment::Outside) {
+          continue;
+        }
+        // Everything below a fully contained node is visible; skip the plane tests.
+        if (containment == Containment::Inside && !node.is_leaf()) {
+          if (!visit_subtree(index, visit)) {
+            return;
+          }
+          continue;
+        }
+      } else if (!node_overlaps(node.box, shape)) {
+        continue;
+      }
+
+      if (node.is_leaf()) {
+        const auto& proxy = proxies_[node.proxy];
+        if (node_overlaps(proxy.world_bounds, shape) && !visit(*proxy.object)) {
+          return;
+        }
+        continue;
+      }
+
+      stack.push(node.child1);
+      stack.push(node.child2);
+    }
+  }
+
+  template <typename F>
+  void raycast_proxies(const Ray& ray, F&& visitor) const {
+    if (tree_.root == kNullNode) {
+      return;
+    }
+
+    float max_t = ray.max_distance;
+    TraversalStack stack;
+    stack.push(tree_.root);
+
+    while (!stack.empty()) {
+      const auto& node = tree_.nodes[static_cast<size_t>(stack.pop())];
+      if (!ray.intersect(node.box, max_t)) {
+        continue;
+      }
+
+      if (node.is_leaf()) {
+        const auto& proxy = proxies_[node.proxy];
+        if (ray.intersect(proxy.world_bounds, max_t)) {
+          max_t = visitor(proxy, max_t);
+        }
+        continue;
+      }
+
+      // Push the farther child first so the nearer one is visited next.
+      const auto t1 = ray.intersect(tree_.nodes[static_cast<size_t>(node.child1)].box, max_t);
+      const auto t2 = ray.intersect(tree_.nodes[static_cast<size_t>(node.child2)].box, max_t);
+      if (t1 && t2) {
+        const bool first_nearer = *t1 <= *t2;
+        stack.push(first_nearer ? node.child2 : node.child1);
+        stack.push(first_nearer ? node.child1 : node.child2);
+      } else if (t1) {
+        stack.push(node.child1);
+      } else if (t2) {
+        stack.push(node.child2);
+      }
+    }
+  }
+
+  [[nodiscard]] uint32_t proxy_of(const GameObject& object) const;
+  [[nodiscard]] Aabb fat_box(const Aabb& tight) const noexcept;
+  void mark_moved(uint32_t proxy);
+  void mark_stale(uint32_t proxy);
+  bool refit(uint32_t proxy);
+
+  // Tree maintenance, operating on tree_.
+  int32_t allocate_node();
+  void free_node(int32_t node);
+  void insert_leaf(int32_t leaf);
+  void remove_leaf(int32_t leaf);
+  int32_t balance(int32_t node);
+  void set_internal_box(int32_t node, const Aabb& box);
+
+  // Rebuild.
+  void start_rebuild();
+  void poll_rebuild(bool wait);
+  void adopt_rebuild(RebuildResult result);
+  [[nodiscard]] static RebuildResult build(std::vector<RebuildItem> items);
+
+  SpatialIndexConfig config_;
+  Tree tree_;
+
+  std::vector<Proxy> proxies_;
+  std::vector<uint32_t> free_proxies_;
+  std::unordered_map<const GameObject*, uint32_t> lookup_;
+
+  std::vector<uint32_t> moved_;
+
+  std::future<RebuildResult> rebuild_;
+  std::vector<uint32_t> stale_;
+  std::optional<float> baseline_cost_;  ///< Cost right after the last rebuild; empty until the first one.
+
+  SpatialIndexStats stats_;
+};
+
+}  // namespace kEn
@@ -0,0 +1,261 @@
+#include "triangle_bvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mEn/functions/geometric.hpp>
+#include <mEn/fwd.hpp>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/scene/bounds.hpp>
+
+namespace kEn {
+
+namespace {
+
+/** @brief Number of centroid bins evaluated per axis by the SAH builder. */
+constexpr size_t kSahBins = 16;
+
+/** @brief Depth after which the builder only uses median splits, bounding the tree depth. */
+constexpr size_t kMaxSahDepth = 32;
+
+/** @brief Leaves this small are accepted whenever splitting them does not reduce the SAH cost. */
+constexpr uint32_t kMaxSahLeafTriangles = 16;
+
+/** @brief Möller-Trumbore intersection; two-sided. */
+std::optional<TriangleHit> intersect_triangle(const Ray& ray, const mEn::Vec3& a, const mEn::Vec3& b,
+                                              const mEn::Vec3& c, float max_t) {
+  constexpr float kDetEpsilon = 1e-12F;
+
+  const mEn::Vec3 e1 = b - a;
+  const mEn::Vec3 e2 = c - a;
+  const mEn::Vec3 p  = mEn::cross(ray.direction, e2);
+  const float det    = mEn::dot(e1, p);
+  if (std::abs(det) < kDetEpsilon) {
+    return std::nullopt;
+  }
+
+  const float inv_det = 1.F / det;
+  const mEn::Vec3 s   = ray.origin - a;
+  const float u       = mEn::dot(s, p) * inv_det;
+  if (u < 0.F || u > 1.F) {
+    return std::nullopt;
+  }
+
+  const mEn::Vec3 q = mEn::cross(s, e1);
+  const float v     = mEn::dot(ray.direction, q) * inv_det;
+  if (v < 0.F || u + v > 1.F) {
+    return std::nullopt;
+  }
+
+  const float t = mEn::dot(e2, q) * inv_det;
+  if (t < 0.F || t > max_t) {
+    return std::nullopt;
+  }
+
+  return TriangleHit{.triangle = 0, .distance = t, .u = u, .v = v};
+}
+
+}  // namespace
+
+TriangleBvh::TriangleBvh(std::vector<mEn::Vec3> positions, std::vector<uint32_t> indices, std::string debug_name)
+    : positions_(std::move(positions)),
+      indices_(std::move(indices)),
+      memory_(MemoryCategory::TriangleBvh, std::move(debug_name),
+              positions_.capacity() * sizeof(mEn::Vec3) + indices_.capacity() * sizeof(uint32_t)) {
+  KEN_CORE_ASSERT(indices_.size() % 3 == 0, "TriangleBvh requires a triangle list");
+}
+
+void TriangleBvh::build() const {
+  std::call_once(built_, [this] { build_nodes(); });
+}
+
+void TriangleBvh::build_nodes() const {
+  const size_t count = triangle_count();
+  order_.resize(count);
+  std::iota(order_.begin(), order_.end(), 0U);
+  if (count == 0) {
+    return;
+  }
+
+  std::vector<Aabb> boxes(count);
+  std::vector<mEn::Vec3> centroids(count);
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      boxes[i].expand(positions_[indices_[(3 * i) + k]]);
+    }
+    centroids[i] = boxes[i].center();
+  }
+
+  struct Task {
+    uint32_t node;
+    size_t depth;
+  };
+
+  nodes_.clear();
+  nodes_.push_back({.box = {}, .first = 0, .count = static_cast<uint32_t>(count)});
+  std::vector<Task> tasks{{.node = 0, .depth = 0}};
+
+  while (!tasks.empty()) {
+    const auto [node_index, depth] = tasks.back();
+    tasks.pop_back();
+
+    const uint32_t first = nodes_[node_index].first;
+    const uint32_t n     = nodes_[node_index].count;
+    const auto begin     = order_.begin() + first;
+    const auto end       = begin + n;
+
+    Aabb box;
+    Aabb centroid_bounds;
+    for (auto it = begin; it != end; ++it) {
+      box = box.merged(boxes[*it]);
+      centroid_bounds.expand(centroids[*it]);
+    }
+    nodes_[node_index].box = box;
+
+    // The deepest nodes the traversal stack allows become leaves, however many triangles they keep.
+    if (n <= kMaxLeafTriangles || depth + 1 >= kMaxDepth) {
+      continue;
+    }
+
+    const mEn::Vec3 extent = centroid_bounds.max - centroid_bounds.min;
+    auto middle            = begin;
+
+    if (depth < kMaxSahDepth) {
+      float best_cost   = static_cast<float>(n - 1) * box.surface_area();
+      size_t best_axis  = 0;
+      size_t best_split = 0;
+      const auto bin_of = [&](uint32_t tri, size_t axis) {
+        const float offset = (centroids[tri][axis] - centroid_bounds.min[axis]) / extent[axis];
+        return std::min(kSahBins - 1, static_cast<size_t>(offset * static_cast<float>(kSahBins)));
+      };
+
+      for (size_t axis = 0; axis < 3; ++axis) {
+        if (extent[axis] <= 0.F) {
+          continue;
+        }
+
+        std::array<Aabb, kSahBins> bin_boxes{};
+        std::array<uint32_t, kSahBins> bin_counts{};
+        for (auto it = begin; it != end; ++it) {
+          const size_t bin = bin_of(*it, axis);
+          bin_boxes[bin]   = bin_boxes[bin].merged(boxes[*it]);
+          ++bin_counts[bin];
+        }
+
+        std::array<float, kSahBins> right_cost{};
+        Aabb right_box;
+        uint32_t right_count = 0;
+        for (size_t bin = kSahBins - 1; bin > 0; --bin) {
+          right_box = right_box.merged(bin_boxes[bin]);
+          right_count += bin_counts[bin];
+          right_cost[bin] = static_cast<float>(right_count) * right_box.surface_area();
+        }
+
+        Aabb left_box;
+        uint32_t left_count = 0;
+        for (size_t split = 1; split < kSahBins; ++split) {
+          left_box = left_box.merged(bin_boxes[split - 1]);
+          left_count += bin_counts[split - 1];
+          if (left_count == 0 || left_count == n) {
+            continue;
+          }
+
+          const float cost = static_cast<float>(left_count) * left_box.surface_area() + right_cost[split];
+          if (cost < best_cost) {
+            best_cost  = cost;
+            best_axis  = axis;
+            best_split = split;
+          }
+        }
+      }
+
+      if (best_split != 0) {
+        middle = std::partition(begin, end, [&](uint32_t tri) { return bin_of(tri, best_axis) < best_split; });
+      } else if (n <= kMaxSahLeafTriangles) {
+        continue;  // Splitting does not pay off.
+      }
+    }
+
+    if (middle == begin || middle == end) {
+      const size_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+      middle            = begin + (n / 2);
+      std::nth_element(begin, middle, end,
+                       [&](uint32_t lhs, uint32_t rhs) { return centroids[lhs][axis] < centroids[rhs][axis]; });
+    }
+
+    const auto left_count = static_cast<uint32_t>(middle - begin);
+    const auto left       = static_cast<uint32_t>(nodes_.size());
+    nodes_.push_back({.box = {}, .first = first, .count = left_count});
+    nodes_.push_back({.box = {}, .first = first + left_count, .count = n - left_count});
+    nodes_[node_index].first = left;
+    nodes_[node_index].count = 0;
+
+    tasks.push_back({.node = left + 1, .depth = depth + 1});
+    tasks.push_back({.node = left, .depth = depth + 1});
+  }
+
+  memory_.resize(positions_.capacity() * sizeof(mEn::Vec3) + indices_.capacity() * sizeof(uint32_t) +
+                 nodes_.capacity() * sizeof(Node) + order_.capacity() * sizeof(uint32_t));
+}
+
+std::optional<TriangleHit> TriangleBvh::raycast(const Ray& ray, float max_t) const {
+  build();
+  if (nodes_.empty()) {
+    return std::nullopt;
+  }
+
+  std::optional<TriangleHit> best;
+  float best_t = max_t;
+
+  std::array<uint32_t, kMaxDepth> stack{};
+  size_t top = 0;
+  if (ray.intersect(nodes_[0].box, best_t)) {
+    stack[top++] = 0;
+  }
+
+  while (top > 0) {
+    const auto& node = nodes_[stack[--top]];
+
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        const uint32_t tri = order_[i];
+        const auto hit     = intersect_triangle(ray, positions_[indices_[3 * tri]], positions_[indices_[(3 * tri) + 1]],
+                                                positions_[indices_[(3 * tri) + 2]], best_t);
+        if (hit) {
+          best           = *hit;
+          best->triangle = tri;
+          best_t         = hit->distance;
+        }
+      }
+      continue;
+    }
+
+    // Children are re-tested against the current best distance; push the farther one first.
+    const auto t_left  = ray.intersect(nodes_[node.first].box, best_t);
+    const auto t_right = ray.intersect(nodes_[node.first + 1].box, best_t);
+    KEN_CORE_ASSERT(top + 2 <= kMaxDepth, "TriangleBvh traversal stack overflow");
+    if (t_left && t_right) {
+      const bool left_nearer = *t_left <= *t_right;
+      stack[top++]           = left_nearer ? node.first + 1 : node.first;
+      stack[top++]           = left_nearer ? node.first : node.first + 1;
+    } else if (t_left) {
+      stack[top++] = node.first;
+    } else if (t_right) {
+      stack[top++] = node.first + 1;
+    }
+  }
+
+  return best;
+}
+
+}  // namespace kEn
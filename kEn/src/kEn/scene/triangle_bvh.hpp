@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <mEn/fwd.hpp>
+#include <mEn/vec3.hpp>
+
+#include <kEn/core/core.hpp>
+#include <kEn/core/memory_tracker.hpp>
+#include <kEn/scene/bounds.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+/** @brief Result of a ray-triangle query. */
+struct TriangleHit {
+  uint32_t triangle = 0;  ///< Index of the triangle, i.e. its first index is @c 3 * triangle.
+  float distance    = 0.F;
+  float u           = 0.F;  ///< Barycentric weight of the second vertex.
+  float v           = 0.F;  ///< Barycentric weight of the third vertex.
+};
+
+/**
+ * @brief Static bounding volume hierarchy over the triangles of one mesh.
+ *
+ * Keeps a CPU copy of the positions and the index list, and builds a binned-SAH
+ * tree over them the first time it is queried (or when build() is called).
+ * The build is thread-safe; queries are const and may run concurrently once
+ * the tree exists.
+ *
+ * All queries are in the mesh's object space.
+ */
+class TriangleBvh {
+ public:
+  /**
+   * @param positions Vertex positions.
+   * @param indices   Triangle list; must be a multiple of three.
+   * @param debug_name Name under which the tree's memory is tracked, see @ref MemoryTracker.
+   */
+  TriangleBvh(std::vector<mEn::Vec3> positions, std::vector<uint32_t> indices, std::string debug_name = {});
+
+  DELETE_COPY_MOVE(TriangleBvh);
+
+  /** @brief Builds the tree now instead of on the first query.  No-op if already built. */
+  void build() const;
+
+  /**
+   * @brief Finds the closest triangle hit by @p ray closer than @p max_t.
+   *
+   * Triangles are two-sided.  The returned distance is in units of the ray
+   * parameter, so it is preserved when the ray was transformed from world space
+   * without renormalizing its direction.
+   */
+  [[nodiscard]] std::optional<TriangleHit> raycast(const Ray& ray, float max_t) const;
+
+  /** @brief Returns the number of triangles. */
+  [[nodiscard]] size_t triangle_count() const noexcept { return indices_.size() / 3; }
+
+  /** @brief Returns the positions the tree was built from. */
+  [[nodiscard]] std::span<const mEn::Vec3> positions() const noexcept { return positions_; }
+  /** @brief Returns the triangle list the tree was built from. */
+  [[nodiscard]] std::span<const uint32_t> indices() const noexcept { return indices_; }
+
+ private:
+  static constexpr uint32_t kMaxLeafTriangles = 4;
+  /** @brief Nodes on the traversal stack at most; the builder keeps the tree shallower than this. */
+  static constexpr size_t kMaxDepth = 64;
+
+  struct Node {
+    Aabb box;
+    uint32_t first = 0;  ///< First child for interior nodes (siblings are adjacent), first entry of order_ for leaves.
+    uint32_t count = 0;  ///< Number of triangles; zero for interior nodes.
+  };
+
+  void build_nodes() const;
+
+  std::vector<mEn::Vec3> positions_;
+  std::vector<uint32_t> indices_;
+
+  mutable std::once_flag built_;
+  mutable std::vector<Node> nodes_;
+  mutable std::vector<uint32_t> order_;  ///< Triangle indices, permuted so every leaf covers a contiguous range.
+  mutable TrackedMemory memory_;         ///< Capacity of all four vectors.
+};
+
+}  // namespace kEn
@@ -0,0 +1,195 @@
+#include "update_scheduler.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include <mEn/functions/geometric.hpp>
+#include <mEn/vec3.hpp>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/core/timestep.hpp>
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/component.hpp>
+#include <kEn/scene/game_object.hpp>
+
+namespace kEn {
+
+UpdateScheduler::~UpdateScheduler() {
+  for (auto& entry : entries_) {
+    if (entry.component != nullptr) {
+      remove(*entry.component);
+    }
+  }
+}
+
+void UpdateScheduler::add(GameObject& object, bool recursive) {
+  for (const auto& component : object.components_) {
+    add(*component);
+  }
+
+  if (recursive) {
+    for (auto* child : object.children_) {
+      add(*child, true);
+    }
+  }
+}
+
+void UpdateScheduler::add(GameComponent& component) {
+  if (component.scheduler_ == this) {
+    return;
+  }
+  KEN_CORE_ASSERT(component.scheduler_ == nullptr, "Component is already registered with another scheduler");
+
+  std::uint32_t index = 0;
+  if (free_entries_.empty()) {
+    index = static_cast<std::uint32_t>(entries_.size());
+    entries_.emplace_back();
+  } else {
+    index = free_entries_.back();
+    free_entries_.pop_back();
+  }
+
+  auto& entry       = entries_[index];
+  entry.component   = &component;
+  entry.state       = State::Awake;
+  entry.last_update = std::nullopt;
+  ++entry.generation;
+
+  component.scheduler_     = this;
+  component.schedule_slot_ = index;
+  ++stats_.registered;
+
+  apply_policy(index);
+  schedule(index, tick_ + 1);
+}
+
+void UpdateScheduler::remove(GameComponent& component) {
+  if (component.scheduler_ != this) {
+    return;
+  }
+
+  if (component.has_parent()) {
+    component.transform().unsubscribe_on_changed(&component);
+  }
+
+  const std::uint32_t index = component.schedule_slot_;
+  auto& entry               = entries_[index];
+  if (entry.state == State::Sleeping) {
+    --stats_.sleeping;
+  }
+  entry.component = nullptr;
+  entry.state     = State::Free;
+  ++entry.generation;
+  free_entries_.push_back(index);
+
+  component.scheduler_ = nullptr;
+  --stats_.registered;
+}
+
+void UpdateScheduler::update(Timestep delta, Timestep time) {
+  time_ = time.duration();
+
+  while (!timers_.empty() && timers_.top().wake_time <= time_) {
+    const Timer timer = timers_.top();
+    timers_.pop();
+    if (entries_[timer.entry].generation == timer.generation) {
+      wake(timer.entry);
+    }
+  }
+
+  ++tick_;
+  stats_.updated   = 0;
+  stats_.throttled = 0;
+
+  // Components updated below may reschedule into the bucket being processed, so drain a copy.
+  due_.swap(wheel_[tick_ % kMaxInterval]);
+  for (const auto slot : due_) {
+    auto& entry = entries_[slot.entry];
+    if (entry.generation != slot.generation || entry.state != State::Awake || entry.due_tick != tick_) {
+      continue;
+    }
+
+    const Timestep elapsed = entry.last_update ? Timestep(time_ - *entry.last_update) : delta;
+    entry.last_update      = time_;
+
+    GameComponent& component = *entry.component;
+    component.update(elapsed, time);
+    ++stats_.updated;
+
+    // The update may have put the component to sleep, removed it, or registered others (reallocating entries_).
+    const auto& after = entries_[slot.entry];
+    if (after.generation == slot.generation && after.state == State::Awake) {
+      const std::uint32_t interval = interval_of(component);
+      if (interval > 1) {
+        ++stats_.throttled;
+      }
+      schedule(slot.entry, tick_ + interval);
+    }
+  }
+  due_.clear();
+}
+
+void UpdateScheduler::wake(std::uint32_t entry) {
+  auto& e = entries_[entry];
+  if (e.state != State::Sleeping) {
+    return;
+  }
+
+  e.state = State::Awake;
+  ++e.generation;
+  --stats_.sleeping;
+  schedule(entry, tick_ + 1);
+}
+
+void UpdateScheduler::sleep(std::uint32_t entry, std::optional<Timestep> duration) {
+  auto& e = entries_[entry];
+  if (e.state == State::Awake) {
+    e.state = State::Sleeping;
+    ++stats_.sleeping;
+  }
+
+  // Invalidates the queued wheel slot and any earlier timer.
+  ++e.generation;
+  if (duration) {
+    timers_.push({.wake_time = time_ + duration->duration(), .entry = entry, .generation = e.generation});
+  }
+}
+
+void UpdateScheduler::apply_policy(std::uint32_t entry) {
+  GameComponent& component = *entries_[entry].component;
+  if (!component.has_parent()) {
+    return;
+  }
+
+  if (component.update_policy_.wake_on_transform_change) {
+    component.transform().subscribe_on_changed(&component, [&component] { component.wake(); });
+  } else {
+    component.transform().unsubscribe_on_changed(&component);
+  }
+}
+
+void UpdateScheduler::schedule(std::uint32_t entry, std::uint64_t tick) {
+  auto& e    = entries_[entry];
+  e.due_tick = tick;
+  wheel_[tick % kMaxInterval].push_back({.entry = entry, .generation = e.generation});
+}
+
+std::uint32_t UpdateScheduler::interval_of(const GameComponent& component) const {
+  const auto& throttle = component.update_policy_.throttle;
+  if (throttle.interval <= 1 || !component.has_parent()) {
+    return 1;
+  }
+
+  const mEn::Vec3 position = component.transform().world_pos();
+  const bool far           = mEn::distance(position, focus_) > throttle.distance;
+  const bool hidden        = throttle.when_not_visible && !views_.empty() &&
+                      std::ranges::none_of(views_, [&](const Frustum& view) {
+                        return view.overlaps(Sphere{.center = position, .radius = throttle.radius});
+                      });
+
+  return far || hidden ? std::min(throttle.interval, kMaxInterval) : 1;
+}
+
+}  // namespace kEn
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <span>
+#include <vector>
+
+#include <mEn/vec3.hpp>
+
+#include <kEn/core/core.hpp>
+#include <kEn/core/timestep.hpp>
+#include <kEn/scene/bounds.hpp>
+
+/** @file
+ *  @ingroup ken
+ */
+
+namespace kEn {
+
+class GameComponent;
+class GameObject;
+
+/**
+ * @brief Reduced update rate for components that are far away or not visible.
+ *
+ * A throttled component is updated every @ref interval ticks instead of every
+ * tick.  It is throttled while it is farther than @ref distance from the
+ * scheduler's focus point, or, with @ref when_not_visible, while a sphere of
+ * @ref radius around its object lies outside every view.
+ */
+struct UpdateThrottle {
+  std::uint32_t interval = 1;  ///< Update every N ticks while throttled; 1 disables throttling.
+  float distance         = std::numeric_limits<float>::infinity();
+  bool when_not_visible  = false;
+  float radius           = 0.F;  ///< Radius around the object's world position used for the view test.
+};
+
+/** @brief Scheduling hints a component gives to an @ref UpdateScheduler. */
+struct UpdatePolicy {
+  UpdateThrottle throttle;
+  bool wake_on_event            = false;  ///< Wake when an event reaches one of the component's subscribers.
+  bool wake_on_transform_change = false;  ///< Wake when the owning object's transform changes.
+};
+
+/** @brief Counters of an @ref UpdateScheduler. */
+struct UpdateSchedulerStats {
+  std::size_t registered = 0;
+  std::size_t sleeping   = 0;
+  std::size_t updated    = 0;  ///< Components updated by the last tick.
+  std::size_t throttled  = 0;  ///< Components rescheduled at a reduced rate by the last tick.
+};
+
+/**
+ * @brief Drives @ref GameComponent::update for registered components at per-component rates.
+ *
+ * Awake components are kept in a timing wheel with one bucket per tick, so a
+ * tick only touches the components that are due; sleeping components are not
+ * touched at all until they are woken by @ref GameComponent::wake, a timer, an
+ * event or a transform change (see @ref UpdatePolicy).  The per-tick cost
+ * therefore scales with the number of active components, not registered ones.
+ *
+ * Every update receives the time since that component's previous update, so
+ * throttled and sleeping components see the correct accumulated delta.  The
+ * throttle of a component is re-evaluated each time it is updated.
+ *
+ * Registered components are skipped by @ref GameObject::update; the scheduler
+ * is their only driver.  Components unregister themselves when detached.
+ */
+class UpdateScheduler {
+ public:
+  /** @brief Longest supported throttle interval, in ticks; longer ones are clamped. */
+  static constexpr std::uint32_t kMaxInterval = 64;
+
+  UpdateScheduler() = default;
+  ~UpdateScheduler();
+
+  DELETE_COPY_MOVE(UpdateScheduler);
+
+  /** @brief Registers every component of @p object, and of its descendants when @p recursive. */
+  void add(GameObject& object, bool recursive = true);
+  /** @brief Registers @p component; it is updated on the next tick.  No-op if already registered here. */
+  void add(GameComponent& component);
+  /** @brief Unregisters @p component.  No-op if it is not registered here. */
+  void remove(GameComponent& component);
+
+  /**
+   * @brief Runs one tick: fires due sleep timers, then updates every component due this tick.
+   *
+   * @param delta Length of the tick; passed to components updated for the first time.
+   * @param time  Total elapsed simulation time.
+   */
+  void update(Timestep delta, Timestep time);
+
+  /** @brief Sets the point distance throttling is measured from, typically the camera position. */
+  void set_focus(const mEn::Vec3& position) noexcept { focus_ = position; }
+  /** @brief Sets the views used by UpdateThrottle::when_not_visible; with no views everything counts as visible. */
+  void set_views(std::span<const Frustum> views) { views_.assign(views.begin(), views.end()); }
+
+  /** @brief Returns the counters; @c updated and @c throttled describe the last tick. */
+  [[nodiscard]] const UpdateSchedulerStats& stats() const noexcept { return stats_; }
+
+ private:
+  enum class State : std::uint8_t { Free, Awake, Sleeping };
+
+  struct Entry {
+    GameComponent* component = nullptr;
+    State state              = State::Free;
+    std::uint32_t generation = 0;  ///< Bumped whenever queued wheel slots and timers of this entry become stale.
+    std::uint64_t due_tick   = 0;
+    std::optional<duration_t> last_update;
+  };
+
+  struct Slot {
+    std::uint32_t entry;
+    std::uint32_t generation;
+  };
+
+  struct Timer {
+    duration_t wake_time;
+    std::uint32_t entry;
+    std::uint32_t generation;
+
+    bool operator>(const Timer& other) const noexcept { return wake_time > other.wake_time; }
+  };
+
+  void wake(std::uint32_t entry);
+  void sleep(std::uint32_t entry, std::optional<Timestep> duration);
+  void apply_policy(std::uint32_t entry);
+  void schedule(std::uint32_t entry, std::uint64_t tick);
+  [[nodiscard]] std::uint32_t interval_of(const GameComponent& component) const;
+
+  std::vector<Entry> entries_;
+  std::vector<std::uint32_t> free_entries_;
+
+  std::array<std::vector<Slot>, kMaxInterval> wheel_;
+  std::vector<Slot> due_;
+  std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers_;
+
+  std::uint64_t tick_ = 0;
+  duration_t time_{};
+
+  mEn::Vec3 focus_{0.F};
+  std::vector<Frustum> views_;
+
+  UpdateSchedulerStats stats_;
+
+  friend GameComponent;
+};
+
+}  // namespace kEn
@@ -0,0 +1,111 @@
+#include "null_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/renderer/buffer.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+NullBuffer::NullBuffer(const BufferDesc& desc, const void* data, NullCommandStream& stream)
+    : desc_(desc),
+      handle_(stream.next_handle()),
+      stream_(&stream),
+      memory_(MemoryCategory::Buffer, desc_.debug_name, desc_.size) {
+  allocate(data);
+}
+
+void NullBuffer::allocate(const void* data) {
+  storage_.assign(desc_.size, std::byte{0});
+  if (data != nullptr && desc_.size != 0) {
+    std::memcpy(storage_.data(), data, desc_.size);
+  }
+}
+
+// ---------------- //
+
+NullMutableBuffer::NullMutableBuffer(std::shared_ptr<NullBuffer> buffer) : buffer_(std::move(buffer)) {
+  KEN_CORE_ASSERT(buffer_ != nullptr, "NullMutableBuffer requires a valid buffer");
+  KEN_CORE_ASSERT(buffer_->desc_.usage != BufferUsage::Immutable, "NullMutableBuffer requires mutable buffer");
+}
+
+bool NullMutableBuffer::can_map(MapMode mode) const {
+  switch (buffer_->desc_.usage) {
+    case BufferUsage::Immutable:
+    case BufferUsage::Default:
+      return false;
+    case BufferUsage::Dynamic:
+      return mode != MapMode::Read && mode != MapMode::ReadWrite;
+    case BufferUsage::Staging:
+      return true;
+  }
+
+  KEN_UNREACHABLE();
+}
+
+MappedBuffer NullMutableBuffer::map(MapMode mode) const {
+  KEN_CORE_ASSERT(can_map(mode), "Requested map mode is incompatible with buffer usage");
+
+  auto* buffer = buffer_.get();
+  return MappedBuffer(buffer->storage_, [buffer]() {
+    buffer->stream_->record({.type = NullCommandType::UpdateBuffer, .object = buffer->handle_},
+                            std::as_bytes(std::span(buffer->storage_)));
+  });
+}
+
+void NullMutableBuffer::set_data(const void* data, std::size_t size) {
+  if (size != buffer_->size()) {
+    resize(size, data);
+    return;
+  }
+
+  update_data(0, data, size);
+}
+
+void NullMutableBuffer::update_data(std::size_t offset, const void* data, std::size_t size) {
+  KEN_CORE_ASSERT(offset + size <= buffer_->size(), "Buffer update range is out of bounds");
+
+  if (size == 0) {
+    return;
+  }
+
+  const std::span bytes(static_cast<const std::byte*>(data), size);
+  std::ranges::copy(bytes, buffer_->storage_.begin() + static_cast<std::ptrdiff_t>(offset));
+  buffer_->stream_->record(
+      {.type = NullCommandType::UpdateBuffer, .object = buffer_->handle_, .args = {0, 0, offset}}, bytes);
+}
+
+void NullMutableBuffer::resize(std::size_t size, const void* data) {
+  buffer_->desc_.size = size;
+  buffer_->memory_.resize(size);
+  buffer_->allocate(data);
+  if (data != nullptr) {
+    buffer_->stream_->record({.type = NullCommandType::UpdateBuffer, .object = buffer_->handle_},
+                             std::as_bytes(std::span(buffer_->storage_)));
+  }
+}
+
+// ---------------- //
+
+NullUniformBuffer::NullUniformBuffer(std::shared_ptr<NullBuffer> buffer) : buffer_(std::move(buffer)) {
+  KEN_CORE_ASSERT(buffer_ != nullptr, "NullUniformBuffer requires a valid buffer");
+  KEN_CORE_ASSERT(buffer_->desc().bind_flags.test(BufferBind::Uniform),
+                  "Underlying buffer is not marked for uniform binding");
+}
+
+// ---------------- //
+
+NullShaderStorageBuffer::NullShaderStorageBuffer(std::shared_ptr<NullBuffer> buffer) : buffer_(std::move(buffer)) {
+  KEN_CORE_ASSERT(buffer_ != nullptr, "NullShaderStorageBuffer requires a valid buffer");
+  KEN_CORE_ASSERT(buffer_->desc().bind_flags.test(BufferBind::Storage),
+                  "Underlying buffer is not marked for storage binding");
+}
+
+}  // namespace kEn
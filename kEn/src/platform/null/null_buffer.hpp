@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <kEn/core/memory_tracker.hpp>
+#include <kEn/renderer/buffer.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+/**
+ * @brief Null implementation of Buffer.
+ *
+ * Keeps its contents in system memory so that mapping works as on a GPU
+ * backend.  Exposed to NullMutableBuffer via friendship for uploads and
+ * resizing.
+ */
+class NullBuffer final : public Buffer {
+ public:
+  NullBuffer(const BufferDesc& desc, const void* data, NullCommandStream& stream);
+
+  [[nodiscard]] const BufferDesc& desc() const override { return desc_; }
+  [[nodiscard]] std::uintptr_t native_handle() const noexcept override { return handle_; }
+
+ private:
+  void allocate(const void* data);
+
+  BufferDesc desc_{};
+  std::uintptr_t handle_;
+  std::vector<std::byte> storage_;
+  NullCommandStream* stream_;
+  TrackedMemory memory_;
+
+  friend class NullMutableBuffer;
+};
+
+/**
+ * @brief Null implementation of MutableBuffer.
+ *
+ * Every upload is copied into the buffer and recorded, with its data, as an
+ * @c UpdateBuffer command.  Map mode checks match the OpenGL backend.
+ */
+class NullMutableBuffer final : public MutableBuffer {
+ public:
+  explicit NullMutableBuffer(std::shared_ptr<NullBuffer> buffer);
+
+  [[nodiscard]] MappedBuffer map(MapMode mode) const override;
+  void set_data(const void* data, std::size_t size) override;
+  void update_data(std::size_t offset, const void* data, std::size_t size) override;
+  void resize(std::size_t size, const void* data) override;
+  [[nodiscard]] std::shared_ptr<Buffer> underlying_buffer() const override { return buffer_; }
+
+ private:
+  [[nodiscard]] bool can_map(MapMode mode) const;
+
+  std::shared_ptr<NullBuffer> buffer_;
+};
+
+class NullUniformBuffer final : public UniformBuffer {
+ public:
+  explicit NullUniformBuffer(std::shared_ptr<NullBuffer> buffer);
+
+  [[nodiscard]] std::shared_ptr<Buffer> underlying_buffer() const override {
+    return std::static_pointer_cast<Buffer>(buffer_);
+  }
+
+ private:
+  std::shared_ptr<NullBuffer> buffer_;
+};
+
+class NullShaderStorageBuffer final : public ShaderStorageBuffer {
+ public:
+  explicit NullShaderStorageBuffer(std::shared_ptr<NullBuffer> buffer);
+
+  [[nodiscard]] std::shared_ptr<Buffer> underlying_buffer() const override {
+    return std::static_pointer_cast<Buffer>(buffer_);
+  }
+
+ private:
+  std::shared_ptr<NullBuffer> buffer_;
+};
+
+}  // namespace kEn
@@ -0,0 +1,62 @@
+#include "null_command_stream.hpp"
+
+#include <cstddef>
+#include <span>
+#include <utility>
+
+namespace kEn {
+
+namespace {
+
+void accumulate(NullFrameStats& total, const NullFrameStats& frame) {
+  total.commands += frame.commands;
+  total.draw_calls += frame.draw_calls;
+  total.elements += frame.elements;
+  total.payload_bytes += frame.payload_bytes;
+  for (std::size_t i = 0; i < total.counts.size(); ++i) {
+    total.counts[i] += frame.counts[i];
+  }
+}
+
+}  // namespace
+
+void NullCommandStream::record(const NullCommand& command) {
+  commands_.push_back(command);
+  count(command, 0);
+}
+
+void NullCommandStream::record(NullCommand command, std::span<const std::byte> payload) {
+  command.args[0] = payload_.size();
+  command.args[1] = payload.size();
+  payload_.insert(payload_.end(), payload.begin(), payload.end());
+
+  commands_.push_back(command);
+  count(command, payload.size());
+}
+
+void NullCommandStream::end_frame() {
+  std::swap(commands_, last_frame_);
+  std::swap(payload_, last_payload_);
+  commands_.clear();
+  payload_.clear();
+  memory_.resize((commands_.capacity() + last_frame_.capacity()) * sizeof(NullCommand) + payload_.capacity() +
+                 last_payload_.capacity());
+
+  last_stats_ = std::exchange(stats_, {});
+  accumulate(total_stats_, last_stats_);
+  ++frame_count_;
+}
+
+void NullCommandStream::count(const NullCommand& command, std::size_t payload_size) {
+  ++stats_.commands;
+  ++stats_.counts[std::to_underlying(command.type)];
+  stats_.payload_bytes += payload_size;
+
+  if (command.type == NullCommandType::Draw || command.type == NullCommandType::DrawIndexed) {
+    // args: element count, instance count, first element, base vertex / first instance
+    ++stats_.draw_calls;
+    stats_.elements += command.args[0] * command.args[1];
+  }
+}
+
+}  // namespace kEn
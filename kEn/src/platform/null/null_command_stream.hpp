@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <kEn/core/memory_tracker.hpp>
+
+namespace kEn {
+
+/** @brief Kind of a command recorded by the null backend. */
+enum class NullCommandType : std::uint8_t {
+  SetClearColor,
+  SetClearDepth,
+  Clear,
+  SetViewport,
+  SetScissorRect,
+  SetDepthState,
+  SetBlendState,
+  SetRasterState,
+  SetShader,
+  SetVertexInput,
+  BindTexture,
+  BindAttachment,
+  BindUniformBuffer,
+  BindStorageBuffer,
+  SetRenderTarget,
+  BindDefaultFramebuffer,
+  Draw,
+  DrawIndexed,
+  SetPatchVertices,
+  SetUniform,
+  SetUniformArray,
+  BindUniformBlock,
+  UpdateBuffer,
+  UpdateTexture,
+  ClearAttachment,
+  BeginGpuScope,
+  EndGpuScope,
+  Count,
+};
+
+/**
+ * @brief One recorded command.
+ *
+ * @c object is the native handle of the resource the command refers to.  The
+ * meaning of @c slot and @c args depends on the type (binding slot, uniform
+ * location, clear mask, render mode; counts, offsets, rectangles).  Commands
+ * that carry data (uniform values, buffer and texture uploads) copy it into
+ * the stream's payload and store its offset and size in @c args[0] and
+ * @c args[1].
+ */
+struct NullCommand {
+  NullCommandType type;
+  std::uint32_t slot    = 0;
+  std::uintptr_t object = 0;
+  std::array<std::uint64_t, 4> args{};
+};
+
+/** @brief Totals over the commands of one frame. */
+struct NullFrameStats {
+  std::size_t commands      = 0;
+  std::size_t draw_calls    = 0;
+  std::size_t elements      = 0; /**< Vertices or indices submitted, times instances. */
+  std::size_t payload_bytes = 0;
+  std::array<std::size_t, std::to_underlying(NullCommandType::Count)> counts{}; /**< Indexed by command type. */
+
+  /** @brief Number of commands of type @p type. */
+  [[nodiscard]] std::size_t count(NullCommandType type) const { return counts[std::to_underlying(type)]; }
+};
+
+/**
+ * @brief In-memory command stream shared by all objects of a null device.
+ *
+ * Commands of the current frame are appended until @ref end_frame(), which
+ * keeps them available as the last frame and starts a new one, reusing the
+ * allocations.  Nothing is ever executed.
+ */
+class NullCommandStream {
+ public:
+  /** @brief Append @p command without payload. */
+  void record(const NullCommand& command);
+
+  /** @brief Append @p command and copy @p payload into the stream. */
+  void record(NullCommand command, std::span<const std::byte> payload);
+
+  /** @brief Finish the current frame. */
+  void end_frame();
+
+  /** @brief Returns a fresh native handle for a new resource; never 0. */
+  [[nodiscard]] std::uintptr_t next_handle() { return ++last_handle_; }
+
+  /** @brief Commands of the last finished frame. */
+  [[nodiscard]] std::span<const NullCommand> last_frame() const { return last_frame_; }
+  /** @brief Payload bytes referenced by @ref last_frame(). */
+  [[nodiscard]] std::span<const std::byte> last_frame_payload() const { return last_payload_; }
+  /** @brief Totals of the last finished frame. */
+  [[nodiscard]] const NullFrameStats& last_frame_stats() const { return last_stats_; }
+
+  /** @brief Totals over every finished frame. */
+  [[nodiscard]] const NullFrameStats& total_stats() const { return total_stats_; }
+  /** @brief Number of finished frames. */
+  [[nodiscard]] std::size_t frame_count() const { return frame_count_; }
+
+ private:
+  void count(const NullCommand& command, std::size_t payload_size);
+
+  std::vector<NullCommand> commands_;
+  std::vector<std::byte> payload_;
+  NullFrameStats stats_;
+
+  std::vector<NullCommand> last_frame_;
+  std::vector<std::byte> last_payload_;
+  NullFrameStats last_stats_;
+
+  NullFrameStats total_stats_;
+  std::size_t frame_count_    = 0;
+  std::uintptr_t last_handle_ = 0;
+
+  TrackedMemory memory_{MemoryCategory::CommandStream, "Frames", 0}; /**< Capacity of both frames, as of end_frame(). */
+};
+
+}  // namespace kEn
@@ -0,0 +1,105 @@
+#include "null_device.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include <kEn/core/log.hpp>
+#include <kEn/imgui/imgui_backend.hpp>
+#include <kEn/renderer/buffer.hpp>
+#include <kEn/renderer/framebuffer.hpp>
+#include <kEn/renderer/render_state.hpp>
+#include <kEn/renderer/shader.hpp>
+#include <kEn/renderer/texture.hpp>
+#include <kEn/renderer/texture_format.hpp>
+#include <kEn/renderer/vertex_input.hpp>
+
+#include "null_buffer.hpp"
+#include "null_framebuffer.hpp"
+#include "null_imgui_backend.hpp"
+#include "null_shader.hpp"
+#include "null_state.hpp"
+#include "null_texture.hpp"
+#include "null_vertex_input.hpp"
+
+namespace kEn {
+
+NullDevice::NullDevice() { render_context_.init(false); }
+
+NullDevice::~NullDevice() {
+  const NullFrameStats& total = stream_.total_stats();
+  KEN_CORE_INFO("Null device recorded {} frames: {} commands, {} draw calls, {} elements, {} payload bytes",
+                stream_.frame_count(), total.commands, total.draw_calls, total.elements, total.payload_bytes);
+}
+
+std::shared_ptr<Buffer> NullDevice::create_buffer(const BufferDesc& desc, const void* data) {
+  return std::make_shared<NullBuffer>(desc, data, stream_);
+}
+
+std::shared_ptr<MutableBuffer> NullDevice::create_mutable_buffer(const BufferDesc& desc, const void* data) {
+  return std::make_shared<NullMutableBuffer>(std::make_shared<NullBuffer>(desc, data, stream_));
+}
+
+std::shared_ptr<UniformBuffer> NullDevice::create_uniform_buffer(std::shared_ptr<Buffer> buffer) {
+  return std::make_shared<NullUniformBuffer>(std::dynamic_pointer_cast<NullBuffer>(std::move(buffer)));
+}
+
+std::shared_ptr<ShaderStorageBuffer> NullDevice::create_shader_storage_buffer(std::shared_ptr<Buffer> buffer) {
+  return std::make_shared<NullShaderStorageBuffer>(std::dynamic_pointer_cast<NullBuffer>(std::move(buffer)));
+}
+
+std::shared_ptr<Shader> NullDevice::create_shader(std::string_view name, std::string_view /*vertex_src*/,
+                                                  std::string_view /*fragment_src*/) {
+  return std::make_shared<NullShader>(name, stream_);
+}
+
+std::shared_ptr<Shader> NullDevice::create_shader(const std::filesystem::path& path, ShaderConfig /*config*/) {
+  return std::make_shared<NullShader>(path, stream_);
+}
+
+std::shared_ptr<Texture> NullDevice::create_texture(const TextureDesc& desc, const SamplerDesc& sampler) {
+  return std::make_shared<NullTexture2D>(desc, sampler, stream_);
+}
+
+std::shared_ptr<Texture> NullDevice::create_texture(const std::filesystem::path& path, const SamplerDesc& sampler,
+                                                    TextureFormat format, std::uint32_t mip_levels) {
+  if (const auto it = loaded_textures_.find(path); it != loaded_textures_.end()) {
+    return it->second;
+  }
+
+  return loaded_textures_[path] = std::make_shared<NullTexture2D>(path, sampler, format, mip_levels, stream_);
+}
+
+std::shared_ptr<Texture> NullDevice::create_texture(const std::filesystem::path& path, const Image& image,
+                                                    const SamplerDesc& sampler, std::uint32_t mip_levels) {
+  if (const auto it = loaded_textures_.find(path); it != loaded_textures_.end()) {
+    return it->second;
+  }
+
+  return loaded_textures_[path] =
+             std::make_shared<NullTexture2D>(image, sampler, mip_levels, path.generic_string(), stream_);
+}
+
+std::unique_ptr<VertexInput> NullDevice::create_vertex_input() { return std::make_unique<NullVertexInput>(stream_); }
+
+std::shared_ptr<Framebuffer> NullDevice::create_framebuffer(const FramebufferSpec& spec) {
+  return std::make_shared<NullFramebuffer>(spec, stream_);
+}
+
+std::shared_ptr<DepthState> NullDevice::create_depth_state(const DepthStateDesc& desc) {
+  return std::make_shared<NullDepthState>(desc);
+}
+
+std::shared_ptr<BlendState> NullDevice::create_blend_state(const BlendStateDesc& desc) {
+  return std::make_shared<NullBlendState>(desc);
+}
+
+std::shared_ptr<RasterState> NullDevice::create_raster_state(const RasterStateDesc& desc) {
+  return std::make_shared<NullRasterState>(desc);
+}
+
+std::unique_ptr<ImguiBackend> NullDevice::create_imgui_backend() { return std::make_unique<NullImguiBackend>(); }
+
+}  // namespace kEn
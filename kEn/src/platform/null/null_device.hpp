@@ -0,0 +1,65 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+
+#include <kEn/renderer/device.hpp>
+
+#include "null_command_stream.hpp"
+#include "null_render_context.hpp"
+
+namespace kEn {
+
+/**
+ * @brief Device that records commands instead of talking to a GPU.
+ *
+ * Every resource and the render context append to one @ref NullCommandStream;
+ * @ref swap_buffers() closes the frame.  The engine's CPU-side work (scene
+ * traversal, uniform and state setting, uploads) runs unchanged, which makes
+ * it measurable without a window or a driver.  Totals are logged when the
+ * device is destroyed.
+ */
+class NullDevice final : public Device {
+ public:
+  NullDevice();
+  ~NullDevice() override;
+
+  DELETE_COPY_MOVE(NullDevice);
+
+  void swap_buffers() override { stream_.end_frame(); }
+  RenderContext& context() override { return render_context_; }
+
+  /** @brief The recorded command stream. */
+  [[nodiscard]] const NullCommandStream& commands() const { return stream_; }
+
+  std::shared_ptr<Buffer> create_buffer(const BufferDesc& desc, const void* data) override;
+  std::shared_ptr<MutableBuffer> create_mutable_buffer(const BufferDesc& desc, const void* data) override;
+  std::shared_ptr<UniformBuffer> create_uniform_buffer(std::shared_ptr<Buffer> buffer) override;
+  std::shared_ptr<ShaderStorageBuffer> create_shader_storage_buffer(std::shared_ptr<Buffer> buffer) override;
+
+  std::shared_ptr<Shader> create_shader(std::string_view, std::string_view, std::string_view) override;
+  std::shared_ptr<Shader> create_shader(const std::filesystem::path&, ShaderConfig) override;
+
+  std::shared_ptr<Texture> create_texture(const TextureDesc&, const SamplerDesc&) override;
+  std::shared_ptr<Texture> create_texture(const std::filesystem::path&, const SamplerDesc&, TextureFormat,
+                                          std::uint32_t mip_levels) override;
+  std::shared_ptr<Texture> create_texture(const std::filesystem::path&, const Image&, const SamplerDesc&,
+                                          std::uint32_t) override;
+
+  std::unique_ptr<VertexInput> create_vertex_input() override;
+  std::shared_ptr<Framebuffer> create_framebuffer(const FramebufferSpec&) override;
+
+  std::shared_ptr<DepthState> create_depth_state(const DepthStateDesc& desc) override;
+  std::shared_ptr<BlendState> create_blend_state(const BlendStateDesc& desc) override;
+  std::shared_ptr<RasterState> create_raster_state(const RasterStateDesc& desc) override;
+
+  std::unique_ptr<ImguiBackend> create_imgui_backend() override;
+
+ private:
+  NullCommandStream stream_;
+  NullRenderContext render_context_{stream_};
+  std::unordered_map<std::filesystem::path, std::shared_ptr<Texture>> loaded_textures_;
+};
+
+}  // namespace kEn
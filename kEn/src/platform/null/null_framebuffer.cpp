@@ -0,0 +1,107 @@
+#include "null_framebuffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include <mEn/vec4.hpp>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/core/log.hpp>
+#include <kEn/renderer/framebuffer.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+namespace {
+
+constexpr std::uint32_t kMaxFramebufferSize = 8192;
+
+}  // namespace
+
+NullFramebuffer::NullFramebuffer(FramebufferSpec spec, NullCommandStream& stream)
+    : spec_(std::move(spec)), handle_(stream.next_handle()), stream_(&stream) {
+  invalidate();
+}
+
+void NullFramebuffer::invalidate() {
+  color_attachments_.resize(spec_.attachments.color_attachments.size());
+  std::ranges::generate(color_attachments_, [this] { return stream_->next_handle(); });
+
+  depth_attachment_.reset();
+  if (spec_.attachments.depth_attachment.has_value()) {
+    depth_attachment_ = stream_->next_handle();
+  }
+
+  memory_ = TrackedMemory(MemoryCategory::Framebuffer, spec_.debug_name, spec_.memory_size());
+}
+
+void NullFramebuffer::resize(std::uint32_t width, std::uint32_t height) {
+  if (width == 0 || height == 0 || width > kMaxFramebufferSize || height > kMaxFramebufferSize) {
+    KEN_CORE_WARN("Attempted to resize framebuffer to {0}x{1}", width, height);
+    return;
+  }
+
+  spec_.width  = width;
+  spec_.height = height;
+
+  invalidate();
+}
+
+void NullFramebuffer::read_pixels(std::uint32_t attachment_id, int /*x*/, int /*y*/, int /*width*/, int /*height*/,
+                                  std::span<std::byte> out_buffer, std::size_t /*out_row_pitch*/) const {
+  KEN_CORE_ASSERT(attachment_id < color_attachments_.size());
+  KEN_CORE_ASSERT(spec_.samples == 1, "NullFramebuffer::read_pixels does not support multisampled attachments");
+
+  std::ranges::fill(out_buffer, std::byte{0});
+}
+
+AttachmentHandle NullFramebuffer::color_attachment(std::uint32_t attachment_id) const {
+  KEN_CORE_ASSERT(attachment_id < color_attachments_.size());
+  return AttachmentHandle{color_attachments_[attachment_id]};
+}
+
+void NullFramebuffer::record_clear(std::uint32_t slot, std::span<const std::byte> value) {
+  stream_->record({.type = NullCommandType::ClearAttachment, .slot = slot, .object = handle_}, value);
+}
+
+void NullFramebuffer::clear_color_attachment(std::uint32_t attachment_id, std::int32_t value) {
+  KEN_CORE_ASSERT(attachment_id < color_attachments_.size());
+  record_clear(attachment_id, std::as_bytes(std::span(&value, 1)));
+}
+
+void NullFramebuffer::clear_color_attachment(std::uint32_t attachment_id, std::uint32_t value) {
+  KEN_CORE_ASSERT(attachment_id < color_attachments_.size());
+  record_clear(attachment_id, std::as_bytes(std::span(&value, 1)));
+}
+
+void NullFramebuffer::clear_color_attachment(std::uint32_t attachment_id, float value) {
+  KEN_CORE_ASSERT(attachment_id < color_attachments_.size());
+  record_clear(attachment_id, std::as_bytes(std::span(&value, 1)));
+}
+
+void NullFramebuffer::clear_color_attachment(std::uint32_t attachment_id, const mEn::Vec4& value) {
+  KEN_CORE_ASSERT(attachment_id < color_attachments_.size());
+  record_clear(attachment_id, std::as_bytes(std::span(&value, 1)));
+}
+
+void NullFramebuffer::clear_depth(float depth) {
+  KEN_CORE_ASSERT(depth_attachment_.has_value());
+  record_clear(kDepthSlot, std::as_bytes(std::span(&depth, 1)));
+}
+
+void NullFramebuffer::clear_stencil(std::uint8_t stencil) {
+  KEN_CORE_ASSERT(depth_attachment_.has_value());
+  record_clear(kDepthSlot, std::as_bytes(std::span(&stencil, 1)));
+}
+
+void NullFramebuffer::clear_depth_stencil(float depth, std::uint8_t stencil) {
+  KEN_CORE_ASSERT(depth_attachment_.has_value());
+  record_clear(kDepthSlot, std::as_bytes(std::span(&depth, 1)));
+  record_clear(kDepthSlot, std::as_bytes(std::span(&stencil, 1)));
+}
+
+}  // namespace kEn
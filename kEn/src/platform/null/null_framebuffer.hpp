@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/core/memory_tracker.hpp>
+#include <kEn/renderer/framebuffer.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+/**
+ * @brief Null implementation of Framebuffer.
+ *
+ * Attachments are only handles; they are replaced on every resize, like the
+ * OpenGL backend's textures.  Clears are recorded as @c ClearAttachment
+ * commands (@c slot is the color attachment, or @ref kDepthSlot) and reads
+ * return zeros.
+ */
+class NullFramebuffer : public Framebuffer {
+ public:
+  /** @brief @c slot of a @c ClearAttachment command that targets the depth/stencil attachment. */
+  static constexpr std::uint32_t kDepthSlot = ~0U;
+
+  NullFramebuffer(FramebufferSpec spec, NullCommandStream& stream);
+
+  void resize(std::uint32_t width, std::uint32_t height) override;
+
+  [[nodiscard]] std::uintptr_t native_handle() const noexcept override { return handle_; }
+  [[nodiscard]] std::optional<AttachmentHandle> depth_attachment() const noexcept override {
+    if (!depth_attachment_) {
+      return std::nullopt;
+    }
+    return AttachmentHandle{*depth_attachment_};
+  }
+
+  [[nodiscard]] const FramebufferSpec& spec() const override { return spec_; }
+
+  [[nodiscard]] std::size_t color_attachment_count() const override { return color_attachments_.size(); }
+  [[nodiscard]] TextureFormat color_attachment_format(std::uint32_t attachment_id) const override {
+    KEN_CORE_ASSERT(attachment_id < spec_.attachments.color_attachments.size());
+    return spec_.attachments.color_attachments[attachment_id].texture_format;
+  }
+
+  [[nodiscard]] bool has_depth_attachment() const override { return spec_.attachments.depth_attachment.has_value(); }
+  [[nodiscard]] std::optional<TextureFormat> depth_attachment_format() const override {
+    if (!spec_.attachments.depth_attachment.has_value()) {
+      return std::nullopt;
+    }
+    return spec_.attachments.depth_attachment->texture_format;
+  }
+
+  void read_pixels(std::uint32_t attachment_id, int x, int y, int width, int height, std::span<std::byte> out_buffer,
+                   std::size_t out_row_pitch) const override;
+
+  [[nodiscard]] AttachmentHandle color_attachment(std::uint32_t attachment_id) const override;
+
+  void clear_color_attachment(std::uint32_t attachment_id, std::int32_t value) override;
+  void clear_color_attachment(std::uint32_t attachment_id, std::uint32_t value) override;
+  void clear_color_attachment(std::uint32_t attachment_id, float value) override;
+  void clear_color_attachment(std::uint32_t attachment_id, const mEn::Vec4& value) override;
+  void clear_depth(float depth) override;
+  void clear_stencil(std::uint8_t stencil) override;
+  void clear_depth_stencil(float depth, std::uint8_t stencil) override;
+
+ private:
+  void invalidate();
+  void record_clear(std::uint32_t slot, std::span<const std::byte> value);
+
+  FramebufferSpec spec_;
+  std::uintptr_t handle_;
+  NullCommandStream* stream_;
+
+  std::vector<std::uintptr_t> color_attachments_;
+  std::optional<std::uintptr_t> depth_attachment_;
+  TrackedMemory memory_;
+};
+
+}  // namespace kEn
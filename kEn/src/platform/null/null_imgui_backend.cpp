@@ -0,0 +1,67 @@
+#include "null_imgui_backend.hpp"
+
+#include <GLFW/glfw3.h>
+#include <imgui/imgui.h>
+#include <imgui/imgui_impl_glfw.h>
+
+#include <kEn/core/assert.hpp>
+
+namespace kEn {
+
+namespace {
+
+void update_texture(ImTextureData& texture) {
+  switch (texture.Status) {
+    case ImTextureStatus_WantCreate:
+      texture.SetTexID(static_cast<ImTextureID>(texture.UniqueID) + 1);
+      texture.SetStatus(ImTextureStatus_OK);
+      break;
+    case ImTextureStatus_WantUpdates:
+      texture.SetStatus(ImTextureStatus_OK);
+      break;
+    case ImTextureStatus_WantDestroy:
+      texture.SetTexID(ImTextureID_Invalid);
+      texture.SetStatus(ImTextureStatus_Destroyed);
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace
+
+void NullImguiBackend::init(GLFWwindow* window) {
+  KEN_CORE_ASSERT(window != nullptr, "NullImguiBackend requires a native window");
+  ImGui_ImplGlfw_InitForOther(window, true);
+
+  ImGuiIO& io            = ImGui::GetIO();
+  io.BackendRendererName = "kEn_null";
+  io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasVtxOffset;
+}
+
+void NullImguiBackend::shutdown() {
+  for (ImTextureData* texture : ImGui::GetPlatformIO().Textures) {
+    if (texture->RefCount == 1) {
+      texture->SetTexID(ImTextureID_Invalid);
+      texture->SetStatus(ImTextureStatus_Destroyed);
+    }
+  }
+
+  ImGuiIO& io            = ImGui::GetIO();
+  io.BackendRendererName = nullptr;
+  io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasVtxOffset);
+  ImGui_ImplGlfw_Shutdown();
+}
+
+void NullImguiBackend::new_frame() { ImGui_ImplGlfw_NewFrame(); }
+
+void NullImguiBackend::render() {
+  const ImDrawData* draw_data = ImGui::GetDrawData();
+  if (draw_data->Textures != nullptr) {
+    for (ImTextureData* texture : *draw_data->Textures) {
+      update_texture(*texture);
+    }
+  }
+}
+
+}  // namespace kEn
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <kEn/imgui/imgui_backend.hpp>
+
+namespace kEn {
+
+/**
+ * @brief Dear ImGui backend for the null device.
+ *
+ * Uses the GLFW platform backend for input and acknowledges every font
+ * texture request without uploading anything, so ImGui frames are built as
+ * usual and then dropped.
+ */
+class NullImguiBackend final : public ImguiBackend {
+ public:
+  void init(GLFWwindow* window) override;
+  void shutdown() override;
+  void new_frame() override;
+  void render() override;
+};
+
+}  // namespace kEn
@@ -0,0 +1,141 @@
+#include "null_render_context.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include <mEn/vec4.hpp>
+
+#include <kEn/core/log.hpp>
+#include <kEn/renderer/buffer.hpp>
+#include <kEn/renderer/framebuffer.hpp>
+#include <kEn/renderer/render_context.hpp>
+#include <kEn/renderer/render_state.hpp>
+#include <kEn/renderer/shader.hpp>
+#include <kEn/renderer/texture.hpp>
+#include <kEn/renderer/vertex_input.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+namespace {
+
+template <typename T>
+[[nodiscard]] std::uintptr_t address_of(const T& object) {
+  return reinterpret_cast<std::uintptr_t>(&object);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+}  // namespace
+
+void NullRenderContext::init(bool /*enable_debug*/) {
+  KEN_CORE_INFO("Null render context: commands are recorded, nothing is drawn");
+}
+
+void NullRenderContext::set_clear_color(const mEn::Vec4& color) {
+  stream_->record({.type = NullCommandType::SetClearColor}, std::as_bytes(std::span(&color, 1)));
+}
+
+void NullRenderContext::set_clear_depth(float depth) {
+  stream_->record({.type = NullCommandType::SetClearDepth}, std::as_bytes(std::span(&depth, 1)));
+}
+
+void NullRenderContext::record_clear(std::uint32_t aspects) {
+  stream_->record({.type = NullCommandType::Clear, .slot = aspects});
+}
+
+void NullRenderContext::set_viewport(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h) {
+  stream_->record({.type = NullCommandType::SetViewport, .args = {x, y, w, h}});
+}
+
+void NullRenderContext::set_scissor_rect(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h) {
+  stream_->record({.type = NullCommandType::SetScissorRect, .args = {x, y, w, h}});
+}
+
+void NullRenderContext::set_depth_state(const DepthState& state) {
+  stream_->record({.type = NullCommandType::SetDepthState, .object = address_of(state)});
+}
+
+void NullRenderContext::set_blend_state(const BlendState& state) {
+  stream_->record({.type = NullCommandType::SetBlendState, .object = address_of(state)});
+}
+
+void NullRenderContext::set_raster_state(const RasterState& state) {
+  stream_->record({.type = NullCommandType::SetRasterState, .object = address_of(state)});
+}
+
+void NullRenderContext::set_shader(const Shader& shader) {
+  stream_->record({.type = NullCommandType::SetShader, .object = shader.native_handle()});
+}
+
+void NullRenderContext::set_vertex_input(const VertexInput& vertex_input) {
+  stream_->record({.type = NullCommandType::SetVertexInput, .object = vertex_input.native_handle()});
+}
+
+void NullRenderContext::bind_texture(std::uint32_t slot, ShaderStage /*stage*/, const Texture& texture) {
+  stream_->record({.type = NullCommandType::BindTexture, .slot = slot, .object = texture.native_handle()});
+}
+
+void NullRenderContext::bind_attachment(std::uint32_t slot, ShaderStage /*stage*/, AttachmentHandle handle) {
+  stream_->record({.type = NullCommandType::BindAttachment, .slot = slot, .object = handle.value});
+}
+
+void NullRenderContext::bind_uniform_buffer(std::uint32_t binding, ShaderStage /*stage*/, const UniformBuffer& ubo) {
+  stream_->record({.type   = NullCommandType::BindUniformBuffer,
+                   .slot   = binding,
+                   .object = ubo.underlying_buffer()->native_handle()});
+}
+
+void NullRenderContext::bind_storage_buffer(std::uint32_t binding, ShaderStage /*stage*/,
+                                            const ShaderStorageBuffer& ssbo) {
+  stream_->record({.type   = NullCommandType::BindStorageBuffer,
+                   .slot   = binding,
+                   .object = ssbo.underlying_buffer()->native_handle()});
+}
+
+void NullRenderContext::set_render_target(Framebuffer& framebuffer) {
+  stream_->record({.type = NullCommandType::SetRenderTarget, .object = framebuffer.native_handle()});
+}
+
+void NullRenderContext::bind_default_framebuffer() {
+  stream_->record({.type = NullCommandType::BindDefaultFramebuffer});
+}
+
+void NullRenderContext::draw(std::size_t vertex_count, std::uint32_t start_vertex, RenderMode mode) {
+  draw_instanced(vertex_count, 1, start_vertex, 0, mode);
+}
+
+void NullRenderContext::draw_instanced(std::size_t vertex_count, std::size_t instance_count,
+                                       std::uint32_t start_vertex, std::uint32_t start_instance, RenderMode mode) {
+  stream_->record({.type = NullCommandType::Draw,
+                   .slot = std::to_underlying(mode),
+                   .args = {vertex_count, instance_count, start_vertex, start_instance}});
+}
+
+void NullRenderContext::draw_indexed(std::size_t index_count, std::uint32_t start_index, std::int32_t base_vertex,
+                                     RenderMode mode) {
+  draw_indexed_instanced(index_count, 1, start_index, base_vertex, 0, mode);
+}
+
+void NullRenderContext::draw_indexed_instanced(std::size_t index_count, std::size_t instance_count,
+                                               std::uint32_t start_index, std::int32_t base_vertex,
+                                               std::uint32_t start_instance, RenderMode mode) {
+  const std::uint64_t packed = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(base_vertex)) << 32U) |
+                               static_cast<std::uint64_t>(start_instance);
+  stream_->record({.type = NullCommandType::DrawIndexed,
+                   .slot = std::to_underlying(mode),
+                   .args = {index_count, instance_count, start_index, packed}});
+}
+
+void NullRenderContext::set_tessellation_patch_vertices(std::size_t count) {
+  stream_->record({.type = NullCommandType::SetPatchVertices, .args = {count}});
+}
+
+void NullRenderContext::begin_gpu_scope(const char* name) {
+  stream_->record({.type = NullCommandType::BeginGpuScope, .object = address_of(*name)});
+}
+
+void NullRenderContext::end_gpu_scope() { stream_->record({.type = NullCommandType::EndGpuScope}); }
+
+}  // namespace kEn
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <kEn/renderer/buffer.hpp>
+#include <kEn/renderer/framebuffer.hpp>
+#include <kEn/renderer/render_context.hpp>
+#include <kEn/renderer/texture.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+/**
+ * @brief Null implementation of @ref RenderContext.
+ *
+ * Every call is appended to the device's @ref NullCommandStream and nothing
+ * else happens.  State objects are identified by their address.  Command
+ * arguments:
+ * - @c Clear: @c slot holds the cleared aspects (@ref kClearColor, @ref kClearDepth, @ref kClearStencil).
+ * - @c Draw: @c slot is the @ref RenderMode; @c args are the vertex count, instance count, first vertex
+ *   and first instance.
+ * - @c DrawIndexed: as @c Draw with the index count and first index; @c args[3] holds the base vertex in
+ *   the high and the first instance in the low 32 bits.
+ * - Bindings: @c slot is the binding point and @c object the bound resource.
+ * - @c BeginGpuScope: @c object is the address of the scope's name.
+ *
+ * GPU time is not measured; @ref gpu_timings() is always empty.
+ */
+class NullRenderContext final : public RenderContext {
+ public:
+  static constexpr std::uint32_t kClearColor   = 1U << 0;
+  static constexpr std::uint32_t kClearDepth   = 1U << 1;
+  static constexpr std::uint32_t kClearStencil = 1U << 2;
+
+  /** @brief Tessellation level reported by @ref max_tessellation_level(); the minimum OpenGL guarantees. */
+  static constexpr std::size_t kMaxTessellationLevel = 64;
+
+  explicit NullRenderContext(NullCommandStream& stream) : stream_(&stream) {}
+
+  void init(bool enable_debug) override;
+
+  void set_clear_color(const mEn::Vec4& color) override;
+  void set_clear_depth(float depth) override;
+
+  void clear() override { record_clear(kClearColor | kClearDepth | kClearStencil); }
+  void clear_color() override { record_clear(kClearColor); }
+  void clear_depth() override { record_clear(kClearDepth); }
+  void clear_stencil() override { record_clear(kClearStencil); }
+  void clear_depth_stencil() override { record_clear(kClearDepth | kClearStencil); }
+
+  void set_viewport(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h) override;
+  void set_scissor_rect(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h) override;
+
+  void set_depth_state(const DepthState& state) override;
+  void set_blend_state(const BlendState& state) override;
+  void set_raster_state(const RasterState& state) override;
+
+  void set_shader(const Shader& shader) override;
+  void set_vertex_input(const VertexInput& vertex_input) override;
+
+  void bind_texture(std::uint32_t slot, ShaderStage stage, const Texture& texture) override;
+  void bind_attachment(std::uint32_t slot, ShaderStage stage, AttachmentHandle handle) override;
+  void bind_uniform_buffer(std::uint32_t binding, ShaderStage stage, const UniformBuffer& ubo) override;
+  void bind_storage_buffer(std::uint32_t binding, ShaderStage stage, const ShaderStorageBuffer& ssbo) override;
+
+  void set_render_target(Framebuffer& framebuffer) override;
+  void bind_default_framebuffer() override;
+
+  void draw(std::size_t vertex_count, std::uint32_t start_vertex, RenderMode mode) override;
+  void draw_instanced(std::size_t vertex_count, std::size_t instance_count, std::uint32_t start_vertex,
+                      std::uint32_t start_instance, RenderMode mode) override;
+
+  void draw_indexed(std::size_t index_count, std::uint32_t start_index, std::int32_t base_vertex,
+                    RenderMode mode) override;
+  void draw_indexed_instanced(std::size_t index_count, std::size_t instance_count, std::uint32_t start_index,
+                              std::int32_t base_vertex, std::uint32_t start_instance, RenderMode mode) override;
+
+  void set_tessellation_patch_vertices(std::size_t count) override;
+  [[nodiscard]] std::size_t max_tessellation_level() const override { return kMaxTessellationLevel; }
+
+  void begin_gpu_scope(const char* name) override;
+  void end_gpu_scope() override;
+  [[nodiscard]] std::span<const GpuTiming> gpu_timings() const override { return {}; }
+
+ private:
+  void record_clear(std::uint32_t aspects);
+
+  NullCommandStream* stream_;
+};
+
+}  // namespace kEn
@@ -0,0 +1,101 @@
+#include "null_shader.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <kEn/renderer/shader.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+NullShader::NullShader(std::string_view name, NullCommandStream& stream)
+    : handle_(stream.next_handle()), stream_(&stream), name_(name) {}
+
+NullShader::NullShader(const std::filesystem::path& path, NullCommandStream& stream)
+    : NullShader(std::string_view{path.stem().string()}, stream) {}
+
+std::uint32_t NullShader::uniform_location(UniformId id) const {
+  if (const auto it = uniform_locations_.find(id.hash()); it != uniform_locations_.end()) {
+    return it->second;
+  }
+
+  const auto location = static_cast<std::uint32_t>(uniform_locations_.size());
+  uniform_locations_.emplace(id.hash(), location);
+  uniform_values_.emplace_back();
+  return location;
+}
+
+void NullShader::set_uniform_any(UniformId id, const UniformValue& value) const {
+  const std::uint32_t location = uniform_location(id);
+  if (uniform_values_[location] == value) {
+    return;
+  }
+
+  uniform_values_[location] = value;
+  std::visit(
+      [&](const auto& x) {
+        stream_->record({.type = NullCommandType::SetUniform, .slot = location, .object = handle_},
+                        std::as_bytes(std::span(&x, 1)));
+      },
+      value);
+}
+
+void NullShader::set_uniform_array_any(std::string_view name, const UniformArray& values) const {
+  const std::uint32_t location = uniform_location(UniformId(name));
+
+  // Same as the OpenGL backend: array writes make the last values of the written elements unknown. Without reflection
+  // they are found by name: "a" and "a[0]" both start at the first element, "a[k]" at the k-th.
+  std::string_view array = name;
+  std::size_t first      = 0;
+  if (const std::size_t open = name.rfind('['); open != std::string_view::npos && name.ends_with(']')) {
+    array = name.substr(0, open);
+    std::from_chars(name.data() + open + 1, name.data() + name.size() - 1, first);
+  }
+  const auto forget = [this](std::string_view element) {
+    if (const auto it = uniform_locations_.find(UniformId::hash(element)); it != uniform_locations_.end()) {
+      uniform_values_[it->second].reset();
+    }
+  };
+
+  uniform_values_[location].reset();
+  if (first == 0) {
+    forget(array);
+  }
+  const std::size_t written = std::visit([](auto span) { return span.size(); }, values);
+  for (std::size_t element = first; element < first + written; ++element) {
+    forget(std::format("{}[{}]", array, element));
+  }
+  std::visit(
+      [&](auto span) {
+        stream_->record({.type = NullCommandType::SetUniformArray, .slot = location, .object = handle_},
+                        std::as_bytes(span));
+      },
+      values);
+}
+
+void NullShader::bind_uniform_block(std::string_view block_name, ShaderStage /*stage*/, std::uint32_t binding) const {
+  uniform_block_bindings_.insert_or_assign(std::string(block_name), binding);
+  stream_->record({.type = NullCommandType::BindUniformBlock, .slot = binding, .object = handle_});
+}
+
+std::optional<std::uint32_t> NullShader::uniform_block_binding(std::string_view block_name,
+                                                               ShaderStage /*stage*/) const {
+  const auto it = uniform_block_bindings_.find(block_name);
+  if (it == uniform_block_bindings_.end()) {
+    return std::nullopt;
+  }
+
+  return it->second;
+}
+
+}  // namespace kEn
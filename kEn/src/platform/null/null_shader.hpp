@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <kEn/core/core.hpp>
+#include <kEn/renderer/shader.hpp>
+#include <kEn/util/string_hash.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+/**
+ * @brief Null implementation of Shader.
+ *
+ * Nothing is compiled and source files are not read.  Uniform ids are
+ * resolved through a location table like the OpenGL backend's (any name is
+ * accepted and assigned the next free location), and every uniform write that
+ * changes a value is recorded with it as a @c SetUniform command; array writes
+ * are always recorded, as @c SetUniformArray.  Since there is no reflection,
+ * uniform_block_binding() only knows blocks bound through bind_uniform_block().
+ */
+class NullShader final : public Shader {
+ public:
+  NullShader(std::string_view name, NullCommandStream& stream);
+  NullShader(const std::filesystem::path& path, NullCommandStream& stream);
+
+  [[nodiscard]] std::uintptr_t native_handle() const noexcept override { return handle_; }
+
+  using Shader::set_uniform_any;
+  void set_uniform_any(UniformId id, const UniformValue& value) const override;
+  [[nodiscard]] bool has_uniform(UniformId /*id*/) const override { return true; }
+  void set_uniform_array_any(std::string_view name, const UniformArray& values) const override;
+
+  void bind_uniform_block(std::string_view block_name, ShaderStage stage, std::uint32_t binding) const override;
+  [[nodiscard]] std::optional<std::uint32_t> uniform_block_binding(std::string_view block_name,
+                                                                   ShaderStage stage) const override;
+
+  std::string_view name() const override { return name_; }
+
+  DELETE_COPY_MOVE(NullShader);
+
+ private:
+  [[nodiscard]] std::uint32_t uniform_location(UniformId id) const;
+
+  std::uintptr_t handle_;
+  NullCommandStream* stream_;
+  std::string name_;
+
+  mutable std::unordered_map<std::uint64_t, std::uint32_t> uniform_locations_;  ///< Keyed by @ref UniformId::hash.
+  mutable std::vector<std::optional<UniformValue>> uniform_values_;           ///< Last value of each location.
+  mutable std::unordered_map<std::string, std::uint32_t, StringHash, std::equal_to<>> uniform_block_bindings_;
+};
+
+}  // namespace kEn
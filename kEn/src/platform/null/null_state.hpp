@@ -0,0 +1,37 @@
+#pragma once
+
+#include <kEn/renderer/render_state.hpp>
+
+namespace kEn {
+
+/** @brief Null concrete depth/stencil state object. */
+class NullDepthState final : public DepthState {
+ public:
+  explicit NullDepthState(const DepthStateDesc& desc) : desc_(desc) {}
+  [[nodiscard]] const DepthStateDesc& desc() const { return desc_; }
+
+ private:
+  DepthStateDesc desc_;
+};
+
+/** @brief Null concrete blend state object. */
+class NullBlendState final : public BlendState {
+ public:
+  explicit NullBlendState(const BlendStateDesc& desc) : desc_(desc) {}
+  [[nodiscard]] const BlendStateDesc& desc() const { return desc_; }
+
+ private:
+  BlendStateDesc desc_;
+};
+
+/** @brief Null concrete rasterizer state object. */
+class NullRasterState final : public RasterState {
+ public:
+  explicit NullRasterState(const RasterStateDesc& desc) : desc_(desc) {}
+  [[nodiscard]] const RasterStateDesc& desc() const { return desc_; }
+
+ private:
+  RasterStateDesc desc_;
+};
+
+}  // namespace kEn
@@ -0,0 +1,73 @@
+#include "null_texture.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <utility>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/renderer/image.hpp>
+#include <kEn/renderer/texture.hpp>
+#include <kEn/renderer/texture_format.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+NullTexture2D::NullTexture2D(TextureDesc desc, SamplerDesc sampler, NullCommandStream& stream)
+    : desc_(desc),
+      sampler_desc_(sampler),
+      handle_(stream.next_handle()),
+      stream_(&stream),
+      memory_(MemoryCategory::Texture, desc_.debug_name, desc_.memory_size()) {
+  KEN_ASSERT(desc_.kind == TextureKind::Tex2D);
+  KEN_ASSERT(desc_.width > 0);
+  KEN_ASSERT(desc_.height > 0);
+  KEN_ASSERT(desc_.depth == 1);
+  KEN_ASSERT(desc_.layers == 1);
+  KEN_ASSERT(desc_.has_valid_mip_request());
+}
+
+NullTexture2D::NullTexture2D(const std::filesystem::path& path, SamplerDesc sampler, TextureFormat format,
+                             std::uint32_t mip_levels, NullCommandStream& stream)
+    : sampler_desc_(sampler), handle_(stream.next_handle()), stream_(&stream) {
+  // Decode like the OpenGL backend does, so asset loading costs the same on the CPU.
+  if (const auto image = Image::load(path, format)) {
+    init_from_image(*image, mip_levels, path.generic_string());
+  }
+}
+
+NullTexture2D::NullTexture2D(const Image& image, SamplerDesc sampler, std::uint32_t mip_levels, std::string debug_name,
+                             NullCommandStream& stream)
+    : sampler_desc_(sampler), handle_(stream.next_handle()), stream_(&stream) {
+  init_from_image(image, mip_levels, std::move(debug_name));
+}
+
+void NullTexture2D::set_data(std::span<const std::byte> data, std::uint32_t mip_level,
+                             [[maybe_unused]] std::uint32_t layer) {
+  KEN_ASSERT(layer == 0);
+  KEN_ASSERT(mip_level < desc_.resolved_mip_levels());
+
+  const std::uint32_t mip_width  = std::max(1U, desc_.width >> mip_level);
+  const std::uint32_t mip_height = std::max(1U, desc_.height >> mip_level);
+
+  [[maybe_unused]] const std::size_t expected_size =
+      static_cast<std::size_t>(mip_width) * static_cast<std::size_t>(mip_height) *
+      static_cast<std::size_t>(texture_format::bytes_per_block(desc_.format));
+
+  KEN_CORE_ASSERT(data.size_bytes() == expected_size, "Data must match the target mip size");
+
+  stream_->record({.type = NullCommandType::UpdateTexture, .slot = mip_level, .object = handle_}, data);
+}
+
+void NullTexture2D::init_from_image(const Image& image, std::uint32_t mip_levels, std::string debug_name) {
+  desc_            = image.texture_desc(mip_levels);
+  desc_.debug_name = std::move(debug_name);
+  memory_          = TrackedMemory(MemoryCategory::Texture, desc_.debug_name, desc_.memory_size());
+  set_data(image.pixels(), 0, 0);
+}
+
+}  // namespace kEn
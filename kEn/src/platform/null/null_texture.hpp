@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <kEn/core/memory_tracker.hpp>
+#include <kEn/renderer/image.hpp>
+#include <kEn/renderer/texture.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+/**
+ * @brief Null implementation of a 2D Texture.
+ *
+ * Validates uploads like the OpenGL backend and records them, with their
+ * data, as @c UpdateTexture commands.  No texel storage is kept.
+ */
+class NullTexture2D : public Texture {
+ public:
+  NullTexture2D(TextureDesc desc, SamplerDesc sampler, NullCommandStream& stream);
+  NullTexture2D(const std::filesystem::path& path, SamplerDesc sampler, TextureFormat format,
+                std::uint32_t mip_levels, NullCommandStream& stream);
+  NullTexture2D(const Image& image, SamplerDesc sampler, std::uint32_t mip_levels, std::string debug_name,
+                NullCommandStream& stream);
+
+  [[nodiscard]] const TextureDesc& desc() const override { return desc_; }
+  void set_data(std::span<const std::byte> data, std::uint32_t mip_level, std::uint32_t layer) override;
+
+  [[nodiscard]] const SamplerDesc& sampler_desc() const noexcept { return sampler_desc_; }
+
+  [[nodiscard]] std::uintptr_t native_handle() const noexcept override { return handle_; }
+  [[nodiscard]] ImTextureID imgui_id() const noexcept override { return static_cast<ImTextureID>(handle_); }
+
+ private:
+  void init_from_image(const Image& image, std::uint32_t mip_levels, std::string debug_name);
+
+  TextureDesc desc_;
+  SamplerDesc sampler_desc_;
+  std::uintptr_t handle_;
+  NullCommandStream* stream_;
+  TrackedMemory memory_;
+};
+
+}  // namespace kEn
@@ -0,0 +1,40 @@
+#include "null_vertex_input.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/renderer/buffer.hpp>
+#include <kEn/renderer/vertex_input.hpp>
+
+namespace kEn {
+
+void NullVertexInput::add_vertex_stream(const VertexStreamBinding& stream) {
+  KEN_CORE_ASSERT(!stream.layout.empty(), "Vertex stream must have a layout!");
+  streams_.push_back(stream);
+}
+
+void NullVertexInput::set_index_buffer_impl(std::shared_ptr<Buffer> index_buf, IndexType index_type,
+                                            std::size_t index_offset) {
+  index_buffer_        = std::move(index_buf);
+  index_type_          = index_type;
+  index_buffer_offset_ = index_offset;
+}
+
+std::size_t NullVertexInput::element_count() const {
+  if (index_buffer_) {
+    const std::size_t index_size = index_type_ == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+    return (index_buffer_->size() - index_buffer_offset_) / index_size;
+  }
+
+  if (!streams_.empty()) {
+    return streams_[0].buffer->size() / streams_[0].layout.stride;
+  }
+
+  KEN_CORE_ASSERT(false, "No index buffer or vertex stream found!");
+  return 0;
+}
+
+}  // namespace kEn
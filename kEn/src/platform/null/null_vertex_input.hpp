@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <kEn/renderer/vertex_input.hpp>
+
+#include "null_command_stream.hpp"
+
+namespace kEn {
+
+class NullVertexInput final : public VertexInput {
+ public:
+  explicit NullVertexInput(NullCommandStream& stream) : handle_(stream.next_handle()) {}
+
+  [[nodiscard]] std::uintptr_t native_handle() const noexcept override { return handle_; }
+
+  void add_vertex_stream(const VertexStreamBinding& stream) override;
+  [[nodiscard]] std::size_t element_count() const override;
+
+  [[nodiscard]] std::span<const VertexStreamBinding> vertex_streams() const override { return streams_; }
+  [[nodiscard]] const std::shared_ptr<Buffer>& index_buffer() const override { return index_buffer_; }
+  [[nodiscard]] IndexType index_type() const override { return index_type_; }
+  [[nodiscard]] std::size_t index_buffer_offset() const override { return index_buffer_offset_; }
+
+ protected:
+  void set_index_buffer_impl(std::shared_ptr<Buffer> index_buf, IndexType index_type,
+                             std::size_t index_offset) override;
+
+ private:
+  std::uintptr_t handle_;
+
+  std::vector<VertexStreamBinding> streams_;
+  std::shared_ptr<Buffer> index_buffer_;
+  IndexType index_type_{IndexType::UInt32};
+  std::size_t index_buffer_offset_{0};
+};
+
+}  // namespace kEn
@@ -12,7 +12,8 @@
 
 namespace kEn {
 
-OpenglBuffer::OpenglBuffer(const BufferDesc& desc, const void* data) : desc_(desc) {
+OpenglBuffer::OpenglBuffer(const BufferDesc& desc, const void* data)
+    : desc_(desc), memory_(MemoryCategory::Buffer, desc_.debug_name, desc_.size) {
   glCreateBuffers(1, &renderer_id_);
   allocate(data);
 }
@@ -27,7 +28,7 @@ OpenglBuffer::~OpenglBuffer() {
 }
 
 OpenglBuffer::OpenglBuffer(OpenglBuffer&& other) noexcept
-    : desc_(other.desc_), renderer_id_(std::exchange(other.renderer_id_, 0)) {
+    : desc_(other.desc_), renderer_id_(std::exchange(other.renderer_id_, 0)), memory_(std::move(other.memory_)) {
   other.desc_ = {};
 }
 
@@ -42,6 +43,7 @@ OpenglBuffer& OpenglBuffer::operator=(OpenglBuffer&& other) noexcept {
 
   desc_        = other.desc_;
   renderer_id_ = std::exchange(other.renderer_id_, 0);
+  memory_      = std::move(other.memory_);
   other.desc_  = {};
   return *this;
 }
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <memory>
 
+#include <kEn/core/memory_tracker.hpp>
 #include <kEn/renderer/buffer.hpp>
 #include <kEn/util/enum_map.hpp>
 
@@ -96,10 +97,14 @@ class OpenglBuffer final : public Buffer {
 
  private:
   void allocate(const void* data) const;
-  void set_size(std::size_t size) { desc_.size = size; }
+  void set_size(std::size_t size) {
+    desc_.size = size;
+    memory_.resize(size);
+  }
 
   BufferDesc desc_{};
   std::uint32_t renderer_id_{};
+  TrackedMemory memory_;
 
   friend class OpenglMutableBuffer;
 };
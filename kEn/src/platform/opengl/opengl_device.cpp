@@ -6,8 +6,6 @@
 #include <string_view>
 #include <utility>
 
-#include <kEn/core/assert.hpp>
-#include <kEn/core/log.hpp>
 #include <kEn/imgui/imgui_backend.hpp>
 #include <kEn/renderer/buffer.hpp>
 #include <kEn/renderer/device.hpp>
@@ -28,22 +26,15 @@
 
 namespace kEn {
 
-std::unique_ptr<Device> Device::create(Device::Api api, GLFWwindow* window, bool enable_debug) {
-  switch (api) {
-    case Device::Api::OpenGL:
-      return std::make_unique<OpenglDevice>(window, enable_debug);
-    default:
-      KEN_CORE_CRITICAL("Only OpenGL is currently supported");
-      KEN_UNREACHABLE();
-  }
-}
-
 OpenglDevice::OpenglDevice(GLFWwindow* window, bool enable_debug) : swap_chain_(window) {
   swap_chain_.init();
   render_context_.init(enable_debug);
 }
 
-void OpenglDevice::swap_buffers() { swap_chain_.swap_buffers(); }
+void OpenglDevice::swap_buffers() {
+  render_context_.end_frame();
+  swap_chain_.swap_buffers();
+}
 
 std::shared_ptr<Buffer> OpenglDevice::create_buffer(const BufferDesc& desc, const void* data) {
   return std::make_shared<OpenglBuffer>(desc, data);
@@ -83,6 +74,16 @@ std::shared_ptr<Texture> OpenglDevice::create_texture(const std::filesystem::pat
   return loaded_textures_[path] = std::make_shared<OpenglTexture2D>(path, sampler, format, mip_levels);
 }
 
+std::shared_ptr<Texture> OpenglDevice::create_texture(const std::filesystem::path& path, const Image& image,
+                                                      const SamplerDesc& sampler, std::uint32_t mip_levels) {
+  if (const auto it = loaded_textures_.find(path); it != loaded_textures_.end()) {
+    return it->second;
+  }
+
+  return loaded_textures_[path] =
+             std::make_shared<OpenglTexture2D>(image, sampler, mip_levels, path.generic_string());
+}
+
 std::unique_ptr<VertexInput> OpenglDevice::create_vertex_input() { return std::make_unique<OpenglVertexInput>(); }
 
 std::shared_ptr<Framebuffer> OpenglDevice::create_framebuffer(const FramebufferSpec& spec) {
@@ -29,6 +29,8 @@ class OpenglDevice final : public Device {
   std::shared_ptr<Texture> create_texture(const TextureDesc&, const SamplerDesc&) override;
   std::shared_ptr<Texture> create_texture(const std::filesystem::path&, const SamplerDesc&, TextureFormat,
                                           std::uint32_t mip_levels) override;
+  std::shared_ptr<Texture> create_texture(const std::filesystem::path&, const Image&, const SamplerDesc&,
+                                          std::uint32_t) override;
 
   std::unique_ptr<VertexInput> create_vertex_input() override;
   std::shared_ptr<Framebuffer> create_framebuffer(const FramebufferSpec&) override;
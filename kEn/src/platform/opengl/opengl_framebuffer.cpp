@@ -127,6 +127,8 @@ void OpenglFramebuffer::invalidate() {
 
   KEN_CORE_ASSERT(glCheckNamedFramebufferStatus(renderer_id_, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
                   "Framebuffer is incomplete!");
+
+  memory_ = TrackedMemory(MemoryCategory::Framebuffer, spec_.debug_name, spec_.memory_size());
 }
 
 void OpenglFramebuffer::resize(std::uint32_t width, std::uint32_t height) {
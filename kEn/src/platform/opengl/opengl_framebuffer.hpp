@@ -7,6 +7,7 @@
 #include <vector>
 
 #include <kEn/core/assert.hpp>
+#include <kEn/core/memory_tracker.hpp>
 #include <kEn/renderer/framebuffer.hpp>
 
 namespace kEn {
@@ -80,6 +81,7 @@ class OpenglFramebuffer : public Framebuffer {
 
   std::vector<std::uint32_t> color_attachments_;  /**< OpenGL texture names for each color attachment. */
   std::optional<std::uint32_t> depth_attachment_; /**< OpenGL texture name for the depth attachment. */
+  TrackedMemory memory_;                          /**< Size of the attachments, updated by @ref invalidate(). */
 };
 
 }  // namespace kEn
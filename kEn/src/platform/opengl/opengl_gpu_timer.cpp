@@ -0,0 +1,122 @@
+#include "opengl_gpu_timer.hpp"
+
+#include <glad/gl.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <kEn/core/assert.hpp>
+#include <kEn/core/profiler.hpp>
+#include <kEn/renderer/render_context.hpp>
+
+namespace kEn {
+
+namespace {
+
+/** @brief Frames between measurements of the GPU clock's offset; reading @c GL_TIMESTAMP may flush. */
+constexpr std::uint64_t kCalibrationInterval = 64;
+
+constexpr double kNanosPerMilli = 1e6;
+
+}  // namespace
+
+OpenglGpuTimer::OpenglGpuTimer() {
+#ifdef KEN_ENABLE_PROFILING
+  track_ = Profiler::add_track("GPU");
+  calibrate();
+#endif
+}
+
+OpenglGpuTimer::~OpenglGpuTimer() {
+  for (const auto& frame : frames_) {
+    for (const auto& scope : frame.scopes) {
+      glDeleteQueries(1, &scope.begin_query);
+      glDeleteQueries(1, &scope.end_query);
+    }
+  }
+}
+
+void OpenglGpuTimer::begin(const char* name) {
+  Frame& frame = frames_[current_];
+  if (frame.used == frame.scopes.size()) {
+    Scope& scope = frame.scopes.emplace_back();
+    glGenQueries(1, &scope.begin_query);
+    glGenQueries(1, &scope.end_query);
+  }
+
+  Scope& scope = frame.scopes[frame.used];
+  scope.name   = name;
+  scope.depth  = static_cast<std::uint32_t>(open_.size());
+  glQueryCounter(scope.begin_query, GL_TIMESTAMP);
+  open_.push_back(frame.used++);
+}
+
+void OpenglGpuTimer::end() {
+  KEN_CORE_ASSERT(!open_.empty(), "end_gpu_scope without a matching begin_gpu_scope");
+  Frame& frame     = frames_[current_];
+  frame.last_query = frame.scopes[open_.back()].end_query;
+  glQueryCounter(frame.last_query, GL_TIMESTAMP);
+  open_.pop_back();
+}
+
+void OpenglGpuTimer::end_frame() {
+  KEN_CORE_ASSERT(open_.empty(), "GPU timing scope left open at the end of a frame");
+  frames_[current_].pending = frames_[current_].used > 0;
+  current_                  = (current_ + 1) % kFrameLatency;
+
+#ifdef KEN_ENABLE_PROFILING
+  if (++frame_count_ % kCalibrationInterval == 0) {
+    calibrate();
+  }
+#endif
+
+  // Frames finish in order, so stop at the first one that has not.
+  for (std::size_t i = 0; i < kFrameLatency; ++i) {
+    Frame& frame = frames_[(current_ + i) % kFrameLatency];
+    if (frame.pending && !resolve(frame)) {
+      break;
+    }
+  }
+
+  // Still unfinished after kFrameLatency - 1 frames; drop it rather than wait for it.
+  frames_[current_].pending = false;
+  frames_[current_].used    = 0;
+}
+
+bool OpenglGpuTimer::resolve(Frame& frame) {
+  // Queries complete in issue order: once the last one is available, reading any result cannot block.
+  GLint available = GL_FALSE;
+  glGetQueryObjectiv(frame.last_query, GL_QUERY_RESULT_AVAILABLE, &available);
+  if (available == GL_FALSE) {
+    return false;
+  }
+
+  timings_.clear();
+  for (std::size_t i = 0; i < frame.used; ++i) {
+    const Scope& scope = frame.scopes[i];
+    GLuint64 begin     = 0;
+    GLuint64 end       = 0;
+    glGetQueryObjectui64v(scope.begin_query, GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(scope.end_query, GL_QUERY_RESULT, &end);
+
+    timings_.push_back({.name         = scope.name,
+                        .milliseconds = static_cast<double>(end - begin) / kNanosPerMilli,
+                        .depth        = scope.depth});
+#ifdef KEN_ENABLE_PROFILING
+    Profiler::record(track_, {.name  = scope.name,
+                              .begin = static_cast<std::int64_t>(begin) + clock_offset_,
+                              .end   = static_cast<std::int64_t>(end) + clock_offset_,
+                              .depth = scope.depth});
+#endif
+  }
+  frame.pending = false;
+  return true;
+}
+
+void OpenglGpuTimer::calibrate() {
+  GLint64 gpu_now = 0;
+  glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+  clock_offset_ = Profiler::now() - gpu_now;
+}
+
+}  // namespace kEn
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <glad/gl.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <kEn/core/core.hpp>
+#include <kEn/renderer/render_context.hpp>
+
+namespace kEn {
+
+/**
+ * @brief GPU timing scopes of @ref OpenglRenderContext, measured with @c GL_TIMESTAMP queries.
+ *
+ * Every scope writes a timestamp when it opens and one when it closes; unlike
+ * @c GL_TIME_ELAPSED queries, timestamps may nest.  The queries of each frame
+ * come from one of @ref kFrameLatency pools, so a frame's results are read
+ * while later frames are recorded.  @ref end_frame() reads every frame whose
+ * results are available without waiting; a frame still unfinished when its
+ * pool is needed again is dropped.
+ *
+ * With @c KEN_ENABLE_PROFILING the results also go to a "GPU" track of the
+ * @ref Profiler, shifted onto its clock, so that traces show them next to the
+ * CPU scopes.
+ */
+class OpenglGpuTimer {
+ public:
+  /** @brief Number of frames whose queries may be in flight. */
+  static constexpr std::size_t kFrameLatency = 4;
+
+  OpenglGpuTimer();
+  ~OpenglGpuTimer();
+
+  void begin(const char* name);
+  void end();
+
+  /** @brief Finishes the current frame and reads the results of finished frames. */
+  void end_frame();
+
+  /** @brief Timings of the newest frame whose results were read. */
+  [[nodiscard]] std::span<const GpuTiming> timings() const { return timings_; }
+
+  DELETE_COPY_MOVE(OpenglGpuTimer);
+
+ private:
+  struct Scope {
+    const char* name    = nullptr;
+    std::uint32_t depth = 0;
+    GLuint begin_query  = 0;
+    GLuint end_query    = 0;
+  };
+
+  struct Frame {
+    std::vector<Scope> scopes; /**< Grows to the most scopes a frame had; the queries are reused. */
+    std::size_t used  = 0;
+    GLuint last_query = 0;     /**< Query issued last; outer scopes close after the scopes nested in them. */
+    bool pending      = false; /**< Results not read yet. */
+  };
+
+  /** @brief Reads the results of @p frame if they are available. */
+  bool resolve(Frame& frame);
+
+  /** @brief Measures the offset between the GPU clock and the profiler's clock. */
+  void calibrate();
+
+  std::array<Frame, kFrameLatency> frames_;
+  std::size_t current_ = 0;
+  std::vector<std::size_t> open_; /**< Indices of the open scopes of the current frame. */
+  std::vector<GpuTiming> timings_;
+
+  std::uint64_t frame_count_ = 0;
+  std::uint32_t track_       = 0;
+  std::int64_t clock_offset_ = 0; /**< Profiler time minus GPU time, in nanoseconds. */
+};
+
+}  // namespace kEn
@@ -24,6 +24,7 @@ namespace kEn {
 
 namespace {
 
+// Driver messages can repeat on every draw call; only a few of each severity are logged.
 void gl_message_callback(GLenum /*src*/, GLenum /*type*/, GLuint /*id*/, GLenum lvl, GLsizei /*len*/, const GLchar* msg,
                          const void* /*params*/) {
   switch (lvl) {
@@ -31,13 +32,13 @@ void gl_message_callback(GLenum /*src*/, GLenum /*type*/, GLuint /*id*/, GLenum
       KEN_CORE_CRITICAL(msg);
       return;
     case GL_DEBUG_SEVERITY_MEDIUM:
-      KEN_CORE_ERROR(msg);
+      KEN_CORE_ERROR_LIMITED(msg);
       return;
     case GL_DEBUG_SEVERITY_LOW:
-      KEN_CORE_WARN(msg);
+      KEN_CORE_WARN_LIMITED(msg);
       return;
     case GL_DEBUG_SEVERITY_NOTIFICATION:
-      KEN_CORE_TRACE(msg);
+      KEN_CORE_TRACE_LIMITED(msg);
       return;
     default:
       KEN_CORE_ASSERT(false, "Unknown message severity!");
@@ -62,6 +63,8 @@ void OpenglRenderContext::init(bool enable_debug) {
   set_depth_state(OpenglDepthState(DepthStateDesc{}));
   set_blend_state(OpenglBlendState(BlendStateDesc{}));
   set_raster_state(OpenglRasterState(RasterStateDesc{}));
+
+  gpu_timer_.emplace();
 }
 
 void OpenglRenderContext::set_clear_color(const mEn::Vec4& color) { glClearColor(color.r, color.g, color.b, color.a); }
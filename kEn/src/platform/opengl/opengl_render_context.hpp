@@ -3,6 +3,7 @@
 #include <glad/gl.h>
 
 #include <optional>
+#include <span>
 
 #include <kEn/renderer/buffer.hpp>
 #include <kEn/renderer/framebuffer.hpp>
@@ -10,6 +11,8 @@
 #include <kEn/renderer/texture.hpp>
 #include <kEn/util/enum_map.hpp>
 
+#include "opengl_gpu_timer.hpp"
+
 namespace kEn {
 
 /** @brief OpenGL-specific utilities for @ref RenderMode. */
@@ -50,6 +53,9 @@ inline constexpr auto kOpenglRenderModes = util::make_enum_map<GLenum>({
  *
  * The @c stage parameter accepted by the four @c bind_* methods is ignored: all OpenGL
  * resource bindings are global and not scoped to a pipeline stage.
+ *
+ * GPU timing scopes are measured by an @ref OpenglGpuTimer created in init();
+ * the owning device calls @ref end_frame() once per frame.
  */
 class OpenglRenderContext final : public RenderContext {
  public:
@@ -94,7 +100,17 @@ class OpenglRenderContext final : public RenderContext {
   void set_tessellation_patch_vertices(std::size_t count) override;
   [[nodiscard]] std::size_t max_tessellation_level() const override;
 
+  void begin_gpu_scope(const char* name) override { gpu_timer_->begin(name); }
+  void end_gpu_scope() override { gpu_timer_->end(); }
+  [[nodiscard]] std::span<const GpuTiming> gpu_timings() const override { return gpu_timer_->timings(); }
+
+  /** @brief Finishes the frame's GPU timing scopes; called by the device before presenting. */
+  void end_frame() { gpu_timer_->end_frame(); }
+
  private:
+  /** @brief Created in init(), once the GL functions are loaded. */
+  std::optional<OpenglGpuTimer> gpu_timer_;
+
   /** @brief Lazily cached result of querying @c GL_MAX_TESS_GEN_LEVEL. */
   mutable std::optional<std::size_t> max_tessellation_level_;
 };
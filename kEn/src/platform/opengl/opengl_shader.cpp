@@ -2,26 +2,33 @@
 
 #include <glad/gl.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <regex>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <kEn/core/assert.hpp>
 #include <kEn/core/log.hpp>
+#include <kEn/core/profiler.hpp>
 #include <kEn/renderer/shader.hpp>
 
 namespace kEn {
@@ -78,6 +85,76 @@ std::string display_name_for(const std::filesystem::path& key, bool internal) {
   return key.string();
 }
 
+std::string resource_name(GLuint program, GLenum resource_interface, GLuint index, GLint length) {
+  std::string name(static_cast<std::size_t>(length), '\0');
+  GLsizei written = 0;
+  glGetProgramResourceName(program, resource_interface, index, length, &written, name.data());
+  name.resize(static_cast<std::size_t>(written));
+  return name;
+}
+
+/** @brief Whether @p type is a scalar, vector or matrix type rather than an opaque one (sampler, image, ...). */
+constexpr bool is_numeric(GLenum type) {
+  switch (type) {
+    case GL_FLOAT:
+    case GL_FLOAT_VEC2:
+    case GL_FLOAT_VEC3:
+    case GL_FLOAT_VEC4:
+    case GL_DOUBLE:
+    case GL_INT:
+    case GL_INT_VEC2:
+    case GL_INT_VEC3:
+    case GL_INT_VEC4:
+    case GL_UNSIGNED_INT:
+    case GL_UNSIGNED_INT_VEC2:
+    case GL_UNSIGNED_INT_VEC3:
+    case GL_UNSIGNED_INT_VEC4:
+    case GL_BOOL:
+    case GL_BOOL_VEC2:
+    case GL_BOOL_VEC3:
+    case GL_BOOL_VEC4:
+    case GL_FLOAT_MAT2:
+    case GL_FLOAT_MAT3:
+    case GL_FLOAT_MAT4:
+    case GL_FLOAT_MAT2x3:
+    case GL_FLOAT_MAT2x4:
+    case GL_FLOAT_MAT3x2:
+    case GL_FLOAT_MAT3x4:
+    case GL_FLOAT_MAT4x2:
+    case GL_FLOAT_MAT4x3:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** @brief Whether a uniform of GLSL type @p type can be set from @p value; opaque types are set from an int. */
+bool accepts(GLenum type, const UniformValue& value) {
+  return std::visit(
+      [type]<typename T>(const T& /*value*/) {
+        if constexpr (std::is_same_v<T, bool>) {
+          return type == GL_BOOL;
+        } else if constexpr (std::is_same_v<T, int>) {
+          return type == GL_INT || type == GL_BOOL || !is_numeric(type);
+        } else if constexpr (std::is_same_v<T, uint32_t>) {
+          return type == GL_UNSIGNED_INT || type == GL_BOOL;
+        } else if constexpr (std::is_same_v<T, float>) {
+          return type == GL_FLOAT;
+        } else if constexpr (std::is_same_v<T, mEn::Vec2>) {
+          return type == GL_FLOAT_VEC2;
+        } else if constexpr (std::is_same_v<T, mEn::Vec3>) {
+          return type == GL_FLOAT_VEC3;
+        } else if constexpr (std::is_same_v<T, mEn::Vec4>) {
+          return type == GL_FLOAT_VEC4;
+        } else if constexpr (std::is_same_v<T, mEn::Mat3>) {
+          return type == GL_FLOAT_MAT3;
+        } else {
+          return type == GL_FLOAT_MAT4;
+        }
+      },
+      value);
+}
+
 std::string annotate_glsl_log(std::string_view raw, const std::vector<std::string>& map) {
   std::stringstream in((std::string(raw)));
   std::string line;
@@ -243,6 +320,7 @@ std::string OpenglShader::read_shader_src(const std::filesystem::path& file,
 
 GLuint OpenglShader::create_shader(std::string_view src, GLenum type, std::string_view debug_name,
                                    std::vector<std::string>* source_id_map) {
+  KEN_PROFILE_FUNCTION();
   const GLuint shader = glCreateShader(type);
   if (shader == 0) {
     KEN_CORE_ERROR("Shader construction failed! stage={} file={}", shader_stage_name(type), debug_name);
@@ -289,6 +367,7 @@ GLuint OpenglShader::create_shader(std::string_view src, GLenum type, std::strin
 }
 
 void OpenglShader::link_shader() const {
+  KEN_PROFILE_FUNCTION();
   glLinkProgram(renderer_id_);
 
   GLint status = 0;
@@ -347,6 +426,7 @@ void OpenglShader::create_program(std::string_view vertex_src, std::string_view
   glAttachShader(renderer_id_, fragment_shader);
 
   link_shader();
+  reflect();
 
   glDetachShader(renderer_id_, vertex_shader);
   glDetachShader(renderer_id_, fragment_shader);
@@ -356,6 +436,7 @@ void OpenglShader::create_program(std::string_view vertex_src, std::string_view
 }
 
 OpenglShader::OpenglShader(const std::filesystem::path& path, ShaderConfig config) {
+  KEN_PROFILE_FUNCTION();
   auto shader_src_path = std::filesystem::path{kShaderPath} / path;
 
   name_ = shader_src_path.stem().string();
@@ -435,6 +516,7 @@ OpenglShader::OpenglShader(const std::filesystem::path& path, ShaderConfig confi
   }
 
   link_shader();
+  reflect();
 
   glDetachShader(renderer_id_, vertex_shader);
   glDetachShader(renderer_id_, fragment_shader);
@@ -465,52 +547,130 @@ OpenglShader::OpenglShader(std::string_view name, std::string_view vertex_src, s
 OpenglShader::~OpenglShader() { glDeleteProgram(renderer_id_); }
 
 // <Uniforms>
-GLint OpenglShader::uniform_location(std::string_view name) const {
-  auto it = uniform_locations_.find(name);
-  if (it != uniform_locations_.end()) {
-    return it->second;
+void OpenglShader::reflect() {
+  KEN_PROFILE_FUNCTION();
+  uniforms_.clear();
+  uniform_ids_.clear();
+  blocks_.clear();
+
+  const auto add_name = [this](std::string_view name, std::size_t entry) {
+    const bool inserted = uniform_ids_.try_emplace(UniformId::hash(name), entry).second;
+    KEN_CORE_ASSERT(inserted, "Two uniform names of the shader share a hash");
+  };
+  const auto add = [this, &add_name](std::string_view name, GLint location, GLenum type) {
+    uniforms_.push_back({.location = location, .type = type, .value = std::nullopt});
+    add_name(name, uniforms_.size() - 1);
+  };
+
+  GLint count = 0;
+  glGetProgramInterfaceiv(renderer_id_, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+  constexpr std::array<GLenum, 5> kUniformProps{GL_NAME_LENGTH, GL_TYPE, GL_LOCATION, GL_ARRAY_SIZE, GL_BLOCK_INDEX};
+  for (GLuint i = 0; i < static_cast<GLuint>(count); ++i) {
+    std::array<GLint, kUniformProps.size()> props{};
+    glGetProgramResourceiv(renderer_id_, GL_UNIFORM, i, kUniformProps.size(), kUniformProps.data(), props.size(),
+                           nullptr, props.data());
+    const auto [name_length, type, location, array_size, block_index] = props;
+    if (block_index != -1 || location == -1) {
+      continue;  // Block members are written through buffers
+    }
+
+    const std::string name = resource_name(renderer_id_, GL_UNIFORM, i, name_length);
+    if (!name.ends_with("[0]")) {
+      add(name, location, static_cast<GLenum>(type));
+      continue;
+    }
+
+    // Arrays of basic types are one resource named after their first element; the bare name writes that element
+    // too, so it shares its entry and the last value written through either name.
+    const std::string_view array = std::string_view(name).substr(0, name.size() - 3);
+    const std::size_t first      = uniforms_.size();
+    for (GLint element = 0; element < array_size; ++element) {
+      const std::string element_name = std::format("{}[{}]", array, element);
+      add(element_name, glGetProgramResourceLocation(renderer_id_, GL_UNIFORM, element_name.c_str()),
+          static_cast<GLenum>(type));
+    }
+    for (GLint element = 0; element < array_size; ++element) {
+      uniforms_[first + element].array_tail = static_cast<std::uint32_t>(array_size - element);
+    }
+    add_name(array, first);
+  }
+
+  constexpr std::array<GLenum, 2> kBlockProps{GL_NAME_LENGTH, GL_BUFFER_BINDING};
+  for (const GLenum kind : {GL_UNIFORM_BLOCK, GL_SHADER_STORAGE_BLOCK}) {
+    glGetProgramInterfaceiv(renderer_id_, kind, GL_ACTIVE_RESOURCES, &count);
+    for (GLuint i = 0; i < static_cast<GLuint>(count); ++i) {
+      std::array<GLint, kBlockProps.size()> props{};
+      glGetProgramResourceiv(renderer_id_, kind, i, kBlockProps.size(), kBlockProps.data(), props.size(), nullptr,
+                             props.data());
+      const auto binding = static_cast<std::uint32_t>(props[1]);
+      blocks_.insert_or_assign(resource_name(renderer_id_, kind, i, props[0]),
+                               ReflectedBlock{.kind = kind, .index = i, .binding = binding});
+    }
   }
 
-  const std::string key(name);
-  const GLint location    = glGetUniformLocation(renderer_id_, key.c_str());
-  uniform_locations_[key] = location;
-  if (location == -1) {
-    KEN_CORE_WARN("Unable to find uniform '{0}' in shader '{1}'", name, name_);
-    return -1;
+  KEN_CORE_DEBUG("Reflected {0} uniforms and {1} blocks in shader '{2}'", uniforms_.size(), blocks_.size(), name_);
+}
+
+OpenglShader::ReflectedUniform* OpenglShader::find_uniform(UniformId id) const {
+  const auto it = uniform_ids_.find(id.hash());
+  if (it == uniform_ids_.end()) {
+    KEN_CORE_WARN_LIMITED("Unable to find uniform '{0}' in shader '{1}'", id.name(), name_);
+    return nullptr;
+  }
+  return &uniforms_[it->second];
+}
+
+void OpenglShader::set_uniform_any(UniformId id, const UniformValue& value) const {
+  ReflectedUniform* uniform = find_uniform(id);
+  if (uniform == nullptr || uniform->value == value) {
+    return;
   }
 
-  KEN_CORE_DEBUG("Adding new uniform location for '{0}' = {1}", name, location);
-  return location;
+#ifdef KEN_DEBUG_BUILD
+  if (!accepts(uniform->type, value)) {
+    KEN_CORE_WARN_LIMITED("Uniform '{0}' in shader '{1}' is set from a value of another type", id.name(), name_);
+  }
+#endif
+
+  uniform->value = value;
+  std::visit([&](const auto& x) { kEn::set_uniform(renderer_id_, uniform->location, x); }, value);
+}
+
+void OpenglShader::set_uniform_array_any(std::string_view name, const UniformArray& values) const {
+  ReflectedUniform* uniform = find_uniform(UniformId(name));
+  if (uniform == nullptr) {
+    return;
+  }
+
+  // The elements' last values are not tracked through arrays; forget the written ones rather than go stale.
+  const std::size_t written = std::visit([](auto span) { return span.size(); }, values);
+  for (auto& element : std::span(uniform, std::min<std::size_t>(written, uniform->array_tail))) {
+    element.value.reset();
+  }
+  std::visit([&](auto span) { kEn::set_uniform_array(renderer_id_, uniform->location, span); }, values);
 }
 
 void OpenglShader::bind_uniform_block(std::string_view block_name, ShaderStage /*stage*/, std::uint32_t binding) const {
-  const std::string tmp(block_name);
-  const GLuint block_index = glGetUniformBlockIndex(renderer_id_, tmp.c_str());
-  if (block_index == GL_INVALID_INDEX) {
+  const auto it = blocks_.find(block_name);
+  if (it == blocks_.end() || it->second.kind != GL_UNIFORM_BLOCK) {
     KEN_CORE_WARN("Unable to find uniform block '{0}' in shader '{1}'", block_name, name_);
     return;
   }
 
-  uniform_block_bindings_[block_index] = binding;
-  glUniformBlockBinding(renderer_id_, block_index, binding);
-  KEN_CORE_DEBUG("Adding new uniform block '{0}' (index: {1}) in shader '{2}' to binding: {3}", block_name, block_index,
-                 name_, binding);
+  it->second.binding = binding;
+  glUniformBlockBinding(renderer_id_, it->second.index, binding);
+  KEN_CORE_DEBUG("Binding uniform block '{0}' (index: {1}) in shader '{2}' to binding: {3}", block_name,
+                 it->second.index, name_, binding);
 }
 
 std::optional<std::uint32_t> OpenglShader::uniform_block_binding(std::string_view block_name,
                                                                  ShaderStage /*stage*/) const {
-  const std::string tmp(block_name);
-  const GLuint block_index = glGetUniformBlockIndex(renderer_id_, tmp.c_str());
-  if (block_index == GL_INVALID_INDEX) {
-    return std::nullopt;
-  }
-
-  const auto it = uniform_block_bindings_.find(block_index);
-  if (it == uniform_block_bindings_.end()) {
+  const auto it = blocks_.find(block_name);
+  if (it == blocks_.end()) {
     return std::nullopt;
   }
 
-  return it->second;
+  return it->second.binding;
 }
 
 // </Uniforms>
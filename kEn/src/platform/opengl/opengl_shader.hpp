@@ -2,9 +2,15 @@
 
 #include <glad/gl.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <optional>
 #include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <mEn.hpp>
 #include <mEn/features/type_ptr.hpp>
@@ -83,7 +89,8 @@ inline void set_uniform_array(GLuint program, GLint location, std::span<const T>
  * - Vertex/fragment programs created from in-memory sources
  * - File-based loading with optional geometry/tessellation stages
  * - Basic preprocessing for `#include "..."` and `#pragma once`
- * - Uniform location caching and uniform-block binding helpers
+ * - Reflection of the active uniforms and blocks at link time
+ * - Uniform writes indexed by @ref UniformId, skipped when the value is unchanged
  *
  * @note This class is not thread-safe: it mutates internal caches in const methods.
  */
@@ -132,23 +139,10 @@ class OpenglShader final : public Shader {
 
   // <Uniforms>
 
-  void set_uniform_any(std::string_view name, const UniformValue& value) const override {
-    std::visit(
-        [&](auto const& x) {
-          const GLint location = uniform_location(name);
-          kEn::set_uniform(renderer_id_, location, x);
-        },
-        value);
-  }
-
-  void set_uniform_array_any(std::string_view name, const UniformArray& values) const override {
-    std::visit(
-        [&](auto span) {
-          const GLint location = uniform_location(name);
-          kEn::set_uniform_array(renderer_id_, location, span);
-        },
-        values);
-  }
+  using Shader::set_uniform_any;
+  void set_uniform_any(UniformId id, const UniformValue& value) const override;
+  [[nodiscard]] bool has_uniform(UniformId id) const override { return uniform_ids_.contains(id.hash()); }
+  void set_uniform_array_any(std::string_view name, const UniformArray& values) const override;
 
   void bind_uniform_block(std::string_view block_name, ShaderStage stage, std::uint32_t binding) const override;
   [[nodiscard]] std::optional<std::uint32_t> uniform_block_binding(std::string_view block_name,
@@ -163,6 +157,21 @@ class OpenglShader final : public Shader {
  private:
   struct PreprocessContext;
 
+  /** @brief Active uniform outside of any block, with the last value written to it. */
+  struct ReflectedUniform {
+    GLint location;
+    GLenum type;
+    std::optional<UniformValue> value;  ///< Unknown until first written through this shader.
+    std::uint32_t array_tail = 1;       ///< Entries an array write starting here can reach, this one included.
+  };
+
+  /** @brief Active uniform or shader storage block. */
+  struct ReflectedBlock {
+    GLenum kind;  ///< @c GL_UNIFORM_BLOCK or @c GL_SHADER_STORAGE_BLOCK.
+    GLuint index;
+    std::uint32_t binding;
+  };
+
   /**
    * @brief Read and preprocess a shader source file, recursively resolving includes.
    *
@@ -217,14 +226,19 @@ class OpenglShader final : public Shader {
   void link_shader() const;
 
   /**
-   * @brief Get (and cache) the uniform location for a given name.
+   * @brief Record the program's active uniforms and blocks; called after a successful link.
    *
-   * @param name Uniform name as declared in the shader.
-   * @return Location, or -1 if not found/active.
+   * Every uniform outside a block is indexed by the @ref UniformId hash of its name.  Array
+   * elements are indexed individually, and the first one also under the bare array name.
+   */
+  void reflect();
+
+  /**
+   * @brief Get the reflected uniform named @p id.
    *
-   * @note Caches lookups in @ref uniform_locations_ to avoid repeated driver queries.
+   * @return The uniform, or null if it is not active; a rate-limited warning is logged.
    */
-  GLint uniform_location(std::string_view name) const;
+  ReflectedUniform* find_uniform(UniformId id) const;
 
  private:
   static constexpr std::string_view kVertexExt      = ".vert";
@@ -237,8 +251,10 @@ class OpenglShader final : public Shader {
   static const std::unordered_map<std::string_view, std::string_view> kInternalLibs;
 
   std::uint32_t renderer_id_;
-  mutable std::unordered_map<std::string, GLint, StringHash, std::equal_to<>> uniform_locations_;
-  mutable std::unordered_map<GLuint, GLuint> uniform_block_bindings_;
+  mutable std::vector<ReflectedUniform> uniforms_;  ///< One entry per location.
+  /** @brief @ref UniformId::hash of every name of a uniform to its entry; an array and its first element share one. */
+  std::unordered_map<std::uint64_t, std::size_t> uniform_ids_;
+  mutable std::unordered_map<std::string, ReflectedBlock, StringHash, std::equal_to<>> blocks_;
   std::string name_;
 };
 
@@ -1,16 +1,17 @@
 #include "opengl_texture.hpp"
 
 #include <glad/gl.h>
-#include <stb_image.h>
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <span>
+#include <string>
+#include <utility>
 
 #include <kEn/core/assert.hpp>
-#include <kEn/core/log.hpp>
+#include <kEn/renderer/image.hpp>
 #include <kEn/renderer/texture.hpp>
 #include <kEn/renderer/texture_format.hpp>
 
@@ -51,11 +52,6 @@ namespace {
   }
 }
 
-[[nodiscard]] constexpr bool is_byte_color_format(TextureFormat format) noexcept {
-  return texture_format::is_color_format(format) && !texture_format::is_integer_format(format) &&
-         texture_format::bytes_per_block(format) == texture_format::color_channel_count(format);
-}
-
 }  // namespace
 
 OpenglTexture2D::OpenglTexture2D(TextureDesc desc, SamplerDesc sampler) : desc_(desc), sampler_desc_(sampler) {
@@ -73,42 +69,15 @@ OpenglTexture2D::OpenglTexture2D(TextureDesc desc, SamplerDesc sampler) : desc_(
 OpenglTexture2D::OpenglTexture2D(const std::filesystem::path& path, SamplerDesc sampler, TextureFormat format,
                                  std::uint32_t mip_levels)
     : sampler_desc_(sampler) {
-  KEN_ASSERT(is_byte_color_format(format));
-
-  int width    = 0;
-  int height   = 0;
-  int channels = 0;
-
-  const int desired_channels = static_cast<int>(texture_format::color_channel_count(format));
-
-  stbi_set_flip_vertically_on_load(1);
-  stbi_uc* data = stbi_load(path.string().c_str(), &width, &height, &channels, desired_channels);
-
-  if (data == nullptr) {
-    KEN_CORE_CRITICAL("stb_image load error: {0}", stbi_failure_reason());
-    return;
+  if (const auto image = Image::load(path, format)) {
+    init_from_image(*image, mip_levels, path.generic_string());
   }
+}
 
-  KEN_ASSERT(width > 0);
-  KEN_ASSERT(height > 0);
-
-  desc_ = TextureDesc::texture_2d(static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), format,
-                                  mip_levels);
-
-  KEN_ASSERT(desc_.has_valid_mip_request());
-
-  allocate_storage();
-  apply_sampler_state();
-
-  const std::size_t size_bytes = static_cast<std::size_t>(desc_.width) * static_cast<std::size_t>(desc_.height) *
-                                 static_cast<std::size_t>(texture_format::bytes_per_block(desc_.format));
-
-  set_data(std::span<const std::byte>{reinterpret_cast<const std::byte*>(data), size_bytes}, 0, 0);
-
-  stbi_image_free(data);
-
-  KEN_CORE_INFO("Loaded texture '{}' ({}x{}, source channels: {}, requested channels: {})", path.string(), width,
-                height, channels, desired_channels);
+OpenglTexture2D::OpenglTexture2D(const Image& image, SamplerDesc sampler, std::uint32_t mip_levels,
+                                 std::string debug_name)
+    : sampler_desc_(sampler) {
+  init_from_image(image, mip_levels, std::move(debug_name));
 }
 
 OpenglTexture2D::~OpenglTexture2D() { glDeleteTextures(1, &renderer_id_); }
@@ -137,6 +106,16 @@ void OpenglTexture2D::set_data(std::span<const std::byte> data, std::uint32_t mi
   }
 }
 
+void OpenglTexture2D::init_from_image(const Image& image, std::uint32_t mip_levels, std::string debug_name) {
+  desc_            = image.texture_desc(mip_levels);
+  desc_.debug_name = std::move(debug_name);
+  KEN_ASSERT(desc_.has_valid_mip_request());
+
+  allocate_storage();
+  apply_sampler_state();
+  set_data(image.pixels(), 0, 0);
+}
+
 void OpenglTexture2D::allocate_storage() {
   KEN_ASSERT(renderer_id_ == 0);
 
@@ -147,6 +126,7 @@ void OpenglTexture2D::allocate_storage() {
   glCreateTextures(GL_TEXTURE_2D, 1, &renderer_id_);
   glTextureStorage2D(renderer_id_, static_cast<GLsizei>(desc_.resolved_mip_levels()), internal_format_,
                      static_cast<GLsizei>(desc_.width), static_cast<GLsizei>(desc_.height));
+  memory_ = TrackedMemory(MemoryCategory::Texture, desc_.debug_name, desc_.memory_size());
 }
 
 void OpenglTexture2D::apply_sampler_state() {
@@ -4,7 +4,10 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <string>
 
+#include <kEn/core/memory_tracker.hpp>
+#include <kEn/renderer/image.hpp>
 #include <kEn/renderer/texture.hpp>
 
 namespace kEn {
@@ -46,6 +49,15 @@ class OpenglTexture2D : public Texture {
    */
   explicit OpenglTexture2D(const std::filesystem::path& path, SamplerDesc sampler = {},
                            TextureFormat format = TextureFormat::RGBA8, std::uint32_t mip_levels = kFullMipChain);
+  /**
+   * @brief Allocates storage for an already decoded @p image and uploads its pixels.
+   *
+   * @param image      Decoded pixels, e.g. from a worker thread.
+   * @param sampler    Sampler parameters applied once at construction.
+   * @param mip_levels Mip level count; use @ref kFullMipChain to generate a full chain.
+   * @param debug_name Label for memory accounting, usually the image's path.
+   */
+  OpenglTexture2D(const Image& image, SamplerDesc sampler, std::uint32_t mip_levels, std::string debug_name);
   ~OpenglTexture2D() override;
 
   [[nodiscard]] const TextureDesc& desc() const override { return desc_; }
@@ -63,6 +75,7 @@ class OpenglTexture2D : public Texture {
   [[nodiscard]] ImTextureID imgui_id() const noexcept override { return static_cast<ImTextureID>(renderer_id_); }
 
  private:
+  void init_from_image(const Image& image, std::uint32_t mip_levels, std::string debug_name);
   void allocate_storage();
   void apply_sampler_state();
 
@@ -74,6 +87,8 @@ class OpenglTexture2D : public Texture {
   GLenum internal_format_ = GL_NONE;
   GLenum upload_format_   = GL_NONE;
   GLenum upload_type_     = GL_NONE;
+
+  TrackedMemory memory_;
 };
 
 }  // namespace kEn
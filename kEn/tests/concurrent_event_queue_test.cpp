@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <kEn/event/concurrent_event_queue.hpp>
+#include <kEn/event/event.hpp>
+
+namespace {
+
+struct SequenceEvent : kEn::Event<SequenceEvent> {
+  SequenceEvent(std::size_t producer, std::size_t sequence) : producer(producer), sequence(sequence) {}
+
+  std::size_t producer;
+  std::size_t sequence;
+};
+
+/** @brief Too large for a queue node, so it takes the heap path. */
+struct LargeEvent : kEn::Event<LargeEvent> {
+  explicit LargeEvent(int* destroyed) : destroyed(destroyed) {}
+  ~LargeEvent() override { ++*destroyed; }
+  DELETE_COPY_MOVE(LargeEvent);
+
+  int* destroyed;
+  std::array<std::byte, 512> payload{};
+};
+
+}  // namespace
+
+TEST(ConcurrentEventQueue, SingleProducerKeepsPostOrder) {
+  kEn::ConcurrentEventQueue queue;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    queue.post<SequenceEvent>(0, i);
+  }
+
+  std::vector<std::size_t> order;
+  const std::size_t delivered =
+      queue.drain([&](kEn::BaseEvent& e) { order.push_back(static_cast<SequenceEvent&>(e).sequence); });
+
+  ASSERT_EQ(delivered, 1000U);
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(ConcurrentEventQueue, ProducersKeepTheirOwnOrderAndNothingIsLost) {
+  constexpr std::size_t kProducers = 4;
+  constexpr std::size_t kEvents    = 20'000;
+
+  kEn::ConcurrentEventQueue queue;
+  std::array<std::size_t, kProducers> next{};
+  std::size_t delivered = 0;
+  const auto consume    = [&](kEn::BaseEvent& e) {
+    const auto& event = static_cast<SequenceEvent&>(e);
+    EXPECT_EQ(event.sequence, next[event.producer]);
+    next[event.producer] = event.sequence + 1;
+    ++delivered;
+  };
+
+  {
+    std::vector<std::jthread> producers;
+    for (std::size_t p = 0; p < kProducers; ++p) {
+      producers.emplace_back([&queue, p] {
+        for (std::size_t i = 0; i < kEvents; ++i) {
+          queue.post<SequenceEvent>(p, i);
+        }
+      });
+    }
+    // Drain while the producers are still posting.
+    while (delivered < kProducers * kEvents / 2) {
+      queue.drain(consume);
+    }
+  }
+  queue.drain(consume);
+
+  EXPECT_EQ(delivered, kProducers * kEvents);
+  for (const std::size_t count : next) {
+    EXPECT_EQ(count, kEvents);
+  }
+}
+
+TEST(ConcurrentEventQueue, EventsPostedWhileDrainingWaitForTheNextDrain) {
+  kEn::ConcurrentEventQueue queue;
+  queue.post<SequenceEvent>(0, 0);
+
+  std::vector<std::size_t> order;
+  const auto handler = [&](kEn::BaseEvent& e) {
+    const auto sequence = static_cast<SequenceEvent&>(e).sequence;
+    order.push_back(sequence);
+    if (sequence == 0) {
+      queue.post<SequenceEvent>(0, 1);
+    }
+  };
+
+  EXPECT_EQ(queue.drain(handler), 1U);
+  EXPECT_FALSE(queue.empty());
+  EXPECT_EQ(queue.drain(handler), 1U);
+  EXPECT_EQ(order, (std::vector<std::size_t>{0, 1}));
+}
+
+TEST(ConcurrentEventQueue, DrainReturnsWhileProducersKeepPosting) {
+  kEn::ConcurrentEventQueue queue;
+  std::size_t delivered = 0;
+  {
+    const std::jthread producer([&queue](const std::stop_token& stop) {
+      for (std::size_t i = 0; !stop.stop_requested(); ++i) {
+        queue.post<SequenceEvent>(0, i);
+      }
+    });
+    while (queue.empty()) {
+      std::this_thread::yield();
+    }
+    // Each drain stops at the newest event posted when it started, however fast the producer is.
+    for (int i = 0; i < 100; ++i) {
+      delivered += queue.drain([](kEn::BaseEvent&) {});
+    }
+  }
+  delivered += queue.drain([](kEn::BaseEvent&) {});
+  EXPECT_GT(delivered, 0U);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(ConcurrentEventQueue, DestroysDeliveredAndUndeliveredEvents) {
+  int destroyed = 0;
+  {
+    kEn::ConcurrentEventQueue queue;
+    queue.post<LargeEvent>(&destroyed);
+    EXPECT_EQ(queue.drain([](kEn::BaseEvent&) {}), 1U);
+    EXPECT_EQ(destroyed, 1);
+
+    queue.post<LargeEvent>(&destroyed);
+    queue.post<LargeEvent>(&destroyed);
+  }
+  EXPECT_EQ(destroyed, 3);
+}
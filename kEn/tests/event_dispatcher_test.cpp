@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <kEn/core/input/key_codes.hpp>
+#include <kEn/core/input/mod_keys.hpp>
+#include <kEn/event/application_events.hpp>
+#include <kEn/event/event.hpp>
+#include <kEn/event/key_events.hpp>
+
+namespace {
+
+using kEn::BaseEvent;
+using kEn::EventDispatcher;
+using kEn::KeyPressedEvent;
+using kEn::WindowCloseEvent;
+using kEn::WindowResizeEvent;
+
+}  // namespace
+
+TEST(EventDispatcher, IdsAreDenseAndStable) {
+  const auto close  = WindowCloseEvent::static_id();
+  const auto resize = WindowResizeEvent::static_id();
+
+  EXPECT_NE(close, kEn::kCatchAllEventId);
+  EXPECT_NE(resize, kEn::kCatchAllEventId);
+  EXPECT_NE(close, resize);
+  EXPECT_EQ(WindowCloseEvent::static_id(), close);
+
+  const WindowResizeEvent event(1, 2);
+  EXPECT_EQ(event.event_id(), resize);
+}
+
+TEST(EventDispatcher, DeliversOnlyToSubscribersOfTheEventType) {
+  EventDispatcher dispatcher;
+  std::vector<int> calls;
+  dispatcher.subscribe([&](WindowCloseEvent&) {
+    calls.push_back(1);
+    return false;
+  });
+  dispatcher.subscribe([&](WindowResizeEvent& e) {
+    calls.push_back(static_cast<int>(e.width()));
+    return false;
+  });
+
+  WindowResizeEvent resize(7, 8);
+  EXPECT_FALSE(dispatcher.dispatch(resize));
+  WindowCloseEvent close;
+  EXPECT_FALSE(dispatcher.dispatch(close));
+  KeyPressedEvent key(kEn::key::a, kEn::ModKeys{}, false);
+  EXPECT_FALSE(dispatcher.dispatch(key));
+
+  EXPECT_EQ(calls, (std::vector{7, 1}));
+  EXPECT_EQ(dispatcher.size(), 2U);
+  EXPECT_FALSE(dispatcher.listens_to(key));
+}
+
+TEST(EventDispatcher, CatchAllRunsAfterTypedSubscribers) {
+  EventDispatcher dispatcher;
+  std::vector<int> calls;
+  dispatcher.subscribe<BaseEvent>([&](BaseEvent&) {
+    calls.push_back(0);
+    return false;
+  });
+  dispatcher.subscribe([&](WindowCloseEvent&) {
+    calls.push_back(1);
+    return false;
+  });
+
+  WindowCloseEvent close;
+  EXPECT_FALSE(dispatcher.dispatch(close));
+  KeyPressedEvent key(kEn::key::a, kEn::ModKeys{}, false);
+  EXPECT_FALSE(dispatcher.dispatch(key));
+
+  EXPECT_EQ(calls, (std::vector{1, 0, 0}));
+  EXPECT_TRUE(dispatcher.listens_to(key));
+}
+
+TEST(EventDispatcher, HandledEventStopsPropagation) {
+  EventDispatcher dispatcher;
+  int later = 0;
+  dispatcher.subscribe([](WindowCloseEvent&) { return true; });
+  dispatcher.subscribe([&](WindowCloseEvent&) { return ++later > 0; });
+  dispatcher.subscribe<BaseEvent>([&](BaseEvent&) { return ++later > 0; });
+
+  WindowCloseEvent close;
+  EXPECT_TRUE(dispatcher.dispatch(close));
+  EXPECT_TRUE(close.handled);
+  EXPECT_EQ(later, 0);
+}
+
+TEST(EventDispatcher, ClearRemovesEverySubscriber) {
+  EventDispatcher dispatcher;
+  dispatcher.subscribe([](WindowCloseEvent&) { return true; });
+  dispatcher.clear();
+
+  WindowCloseEvent close;
+  EXPECT_TRUE(dispatcher.empty());
+  EXPECT_FALSE(dispatcher.dispatch(close));
+}
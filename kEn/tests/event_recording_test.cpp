@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mEn/vec2.hpp>
+
+#include <kEn/core/input/key_codes.hpp>
+#include <kEn/core/input/mod_keys.hpp>
+#include <kEn/core/input/mouse_codes.hpp>
+#include <kEn/core/timestep.hpp>
+#include <kEn/event/application_events.hpp>
+#include <kEn/event/event.hpp>
+#include <kEn/event/event_recording.hpp>
+#include <kEn/event/key_events.hpp>
+#include <kEn/event/mouse_events.hpp>
+
+namespace {
+
+using kEn::duration_t;
+using kEn::EventRecorder;
+using kEn::EventReplay;
+using namespace std::chrono_literals;  // NOLINT(google-build-using-namespace)
+
+constexpr duration_t kTickTime = 10ms;
+/** @brief Size of one entry of the file format, see @c FileEntry in event_recording.cpp. */
+constexpr std::uintmax_t kEntrySize = 28;
+
+/** @brief Events arriving before the tick they are paired with, ordered by tick. */
+struct TimedEvents {
+  std::vector<std::pair<std::uint64_t, std::unique_ptr<kEn::BaseEvent>>> events;
+
+  template <typename T, typename... Args>
+  void add(std::uint64_t tick, Args&&... args) {
+    events.emplace_back(tick, std::make_unique<T>(std::forward<Args>(args)...));
+  }
+};
+
+/** @brief Removes its file on destruction, so each test starts from a fresh path. */
+class RecordingFile {
+ public:
+  explicit RecordingFile(const std::string& name)
+      : path_(std::filesystem::temp_directory_path() / ("ken_" + name + ".rec")) {}
+  ~RecordingFile() { std::filesystem::remove(path_); }
+
+  RecordingFile(const RecordingFile&)            = delete;
+  RecordingFile& operator=(const RecordingFile&) = delete;
+
+  [[nodiscard]] const std::filesystem::path& path() const { return path_; }
+
+ private:
+  std::filesystem::path path_;
+};
+
+/** @brief Delivered events as (tick, description) pairs, describing each by its @c to_string(). */
+std::vector<std::pair<std::uint64_t, std::string>> replay_all(EventReplay& replay) {
+  std::vector<std::pair<std::uint64_t, std::string>> delivered;
+  for (std::uint64_t tick = 0; !replay.finished(tick); ++tick) {
+    replay.deliver(tick, [&](kEn::BaseEvent& event) { delivered.emplace_back(tick, event.to_string()); });
+  }
+  return delivered;
+}
+
+TimedEvents sample_session() {
+  const kEn::ModKeys shift_control = kEn::ModKey::Shift | kEn::ModKey::Control;
+  TimedEvents session;
+  session.add<kEn::WindowResizeEvent>(0, 1280U, 720U);
+  session.add<kEn::KeyPressedEvent>(2, kEn::key::a, shift_control, false);
+  session.add<kEn::KeyPressedEvent>(2, kEn::key::a, shift_control, true);
+  session.add<kEn::MouseMoveEvent>(3, mEn::Vec2(10.5F, 20.25F));
+  session.add<kEn::MouseButtonPressedEvent>(3, mEn::Vec2(10.5F, 20.25F), kEn::mouse::button_left, kEn::ModKeys{});
+  session.add<kEn::MouseDragEvent>(4, mEn::Vec2(10.5F, 20.25F), mEn::Vec2(30.F, 5.F), kEn::mouse::button_left,
+                                   kEn::ModKeys{});
+  session.add<kEn::MouseScrollEvent>(4, mEn::Vec2(0.F, -2.F));
+  session.add<kEn::KeyReleasedEvent>(6, kEn::key::a, kEn::ModKeys{});
+  session.add<kEn::KeyTypedEvent>(6, kEn::key::b);
+  session.add<kEn::WindowResizeEvent>(7, 0U, 0U);
+  session.add<kEn::WindowCloseEvent>(8);
+  return session;
+}
+
+}  // namespace
+
+TEST(EventRecording, ReplayDeliversEveryEventBeforeItsTick) {
+  const RecordingFile file("round_trip");
+  const TimedEvents session = sample_session();
+  std::vector<std::pair<std::uint64_t, std::string>> expected;
+  {
+    EventRecorder recorder(file.path(), kTickTime);
+    for (const auto& [tick, event] : session.events) {
+      recorder.record(tick, *event);
+      expected.emplace_back(tick, event->to_string());
+    }
+    ASSERT_TRUE(recorder.good());
+    recorder.finish(10);
+  }
+
+  const auto replay = EventReplay::load(file.path());
+  ASSERT_NE(replay, nullptr);
+  EXPECT_EQ(replay->tick_time(), kTickTime);
+  EXPECT_EQ(replay->tick_count(), 10U);
+  EXPECT_TRUE(replay->tick_intervals().empty());
+  EXPECT_EQ(replay_all(*replay), expected);
+}
+
+TEST(EventRecording, TickIntervalsRoundTrip) {
+  const RecordingFile file("tick_intervals");
+  const std::vector<duration_t> intervals{0ns, 16'666'667ns, 9'000'001ns, 33ms, 1ns};
+  {
+    EventRecorder recorder(file.path(), kTickTime);
+    for (std::uint64_t tick = 0; tick < intervals.size(); ++tick) {
+      recorder.record_tick(tick, intervals[tick]);
+      recorder.record(tick, kEn::MouseMoveEvent(mEn::Vec2(static_cast<float>(tick))));
+    }
+    recorder.finish(intervals.size());
+  }
+
+  const auto replay = EventReplay::load(file.path());
+  ASSERT_NE(replay, nullptr);
+  EXPECT_EQ(replay->tick_intervals(), intervals);
+  EXPECT_EQ(replay->tick_count(), intervals.size());
+  EXPECT_EQ(replay_all(*replay).size(), intervals.size());
+}
+
+TEST(EventRecording, NonWindowEventsAreNotRecorded) {
+  struct GameplayEvent : kEn::Event<GameplayEvent> {};
+
+  const RecordingFile file("non_window");
+  {
+    EventRecorder recorder(file.path(), kTickTime);
+    recorder.record(0, GameplayEvent{});
+    recorder.record(1, kEn::WindowCloseEvent{});
+  }
+
+  const auto replay = EventReplay::load(file.path());
+  ASSERT_NE(replay, nullptr);
+  EXPECT_EQ(replay->tick_count(), 2U);  // The destructor ends the recording after its last event
+  const auto delivered = replay_all(*replay);
+  ASSERT_EQ(delivered.size(), 1U);
+  EXPECT_EQ(delivered.front(), std::make_pair(std::uint64_t{1}, kEn::WindowCloseEvent{}.to_string()));
+}
+
+TEST(EventRecording, RecordingCutShortReplaysUpToItsLastEntry) {
+  const RecordingFile file("cut_short");
+  {
+    EventRecorder recorder(file.path(), kTickTime);
+    for (std::uint64_t tick = 0; tick < 4; ++tick) {
+      recorder.record_tick(tick, kTickTime);
+    }
+    recorder.record(5, kEn::KeyTypedEvent(kEn::key::c));
+    recorder.finish(100);
+  }
+  // Drop the end entry, as a crash during recording would.
+  const auto size = std::filesystem::file_size(file.path());
+  std::filesystem::resize_file(file.path(), size - kEntrySize);
+
+  const auto replay = EventReplay::load(file.path());
+  ASSERT_NE(replay, nullptr);
+  EXPECT_EQ(replay->tick_count(), 6U);
+  EXPECT_EQ(replay->tick_intervals().size(), 4U);
+  EXPECT_EQ(replay_all(*replay).size(), 1U);
+}
+
+TEST(EventRecording, RejectsMissingAndForeignFiles) {
+  const RecordingFile file("foreign");
+  EXPECT_EQ(EventReplay::load(file.path()), nullptr);
+
+  std::ofstream(file.path(), std::ios::binary) << "definitely not a recording";
+  EXPECT_EQ(EventReplay::load(file.path()), nullptr);
+}
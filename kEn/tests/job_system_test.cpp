@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <kEn/core/job_system.hpp>
+
+namespace {
+
+using kEn::JobCounter;
+using kEn::JobSystem;
+
+constexpr std::uint32_t kWorkers = 4;
+
+/** @brief Runs a pool of four workers for the duration of a test. */
+class JobSystemTest : public ::testing::Test {
+ protected:
+  JobSystemTest() { JobSystem::init(kWorkers); }
+  ~JobSystemTest() override { JobSystem::shutdown(); }
+
+  JobSystemTest(const JobSystemTest&)            = delete;
+  JobSystemTest& operator=(const JobSystemTest&) = delete;
+};
+
+/** @brief One counter per index, to check that every index is handled exactly once. */
+class HitCounts {
+ public:
+  explicit HitCounts(std::size_t count) : hits_(count) {}
+
+  void hit(std::size_t index) { hits_[index].fetch_add(1, std::memory_order_relaxed); }
+
+  [[nodiscard]] bool each_once() const {
+    for (const auto& hit : hits_) {
+      if (hit.load() != 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::vector<std::atomic<int>> hits_;
+};
+
+}  // namespace
+
+TEST(JobSystem, RunsInlineWithoutAPool) {
+  ASSERT_EQ(JobSystem::worker_count(), 0U);
+  EXPECT_EQ(JobSystem::worker_index(), -1);
+
+  JobCounter counter;
+  int value = 0;
+  JobSystem::run(counter, [&value] { value = 1; });
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(counter.done());
+
+  JobCounter after;
+  JobSystem::run_after(counter, after, [&value] { value = 2; });
+  EXPECT_EQ(value, 2);
+  EXPECT_TRUE(after.done());
+}
+
+TEST_F(JobSystemTest, EveryJobRunsExactlyOnce) {
+  constexpr std::size_t kJobs = 20'000;
+  HitCounts hits(kJobs);
+  JobCounter counter;
+  for (std::size_t i = 0; i < kJobs; ++i) {
+    JobSystem::run(counter, [&hits, i] { hits.hit(i); });
+  }
+  JobSystem::wait(counter);
+
+  EXPECT_TRUE(counter.done());
+  EXPECT_TRUE(hits.each_once());
+  EXPECT_GE(JobSystem::stats().executed, kJobs);
+}
+
+TEST_F(JobSystemTest, CountersCanBeReused) {
+  JobCounter counter;
+  std::atomic<int> runs = 0;
+  for (int round = 0; round < 100; ++round) {
+    for (int i = 0; i < 10; ++i) {
+      JobSystem::run(counter, [&runs] { runs.fetch_add(1); });
+    }
+    JobSystem::wait(counter);
+    ASSERT_EQ(runs.load(), (round + 1) * 10);
+  }
+}
+
+TEST_F(JobSystemTest, RunAfterWaitsForEveryDependency) {
+  constexpr int kDependencies  = 64;
+  constexpr int kContinuations = 64;
+  std::atomic<int> finished    = 0;
+  std::atomic<int> early       = 0;
+
+  JobCounter dependencies;
+  JobCounter continuations;
+  for (int i = 0; i < kDependencies; ++i) {
+    JobSystem::run(dependencies, [&finished] {
+      std::this_thread::yield();
+      finished.fetch_add(1);
+    });
+  }
+  for (int i = 0; i < kContinuations; ++i) {
+    JobSystem::run_after(dependencies, continuations, [&] {
+      if (finished.load() != kDependencies) {
+        early.fetch_add(1);
+      }
+    });
+  }
+  JobSystem::wait(continuations);
+
+  EXPECT_TRUE(dependencies.done());
+  EXPECT_EQ(early.load(), 0);
+}
+
+TEST_F(JobSystemTest, RunAfterChainsRunInOrder) {
+  constexpr int kStages = 50;
+  std::vector<int> order;
+  std::mutex mutex;
+  std::vector<JobCounter> stages(kStages);
+
+  JobSystem::run(stages[0], [&] {
+    const std::scoped_lock lock(mutex);
+    order.push_back(0);
+  });
+  for (int stage = 1; stage < kStages; ++stage) {
+    JobSystem::run_after(stages[stage - 1], stages[stage], [&, stage] {
+      const std::scoped_lock lock(mutex);
+      order.push_back(stage);
+    });
+  }
+  JobSystem::wait(stages.back());
+
+  ASSERT_EQ(order.size(), static_cast<std::size_t>(kStages));
+  for (int stage = 0; stage < kStages; ++stage) {
+    EXPECT_EQ(order[stage], stage);
+  }
+}
+
+TEST_F(JobSystemTest, RunAfterADoneCounterRunsRightAway) {
+  JobCounter done;
+  JobCounter counter;
+  std::atomic<bool> ran = false;
+  JobSystem::run_after(done, counter, [&ran] { ran = true; });
+  JobSystem::wait(counter);
+  EXPECT_TRUE(ran.load());
+}
+
+TEST_F(JobSystemTest, JobsCanWaitForTheJobsTheySpawn) {
+  // More parents than workers: every worker blocks in a nested wait and has to run other jobs meanwhile.
+  constexpr std::size_t kParents         = 4 * kWorkers;
+  constexpr std::size_t kChildren        = 500;
+  std::atomic<std::size_t> children_done = 0;
+  std::atomic<std::size_t> incomplete    = 0;
+
+  JobCounter parents;
+  for (std::size_t p = 0; p < kParents; ++p) {
+    JobSystem::run(parents, [&] {
+      JobCounter children;
+      std::atomic<std::size_t> mine = 0;
+      for (std::size_t c = 0; c < kChildren; ++c) {
+        JobSystem::run(children, [&] {
+          mine.fetch_add(1);
+          children_done.fetch_add(1);
+        });
+      }
+      JobSystem::wait(children);
+      if (mine.load() != kChildren) {
+        incomplete.fetch_add(1);
+      }
+    });
+  }
+  JobSystem::wait(parents);
+
+  EXPECT_EQ(children_done.load(), kParents * kChildren);
+  EXPECT_EQ(incomplete.load(), 0U);
+}
+
+TEST_F(JobSystemTest, ParallelForCoversUnevenRangesOnce) {
+  const std::vector<std::pair<std::size_t, std::size_t>> cases{
+      {0, 1}, {1, 1}, {7, 1}, {7, 3}, {1000, 1}, {1000, 64}, {4097, 5}, {4097, 5000}, {12'345, 128}};
+  for (const auto& [count, grain] : cases) {
+    HitCounts hits(count);
+    std::atomic<bool> small_chunk = false;
+    JobSystem::parallel_for(
+        count,
+        [&, count, grain](std::size_t begin, std::size_t end) {
+          // Only the last chunk may be shorter than the grain.
+          if (end - begin < grain && end != count) {
+            small_chunk = true;
+          }
+          for (std::size_t i = begin; i < end; ++i) {
+            hits.hit(i);
+          }
+        },
+        grain);
+
+    EXPECT_TRUE(hits.each_once()) << count << " elements, grain " << grain;
+    EXPECT_FALSE(small_chunk.load()) << count << " elements, grain " << grain;
+  }
+}
+
+TEST_F(JobSystemTest, NonWorkerThreadsShareTheQueue) {
+  constexpr std::size_t kThreads = 4;
+  constexpr std::size_t kJobs    = 5000;
+  HitCounts hits(kThreads * kJobs);
+  std::atomic<int> outside_index = 0;
+
+  {
+    std::vector<std::jthread> submitters;
+    for (std::size_t t = 0; t < kThreads; ++t) {
+      submitters.emplace_back([&, t] {
+        if (JobSystem::worker_index() != -1) {
+          outside_index.fetch_add(1);
+        }
+        JobCounter counter;
+        for (std::size_t i = 0; i < kJobs; ++i) {
+          JobSystem::run(counter, [&hits, index = (t * kJobs) + i] { hits.hit(index); });
+        }
+        JobSystem::wait(counter);
+      });
+    }
+  }
+
+  EXPECT_EQ(outside_index.load(), 0);
+  EXPECT_TRUE(hits.each_once());
+}
+
+TEST_F(JobSystemTest, JobsRunOnWorkersOrOnWaitingThreads) {
+  std::atomic<int> bad_index = 0;
+  JobCounter counter;
+  for (int i = 0; i < 1000; ++i) {
+    JobSystem::run(counter, [&bad_index] {
+      const int index = JobSystem::worker_index();
+      if (index < -1 || index >= static_cast<int>(kWorkers)) {
+        bad_index.fetch_add(1);
+      }
+    });
+  }
+  JobSystem::wait(counter);
+  EXPECT_EQ(bad_index.load(), 0);
+}
+
+TEST_F(JobSystemTest, DetachedJobsRun) {
+  std::atomic<int> runs = 0;
+  for (int i = 0; i < 100; ++i) {
+    JobSystem::run_detached([&runs] {
+      runs.fetch_add(1);
+      runs.notify_one();
+    });
+  }
+  for (int seen = runs.load(); seen < 100; seen = runs.load()) {
+    runs.wait(seen);
+  }
+  EXPECT_EQ(runs.load(), 100);
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <mEn/constants.hpp>
+#include <mEn/functions/geometric.hpp>
+#include <mEn/functions/matrix_common.hpp>
+#include <mEn/functions/matrix_projection.hpp>
+#include <mEn/functions/matrix_transform.hpp>
+#include <mEn/mat4.hpp>
+#include <mEn/vec3.hpp>
+#include <mEn/vec4.hpp>
+
+#include <kEn/renderer/light_clusters.hpp>
+#include <kEn/scene/components/light.hpp>
+
+namespace {
+
+using kEn::Attenuation;
+using kEn::LightClusters;
+using kEn::PointLight;
+using kEn::SpotLight;
+
+constexpr float kNear = 0.1F;
+constexpr float kFar  = 100.F;
+
+/** @brief Random point and spot lights around a camera looking at the origin, with a fixed seed. */
+class LightClustersTest : public ::testing::Test {
+ protected:
+  LightClustersTest()
+      : view_(mEn::lookAt(mEn::Vec3(0.F, 2.F, 10.F), mEn::Vec3(0.F), mEn::Vec3(0.F, 1.F, 0.F))),
+        projection_(mEn::perspective(mEn::kPi<float> / 3.F, 16.F / 9.F, kNear, kFar)),
+        rng_(31) {
+    std::uniform_real_distribution<float> coordinate(-20.F, 20.F);
+    std::uniform_real_distribution<float> radius(0.5F, 6.F);
+    std::uniform_real_distribution<float> cutoff(0.5F, 0.95F);
+    for (int i = 0; i < 300; ++i) {
+      points_.push_back({.color = mEn::Vec3(1.F),
+                         .pos   = {coordinate(rng_), coordinate(rng_), coordinate(rng_)},
+                         .atten = Attenuation::from_radius(radius(rng_))});
+    }
+    for (int i = 0; i < 100; ++i) {
+      const mEn::Vec3 dir = mEn::normalize(mEn::Vec3(coordinate(rng_), coordinate(rng_), coordinate(rng_)));
+      const float outer   = cutoff(rng_);
+      spots_.push_back({.color        = mEn::Vec3(1.F),
+                        .pos          = {coordinate(rng_), coordinate(rng_), coordinate(rng_)},
+                        .dir          = dir,
+                        .atten        = Attenuation::from_radius(radius(rng_) * 2.F),
+                        .cutoff       = std::min(outer + 0.03F, 1.F),
+                        .outer_cutoff = outer});
+    }
+  }
+
+  /** @brief Random world-space point inside the view frustum. */
+  mEn::Vec3 random_visible_point() {
+    std::uniform_real_distribution<float> ndc(-1.F, 1.F);
+    std::uniform_real_distribution<float> log_depth(std::log(kNear), std::log(30.F));
+    const float depth       = std::exp(log_depth(rng_));
+    const mEn::Vec4 near    = mEn::inverse(projection_) * mEn::Vec4(ndc(rng_), ndc(rng_), -1.F, 1.F);
+    const mEn::Vec3 in_view = mEn::Vec3(near) / near.w * (depth / -(near.z / near.w));
+    return mEn::Vec3(mEn::inverse(view_) * mEn::Vec4(in_view, 1.F));
+  }
+
+  /** @brief CPU copy of @c find_cluster in `light.glsl`. */
+  const LightClusters::Cluster& find_cluster(const mEn::Vec3& world) const {
+    const auto& header   = clusters_.header();
+    const mEn::Vec4 clip = projection_ * view_ * mEn::Vec4(world, 1.F);
+    const auto tile      = [&clip](float ndc, std::uint32_t tiles) {
+      const float scaled = ((ndc / clip.w * 0.5F) + 0.5F) * static_cast<float>(tiles);
+      return static_cast<std::uint32_t>(std::clamp(scaled, 0.F, static_cast<float>(tiles - 1)));
+    };
+
+    const float depth     = std::max(-(view_ * mEn::Vec4(world, 1.F)).z, 1e-4F);
+    const float slice     = std::floor((std::log(depth) * header.depth_scale) + header.depth_bias);
+    const auto z          = static_cast<std::uint32_t>(std::clamp(slice, 0.F, static_cast<float>(header.slices - 1)));
+    const std::uint32_t x = tile(clip.x, header.tiles_x);
+    const std::uint32_t y = tile(clip.y, header.tiles_y);
+    return clusters_.clusters()[(((z * header.tiles_y) + y) * header.tiles_x) + x];
+  }
+
+  [[nodiscard]] std::vector<std::uint32_t> points_of(const LightClusters::Cluster& cluster) const {
+    const auto indices = clusters_.indices().subspan(cluster.first, cluster.point_count);
+    return {indices.begin(), indices.end()};
+  }
+
+  [[nodiscard]] std::vector<std::uint32_t> spots_of(const LightClusters::Cluster& cluster) const {
+    const auto indices = clusters_.indices().subspan(cluster.first + cluster.point_count, cluster.spot_count);
+    return {indices.begin(), indices.end()};
+  }
+
+  void build() { clusters_.build(view_, projection_, points_, spots_); }
+
+  mEn::Mat4 view_;
+  mEn::Mat4 projection_;
+  std::mt19937 rng_;
+  std::vector<PointLight::Data> points_;
+  std::vector<SpotLight::Data> spots_;
+  LightClusters clusters_;
+};
+
+bool lists(const std::vector<std::uint32_t>& list, std::uint32_t light) {
+  return std::ranges::find(list, light) != list.end();
+}
+
+}  // namespace
+
+TEST_F(LightClustersTest, ListsCoverTheIndexBufferInOrder) {
+  build();
+  std::uint32_t next  = 0;
+  std::size_t longest = 0;
+  for (const auto& cluster : clusters_.clusters()) {
+    EXPECT_EQ(cluster.first, next);
+    next += cluster.point_count + cluster.spot_count;
+    longest = std::max<std::size_t>(longest, cluster.point_count + cluster.spot_count);
+    for (const auto light : points_of(cluster)) {
+      EXPECT_LT(light, points_.size());
+    }
+    for (const auto light : spots_of(cluster)) {
+      EXPECT_LT(light, spots_.size());
+    }
+  }
+  EXPECT_EQ(next, clusters_.indices().size());
+  EXPECT_EQ(clusters_.stats().references, clusters_.indices().size());
+  EXPECT_EQ(clusters_.stats().max_lights, longest);
+  EXPECT_EQ(clusters_.clusters().size(), LightClusters::kClusterCount);
+}
+
+TEST_F(LightClustersTest, DepthSlicesSpanNearToFar) {
+  build();
+  const auto& header = clusters_.header();
+  EXPECT_NEAR((std::log(kNear) * header.depth_scale) + header.depth_bias, 0.F, 1e-3F);
+  EXPECT_NEAR((std::log(kFar) * header.depth_scale) + header.depth_bias, static_cast<float>(LightClusters::kSlices),
+              1e-3F);
+}
+
+TEST_F(LightClustersTest, EveryLightReachingAPointIsInItsCluster) {
+  build();
+  std::size_t reached = 0;
+  for (int i = 0; i < 20'000; ++i) {
+    const mEn::Vec3 point = random_visible_point();
+    const auto& cluster   = find_cluster(point);
+
+    const auto points = points_of(cluster);
+    for (std::uint32_t light = 0; light < points_.size(); ++light) {
+      if (mEn::length(point - points_[light].pos) < points_[light].atten.radius()) {
+        ++reached;
+        EXPECT_TRUE(lists(points, light)) << "point light " << light << ", sample " << i;
+      }
+    }
+
+    const auto spots = spots_of(cluster);
+    for (std::uint32_t light = 0; light < spots_.size(); ++light) {
+      const auto& spot   = spots_[light];
+      const mEn::Vec3 to = point - spot.pos;
+      const float length = mEn::length(to);
+      if (length < spot.atten.radius() && mEn::dot(to, spot.dir) >= spot.outer_cutoff * length) {
+        ++reached;
+        EXPECT_TRUE(lists(spots, light)) << "spot light " << light << ", sample " << i;
+      }
+    }
+  }
+  EXPECT_GT(reached, 10'000U);
+}
+
+TEST_F(LightClustersTest, LightsOutsideTheFrustumAreInNoCluster) {
+  // A point light behind the camera and a spot light beyond the far plane, pointing away.
+  points_ = {{.color = mEn::Vec3(1.F), .pos = {0.F, 2.F, 20.F}, .atten = Attenuation::from_radius(5.F)}};
+  spots_  = {{.color        = mEn::Vec3(1.F),
+              .pos          = {0.F, 0.F, -200.F},
+              .dir          = {0.F, 0.F, -1.F},
+              .atten        = Attenuation::from_radius(30.F),
+              .cutoff       = 0.99F,
+              .outer_cutoff = 0.98F}};
+  build();
+  EXPECT_TRUE(clusters_.indices().empty());
+}
+
+TEST_F(LightClustersTest, WideSpotLightsReachBehindTheirTip) {
+  // Out to 120 degrees off its direction, which points away from the camera: the points lit below are all nearer the
+  // camera than the light.
+  spots_ = {{.color        = mEn::Vec3(1.F),
+             .pos          = mEn::Vec3(0.F),
+             .dir          = {0.F, 0.F, -1.F},
+             .atten        = Attenuation::from_radius(10.F),
+             .cutoff       = -0.4F,
+             .outer_cutoff = -0.5F}};
+  build();
+
+  for (const mEn::Vec3 point : {mEn::Vec3(6.F, 0.F, 3.F), mEn::Vec3(-6.F, 0.F, 3.F), mEn::Vec3(0.F, -3.F, 1.5F)}) {
+    const mEn::Vec3 to = point - spots_[0].pos;
+    ASSERT_GE(mEn::dot(to, spots_[0].dir), spots_[0].outer_cutoff * mEn::length(to));
+    EXPECT_TRUE(lists(spots_of(find_cluster(point)), 0)) << point.x << ", " << point.y << ", " << point.z;
+  }
+}
+
+TEST_F(LightClustersTest, SmallLightTouchesOnlyNearbyClusters) {
+  points_ = {{.color = mEn::Vec3(1.F), .pos = mEn::Vec3(0.F), .atten = Attenuation::from_radius(0.05F)}};
+  spots_.clear();
+  build();
+
+  const auto& home = find_cluster(mEn::Vec3(0.F));
+  EXPECT_EQ(points_of(home), (std::vector<std::uint32_t>{0}));
+  EXPECT_GE(clusters_.stats().references, 1U);
+  EXPECT_LE(clusters_.stats().references, 8U);
+}
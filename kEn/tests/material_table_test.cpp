@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <kEn/renderer/material.hpp>
+
+namespace {
+
+using kEn::Material;
+using kEn::MaterialTable;
+
+/** @brief A baked material whose parameters no other test uses; the table is process-wide. */
+Material baked(float shininess) {
+  Material material;
+  material.shininess_factor = shininess;
+  material.bake();
+  return material;
+}
+
+}  // namespace
+
+TEST(MaterialTable, EqualMaterialsShareACountedBlock) {
+  const Material first  = baked(1001.F);
+  const Material second = baked(1001.F);
+  ASSERT_TRUE(first.baked());
+  EXPECT_EQ(first.block(), second.block());
+  EXPECT_EQ(MaterialTable::references(first.block()), 2U);
+
+  {
+    const Material copy = first;  // NOLINT(performance-unnecessary-copy-initialization)
+    EXPECT_EQ(copy.block(), first.block());
+    EXPECT_EQ(MaterialTable::references(first.block()), 3U);
+  }
+  EXPECT_EQ(MaterialTable::references(first.block()), 2U);
+
+  Material moved        = baked(1001.F);
+  const Material target = std::move(moved);
+  EXPECT_FALSE(moved.baked());  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(MaterialTable::references(first.block()), 3U);
+}
+
+TEST(MaterialTable, RebakingAnUnsharedMaterialUpdatesItsBlockInPlace) {
+  Material material         = baked(1002.F);
+  const std::uint32_t block = material.block();
+  const std::size_t size    = MaterialTable::blocks().size();
+
+  MaterialTable::clear_dirty();
+  for (int i = 0; i < 100; ++i) {
+    material.shininess_factor = 1003.F + static_cast<float>(i);
+    material.bake();
+    EXPECT_EQ(material.block(), block);
+  }
+  EXPECT_EQ(MaterialTable::blocks().size(), size);
+  EXPECT_EQ(MaterialTable::blocks()[block].m, 1102.F);
+
+  const auto dirty = MaterialTable::dirty_blocks();
+  ASSERT_EQ(dirty.size(), 1U);
+  EXPECT_EQ(dirty.data(), &MaterialTable::blocks()[block]);
+}
+
+TEST(MaterialTable, RebakingASharedMaterialLeavesTheOthersBlockAlone) {
+  const Material other = baked(1201.F);
+  Material edited      = other;
+
+  edited.shininess_factor = 1202.F;
+  edited.bake();
+  EXPECT_NE(edited.block(), other.block());
+  EXPECT_EQ(MaterialTable::blocks()[other.block()].m, 1201.F);
+  EXPECT_EQ(MaterialTable::references(other.block()), 1U);
+
+  // Back to the shared parameters: the edited block is freed rather than left behind.
+  const std::uint32_t freed = edited.block();
+  edited.shininess_factor   = 1201.F;
+  edited.bake();
+  EXPECT_EQ(edited.block(), other.block());
+  EXPECT_EQ(MaterialTable::references(freed), 0U);
+}
+
+TEST(MaterialTable, FreedBlocksAreReused) {
+  std::uint32_t freed = Material::kNoBlock;
+  {
+    const Material material = baked(1301.F);
+    freed                   = material.block();
+  }
+  EXPECT_EQ(MaterialTable::references(freed), 0U);
+
+  const std::size_t size  = MaterialTable::blocks().size();
+  const Material material = baked(1302.F);
+  EXPECT_EQ(material.block(), freed);
+  EXPECT_EQ(MaterialTable::blocks().size(), size);
+}
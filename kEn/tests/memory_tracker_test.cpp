@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <string>
+#include <utility>
+
+#include <kEn/core/memory_tracker.hpp>
+
+namespace {
+
+using kEn::MemoryCategory;
+using kEn::MemoryStats;
+using kEn::MemoryTracker;
+using kEn::TrackedMemory;
+
+/** @brief Every category; the tracker is process-wide, so tests compare against the usage they started from. */
+auto categories() {
+  return std::views::iota(std::size_t{0}, static_cast<std::size_t>(MemoryCategory::Count)) |
+         std::views::transform([](std::size_t i) { return static_cast<MemoryCategory>(i); });
+}
+
+}  // namespace
+
+TEST(MemoryTracker, CountsAllocationsOfEveryCategory) {
+  MemoryTracker::reset_peaks();
+  for (const MemoryCategory category : categories()) {
+    SCOPED_TRACE(std::string(kEn::memory_category::name(category)));
+    const MemoryStats before = MemoryTracker::stats(category);
+    {
+      const TrackedMemory first(category, "test first", 100);
+      const TrackedMemory second(category, "test second", 50);
+
+      const MemoryStats during = MemoryTracker::stats(category);
+      EXPECT_EQ(during.bytes, before.bytes + 150);
+      EXPECT_EQ(during.peak, before.bytes + 150);
+      EXPECT_EQ(during.allocations, before.allocations + 2);
+    }
+
+    const MemoryStats after = MemoryTracker::stats(category);
+    EXPECT_EQ(after.bytes, before.bytes);
+    EXPECT_EQ(after.peak, before.bytes + 150);
+    EXPECT_EQ(after.allocations, before.allocations);
+  }
+}
+
+TEST(MemoryTracker, TotalsSplitGpuAndCpuCategories) {
+  const MemoryStats gpu_before = MemoryTracker::total(true);
+  const MemoryStats cpu_before = MemoryTracker::total(false);
+  const TrackedMemory texture(MemoryCategory::Texture, "test texture", 64);
+  const TrackedMemory bvh(MemoryCategory::TriangleBvh, "test bvh", 32);
+
+  EXPECT_EQ(MemoryTracker::total(true).bytes, gpu_before.bytes + 64);
+  EXPECT_EQ(MemoryTracker::total(false).bytes, cpu_before.bytes + 32);
+}
+
+TEST(MemoryTracker, ResizeAndMoveKeepTheCountsExact) {
+  const MemoryStats before = MemoryTracker::stats(MemoryCategory::Buffer);
+  MemoryTracker::reset_peaks();
+
+  TrackedMemory memory(MemoryCategory::Buffer, "test resized", 10);
+  memory.resize(40);
+  memory.resize(20);
+  EXPECT_EQ(MemoryTracker::stats(MemoryCategory::Buffer).bytes, before.bytes + 20);
+  EXPECT_EQ(MemoryTracker::stats(MemoryCategory::Buffer).peak, before.bytes + 40);
+  EXPECT_EQ(MemoryTracker::stats(MemoryCategory::Buffer).allocations, before.allocations + 1);
+
+  TrackedMemory moved = std::move(memory);
+  EXPECT_EQ(MemoryTracker::stats(MemoryCategory::Buffer).bytes, before.bytes + 20);
+  moved = TrackedMemory();
+  EXPECT_EQ(MemoryTracker::stats(MemoryCategory::Buffer).bytes, before.bytes);
+  EXPECT_EQ(MemoryTracker::stats(MemoryCategory::Buffer).allocations, before.allocations);
+}
+
+TEST(MemoryTracker, ReportsUsageByName) {
+  const TrackedMemory small(MemoryCategory::Framebuffer, "test by name", 8);
+  const TrackedMemory large(MemoryCategory::Framebuffer, "test by name", 24);
+
+  const auto names = MemoryTracker::by_name(MemoryCategory::Framebuffer);
+  const auto it    = std::ranges::find(names, std::string("test by name"), &kEn::NamedMemoryStats::name);
+  ASSERT_NE(it, names.end());
+  EXPECT_EQ(it->stats.bytes, 32U);
+  EXPECT_EQ(it->stats.allocations, 2U);
+}
+
+TEST(MemoryTracker, DetectsBudgetOverruns) {
+  constexpr MemoryCategory kCategory = MemoryCategory::CommandStream;
+  const std::size_t used             = MemoryTracker::stats(kCategory).bytes;
+  MemoryTracker::set_budget(kCategory, used + 1000);
+  EXPECT_EQ(MemoryTracker::budget(kCategory), used + 1000);
+
+  {
+    const TrackedMemory within(kCategory, "test within budget", 1000);
+    EXPECT_EQ(MemoryTracker::overruns(kCategory), 0U);
+
+    const TrackedMemory over(kCategory, "test over budget", 1);
+    EXPECT_EQ(MemoryTracker::overruns(kCategory), 1U);
+    const TrackedMemory further(kCategory, "test over budget", 1);
+    EXPECT_EQ(MemoryTracker::overruns(kCategory), 2U);
+  }
+
+  const TrackedMemory back_within(kCategory, "test within budget", 1000);
+  EXPECT_EQ(MemoryTracker::overruns(kCategory), 2U);
+
+  MemoryTracker::set_budget(kCategory, 0);
+  const TrackedMemory unlimited(kCategory, "test unlimited", 1 << 20);
+  EXPECT_EQ(MemoryTracker::overruns(kCategory), 0U);
+}
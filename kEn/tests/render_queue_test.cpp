@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <kEn/renderer/render_queue.hpp>
+
+namespace {
+
+using kEn::RenderPass;
+using kEn::RenderQueue;
+
+/**
+ * Keys only look at the addresses of the shader, material and vertex input,
+ * so distinct bytes of a buffer stand in for the real objects.
+ */
+struct alignas(64) StateObject {
+  std::byte storage;
+};
+std::array<StateObject, 8> g_state_objects{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+template <typename T>
+const T& stand_in(std::size_t index) {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  return *reinterpret_cast<const T*>(&g_state_objects.at(index));
+}
+
+std::uint64_t key(RenderPass pass, std::size_t shader, std::size_t input, float depth) {
+  return RenderQueue::make_key(pass, stand_in<kEn::Shader>(shader), nullptr, stand_in<kEn::VertexInput>(input), depth);
+}
+
+/** @brief A shader stand-in whose hash differs from the one of stand-in 0; hashes are only 14 bits wide. */
+std::size_t other_shader() {
+  std::size_t shader = 1;
+  while (key(RenderPass::Opaque, shader, 0, 0.F) == key(RenderPass::Opaque, 0, 0, 0.F)) {
+    ++shader;
+  }
+  return shader;
+}
+
+std::vector<std::uint32_t> sorted_order(RenderQueue& queue) {
+  queue.sort();
+  const auto order = queue.order();
+  return {order.begin(), order.end()};
+}
+
+}  // namespace
+
+TEST(RenderQueue, SortMatchesStableSortOfRandomKeys) {
+  std::mt19937_64 rng(42);
+  RenderQueue queue;
+  std::vector<std::uint64_t> keys;
+  for (int i = 0; i < 5000; ++i) {
+    // Few distinct high bits, so some byte positions are skipped and many keys are equal
+    const std::uint64_t value = (rng() & 0xFF00'0000'00FF'00F0ULL) | ((rng() % 4) << 40U);
+    keys.push_back(value);
+    queue.push(value, {});
+  }
+
+  std::vector<std::uint32_t> expected(keys.size());
+  std::iota(expected.begin(), expected.end(), 0U);
+  std::ranges::stable_sort(expected, {}, [&keys](std::uint32_t i) { return keys[i]; });
+
+  EXPECT_EQ(sorted_order(queue), expected);
+}
+
+TEST(RenderQueue, EqualKeysKeepSubmissionOrder) {
+  RenderQueue queue;
+  for (int i = 0; i < 8; ++i) {
+    queue.push(i % 2 == 0 ? 7 : 3, {});
+  }
+  EXPECT_EQ(sorted_order(queue), (std::vector<std::uint32_t>{1, 3, 5, 7, 0, 2, 4, 6}));
+}
+
+TEST(RenderQueue, OrderIsSubmissionOrderUntilSorted) {
+  RenderQueue queue;
+  queue.push(2, {});
+  queue.push(1, {});
+  EXPECT_EQ(std::vector<std::uint32_t>(queue.order().begin(), queue.order().end()),
+            (std::vector<std::uint32_t>{0, 1}));
+
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_TRUE(queue.order().empty());
+}
+
+TEST(RenderQueue, OpaqueDrawsGroupByStateThenFrontToBack) {
+  const std::size_t other = other_shader();
+  RenderQueue queue;
+  queue.push(key(RenderPass::Opaque, 0, 0, 9.F), {});
+  queue.push(key(RenderPass::Opaque, other, 0, 1.F), {});
+  queue.push(key(RenderPass::Opaque, 0, 0, 2.F), {});
+  queue.push(key(RenderPass::Opaque, other, 0, 5.F), {});
+
+  const auto order = sorted_order(queue);
+  const auto at    = [&order](std::uint32_t packet) { return std::ranges::find(order, packet) - order.begin(); };
+  EXPECT_EQ(std::abs(at(0) - at(2)), 1);  // Same state is adjacent...
+  EXPECT_EQ(std::abs(at(1) - at(3)), 1);
+  EXPECT_LT(at(2), at(0));  // ...and nearer first
+  EXPECT_LT(at(1), at(3));
+}
+
+TEST(RenderQueue, TransparentDrawsComeAfterOpaqueBackToFront) {
+  RenderQueue queue;
+  queue.push(key(RenderPass::Transparent, 0, 0, 1.F), {});
+  queue.push(key(RenderPass::Opaque, 0, 0, 100.F), {});
+  queue.push(key(RenderPass::Transparent, 1, 1, 50.F), {});
+  queue.push(key(RenderPass::Transparent, 2, 0, 10.F), {});
+
+  EXPECT_EQ(sorted_order(queue), (std::vector<std::uint32_t>{1, 2, 3, 0}));
+}
+
+TEST(RenderQueue, NegativeDepthSortsAsZero) {
+  EXPECT_EQ(key(RenderPass::Opaque, 0, 0, -3.F), key(RenderPass::Opaque, 0, 0, 0.F));
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <mEn/constants.hpp>
+#include <mEn/functions/matrix_projection.hpp>
+#include <mEn/functions/matrix_transform.hpp>
+#include <mEn/vec3.hpp>
+
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/game_object.hpp>
+#include <kEn/scene/spatial_index.hpp>
+
+namespace {
+
+using kEn::Aabb;
+using kEn::GameObject;
+using kEn::SpatialIndex;
+
+const Aabb kUnitBox = Aabb::from_center_extents(mEn::Vec3(0.F), mEn::Vec3(0.5F));
+
+/** @brief A few hundred unit boxes scattered over a 100^3 volume, registered in an index without worker threads. */
+class SpatialIndexTest : public ::testing::Test {
+ protected:
+  static constexpr std::size_t kObjects = 300;
+
+  SpatialIndexTest() : index_({.background_rebuild = false}), rng_(1234) {
+    for (std::size_t i = 0; i < kObjects; ++i) {
+      objects_.push_back(std::make_unique<GameObject>(random_point()));
+      index_.insert(*objects_.back(), kUnitBox);
+    }
+    index_.update();
+  }
+
+  mEn::Vec3 random_point() {
+    std::uniform_real_distribution<float> coordinate(-50.F, 50.F);
+    return {coordinate(rng_), coordinate(rng_), coordinate(rng_)};
+  }
+
+  /** @brief Objects the index returns for @p shape, sorted. */
+  template <typename Shape>
+  std::vector<GameObject*> query(const Shape& shape) const {
+    std::vector<GameObject*> found;
+    index_.query(shape, [&found](GameObject& object) { found.push_back(&object); });
+    std::ranges::sort(found);
+    return found;
+  }
+
+  /** @brief Objects whose world bounds overlap @p shape, found by testing every object, sorted. */
+  template <typename Shape>
+  std::vector<GameObject*> brute_force(const Shape& shape) const {
+    std::vector<GameObject*> found;
+    for (const auto& object : objects_) {
+      if (object != nullptr && overlaps(index_.world_bounds(*object), shape)) {
+        found.push_back(object.get());
+      }
+    }
+    std::ranges::sort(found);
+    return found;
+  }
+
+  static bool overlaps(const Aabb& box, const Aabb& shape) { return box.overlaps(shape); }
+  static bool overlaps(const Aabb& box, const kEn::Sphere& shape) { return shape.overlaps(box); }
+  static bool overlaps(const Aabb& box, const kEn::Frustum& shape) { return shape.overlaps(box); }
+
+  SpatialIndex index_;
+  std::mt19937 rng_;
+  std::vector<std::unique_ptr<GameObject>> objects_;
+};
+
+}  // namespace
+
+TEST_F(SpatialIndexTest, WorldBoundsFollowTheTransform) {
+  const auto& object = *objects_.front();
+  const Aabb& bounds = index_.world_bounds(object);
+  const auto center  = object.transform().local_pos();
+  for (int axis = 0; axis < 3; ++axis) {
+    EXPECT_NEAR(bounds.min[axis], center[axis] - 0.5F, 1e-4F);
+    EXPECT_NEAR(bounds.max[axis], center[axis] + 0.5F, 1e-4F);
+  }
+}
+
+TEST_F(SpatialIndexTest, BoxQueriesMatchBruteForce) {
+  for (int i = 0; i < 50; ++i) {
+    const Aabb box = Aabb::from_center_extents(random_point(), mEn::Vec3(static_cast<float>(i % 10) * 2.F + 1.F));
+    EXPECT_EQ(query(box), brute_force(box));
+  }
+}
+
+TEST_F(SpatialIndexTest, SphereQueriesMatchBruteForce) {
+  for (int i = 0; i < 50; ++i) {
+    const kEn::Sphere sphere{.center = random_point(), .radius = static_cast<float>(i % 10) * 3.F + 0.5F};
+    EXPECT_EQ(query(sphere), brute_force(sphere));
+  }
+}
+
+TEST_F(SpatialIndexTest, FrustumQueriesMatchBruteForce) {
+  const auto projection = mEn::perspective(mEn::kPi<float> / 3.F, 16.F / 9.F, 0.1F, 60.F);
+  for (int i = 0; i < 20; ++i) {
+    const auto view    = mEn::lookAt(random_point(), random_point(), mEn::Vec3(0.F, 1.F, 0.F));
+    const auto frustum = kEn::Frustum::from_matrix(projection * view);
+    EXPECT_EQ(query(frustum), brute_force(frustum));
+  }
+}
+
+TEST_F(SpatialIndexTest, QueriesSeeMovedObjectsAfterUpdate) {
+  for (std::size_t i = 0; i < kObjects; i += 2) {
+    objects_[i]->transform().set_local_pos(random_point());
+  }
+  index_.update();
+  EXPECT_EQ(index_.stats().moved, kObjects / 2);
+
+  for (int i = 0; i < 20; ++i) {
+    const Aabb box = Aabb::from_center_extents(random_point(), mEn::Vec3(10.F));
+    EXPECT_EQ(query(box), brute_force(box));
+  }
+}
+
+TEST_F(SpatialIndexTest, RebuiltTreesStayExactUnderIncrementalUpdates) {
+  EXPECT_EQ(index_.stats().rebuilds, 1U);
+  for (int round = 0; round < 10; ++round) {
+    for (const auto& object : objects_) {
+      object->transform().set_local_pos(random_point());
+    }
+    index_.update();
+
+    for (int i = 0; i < 10; ++i) {
+      const Aabb box = Aabb::from_center_extents(random_point(), mEn::Vec3(15.F));
+      EXPECT_EQ(query(box), brute_force(box));
+    }
+  }
+}
+
+TEST_F(SpatialIndexTest, RaycastReturnsTheNearestBounds) {
+  const kEn::Ray ray(mEn::Vec3(-100.F, 0.F, 0.F), mEn::Vec3(1.F, 0.F, 0.F));
+  auto& near = *objects_[0];
+  auto& far  = *objects_[1];
+  near.transform().set_local_pos(mEn::Vec3(-80.F, 0.F, 0.F));
+  far.transform().set_local_pos(mEn::Vec3(-70.F, 0.F, 0.F));
+  index_.update();
+
+  const auto hit = index_.raycast(ray);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->object, &near);
+  EXPECT_EQ(hit->mesh, nullptr);
+  EXPECT_NEAR(hit->distance, 19.5F, 1e-4F);
+}
+
+TEST_F(SpatialIndexTest, DestroyedObjectsLeaveTheIndex) {
+  const Aabb everything = Aabb::from_center_extents(mEn::Vec3(0.F), mEn::Vec3(100.F));
+  GameObject* destroyed = objects_[3].get();
+  EXPECT_EQ(destroyed->spatial_index(), &index_);
+
+  objects_[3].reset();
+  EXPECT_EQ(index_.size(), kObjects - 1);
+  index_.update();
+  EXPECT_EQ(query(everything), brute_force(everything));
+  EXPECT_EQ(query(everything).size(), kObjects - 1);
+}
+
+TEST(SpatialIndex, ReleasesObjectsWhenDestroyedFirst) {
+  GameObject object;
+  {
+    SpatialIndex index;
+    index.insert(object, kUnitBox);
+    EXPECT_TRUE(index.contains(object));
+  }
+  EXPECT_EQ(object.spatial_index(), nullptr);
+}
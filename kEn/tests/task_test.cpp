@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include <kEn/core/application.hpp>
+#include <kEn/core/job_system.hpp>
+#include <kEn/core/layer.hpp>
+#include <kEn/core/task.hpp>
+
+namespace {
+
+using kEn::Task;
+
+Task<int> one() { co_return 1; }
+
+Task<int> sum_of_ones(int count) {
+  int total = 0;
+  for (int i = 0; i < count; ++i) {
+    total += co_await one();
+  }
+  co_return total;
+}
+
+Task<int> fail(const char* message) {
+  throw std::runtime_error(message);
+  co_return 0;
+}
+
+Task<void> fail_void() {
+  throw std::logic_error("void task failed");
+  co_return;
+}
+
+Task<int> recover(const char* message) {
+  try {
+    co_return co_await fail(message);
+  } catch (const std::runtime_error&) {
+    co_return -1;
+  }
+}
+
+Task<int> forward(const char* message) { co_return co_await fail(message) + 1; }
+
+/** @brief Where each half of @ref hop ran. */
+struct HopThreads {
+  std::thread::id worker;
+  std::thread::id main;
+  int worker_index = -1;
+};
+
+Task<HopThreads> hop() {
+  HopThreads threads;
+  co_await kEn::resume_on_worker("hop");
+  threads.worker       = std::this_thread::get_id();
+  threads.worker_index = kEn::JobSystem::worker_index();
+  co_await kEn::resume_on_main_thread();
+  threads.main = std::this_thread::get_id();
+  co_return threads;
+}
+
+/** @brief Awaits @ref hop, which finishes on another thread than the one it was awaited on. */
+Task<HopThreads> await_hop() { co_return co_await hop(); }
+
+/** @brief Starts a task when attached and closes the application once it is done, or after a few seconds. */
+class RunTask : public kEn::Layer {
+ public:
+  explicit RunTask(Task<HopThreads>& task) : Layer("RunTask"), task_(task) {}
+
+  void on_attach() override { task_.start(); }
+
+  void on_update(kEn::Timestep /*delta*/, kEn::Timestep /*time*/) override {
+    if (task_.done() || ++ticks_ > kMaxTicks) {
+      kEn::Application::instance().close();
+    }
+  }
+
+ private:
+  static constexpr int kMaxTicks = 600;
+
+  Task<HopThreads>& task_;
+  int ticks_ = 0;
+};
+
+}  // namespace
+
+TEST(Task, StartedTaskRunsToCompletion) {
+  auto task = sum_of_ones(3);
+  EXPECT_FALSE(task.done());
+  task.start();
+  ASSERT_TRUE(task.done());
+  EXPECT_EQ(task.result(), 3);
+}
+
+// Every awaited task finishes synchronously; without symmetric transfer each of them would resume its awaiter on a
+// deeper stack frame and this would overflow the stack.
+TEST(Task, SynchronousAwaitsDoNotGrowTheStack) {
+  constexpr int kAwaits = 1'000'000;
+  auto task             = sum_of_ones(kAwaits);
+  task.start();
+  ASSERT_TRUE(task.done());
+  EXPECT_EQ(task.result(), kAwaits);
+}
+
+TEST(Task, ResultRethrowsTheTasksException) {
+  auto task = fail("task failed");
+  task.start();
+  ASSERT_TRUE(task.done());
+  EXPECT_THROW(task.result(), std::runtime_error);
+
+  auto void_task = fail_void();
+  void_task.start();
+  ASSERT_TRUE(void_task.done());
+  EXPECT_THROW(void_task.result(), std::logic_error);
+}
+
+TEST(Task, ExceptionsPropagateOutOfCoAwait) {
+  auto recovered = recover("caught by the awaiter");
+  recovered.start();
+  ASSERT_TRUE(recovered.done());
+  EXPECT_EQ(recovered.result(), -1);
+
+  auto forwarded = forward("passed through the awaiter");
+  forwarded.start();
+  ASSERT_TRUE(forwarded.done());
+  EXPECT_THROW(forwarded.result(), std::runtime_error);
+}
+
+TEST(Task, HopsToAWorkerAndBackToTheMainThread) {
+  kEn::Application app({.headless = true, .worker_threads = 2});
+  auto task = await_hop();
+  app.push_layer(std::make_unique<RunTask>(task));
+  app.run();
+
+  ASSERT_TRUE(task.done());
+  const HopThreads threads = task.result();
+  EXPECT_GE(threads.worker_index, 0);
+  EXPECT_NE(threads.worker, std::this_thread::get_id());
+  EXPECT_EQ(threads.main, std::this_thread::get_id());
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <mEn/functions/geometric.hpp>
+#include <mEn/vec3.hpp>
+
+#include <kEn/scene/bounds.hpp>
+#include <kEn/scene/triangle_bvh.hpp>
+
+namespace {
+
+using kEn::Ray;
+using kEn::TriangleBvh;
+using kEn::TriangleHit;
+
+struct Soup {
+  std::vector<mEn::Vec3> positions;
+  std::vector<uint32_t> indices;
+};
+
+/** @brief Small random triangles scattered in a 20^3 box, some of them sharing vertices. */
+Soup random_soup(std::mt19937& rng, std::size_t triangles) {
+  std::uniform_real_distribution<float> coordinate(-10.F, 10.F);
+  std::uniform_real_distribution<float> offset(-0.5F, 0.5F);
+  Soup soup;
+  for (std::size_t i = 0; i < triangles; ++i) {
+    const mEn::Vec3 center(coordinate(rng), coordinate(rng), coordinate(rng));
+    for (int corner = 0; corner < 3; ++corner) {
+      const bool shared = corner == 0 && i > 0 && i % 4 == 0;
+      const auto next   = static_cast<uint32_t>(soup.positions.size());
+      soup.indices.push_back(shared ? soup.indices[soup.indices.size() - 3] : next);
+      if (!shared) {
+        soup.positions.push_back(center + mEn::Vec3(offset(rng), offset(rng), offset(rng)));
+      }
+    }
+  }
+  return soup;
+}
+
+/** @brief Reference answer: every triangle tested with Möller-Trumbore, two-sided. */
+std::optional<TriangleHit> brute_force(const Soup& soup, const Ray& ray, float max_t) {
+  std::optional<TriangleHit> best;
+  for (std::size_t tri = 0; tri < soup.indices.size() / 3; ++tri) {
+    const mEn::Vec3 a = soup.positions[soup.indices[3 * tri]];
+    const mEn::Vec3 b = soup.positions[soup.indices[(3 * tri) + 1]];
+    const mEn::Vec3 c = soup.positions[soup.indices[(3 * tri) + 2]];
+
+    const mEn::Vec3 e1 = b - a;
+    const mEn::Vec3 e2 = c - a;
+    const mEn::Vec3 p  = mEn::cross(ray.direction, e2);
+    const float det    = mEn::dot(e1, p);
+    if (std::abs(det) < 1e-12F) {
+      continue;
+    }
+    const mEn::Vec3 s = ray.origin - a;
+    const float u     = mEn::dot(s, p) / det;
+    const mEn::Vec3 q = mEn::cross(s, e1);
+    const float v     = mEn::dot(ray.direction, q) / det;
+    const float t     = mEn::dot(e2, q) / det;
+    if (u < 0.F || v < 0.F || u + v > 1.F || t < 0.F || t >= max_t) {
+      continue;
+    }
+    if (!best || t < best->distance) {
+      best = TriangleHit{.triangle = static_cast<uint32_t>(tri), .distance = t, .u = u, .v = v};
+    }
+  }
+  return best;
+}
+
+Ray random_ray(std::mt19937& rng) {
+  std::uniform_real_distribution<float> coordinate(-15.F, 15.F);
+  const mEn::Vec3 origin(coordinate(rng), coordinate(rng), coordinate(rng));
+  const mEn::Vec3 target(coordinate(rng), coordinate(rng), coordinate(rng));
+  return {origin, target - origin};
+}
+
+}  // namespace
+
+TEST(TriangleBvh, RaycastMatchesBruteForce) {
+  std::mt19937 rng(2024);
+  const Soup soup = random_soup(rng, 1000);
+  const TriangleBvh bvh(soup.positions, soup.indices);
+
+  std::size_t hits = 0;
+  for (int i = 0; i < 2000; ++i) {
+    const Ray ray       = random_ray(rng);
+    const auto expected = brute_force(soup, ray, ray.max_distance);
+    const auto actual   = bvh.raycast(ray, ray.max_distance);
+    ASSERT_EQ(actual.has_value(), expected.has_value()) << "ray " << i;
+    if (expected) {
+      ++hits;
+      EXPECT_NEAR(actual->distance, expected->distance, 1e-4F * expected->distance) << "ray " << i;
+      EXPECT_EQ(actual->triangle, expected->triangle) << "ray " << i;
+    }
+  }
+  // Both outcomes must actually be exercised.
+  EXPECT_GT(hits, 200U);
+  EXPECT_LT(hits, 1800U);
+}
+
+TEST(TriangleBvh, RaycastIgnoresHitsBeyondMaxDistance) {
+  std::mt19937 rng(7);
+  const Soup soup = random_soup(rng, 500);
+  const TriangleBvh bvh(soup.positions, soup.indices);
+
+  for (int i = 0; i < 500; ++i) {
+    const Ray ray      = random_ray(rng);
+    const auto nearest = brute_force(soup, ray, ray.max_distance);
+    if (!nearest) {
+      continue;
+    }
+    EXPECT_FALSE(bvh.raycast(ray, nearest->distance * 0.999F).has_value());
+    EXPECT_EQ(bvh.raycast(ray, nearest->distance * 1.001F)->triangle, nearest->triangle);
+  }
+}
+
+TEST(TriangleBvh, BarycentricsReconstructTheHitPoint) {
+  const std::vector<mEn::Vec3> positions{{0.F, 0.F, 0.F}, {2.F, 0.F, 0.F}, {0.F, 2.F, 0.F}};
+  const TriangleBvh bvh(positions, {0, 1, 2});
+
+  const Ray ray(mEn::Vec3(0.5F, 0.25F, 3.F), mEn::Vec3(0.F, 0.F, -2.F));
+  const auto hit = bvh.raycast(ray, ray.max_distance);
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->triangle, 0U);
+  EXPECT_FLOAT_EQ(hit->distance, 1.5F);  // In units of the unnormalized direction
+
+  const mEn::Vec3 point = positions[0] * (1.F - hit->u - hit->v) + positions[1] * hit->u + positions[2] * hit->v;
+  EXPECT_FLOAT_EQ(point.x, 0.5F);
+  EXPECT_FLOAT_EQ(point.y, 0.25F);
+
+  // Two-sided: the same triangle is hit from behind.
+  const Ray back(mEn::Vec3(0.5F, 0.25F, -1.F), mEn::Vec3(0.F, 0.F, 1.F));
+  EXPECT_TRUE(bvh.raycast(back, back.max_distance).has_value());
+}
+
+TEST(TriangleBvh, EmptyMeshNeverHits) {
+  const TriangleBvh bvh({}, {});
+  const Ray ray(mEn::Vec3(0.F), mEn::Vec3(1.F, 0.F, 0.F));
+  EXPECT_EQ(bvh.triangle_count(), 0U);
+  EXPECT_FALSE(bvh.raycast(ray, ray.max_distance).has_value());
+}